@@ -0,0 +1,52 @@
+#!/bin/sh
+
+# Thread scaling of the two accumulation modes of the tiled sampler.
+#
+# The Cornell Box is rendered with the tiled sampler at a range of thread
+# counts, once with the render tiles merged by the merge thread (queued
+# accumulation), and once with the render threads merging their tiles
+# themselves (direct accumulation). Every line of the resulting table lists
+# mode, threads, render time in seconds and samples per second.
+
+common_properties="
+	-b
+	-res=512x512
+	"
+
+samples=256
+thread_counts="1 2 4 8 16 32 64"
+
+results=AccumulationScaling.txt
+
+echo "# mode threads seconds samples_per_second" > ${results}
+
+for threads in ${thread_counts}
+do
+	for direct in NO YES
+	do
+		if [ ${direct} = YES ]
+		then
+			mode=direct
+		else
+			mode=queued
+		fi
+
+		start=`date +%s.%N`
+
+		artist CornellBox.arm \
+			   ${common_properties} \
+			   -j=${threads} \
+			   -DSAMPLES=${samples} \
+			   -DDIRECT_ACCUMULATION=${direct} \
+			   -tt ${mode}_${threads}
+
+		end=`date +%s.%N`
+
+		seconds=`echo "${end} - ${start}" | bc`
+
+		echo "${mode} ${threads} ${seconds}" \
+			 `echo "512 * 512 * ${samples} / ${seconds}" | bc` >> ${results}
+	done
+done
+
+cat ${results}
@@ -0,0 +1,57 @@
+#!/bin/sh
+
+# Convergence comparison of the random generators on the Cornell Box.
+#
+# A high sample count reference is rendered first; each generator is then
+# rendered at a series of sample counts, and compared against the reference
+# with art_imagesnr. Every line of the resulting table lists generator,
+# samples per pixel, render time in seconds and SNR (spectral and RGB), so
+# that both equal-spp and (by picking rows with matching times) equal-time
+# comparisons can be read off it.
+
+common_properties="
+	-b
+	-res=256x256
+	"
+
+reference_samples=8192
+sample_counts="16 32 64 128 256 512"
+generators="RANDOM_SEQUENCE HALTON_SEQUENCE EFFICIENT_SEQUENCE COUNTER_BASED_SEQUENCE SOBOL_SEQUENCE"
+
+results=SamplerConvergence.txt
+
+artist CornellBox.arm \
+	   ${common_properties} \
+	   -DSAMPLES=${reference_samples} \
+	   -DRANDOM_GENERATOR=SOBOL_SEQUENCE \
+	   -tt reference
+
+echo "# generator spp seconds snr snr_rgb" > ${results}
+
+for generator in ${generators}
+do
+	for samples in ${sample_counts}
+	do
+		tag=${generator}_${samples}
+
+		start=`date +%s.%N`
+
+		artist CornellBox.arm \
+			   ${common_properties} \
+			   -DSAMPLES=${samples} \
+			   -DRANDOM_GENERATOR=${generator} \
+			   -tt ${tag}
+
+		end=`date +%s.%N`
+
+		art_imagesnr CornellBox.reference.artraw \
+			   -c CornellBox.${tag}.artraw \
+			   -o CornellBox.${tag}.snr
+
+		echo "${generator} ${samples}" \
+			 `echo "${end} - ${start}" | bc` \
+			 `cat CornellBox.${tag}.snr` >> ${results}
+	done
+done
+
+cat ${results}
@@ -0,0 +1,74 @@
+#!/bin/sh
+
+# Delta and ratio tracking through the smoke cloud of Volume.arm.
+#
+# The heterogeneous smoke volume (smoke.vol) is rendered with the plain
+# exponential tracking integrator, non-fluorescent scattering and no
+# other geometry, at several density scales - the denser the cloud, the
+# more a single global majorant overestimates its thin parts. A high
+# sample count reference is rendered first for each scale. The scene is
+# then rendered with the current artist and - if BASELINE_ARTIST points
+# to the artist binary of an older build, e.g. one that still tracks
+# with the per-ray majorant - with that one as well. Every line of the
+# resulting table lists the binary, density scale, samples per pixel,
+# render time in seconds and SNR (spectral and RGB) against the
+# reference.
+#
+# If the artist was built with ART_WITH_VOLUME_TRACKING_STATISTICS, the
+# number of majorant segments, real and null collisions of each render
+# are appended to its row as well.
+
+common_properties="
+	-b
+	-res=256x256
+	-DHETEROGENEOUS
+	-DUSE_NON_FLUO=0.8
+	-DDISTANCE_EXP
+	-DALG_MIS
+	-DPLAIN_BOX
+	$*
+	"
+
+reference_samples=4096
+samples=64
+density_scales="1 4 16"
+
+results=VolumeTracking.txt
+
+echo "# artist scale spp seconds snr snr_rgb segments real null" > ${results}
+
+for scale in ${density_scales}
+do
+	artist Volume.arm \
+		   ${common_properties} \
+		   -DHETERO_SCALE=${scale} \
+		   -DSAMPLES=${reference_samples} \
+		   -tt reference_${scale}
+
+	for binary in artist ${BASELINE_ARTIST}
+	do
+		tag=`basename ${binary}`_${scale}
+
+		start=`date +%s.%N`
+
+		${binary} Volume.arm \
+			   ${common_properties} \
+			   -DHETERO_SCALE=${scale} \
+			   -DSAMPLES=${samples} \
+			   -tt ${tag} > Volume.${tag}.log
+
+		end=`date +%s.%N`
+
+		art_imagesnr Volume.reference_${scale}.artraw \
+			   -c Volume.${tag}.artraw \
+			   -o Volume.${tag}.snr
+
+		echo "${binary} ${scale} ${samples}" \
+			 `echo "${end} - ${start}" | bc` \
+			 `cat Volume.${tag}.snr` \
+			 `sed -n 's/.*tracking statistics: \([0-9]*\) [^,]*, \([0-9]*\) [^,]*, \([0-9]*\) .*/\1 \2 \3/p' Volume.${tag}.log` \
+			 >> ${results}
+	done
+done
+
+cat ${results}
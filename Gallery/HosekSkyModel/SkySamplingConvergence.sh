@@ -0,0 +1,59 @@
+#!/bin/sh
+
+# Equal-time comparison of sky dome sampling on LowSunSkySampling.arm.
+#
+# A high sample count reference is rendered first. The scene is then
+# rendered at a series of sample counts with the current artist, and -
+# if BASELINE_ARTIST points to the artist binary of an older build, e.g.
+# one that still samples the sky dome uniformly - with that one as well.
+# Every line of the resulting table lists the binary, samples per pixel,
+# render time in seconds and SNR (spectral and RGB) against the
+# reference; rows with matching times give the equal-time comparison.
+#
+# Additional scene options (e.g. -DPRAGUE or -DELEV=10) can be passed
+# as arguments to this script.
+
+common_properties="
+	-b
+	-res=400x300
+	$*
+	"
+
+reference_samples=4096
+sample_counts="4 8 16 32 64 128"
+
+results=SkySamplingConvergence.txt
+
+artist LowSunSkySampling.arm \
+	   ${common_properties} \
+	   -DSAMPLES=${reference_samples} \
+	   -tt reference
+
+echo "# artist spp seconds snr snr_rgb" > ${results}
+
+for binary in artist ${BASELINE_ARTIST}
+do
+	for samples in ${sample_counts}
+	do
+		tag=`basename ${binary}`_${samples}
+
+		start=`date +%s.%N`
+
+		${binary} LowSunSkySampling.arm \
+			   ${common_properties} \
+			   -DSAMPLES=${samples} \
+			   -tt ${tag}
+
+		end=`date +%s.%N`
+
+		art_imagesnr LowSunSkySampling.reference.artraw \
+			   -c LowSunSkySampling.${tag}.artraw \
+			   -o LowSunSkySampling.${tag}.snr
+
+		echo "${binary} ${samples}" \
+			 `echo "${end} - ${start}" | bc` \
+			 `cat LowSunSkySampling.${tag}.snr` >> ${results}
+	done
+done
+
+cat ${results}
@@ -64,6 +64,18 @@ typedef ArNode *  ArObj;
  */
 #define EFFICIENT_SEQUENCE          arrandomvaluegeneration_efficient
 
+/**
+ * @def COUNTER_BASED_SEQUENCE
+ * @brief Counter-based (Philox) random sequence, reproducible across thread counts
+ */
+#define COUNTER_BASED_SEQUENCE      arrandomvaluegeneration_philox
+
+/**
+ * @def SOBOL_SEQUENCE
+ * @brief Owen-scrambled Sobol sequence, padded per dimension
+ */
+#define SOBOL_SEQUENCE              arrandomvaluegeneration_sobol
+
 /**
  * @def PSEUDORANDOM_SEQUENCE
  * @brief Pseudorandom sequence
@@ -79,6 +79,29 @@ ArNode <ArpSampling2D> * standard_sampler_2D(
         randomValueGeneration   : (int) newRandomValueGeneration
         ;
 
+//   Adaptive sampling: 'samplesPerPixel' is only the upper limit, pixels
+//   stop once their relative noise is below 'noiseThreshold' (e.g. 0.01).
+
+- (id) sampleProvider
+                                : (ArNode <ArpPathspaceIntegrator> *) newRaySampler
+        sampleSplattingKernel   : (ArNode <ArpReconstructionKernel> *) newReconstructionKernel
+        samplesPerPixel         : (unsigned int) newNumberOfSamples
+        noiseThreshold          : (double) newNoiseThreshold
+        randomValueGeneration   : (int) newRandomValueGeneration
+        ;
+
+//   Direct accumulation: render threads merge their tiles themselves
+//   instead of handing them to the merge thread. YES or NO overrides the
+//   default, which is to only do this for 16 or more render threads.
+
+- (id) sampleProvider
+                                : (ArNode <ArpPathspaceIntegrator> *) newRaySampler
+        sampleSplattingKernel   : (ArNode <ArpReconstructionKernel> *) newReconstructionKernel
+        samplesPerPixel         : (unsigned int) newNumberOfSamples
+        directAccumulation      : (BOOL) newDirectAccumulation
+        randomValueGeneration   : (int) newRandomValueGeneration
+        ;
+
 @end
 #define TILED_STOCHASTIC_SAMPLER  \
     ALLOC_OBJECT_AUTORELEASE(ArnTiledStochasticSampler)
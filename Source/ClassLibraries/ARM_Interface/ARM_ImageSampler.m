@@ -153,6 +153,50 @@ ArNode <ArpSampling2D> * standard_sampler_2D(
             ];
 }
 
+- (id) sampleProvider
+
+                                : (ArNode <ArpPathspaceIntegrator> *) newRaySampler
+        sampleSplattingKernel    : (ArNode <ArpReconstructionKernel> *) newReconstructionKernel
+        samplesPerPixel         : (unsigned int) newNumberOfSamples
+        noiseThreshold          : (double) newNoiseThreshold
+        randomValueGeneration   : (int) newRandomValueGeneration
+{
+    [ self init
+        :   newRaySampler
+        :   newReconstructionKernel
+        :   newNumberOfSamples
+        :   newRandomValueGeneration
+        ];
+
+    [ self useAdaptiveSampling
+        :   newNoiseThreshold
+        ];
+
+    return self;
+}
+
+- (id) sampleProvider
+
+                                : (ArNode <ArpPathspaceIntegrator> *) newRaySampler
+        sampleSplattingKernel    : (ArNode <ArpReconstructionKernel> *) newReconstructionKernel
+        samplesPerPixel         : (unsigned int) newNumberOfSamples
+        directAccumulation      : (BOOL) newDirectAccumulation
+        randomValueGeneration   : (int) newRandomValueGeneration
+{
+    [ self init
+        :   newRaySampler
+        :   newReconstructionKernel
+        :   newNumberOfSamples
+        :   newRandomValueGeneration
+        ];
+
+    [ self useDirectAccumulation
+        :   newDirectAccumulation
+        ];
+
+    return self;
+}
+
 @end
 
 @implementation ArnStochasticImageSampler ( ARM_Interface )
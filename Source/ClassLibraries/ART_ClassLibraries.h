@@ -44,6 +44,7 @@ ART_LIBRARY_INTERFACE(ART_ClassLibraries)
 #include "ART_Shape.h"
 #include "ART_SkyModel.h"
 #include "ART_RayCasting.h"
+#include "ART_RayCastingAcceleration.h"
 #include "ART_SurfaceMaterial.h"
 #include "ART_EmissiveSurfaceMaterial.h"
 #include "ART_EnvironmentMaterial.h"
@@ -51,6 +51,7 @@ ART_LIBRARY_INITIALISATION_FUNCTION
     ART_PERFORM_LIBRARY_INITIALISATION( ART_Shape )
     ART_PERFORM_LIBRARY_INITIALISATION( ART_SkyModel )
     ART_PERFORM_LIBRARY_INITIALISATION( ART_RayCasting )
+    ART_PERFORM_LIBRARY_INITIALISATION( ART_RayCastingAcceleration )
     ART_PERFORM_LIBRARY_INITIALISATION( ART_Lightsource )
     ART_PERFORM_LIBRARY_INITIALISATION( ART_ImageSampler )
     ART_PERFORM_LIBRARY_INITIALISATION( ART_PhaseFunction )
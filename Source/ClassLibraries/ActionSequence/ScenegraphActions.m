@@ -533,6 +533,12 @@ ARPACTION_DEFAULT_IMPLEMENTATION(ArnCreateBSPTreeAction)
         :   "creating BSP tree"
         ];
 
+    //   The leaves of the top level tree become instances with pre-computed
+    //   trafos and attribute bindings, so that the attribute nodes above
+    //   the shapes no longer have to be traversed for every ray.
+
+    [ leafNodeBBoxCollection compileInstances ];
+
     ArnBSPTree  * bspTree =
         [ ALLOC_INIT_OBJECT(ArnBSPTree)
             :   HARD_NODE_REFERENCE(sceneGeometry)
@@ -547,6 +553,11 @@ ARPACTION_DEFAULT_IMPLEMENTATION(ArnCreateBSPTreeAction)
     RELEASE_OBJECT( bspTree );
     RELEASE_NODE_REF( node_Ref_BBoxes );
 
+    //   The internal trees of all meshes have been built by now as well, so
+    //   this is the point where a BSP tree cache can be brought up to date.
+
+    art_write_bsp_tree_cache( art_gv );
+
     [ REPORTER endAction ];
 
     [ nodeStack push
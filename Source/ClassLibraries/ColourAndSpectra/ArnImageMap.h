@@ -41,7 +41,7 @@ ART_MODULE_INTERFACE(ArnImageMap)
     double       scaleFactor;
     IVec2D       sourceImageSize;
     
-    ArRGB      * imageRGBData;
+    FCrd3      * imageCoefficientData;
     ArSpectrum **imageSpectralData;
     
     BOOL         isSpectral;
@@ -65,8 +65,8 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
 #define IMAGE_DATA_C3(_p2d) \
     (imageDataC3[((int)(XC(sourceImageSize)*XC(_p2d)))+((int)(YC(sourceImageSize)*YC(_p2d)))*XC(sourceImageSize)])
 
-#define IMAGE_DATA_RGB(_p2d) \
-    (imageRGBData[((int)(XC(sourceImageSize)*XC(_p2d)))+((int)(YC(sourceImageSize)*YC(_p2d)))*XC(sourceImageSize)])
+#define IMAGE_DATA_COEFFICIENTS(_p2d) \
+    (imageCoefficientData[((int)(XC(sourceImageSize)*XC(_p2d)))+((int)(YC(sourceImageSize)*YC(_p2d)))*XC(sourceImageSize)])
 
 #define IMAGE_DATA_SPECTRAL(_p2d) \
     (imageSpectralData[((int)(XC(sourceImageSize)*XC(_p2d)))+((int)(YC(sourceImageSize)*YC(_p2d)))*XC(sourceImageSize)])
@@ -158,7 +158,10 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnImageMap)
         }
     } else {
         ucc = ucc_srgb( art_gv );
-        imageRGBData = ALLOC_ARRAY( ArRGB, sourceImageDataSize );
+
+        //   The RGB values are only needed until they have been uplifted.
+
+        ArRGB  * imageRGBData = ALLOC_ARRAY( ArRGB, sourceImageDataSize );
 
         double  max = 0;
         
@@ -222,6 +225,25 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnImageMap)
                 rgb_d_mul_s( art_gv, scale_factor, & imageRGBData[i] );
             }
         }
+
+        //   Texture lookups are not filtered, so each texel always yields
+        //   the same spectrum. We therefore uplift each texel just once,
+        //   and only store its sigmoid coefficients: a lookup then costs a
+        //   single sigmoid evaluation per hero wavelength, instead of the
+        //   eight that a full trip through the coefficient cube would take.
+
+        imageCoefficientData = ALLOC_ARRAY( FCrd3, sourceImageDataSize );
+
+        for ( int i = 0; i < sourceImageDataSize; i++)
+        {
+            ucc_rgb_to_coefficients(
+                  ucc,
+                & imageRGBData[i],
+                & imageCoefficientData[i]
+                );
+        }
+
+        FREE_ARRAY( imageRGBData );
     }
     
     RELEASE_OBJECT(sourceImageBuffer);
@@ -245,7 +267,7 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnImageMap)
     {
         scaleFactor = newScaleFactor;
         
-        imageRGBData = NULL;
+        imageCoefficientData = NULL;
         imageSpectralData = NULL;
 
         isSpectral = NO;
@@ -258,8 +280,8 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnImageMap)
 
 - (void) dealloc
 {
-    if (imageRGBData) {
-        FREE_ARRAY(imageRGBData);
+    if (imageCoefficientData) {
+        FREE_ARRAY(imageCoefficientData);
     }
 
     if (imageSpectralData) {
@@ -355,10 +377,9 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnImageMap)
                 );
         }
     } else {
-        ucc_rgb_to_sps(
+        ucc_coefficients_to_sps(
             art_gv,
-            ucc,
-          & IMAGE_DATA_RGB(*p2d),
+          & IMAGE_DATA_COEFFICIENTS(*p2d),
             wavelength,
             outSpectralSample
             );
@@ -33,7 +33,7 @@ ART_MODULE_INTERFACE(ArnHosekSkyModel_EnvironmentMaterial)
 
 
 @interface ArnHosekSkyModel (EnvironmentMaterial)
-        < ArpEnvironmentMaterial >
+        < ArpEnvironmentMaterial, ArpSkyRadianceCacheSource >
         @end
 
 
@@ -35,6 +35,36 @@ ART_NO_MODULE_INITIALISATION_FUNCTION_NECESSARY
 
 ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
 
+//   Zenith angle and angular distance from the sun of a normalised
+//   direction, as used by the model.
+
+static void arnhosekskymodel_model_angles(
+        const Vec3D   * direction,
+        const Vec3D   * sunDirection,
+              double  * elevation,
+              double  * distanceFromSun
+        )
+{
+    *elevation =
+        atan2(
+            sqrt( M_SQR(XC(*direction)) + M_SQR(YC(*direction)) ),
+            ZC(*direction)
+            );
+
+    if ( *elevation < 0.0 ) *elevation = -*elevation;
+
+    if ( *elevation < 0.01)
+        *elevation = 0.01;
+
+    if ( *elevation > MATH_PI_DIV_2 )
+        *elevation = MATH_PI_DIV_2;
+
+    double vDot = vec3d_vv_dot( direction, sunDirection );
+
+    if ( vDot > 1.0 ) vDot = 1.0;
+
+    *distanceFromSun = acos( vDot );
+}
 
 @implementation ArnHosekSkyModel (EnvironmentMaterial)
 
@@ -54,25 +84,14 @@ ARPSURFACEMATERIAL_DEFAULT_EMITTER_SURFACETYPE_IMPLEMENTATION
 
     vec3d_norm_v(&hitNormal);
 
-    double elevation =
-        atan2(
-            sqrt( M_SQR(XC(hitNormal)) + M_SQR(YC(hitNormal)) ),
-            ZC(hitNormal)
-            );
-
-    if ( elevation < 0.0 ) elevation = -elevation;
-
-    if ( elevation < 0.01)
-        elevation = 0.01;
-
-    if ( elevation > MATH_PI_DIV_2 )
-        elevation = MATH_PI_DIV_2;
+    double  elevation, distanceFromSun;
 
-    double vDot = vec3d_vv_dot( & hitNormal, & sunDirection );
-
-    if ( vDot > 1.0 ) vDot = 1.0;
-
-    double distanceFromSun = acos( vDot );
+    arnhosekskymodel_model_angles(
+        & hitNormal,
+        & sunDirection,
+        & elevation,
+        & distanceFromSun
+        );
     
     if ( distanceFromSun <= ( solarRadius + 0.00001 ) )
     {
@@ -103,14 +122,22 @@ ARPSURFACEMATERIAL_DEFAULT_EMITTER_SURFACETYPE_IMPLEMENTATION
 
         ArSpectralSample  sky_sample;
 
-         arhosekskymodel_sps(
-              art_gv,
-              skymodel_state_hero,
-              elevation,
-              distanceFromSun,
-              wavelength,
-            & sky_sample
-            );
+        ArcSkyRadianceCache  * cache = [ self skyRadianceCache ];
+
+        if (   ! cache
+            || ! [ cache skyRadiance
+                     : & hitNormal
+                     :   wavelength
+                     : & sky_sample
+                     ] )
+            arhosekskymodel_sps(
+                  art_gv,
+                  skymodel_state_hero,
+                  elevation,
+                  distanceFromSun,
+                  wavelength,
+                & sky_sample
+                );
 
         sps_dd_clamp_s(
               art_gv,
@@ -133,6 +160,36 @@ ARPSURFACEMATERIAL_DEFAULT_EMITTER_SURFACETYPE_IMPLEMENTATION
 }
 
 
+- (void) exactSkyRadiance
+        : (const Vec3D *) direction_worldspace
+        : (unsigned int) numberOfWavelengths
+        : (const double *) wavelengths
+        : (double *) radiance
+{
+    Vec3D  direction = *direction_worldspace;
+
+    vec3d_norm_v(&direction);
+
+    double  elevation, distanceFromSun;
+
+    arnhosekskymodel_model_angles(
+        & direction,
+        & sunDirection,
+        & elevation,
+        & distanceFromSun
+        );
+
+    for ( unsigned int k = 0; k < numberOfWavelengths; k++ )
+        radiance[k] =
+            arhosekskymodel_mono_sample(
+                art_gv,
+                skymodel_state_hero,
+                elevation,
+                distanceFromSun,
+                wavelengths[k]
+                );
+}
+
 - (void) spectralIntensityEmittedTowardsPointFromDirection
         : (ArcPointContext *) queryLocation_worldspace
         : (Vec3D *) queryDirection_worldspace
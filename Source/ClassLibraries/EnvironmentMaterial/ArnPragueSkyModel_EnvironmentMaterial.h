@@ -45,7 +45,7 @@ ART_MODULE_INTERFACE(ArnPragueSkyModel_EnvironmentMaterial)
 
 
 @interface ArnPragueSkyModel(EnvironmentMaterial)
-        < ArpEnvironmentMaterial >
+        < ArpEnvironmentMaterial, ArpSkyRadianceCacheSource >
         @end
 
 
@@ -35,6 +35,12 @@ ART_NO_MODULE_INITIALISATION_FUNCTION_NECESSARY
 
 ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
 
+//   The sky radiance cache is built for a viewpoint at the origin. Within
+//   this distance from it, altitude and local solar elevation change far
+//   less than the resolution of the model data, so the cache can be used
+//   for all query points inside it.
+
+#define ARNPRAGUESKYMODEL_CACHE_VALIDITY_RADIUS     10.0
 
 @implementation ArnPragueSkyModel(EnvironmentMaterial)
 
@@ -110,20 +116,36 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
 
         ArSpectralSample  sky_sample;
 
-        for(unsigned int i = 0; i < HERO_SAMPLES_TO_SPLAT; ++i)
-            SPS_CI( sky_sample, i) =
-                arpragueskymodel_radiance(
-                      skymodel_state,
-                      theta,
-                      gamma,
-                      shadow,
-                      zero,
-                      solarElevationAtQuery,
-                      altitude,
-                      atmosphericTurbidity,
-                      SPS_CI(albedoSample,i),
-                      NANO_FROM_UNIT( ARWL_WI(*wavelength,i) )
-                    );
+        ArcSkyRadianceCache  * cache = 0;
+
+        if (    M_SQR(XC(queryPoint))
+              + M_SQR(YC(queryPoint))
+              + M_SQR(ZC(queryPoint))
+             <= M_SQR(ARNPRAGUESKYMODEL_CACHE_VALIDITY_RADIUS) )
+            cache = [ self skyRadianceCache ];
+
+        if (   ! cache
+            || ! [ cache skyRadiance
+                     :   queryDirection_worldspace
+                     :   wavelength
+                     : & sky_sample
+                     ] )
+        {
+            for(unsigned int i = 0; i < HERO_SAMPLES_TO_SPLAT; ++i)
+                SPS_CI( sky_sample, i) =
+                    arpragueskymodel_radiance(
+                          skymodel_state,
+                          theta,
+                          gamma,
+                          shadow,
+                          zero,
+                          solarElevationAtQuery,
+                          altitude,
+                          atmosphericTurbidity,
+                          SPS_CI(albedoSample,i),
+                          NANO_FROM_UNIT( ARWL_WI(*wavelength,i) )
+                        );
+        }
         
         sps_dd_clamp_s(
               art_gv,
@@ -159,6 +181,72 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
     }
 }
 
+- (void) exactSkyRadiance
+        : (const Vec3D *) direction_worldspace
+        : (unsigned int) numberOfWavelengths
+        : (const double *) wavelengths
+        : (double *) radiance
+{
+    const Pnt3D  queryPoint = PNT3D( 0.0, 0.0, 0.0 );
+
+    double  theta, gamma, shadow, zero, altitude, solarElevationAtQuery;
+
+    arpragueskymodel_compute_angles(
+        & queryPoint,
+          direction_worldspace,
+          solarElevation,
+          solarAzimuth,
+        & solarElevationAtQuery,
+        & altitude,
+        & theta,
+        & gamma,
+        & shadow,
+        & zero
+        );
+
+    //   The ground albedo is looked up four wavelengths at a time
+
+    for ( unsigned int k = 0; k < numberOfWavelengths; k += 4 )
+    {
+        Crd4  lambdaValues;
+
+        for ( unsigned int i = 0; i < 4; i++ )
+            C4_CI( lambdaValues, i ) =
+                wavelengths[ M_MIN( k + i, numberOfWavelengths - 1 ) ];
+
+        ArWavelength      lambda;
+        ArSpectralSample  albedoSample;
+
+        arwavelength_c_init_w(
+              art_gv,
+            & lambdaValues,
+            & lambda
+            );
+
+        sps_sw_init_s(
+              art_gv,
+              groundAlbedo,
+            & lambda,
+            & albedoSample
+            );
+
+        for ( unsigned int i = 0; i < 4 && k + i < numberOfWavelengths; i++ )
+            radiance[ k + i ] =
+                arpragueskymodel_radiance(
+                      skymodel_state,
+                      theta,
+                      gamma,
+                      shadow,
+                      zero,
+                      solarElevationAtQuery,
+                      altitude,
+                      atmosphericTurbidity,
+                      SPS_CI(albedoSample,i),
+                      NANO_FROM_UNIT( wavelengths[ k + i ] )
+                    );
+    }
+}
+
 - (void) spectralIntensityEmittedTowardsPointFromDirection
         : (ArcPointContext *) queryLocation_worldspace
         : (Vec3D *) queryDirection_worldspace
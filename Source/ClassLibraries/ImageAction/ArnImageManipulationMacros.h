@@ -176,4 +176,32 @@
     ARRGBA_A(((ArnRGBAImage*)destinationScanlineBuffer)->data[(_x)])
 
 
+    /* ------------------------------------------------------------------
+         Strip buffer access for 'processStrip' implementations: the
+         worker threads pass their own buffers in, so these take the
+         buffer as an explicit first argument.
+    ---------------------------------------------------------------aw- */
+
+#define LIGHTALPHA_STRIP(_s,_x) \
+    ((ArnLightAlphaImage*)(_s))->data[(_x)]
+
+#define LIGHTALPHA_STRIP_LIGHT(_s,_x) \
+    ARLIGHTALPHA_LIGHT(*LIGHTALPHA_STRIP(_s,_x))
+
+#define LIGHTALPHA_STRIP_ALPHA(_s,_x) \
+    ARLIGHTALPHA_A(*LIGHTALPHA_STRIP(_s,_x))
+
+#define XYZA_STRIP_XYZ(_s,_x) \
+    ARCIEXYZA_C(((ArnCIEXYZAImage*)(_s))->data[(_x)])
+
+#define XYZA_STRIP_ALPHA(_s,_x) \
+    ARCIEXYZA_A(((ArnCIEXYZAImage*)(_s))->data[(_x)])
+
+#define RGBA_STRIP_RGB(_s,_x) \
+    ARRGBA_C(((ArnRGBAImage*)(_s))->data[(_x)])
+
+#define RGBA_STRIP_ALPHA(_s,_x) \
+    ARRGBA_A(((ArnRGBAImage*)(_s))->data[(_x)])
+
+
 // ===========================================================================
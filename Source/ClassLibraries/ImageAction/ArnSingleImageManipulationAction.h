@@ -30,6 +30,7 @@ ART_MODULE_INTERFACE(ArnSingleImageManipulationAction)
 
 #import "ART_Scenegraph.h"
 #import "ART_ImageData.h"
+#import "ArcWorkerPool.h"
 
 //   This is the tag that transient image files are tagged with.
 //   We use an intentionally obtuse string that is unlikely to
@@ -113,6 +114,17 @@ ART_MODULE_INTERFACE(ArnSingleImageManipulationAction)
     IVec2D            destinationImageSize;
     BOOL              tagWasAddedToDestinationFilename;
     BOOL              returnSourceImagesToStack;
+
+    //   Parallel strip executor (see below). Actions that use it set
+    //   'readSourceImagesInStrips' before 'prepareForImageManipulation',
+    //   so that the source images are not loaded into memory as a whole.
+
+    BOOL              readSourceImagesInStrips;
+    unsigned int      stripImageNumber;
+    unsigned int      stripHeight;
+    unsigned int      numberOfStrips;
+    unsigned int      nextStripToWrite;
+    ArcWorkerPool   * stripWorkers;
 }
 
 - (id) removeSource
@@ -163,6 +175,40 @@ ART_MODULE_INTERFACE(ArnSingleImageManipulationAction)
         : (unsigned int) scanline
         ;
 
+/* ----------------------------------------------------------------------
+
+    Parallel strip processing
+
+    Actions where each destination pixel only depends on the source pixel
+    at the same position can hand their scanline loop over to
+    'processImageInParallelStrips'. The image is then cut into strips of
+    a few scanlines, which are converted concurrently by one worker
+    thread per core via 'processStrip'. Each worker owns its own source
+    and destination strip buffers. Strips are read from the source file
+    image, and handed to the destination file image, strictly in order.
+    If 'readSourceImagesInStrips' was set before the preparation, at most
+    one strip per worker is held in memory at any time; otherwise, the
+    strips are taken from the source image buffer.
+
+    'processStrip' is called from the worker threads, and receives the
+    strip buffers as arguments: implementations must not touch the
+    shared scanline buffers, and have to access the strips via the
+    ..._STRIP macros from ArnImageManipulationMacros.h. The pixels of
+    a strip are stored contiguously, so a single loop over all of them
+    is sufficient.
+
+-------------------------------------------------------------------aw- */
+
+- (void) processImageInParallelStrips
+        : (unsigned int) imageNumber
+        ;
+
+- (void) processStrip
+        : (ArNode *) sourceStrip
+        : (ArNode *) destinationStrip
+        : (unsigned int) numberOfPixels
+        ;
+
 - (void) finishImageManipulation
         : (ArNode <ArpNodeStack> *) nodeStack
         ;
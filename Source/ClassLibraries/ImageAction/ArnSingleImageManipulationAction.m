@@ -503,9 +503,14 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnSingleImageManipulationAction)
         );
 #endif
 
-    sourceImageBuffer = ALLOC_ARRAY( ArNode *, numberOfSourceImages );
+    sourceImageBuffer = ALLOC_ARRAY_ZERO( ArNode *, numberOfSourceImages );
     
-    for ( unsigned int i = 0; i < numberOfSourceImages; i++ )
+    //   Actions that work in strips read the source images strip by strip
+    //   while they go, and do not need a buffer for the entire image.
+
+    for ( unsigned int i = 0;
+          i < numberOfSourceImages && ! readSourceImagesInStrips;
+          i++ )
     {
         sourceImageBuffer[i] =
             (ArNode *)
@@ -674,6 +679,219 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnSingleImageManipulationAction)
         ];
 }
 
+/* ----------------------------------------------------------------------
+    Parallel strip processing
+
+    Strips are handed out in increasing order, and each worker waits for
+    its turn before it passes its finished strip to the destination file
+    image. The worker that owns 'nextStripToWrite' never has to wait for
+    anyone, so this cannot deadlock, and the sequential file formats get
+    their scanlines in the order they expect. Reading a strip from the
+    source file image happens while the strip is handed out, for the same
+    reason.
+---------------------------------------------------------------aw- */
+
+#define ART_IMAGE_ACTION_MAXIMUM_STRIP_HEIGHT       32
+#define ART_IMAGE_ACTION_STRIPS_PER_WORKER           4
+
+- (ArNode *) _allocStripBuffer
+        : (Class) bufferClass
+        : (unsigned int) width
+        : (unsigned int) height
+{
+    ArNode  * strip =
+        (ArNode *)
+        [ ALLOC_OBJECT_BY_CLASS(
+            bufferClass,
+            ArpPlainImageSimpleMemory
+            )
+            initWithSize
+            :   IVEC2D( width, height )
+            ];
+
+    ASSERT_CLASS_OR_SUBCLASS_MEMBERSHIP(
+        strip,
+        ArNode
+        );
+
+    return strip;
+}
+
+- (void) _stripWorkerThread
+        : (ArcUnsignedInteger *) threadIndex
+{
+    (void) threadIndex;
+
+    Class  sourceStripClass      = [ sourceScanlineBuffer[0] class ];
+    Class  destinationStripClass = [ destinationScanlineBuffer class ];
+
+    const unsigned int  width = XC(destinationImageSize);
+    const unsigned int  height = YC(destinationImageSize);
+
+    ArNode  * sourceStrip =
+        [ self _allocStripBuffer
+            :   sourceStripClass
+            :   width
+            :   stripHeight
+            ];
+
+    ArNode  * destinationStrip =
+        [ self _allocStripBuffer
+            :   destinationStripClass
+            :   width
+            :   stripHeight
+            ];
+
+    while ( YES )
+    {
+        [ stripWorkers lock ];
+
+        unsigned int  strip;
+
+        if ( ! [ stripWorkers nextWorkItemWithLockHeld : & strip ] )
+        {
+            [ stripWorkers unlock ];
+            break;
+        }
+
+        const unsigned int  y = strip * stripHeight;
+        const unsigned int  rows = M_MIN( stripHeight, height - y );
+
+        //   Only the last strip of an image can be shorter than the
+        //   others; it gets its own buffers of the exact size, since
+        //   the file images expect to be fed whole scanlines.
+
+        ArNode  * thisSourceStrip = sourceStrip;
+        ArNode  * thisDestinationStrip = destinationStrip;
+
+        if ( rows < stripHeight )
+        {
+            thisSourceStrip =
+                [ self _allocStripBuffer
+                    :   sourceStripClass
+                    :   width
+                    :   rows
+                    ];
+
+            thisDestinationStrip =
+                [ self _allocStripBuffer
+                    :   destinationStripClass
+                    :   width
+                    :   rows
+                    ];
+        }
+
+        //   The pool lock is held while the strips are handed out, so
+        //   the source file image is read from top to bottom.
+
+        if ( readSourceImagesInStrips )
+            [ sourceImage[stripImageNumber] getPlainImage
+                :   IPNT2D( 0, y )
+                :   ((ArnPlainImage *)thisSourceStrip)
+                ];
+
+        [ stripWorkers unlock ];
+
+        if ( ! readSourceImagesInStrips )
+            [ ((id <ArpGetPlainImage>)sourceImageBuffer[stripImageNumber])
+                getPlainImage
+                :   IPNT2D( 0, y )
+                :   ((ArnPlainImage *)thisSourceStrip)
+                ];
+
+        [ self processStrip
+            :   thisSourceStrip
+            :   thisDestinationStrip
+            :   width * rows
+            ];
+
+        [ stripWorkers lock ];
+
+        while ( nextStripToWrite != strip )
+            [ stripWorkers waitForSignal ];
+
+        [ stripWorkers unlock ];
+
+        [ destinationImage[stripImageNumber] setPlainImage
+            :   IPNT2D( 0, y )
+            :   ((ArnPlainImage *)thisDestinationStrip)
+            ];
+
+        [ stripWorkers lock ];
+        nextStripToWrite++;
+        [ stripWorkers signal ];
+        [ stripWorkers unlock ];
+
+        if ( rows < stripHeight )
+        {
+            RELEASE_OBJECT(thisSourceStrip);
+            RELEASE_OBJECT(thisDestinationStrip);
+        }
+    }
+
+    RELEASE_OBJECT(sourceStrip);
+    RELEASE_OBJECT(destinationStrip);
+}
+
+- (void) processImageInParallelStrips
+        : (unsigned int) imageNumber
+{
+    if (   XC(sourceImageSize) != XC(destinationImageSize)
+        || YC(sourceImageSize) != YC(destinationImageSize) )
+        ART_ERRORHANDLING_FATAL_ERROR(
+            "parallel strip processing requires source and destination "
+            "images of the same size"
+            );
+
+    unsigned int  numberOfWorkers =
+        art_maximum_number_of_working_threads( art_gv );
+
+    if ( numberOfWorkers < 1 )
+        numberOfWorkers = 1;
+
+    //   A few strips per worker keep all cores busy until the end,
+    //   without making the strips so small that the per-strip
+    //   overhead starts to matter.
+
+    stripHeight =
+        YC(destinationImageSize)
+        / ( numberOfWorkers * ART_IMAGE_ACTION_STRIPS_PER_WORKER );
+
+    stripHeight =
+        M_MIN( stripHeight, ART_IMAGE_ACTION_MAXIMUM_STRIP_HEIGHT );
+
+    if ( stripHeight < 1 )
+        stripHeight = 1;
+
+    stripImageNumber = imageNumber;
+    numberOfStrips   = ( YC(destinationImageSize) + stripHeight - 1 ) / stripHeight;
+    nextStripToWrite = 0;
+
+    stripWorkers =
+        [ ALLOC_INIT_OBJECT(ArcWorkerPool)
+            :   numberOfStrips
+            ];
+
+    [ stripWorkers run
+        :   @selector(_stripWorkerThread:)
+        :   self
+        ];
+
+    RELEASE_OBJECT(stripWorkers);
+}
+
+- (void) processStrip
+        : (ArNode *) sourceStrip
+        : (ArNode *) destinationStrip
+        : (unsigned int) numberOfPixels
+{
+    (void) sourceStrip;
+    (void) destinationStrip;
+    (void) numberOfPixels;
+
+    ART__VIRTUAL_METHOD__EXIT_WITH_ERROR
+}
+
 - (void) finishImageManipulation
         : (ArNode <ArpNodeStack> *) nodeStack
 {
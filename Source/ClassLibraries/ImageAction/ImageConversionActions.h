@@ -96,6 +96,10 @@ ART_MODULE_INTERFACE(ImageConversionActions)
         < ArpCoding, ArpConcreteClass, ArpAction >
 {
     unsigned int  destinationBitsPerChannel;
+
+    //   Transient, set up in performOn for the strip workers
+
+    Mat3          xyz_whitebalance_xyz;
 }
 
 - (id) removeSource
@@ -92,6 +92,8 @@ ARPACTION_DEFAULT_SINGLE_IMAGE_ACTION_IMPLEMENTATION(ArnImageConverter_RAW_To_AR
          we wish to create (in our case, ArfRAWRasterImage and ArfARTCSP).
     ---------------------------------------------------------------aw- */
 
+    readSourceImagesInStrips = YES;
+
     [ self prepareForImageManipulation
         :   nodeStack
         :   [ ArfRAWRasterImage class ]
@@ -108,59 +110,15 @@ ARPACTION_DEFAULT_SINGLE_IMAGE_ACTION_IMPLEMENTATION(ArnImageConverter_RAW_To_AR
             ];
 
     /* ------------------------------------------------------------------
-         Process all pixels in the image.
+         Process all pixels in the image; this is done in parallel,
+         strip by strip, via 'processStrip' below.
     ---------------------------------------------------------------aw- */
 
-    ArSpectrum  * temp_col = spc_alloc( art_gv );
-
     for ( unsigned int i = 0; i < numberOfSourceImages; i++ )
     {
-        for ( int y = 0; y < YC(destinationImageSize); y++ )
-        {
-            [ self loadSourceScanlineBuffer: i : y ];
-
-            for ( int x = 0; x < XC(destinationImageSize); x++ )
-            {
-                #ifdef IMAGECONVERSION_DEBUGPRINTF
-                debugprintf("Source (%u|%u)\n",x,y);
-                arlight_l_debugprintf(
-                      art_gv,
-                      LIGHTALPHA_SOURCE_BUFFER_LIGHT(x)
-                    );
-                #endif
-
-                arlightalpha_to_spc(
-                      art_gv,
-                      LIGHTALPHA_SOURCE_BUFFER(x),
-                      temp_col
-                    );
-
-                spc_to_xyz(
-                      art_gv,
-                      temp_col,
-                    & XYZA_DESTINATION_BUFFER_XYZ(x)
-                    );
-
-                #ifdef IMAGECONVERSION_DEBUGPRINTF
-                debugprintf("Result (%u|%u)\n",x,y);
-                xyz_s_debugprintf(
-                      art_gv,
-                    & XYZA_DESTINATION_BUFFER_XYZ(x)
-                    );
-                #endif
-
-                XYZA_DESTINATION_BUFFER_ALPHA(x) = LIGHTALPHA_SOURCE_BUFFER_ALPHA(x);
-            }
-
-            [ self writeDestinationScanlineBuffer: i : y ];
-        }
+        [ self processImageInParallelStrips: i ];
     }
 
-    spc_free(
-        art_gv,
-        temp_col
-        );
-
     /* ------------------------------------------------------------------
          Free the image manipulation infrastructure and end the action;
          this also places the destination image on the stack.
@@ -173,6 +131,53 @@ ARPACTION_DEFAULT_SINGLE_IMAGE_ACTION_IMPLEMENTATION(ArnImageConverter_RAW_To_AR
     [ REPORTER endAction ];
 }
 
+- (void) processStrip
+        : (ArNode *) sourceStrip
+        : (ArNode *) destinationStrip
+        : (unsigned int) numberOfPixels
+{
+    ArSpectrum  * temp_col = spc_alloc( art_gv );
+
+    for ( unsigned int x = 0; x < numberOfPixels; x++ )
+    {
+        #ifdef IMAGECONVERSION_DEBUGPRINTF
+        debugprintf("Source (%u)\n",x);
+        arlight_l_debugprintf(
+              art_gv,
+              LIGHTALPHA_STRIP_LIGHT(sourceStrip,x)
+            );
+        #endif
+
+        arlightalpha_to_spc(
+              art_gv,
+              LIGHTALPHA_STRIP(sourceStrip,x),
+              temp_col
+            );
+
+        spc_to_xyz(
+              art_gv,
+              temp_col,
+            & XYZA_STRIP_XYZ(destinationStrip,x)
+            );
+
+        #ifdef IMAGECONVERSION_DEBUGPRINTF
+        debugprintf("Result (%u)\n",x);
+        xyz_s_debugprintf(
+              art_gv,
+            & XYZA_STRIP_XYZ(destinationStrip,x)
+            );
+        #endif
+
+        XYZA_STRIP_ALPHA(destinationStrip,x) =
+            LIGHTALPHA_STRIP_ALPHA(sourceStrip,x);
+    }
+
+    spc_free(
+        art_gv,
+        temp_col
+        );
+}
+
 @end
 
 
@@ -705,6 +710,8 @@ ARPACTION_DEFAULT_SINGLE_IMAGE_ACTION_IMPLEMENTATION(ArnImageConverter_ARTCSP_To
          we wish to create (in our case, ArfARTCSP and ArfTIFF).
     ---------------------------------------------------------------aw- */
 
+    readSourceImagesInStrips = YES;
+
     [ self prepareForImageManipulation
         :   nodeStack
         :   [ ArfARTCSP class ]
@@ -726,9 +733,7 @@ ARPACTION_DEFAULT_SINGLE_IMAGE_ACTION_IMPLEMENTATION(ArnImageConverter_ARTCSP_To
     
     //   Transform from the system white point to the white
     //   point of the image format
-    
-    Mat3  xyz_whitebalance_xyz;
-    
+
     if ( RGB_GAMUT_MAPPING == arrgb_gm_lcms )
     {
         //   If littlecms does the work for us, we only correct to
@@ -762,45 +767,7 @@ ARPACTION_DEFAULT_SINGLE_IMAGE_ACTION_IMPLEMENTATION(ArnImageConverter_ARTCSP_To
 
     for ( unsigned int i = 0; i < numberOfSourceImages; i++ )
     {
-        for ( int y = 0; y < YC(destinationImageSize); y++ )
-        {
-            //   Load the source scanline into the buffer
-
-            [ self loadSourceScanlineBuffer: i : y ];
-
-            for ( int x = 0; x < XC(destinationImageSize); x++ )
-            {
-    #ifdef IMAGECONVERSION_DEBUGPRINTF
-                xyz_s_debugprintf( art_gv,& XYZA_SOURCE_BUFFER_XYZ(x) );
-    #endif
-                ArCIEXYZ  xyz_wb;
-                
-                xyz_mat_to_xyz(
-                      art_gv,
-                    & XYZA_SOURCE_BUFFER_XYZ(x),
-                    & xyz_whitebalance_xyz,
-                    & xyz_wb
-                    );
-
-                xyz_conversion_to_unit_rgb_with_gamma(
-                      art_gv,
-                    & xyz_wb,
-                    & RGBA_DESTINATION_BUFFER_RGB(x)
-                    );
-
-    #ifdef IMAGECONVERSION_DEBUGPRINTF
-                rgb_s_debugprintf( art_gv,& RGBA_DESTINATION_BUFFER_RGB(x) );
-    #endif
-
-                //   Copy the alpha channel from the source image
-
-                RGBA_DESTINATION_BUFFER_ALPHA(x) = XYZA_SOURCE_BUFFER_ALPHA(x);
-            }
-
-            //   Write the destination scanline buffer to disk for this line
-
-            [ self writeDestinationScanlineBuffer: i : y ];
-        }
+        [ self processImageInParallelStrips: i ];
     }
 
 
@@ -815,6 +782,42 @@ ARPACTION_DEFAULT_SINGLE_IMAGE_ACTION_IMPLEMENTATION(ArnImageConverter_ARTCSP_To
     [ REPORTER endAction ];
 }
 
+- (void) processStrip
+        : (ArNode *) sourceStrip
+        : (ArNode *) destinationStrip
+        : (unsigned int) numberOfPixels
+{
+    for ( unsigned int x = 0; x < numberOfPixels; x++ )
+    {
+#ifdef IMAGECONVERSION_DEBUGPRINTF
+        xyz_s_debugprintf( art_gv,& XYZA_STRIP_XYZ(sourceStrip,x) );
+#endif
+        ArCIEXYZ  xyz_wb;
+
+        xyz_mat_to_xyz(
+              art_gv,
+            & XYZA_STRIP_XYZ(sourceStrip,x),
+            & xyz_whitebalance_xyz,
+            & xyz_wb
+            );
+
+        xyz_conversion_to_unit_rgb_with_gamma(
+              art_gv,
+            & xyz_wb,
+            & RGBA_STRIP_RGB(destinationStrip,x)
+            );
+
+#ifdef IMAGECONVERSION_DEBUGPRINTF
+        rgb_s_debugprintf( art_gv,& RGBA_STRIP_RGB(destinationStrip,x) );
+#endif
+
+        //   Copy the alpha channel from the source image
+
+        RGBA_STRIP_ALPHA(destinationStrip,x) =
+            XYZA_STRIP_ALPHA(sourceStrip,x);
+    }
+}
+
 - (void) code
         : (ArcObject <ArpCoder> *) coder
 {
@@ -40,6 +40,10 @@ void tonemappingimageactions_initialise();
         < ArpCoding, ArpConcreteClass, ArpAction >
 {
     double  mappingValue;
+
+    //   Transient, set up in performOn for the strip workers
+
+    double  mappingLuminance;
 }
 
 - (id) mappingValue
@@ -57,6 +61,9 @@ void tonemappingimageactions_initialise();
         : ArnSingleImageManipulationAction
         < ArpCoding, ArpConcreteClass, ArpAction >
 {
+    //   Transient, set up in performOn for the strip workers
+
+    double  luminanceScale;
 }
 
 @end
@@ -112,6 +112,8 @@ ARPACTION_DEFAULT_SINGLE_IMAGE_ACTION_IMPLEMENTATION(ArnExponentialToneMapper)
          we wish to create (in our case, two instances of ArfARTCSP).
     ---------------------------------------------------------------aw- */
 
+    readSourceImagesInStrips = YES;
+
     [ self prepareForImageManipulation
         :   nodeStack
         :   [ ArfARTCSP class ]
@@ -130,60 +132,19 @@ ARPACTION_DEFAULT_SINGLE_IMAGE_ACTION_IMPLEMENTATION(ArnExponentialToneMapper)
         ,   [ imageMetrics maximumLuminance ]
         ];
 
-    double  averageLuminance;
-
     if ( mappingValue != 0.0 )
-        averageLuminance = mappingValue;
+        mappingLuminance = mappingValue;
     else
-        averageLuminance = [ imageMetrics averageLuminance ];
+        mappingLuminance = [ imageMetrics averageLuminance ];
 
 
     /* ------------------------------------------------------------------
-         Process all pixels in the image.
+         Process all pixels in the image, strip by strip in parallel.
     ---------------------------------------------------------------aw- */
 
     for ( unsigned int i = 0; i < numberOfSourceImages; i++ )
     {
-        for ( long y = 0; y < YC(destinationImageSize); y++ )
-        {
-            [ self loadSourceScanlineBuffer: i : y ];
-
-            for ( long x = 0; x < XC(destinationImageSize); x++ )
-            {
-                //   Convert the pixel to xyY colour space
-
-                ArCIExyY  xyyValue;
-
-                xyz_to_xyy(
-                      art_gv,
-                    & XYZA_SOURCE_BUFFER_XYZ(x),
-                    & xyyValue
-                    );
-
-                //   mapping
-
-                if ( ARCIExyY_Y( xyyValue ) > 0.0 )
-                {
-                    ARCIExyY_Y( xyyValue ) = 1.0 - exp(  -ARCIExyY_Y( xyyValue )
-                                                       /  averageLuminance );
-                    //   back to XYZ
-
-                    xyy_to_xyz(
-                          art_gv,
-                        & xyyValue,
-                        & XYZA_DESTINATION_BUFFER_XYZ(x)
-                        );
-                }
-                else
-                {
-                    XYZA_DESTINATION_BUFFER_XYZ(x) = XYZA_SOURCE_BUFFER_XYZ(x);
-                }
-
-                XYZA_DESTINATION_BUFFER_ALPHA(x) = XYZA_SOURCE_BUFFER_ALPHA(x);
-            }
-
-            [ self writeDestinationScanlineBuffer: i : y ];
-        }
+        [ self processImageInParallelStrips: i ];
     }
 
 
@@ -201,6 +162,46 @@ ARPACTION_DEFAULT_SINGLE_IMAGE_ACTION_IMPLEMENTATION(ArnExponentialToneMapper)
     [ REPORTER endAction ];
 }
 
+- (void) processStrip
+        : (ArNode *) sourceStrip
+        : (ArNode *) destinationStrip
+        : (unsigned int) numberOfPixels
+{
+    for ( unsigned int x = 0; x < numberOfPixels; x++ )
+    {
+        //   Convert the pixel to xyY colour space
+
+        ArCIExyY  xyyValue;
+
+        xyz_to_xyy(
+              art_gv,
+            & XYZA_STRIP_XYZ(sourceStrip,x),
+            & xyyValue
+            );
+
+        //   mapping
+
+        if ( ARCIExyY_Y( xyyValue ) > 0.0 )
+        {
+            ARCIExyY_Y( xyyValue ) = 1.0 - exp(  -ARCIExyY_Y( xyyValue )
+                                               /  mappingLuminance );
+            //   back to XYZ
+
+            xyy_to_xyz(
+                  art_gv,
+                & xyyValue,
+                & XYZA_STRIP_XYZ(destinationStrip,x)
+                );
+        }
+        else
+        {
+            XYZA_STRIP_XYZ(destinationStrip,x) = XYZA_STRIP_XYZ(sourceStrip,x);
+        }
+
+        XYZA_STRIP_ALPHA(destinationStrip,x) = XYZA_STRIP_ALPHA(sourceStrip,x);
+    }
+}
+
 - (void) code
         : (ArcObject <ArpCoder> *) coder
 {
@@ -247,6 +248,8 @@ ARPACTION_DEFAULT_SINGLE_IMAGE_ACTION_IMPLEMENTATION(ArnScaleToUnityToneMapper)
          we wish to create (in our case, two instances of ArfARTCSP).
     ---------------------------------------------------------------aw- */
 
+    readSourceImagesInStrips = YES;
+
     [ self prepareForImageManipulation
         :   nodeStack
         :   [ ArfARTCSP class ]
@@ -266,7 +269,7 @@ ARPACTION_DEFAULT_SINGLE_IMAGE_ACTION_IMPLEMENTATION(ArnScaleToUnityToneMapper)
         ,   [ imageMetrics maximumLuminance ]
         ];
 
-    double  luminanceScale = 1.0;
+    luminanceScale = 1.0;
     
     if ( [ imageMetrics maximumLuminance ] > 1.0 )
     {
@@ -274,50 +277,12 @@ ARPACTION_DEFAULT_SINGLE_IMAGE_ACTION_IMPLEMENTATION(ArnScaleToUnityToneMapper)
     }
 
     /* ------------------------------------------------------------------
-         Process all pixels in the image.
+         Process all pixels in the image, strip by strip in parallel.
     ---------------------------------------------------------------aw- */
 
     for ( unsigned int i = 0; i < numberOfSourceImages; i++ )
     {
-        for ( long y = 0; y < YC(destinationImageSize); y++ )
-        {
-            [ self loadSourceScanlineBuffer: i : y ];
-
-            for ( long x = 0; x < XC(destinationImageSize); x++ )
-            {
-                //   Convert the pixel to xyY colour space
-
-                ArCIExyY  xyyValue;
-
-                xyz_to_xyy(
-                      art_gv,
-                    & XYZA_SOURCE_BUFFER_XYZ(x),
-                    & xyyValue
-                    );
-
-                //   mapping
-
-                if ( ARCIExyY_Y( xyyValue ) > 0.0 )
-                {
-                    ARCIExyY_Y( xyyValue ) *= luminanceScale;
-                    //   back to XYZ
-
-                    xyy_to_xyz(
-                          art_gv,
-                        & xyyValue,
-                        & XYZA_DESTINATION_BUFFER_XYZ(x)
-                        );
-                }
-                else
-                {
-                    XYZA_DESTINATION_BUFFER_XYZ(x) = XYZA_SOURCE_BUFFER_XYZ(x);
-                }
-
-                XYZA_DESTINATION_BUFFER_ALPHA(x) = XYZA_SOURCE_BUFFER_ALPHA(x);
-            }
-
-            [ self writeDestinationScanlineBuffer: i : y ];
-        }
+        [ self processImageInParallelStrips: i ];
     }
 
 
@@ -335,6 +300,45 @@ ARPACTION_DEFAULT_SINGLE_IMAGE_ACTION_IMPLEMENTATION(ArnScaleToUnityToneMapper)
     [ REPORTER endAction ];
 }
 
+- (void) processStrip
+        : (ArNode *) sourceStrip
+        : (ArNode *) destinationStrip
+        : (unsigned int) numberOfPixels
+{
+    for ( unsigned int x = 0; x < numberOfPixels; x++ )
+    {
+        //   Convert the pixel to xyY colour space
+
+        ArCIExyY  xyyValue;
+
+        xyz_to_xyy(
+              art_gv,
+            & XYZA_STRIP_XYZ(sourceStrip,x),
+            & xyyValue
+            );
+
+        //   mapping
+
+        if ( ARCIExyY_Y( xyyValue ) > 0.0 )
+        {
+            ARCIExyY_Y( xyyValue ) *= luminanceScale;
+            //   back to XYZ
+
+            xyy_to_xyz(
+                  art_gv,
+                & xyyValue,
+                & XYZA_STRIP_XYZ(destinationStrip,x)
+                );
+        }
+        else
+        {
+            XYZA_STRIP_XYZ(destinationStrip,x) = XYZA_STRIP_XYZ(sourceStrip,x);
+        }
+
+        XYZA_STRIP_ALPHA(destinationStrip,x) = XYZA_STRIP_ALPHA(sourceStrip,x);
+    }
+}
+
 - (void) code
         : (ArcObject <ArpCoder> *) coder
 {
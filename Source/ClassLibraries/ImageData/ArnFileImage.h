@@ -49,6 +49,16 @@ ArnFileImageAction;
     char                   * fileName;
 }
 
+/* ---------------------------------------------------------------------------
+    Reading and writing in parts
+        Besides the whole image at once, file images can be read and
+        written in strips of whole scanlines, from top to bottom. The file
+        is opened with the first strip, and stays open until the last
+        scanline has been read, or written. Images whose files are random
+        access (see ArpRandomAccessImageFile) also accept arbitrary regions
+        in any order; these stay open for reading until they are released.
+--------------------------------------------------------------------------- */
+
 - (id) init
         : (const char *) newFileName
         ;
@@ -68,6 +78,15 @@ ArnFileImageAction;
         : (Class) newClass
         ;
 
+/* ---------------------------------------------------------------------------
+    'imageFileIsRandomAccess'
+        YES if the image file can be written, and read, region by region
+        in any order, i.e. if it conforms to ArpRandomAccessImageFile.
+--------------------------------------------------------------------------- */
+
+- (BOOL) imageFileIsRandomAccess
+        ;
+
 - (const char *) fileName
         ;
 
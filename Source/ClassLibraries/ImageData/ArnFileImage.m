@@ -274,6 +274,14 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnFileImage)
     return  [ imageFile class ];
 }
 
+- (BOOL) imageFileIsRandomAccess
+{
+    return
+        [ imageFile conformsToArProtocol
+            :   ARPROTOCOL(ArpRandomAccessImageFile)
+            ];
+}
+
 - (void) getPlainImage
         : (IPnt2D) start
         : (ArnPlainImage *) image
@@ -288,8 +296,19 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnFileImage)
         if ( imageInfo) RELEASE_OBJECT( imageInfo );
         
         imageInfo = [ imageFile open ];
+        action = arnfileimage_reading;
+        y = 0;
     }
-    
+
+    //   Random access files can hand out any region, and remain open
+    //   for further reads.
+
+    if ( [ self imageFileIsRandomAccess ] )
+    {
+        [ imageFile getPlainImage :start :image ];
+        return;
+    }
+
     if (XC(imageInfo->size) != XC(image->size))
         ART_ERRORHANDLING_FATAL_ERROR( "cannot read image line of wrong length" );
 
@@ -325,6 +344,21 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnFileImage)
         y = 0;
     }
 
+    //   Random access files accept regions in any order; the file is
+    //   finalised once all of its pixels have been written.
+
+    if ( [ self imageFileIsRandomAccess ] )
+    {
+        [ imageFile setPlainImage :start :image ];
+
+        if ( [ (ArNode <ArpRandomAccessImageFile> *) imageFile allPixelsWritten ] )
+        {
+            [ imageFile close ];
+            action = arnfileimage_idle;
+        }
+        return;
+    }
+
     if (XC(imageInfo->size) != XC(image->size))
         ART_ERRORHANDLING_FATAL_ERROR( "cannot write image line of wrong length" );
 
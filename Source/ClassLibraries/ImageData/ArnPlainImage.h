@@ -173,16 +173,6 @@ void arnsimpleimage_calculate_copy_region(
         - (Ar##_Type *) line : (long) y ; \
         @end
 
-#define ARN_COL_IMAGE_DEFAULT_DEFINITION_LIGHT(_Type) \
-        @interface Arn##_Type##Image : ArnPlainImage \
-                < \
-                    ArpConcreteClass, ArpPlainImageDefaultMemory, \
-                    ArpSet##_Type##Region, ArpGet##_Type##Region \
-                > \
-            { @public Ar##_Type ** data; } \
-        - (Ar##_Type *) line : (long) y ; \
-        @end
-
 //   Note the lack of the "Ar..." prefix in the macro invocations below!
 
 
@@ -209,7 +199,29 @@ ARN_COL_IMAGE_GENERAL_DEFINITION(Spectrum11)
 ARN_COL_IMAGE_GENERAL_DEFINITION(Spectrum18)
 ARN_COL_IMAGE_GENERAL_DEFINITION(Spectrum46)
 
-ARN_COL_IMAGE_DEFAULT_DEFINITION_LIGHT(LightAlpha)
+/* ---------------------------------------------------------------------------
+    'ArnLightAlphaImage'
+        'data' is the usual table of one ArLightAlpha pointer per pixel.
+        Images that own their pixels keep them in 'framebuffer', so that
+        whole images and tiles can be cleared, merged and normalised with
+        the bulk arlightalphaframebuffer_xxx() operations. Images that are
+        just a part of another ArnLightAlphaImage have an empty
+        framebuffer, and only the 'data' view.
+--------------------------------------------------------------------------- */
+@interface ArnLightAlphaImage : ArnPlainImage
+        <
+            ArpConcreteClass, ArpPlainImageDefaultMemory,
+            ArpSetLightAlphaRegion, ArpGetLightAlphaRegion
+        >
+{
+@public
+    ArLightAlpha             ** data;
+    ArLightAlphaFramebuffer     framebuffer;
+}
+
+- (ArLightAlpha *) line : (long) y ;
+
+@end
 
 #undef ARN_COL_IMAGE_GENERAL_DEFINITION
 #undef ARN_COL_IMAGE_DEFAULT_DEFINITION
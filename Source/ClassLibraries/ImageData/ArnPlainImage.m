@@ -834,16 +834,18 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnLightAlphaImage)
 {
     unsigned int  numberOfPixels = XC(size) * YC(size);
 
-    data = ALLOC_ARRAY( ArLightAlpha *, numberOfPixels );
+    arlightalphaframebuffer_free_contents(
+          art_gv,
+        & framebuffer
+        );
 
-    for ( unsigned int i = 0; i < numberOfPixels; i++ )
-    {
-        data[i] =
-            arlightalpha_d_alloc_init_unpolarised(
-                art_gv,
-                0.0
-                );
-    }
+    arlightalphaframebuffer_init(
+          art_gv,
+        & framebuffer,
+          numberOfPixels
+        );
+
+    data = framebuffer.pixel;
 }
 
 - (id) initWithSize :(IVec2D) newSize
@@ -946,18 +948,15 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnLightAlphaImage)
             [ BASEIMAGE setPlainImage :offset :self ];
     }
 
-    unsigned int  numberOfPixels = XC(size) * YC(size);
+    //   Part images only point into the framebuffer of their base image,
+    //   so their own one is empty.
 
-    if ( data )
-    {
-        for ( unsigned long i = 0; i < numberOfPixels; i++ )
-            arlightalpha_free(
-                art_gv,
-                data[i]
-                );
+    arlightalphaframebuffer_free_contents(
+          art_gv,
+        & framebuffer
+        );
 
-        FREE_ARRAY(data);
-    }
+    data = 0;
 
     [ super dealloc ];
 }
@@ -29,6 +29,7 @@
 ART_LIBRARY_INTERFACE(ART_ImageFileFormat)
 
 #import "ArfARTRAW.h"
+#import "ArfARTTILE.h"
 #import "ArfARTCSP.h"
 #import "ArfARTGSC.h"
 #import "ArfGreyCSV.h"
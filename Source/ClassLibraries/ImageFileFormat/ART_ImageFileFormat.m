@@ -33,6 +33,7 @@
 ART_LIBRARY_INITIALISATION_FUNCTION
 (
     ART_PERFORM_MODULE_INITIALISATION( ArfARTRAW )
+    ART_PERFORM_MODULE_INITIALISATION( ArfARTTILE )
     ART_PERFORM_MODULE_INITIALISATION( ArfARTCSP )
     ART_PERFORM_MODULE_INITIALISATION( ArfARTGSC )
     ART_PERFORM_MODULE_INITIALISATION( ArfGreyCSV )
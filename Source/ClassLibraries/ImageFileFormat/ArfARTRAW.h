@@ -77,9 +77,22 @@ ART_MODULE_INTERFACE(ArfARTRAW)
     ArSpectrum        ** colBufS2;
     ArSpectrum        ** colBufS3;
     ArReferenceFrame     referenceFrame;
-    unsigned char      * charBuffer;
     int                  channels;
 
+    //   Pixel data is moved to and from disk one scanline at a time: the
+    //   strip buffer holds the raw little-endian bytes of a scanline, and
+    //   the float buffer their decoded values. When reading from a regular
+    //   file, the data section is mmap'ed instead, and the strip buffer is
+    //   only used as a fallback.
+
+    unsigned char      * stripBuffer;
+    unsigned long        stripBufferSize;
+    unsigned long        stripBufferPosition;
+    float              * floatBuffer;
+    unsigned char      * mappedFile;
+    unsigned long        mappedFileSize;
+    unsigned long        mappedFilePosition;
+
 }
 
 @end
@@ -146,7 +146,11 @@
 
         The structure of the image data is dependent on whether the
         file contains polarisation information. All float values are written
-        to file in a big-endian byte ordering.
+        to file in little-endian byte ordering, i.e. least significant byte
+        first (the text line that precedes the data section says otherwise,
+        but has to be kept as it is for compatibility). Readers and writers
+        move the data one scanline at a time, and regular files are mmap'ed
+        for reading.
 
         Non-polarised case (data mode 1)
 
@@ -159,7 +163,7 @@
         Polarised case (data mode 2)
 
         In this mode, float values are also stored uncompressed and
-        packed into 4 big-endian bytes each. However, the difference
+        packed into 4 little-endian bytes each. However, the difference
         is that each of the n spectral values for each pixel can
         consist of either one or four float values, depending whether it
         is polarised or not. A single alpha channel is again the
@@ -231,6 +235,9 @@
 #import "ArfARTRAW.h"
 #import "ApplicationSupport.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 //#define ARFARTRAW_DEBUGPRINTF
 
 ART_MODULE_INITIALISATION_FUNCTION
@@ -254,6 +261,57 @@ static const char * arfartraw_short_class_name = "ARTRAW";
 static const char * arfartraw_long_class_name = "ART Raw Image File Format";
 static const char * arfartraw_extension[] = { ARFARTRAW_EXTENSION, 0 };
 
+/* ---------------------------------------------------------------------------
+
+    'arfartraw_decode_floats' / 'arfartraw_encode_floats'
+
+    Conversion between the on-disk representation of pixel data - packed
+    IEEE floats, least significant byte first - and native floats. On
+    little-endian hosts this is a single memcpy; big-endian hosts swap the
+    bytes of each value in the same pass.
+
+------------------------------------------------------------------------aw- */
+
+static void arfartraw_decode_floats(
+        const unsigned char  * bytes,
+              float          * values,
+              unsigned long    numberOfValues
+        )
+{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    for ( unsigned long i = 0; i < numberOfValues; i++ )
+    {
+        uint32_t  word;
+
+        memcpy( & word, bytes + i * 4, 4 );
+        word = __builtin_bswap32( word );
+        memcpy( values + i, & word, 4 );
+    }
+#else
+    memcpy( values, bytes, numberOfValues * 4 );
+#endif
+}
+
+static void arfartraw_encode_floats(
+        const float          * values,
+              unsigned char  * bytes,
+              unsigned long    numberOfValues
+        )
+{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    for ( unsigned long i = 0; i < numberOfValues; i++ )
+    {
+        uint32_t  word;
+
+        memcpy( & word, values + i, 4 );
+        word = __builtin_bswap32( word );
+        memcpy( bytes + i * 4, & word, 4 );
+    }
+#else
+    memcpy( bytes, values, numberOfValues * 4 );
+#endif
+}
+
 
 @implementation ArfARTRAW
 
@@ -313,39 +371,119 @@ ARFRASTERIMAGE_DEFAULT_IMPLEMENTATION(LightAlpha,artraw)
         } \
     }
 
-#define ARFARTRAW_READ_BYTE(__byte) \
-    [ file read \
-        :   & (__byte) \
-        :   1 \
-        :   1 ];
-
-#define ARFARTRAW_READ_DOUBLE(__double) \
-    [ file read \
-        :   (__double) \
-        :   1 \
-        :   4 \
-        ];
+- (void) _ensureStripBufferSize
+        : (unsigned long) numberOfBytes
+{
+    if ( numberOfBytes > stripBufferSize )
+    {
+        if ( stripBuffer )
+            FREE_ARRAY( stripBuffer );
 
-#define ARFARTRAW_READ_PIXEL(__pixel) \
-    [ file read \
-        :   (__pixel) \
-        :   1 \
-        :   channels * 4 \
-        ];
+        stripBuffer = ALLOC_ARRAY( unsigned char, numberOfBytes );
+        stripBufferSize = numberOfBytes;
+    }
+}
 
-- (void) _extractPixelChannelToD
-        : (int) c
-        : (double *) d
+/* ---------------------------------------------------------------------------
+
+    '_mapDataSection'
+
+    Tries to mmap the file we are reading from, so that the data section
+    can be decoded straight from the page cache. Only used for regular
+    files; if anything goes wrong we silently stay with buffered reads via
+    the ArcFile. The file position after the header has been parsed marks
+    the start of the data section.
+
+------------------------------------------------------------------------aw- */
+
+- (void) _mapDataSection
+{
+    FILE         * fp = [ file file ];
+    struct stat    fileStatus;
+
+    if (   ! fp
+        || fstat( fileno( fp ), & fileStatus ) != 0
+        || ! S_ISREG( fileStatus.st_mode )
+        || fileStatus.st_size <= 0 )
+        return;
+
+    long  dataStart = ftell( fp );
+
+    if ( dataStart < 0 || dataStart > fileStatus.st_size )
+        return;
+
+    void  * mapping =
+        mmap(
+            0,
+            (size_t) fileStatus.st_size,
+            PROT_READ,
+            MAP_PRIVATE,
+            fileno( fp ),
+            0
+            );
+
+    if ( mapping == MAP_FAILED )
+        return;
+
+#ifdef MADV_SEQUENTIAL
+    madvise( mapping, (size_t) fileStatus.st_size, MADV_SEQUENTIAL );
+#endif
+
+    mappedFile = mapping;
+    mappedFileSize = (unsigned long) fileStatus.st_size;
+    mappedFilePosition = (unsigned long) dataStart;
+}
+
+/* ---------------------------------------------------------------------------
+
+    '_readDataBytes'
+
+    Returns a pointer to the next 'numberOfBytes' bytes of the data
+    section: either directly into the mapped file, or into the strip buffer
+    after a single block read. Missing data at the end of a truncated file
+    is replaced by zeroes.
+
+------------------------------------------------------------------------aw- */
+
+- (const unsigned char *) _readDataBytes
+        : (unsigned long) numberOfBytes
 {
-    unsigned long l;
-    union { float f; unsigned int i; }  value;
+    if ( mappedFile )
+    {
+        unsigned long  available = mappedFileSize - mappedFilePosition;
 
-    l  = charBuffer[c * 4 + 3] & 0xff; l <<= 8;
-    l |= charBuffer[c * 4 + 2] & 0xff; l <<= 8;
-    l |= charBuffer[c * 4 + 1] & 0xff; l <<= 8;
-    l |= charBuffer[c * 4 + 0] & 0xff;
+        if ( numberOfBytes <= available )
+        {
+            const unsigned char  * bytes = mappedFile + mappedFilePosition;
+
+            mappedFilePosition += numberOfBytes;
+
+            return bytes;
+        }
+
+        [ self _ensureStripBufferSize: numberOfBytes ];
+
+        memcpy( stripBuffer, mappedFile + mappedFilePosition, available );
+        memset( stripBuffer + available, 0, numberOfBytes - available );
+
+        mappedFilePosition = mappedFileSize;
+
+        return stripBuffer;
+    }
+
+    [ self _ensureStripBufferSize: numberOfBytes ];
+
+    BOOL  read_success =
+        [ file read
+            :   stripBuffer
+            :   1
+            :   numberOfBytes
+            ];
+
+    if ( ! read_success )
+        memset( stripBuffer, 0, numberOfBytes );
 
-    value.i = l; *d = (double)value.f;
+    return stripBuffer;
 }
 
 - (void) _assignDToBuffer
@@ -487,88 +625,88 @@ ARFRASTERIMAGE_DEFAULT_IMPLEMENTATION(LightAlpha,artraw)
         : (void *) buffer
         : (long) x
 {
-    BOOL  read_success = ARFARTRAW_READ_DOUBLE( charBuffer );
+    float  value;
 
-    if ( read_success )
-    {
-        [ self _extractPixelChannelToD
-            :   0
-            : & ((double*) buffer)[x]
-            ];
-    }
-    else
-    {
-        ((double*) buffer)[x] = 0.0;
-    }
+    arfartraw_decode_floats(
+        [ self _readDataBytes: 4 ],
+        & value,
+        1
+        );
+
+    ((double*) buffer)[x] = value;
 }
 
 - (void) _readPixelToBufferAt
         : (void *) buffer
         : (long) x
 {
-    BOOL  read_success = ARFARTRAW_READ_PIXEL( charBuffer );
-
-    if ( ! read_success )
-    {
-        //  Plan B - fill the buffer with zeroes
-        
-        for ( int c = 0; c < channels * 4; c++ )
-            ((double*) buffer)[c*4] = 0.0;
-    }
+    arfartraw_decode_floats(
+        [ self _readDataBytes: channels * 4 ],
+        floatBuffer,
+        channels
+        );
 
     for ( int c = 0; c < channels; c++ )
-    {
-        double  d;
-
-        [ self _extractPixelChannelToD
-            :   c
-            : & d
-            ];
-
         [ self _assignDToBuffer
-            :   d
+            :   floatBuffer[c]
             :   buffer
             :   x
             :   c
             ];
-    }
+}
+
+/* ---------------------------------------------------------------------------
+
+    Writing: pixel values are appended to the strip buffer, which is
+    flushed to disk once per scanline by '_writeStripBuffer'.
+
+------------------------------------------------------------------------aw- */
+
+- (void) _writeByte
+        : (char) byte
+{
+    stripBuffer[ stripBufferPosition++ ] = (unsigned char) byte;
 }
 
 - (void) _writeDouble
         : (double *) d
 {
-    unsigned long  l;
-    union { float f; unsigned int i; }  value;
-
-    value.f = (float)*d; l = value.i;
+    float  value = (float) *d;
 
-    charBuffer[0] = l & 0xff; l >>= 8;
-    charBuffer[1] = l & 0xff; l >>= 8;
-    charBuffer[2] = l & 0xff; l >>= 8;
-    charBuffer[3] = l & 0xff;
+    arfartraw_encode_floats(
+          & value,
+            stripBuffer + stripBufferPosition,
+            1
+        );
 
-    [ file write: charBuffer : 1 : 4 ];
+    stripBufferPosition += 4;
 }
 
 - (void) _writePixel
         : (ArSpectrum *) colour
 {
     for ( int c = 0; c < channels; c++ )
-    {
-        double  d;
-        unsigned long  l;
-        union { float f; unsigned int i; }  value;
+        floatBuffer[c] = (float) spc_si( art_gv, colour, c );
 
-        d = spc_si( art_gv, colour, c );
-        value.f = (float)d; l = value.i;
+    arfartraw_encode_floats(
+        floatBuffer,
+        stripBuffer + stripBufferPosition,
+        channels
+        );
 
-        charBuffer[c * 4 + 0] = l & 0xff; l >>= 8;
-        charBuffer[c * 4 + 1] = l & 0xff; l >>= 8;
-        charBuffer[c * 4 + 2] = l & 0xff; l >>= 8;
-        charBuffer[c * 4 + 3] = l & 0xff;
-    }
+    stripBufferPosition += channels * 4;
+}
+
+- (void) _writeStripBuffer
+{
+    if ( stripBufferPosition > 0 )
+        [ file write
+            :   stripBuffer
+            :   1
+            :   stripBufferPosition
+            ];
 
-    [ file write: charBuffer : 1 : channels * 4 ];
+    stripBufferPosition = 0;
 }
 
 #define TERMINATE_IF_SCANF_UNSUCCESSFUL(__retval) \
@@ -877,8 +1015,10 @@ while (0);
                 0.0
                 );
 
-    // we need one additional char-4 for the alpha channel
-    charBuffer = ALLOC_ARRAY( unsigned char, channels * 4 );
+    // one scanline worth of floats: channels plus alpha for each pixel
+    floatBuffer = ALLOC_ARRAY( float, XC(size) * ( channels + 1 ) );
+
+    [ self _mapDataSection ];
 
     ARFARTRAW_ALLOC_BUFFER_ARRAY( bufferS0, XC(size) )
     bufferA = ALLOC_ARRAY( double, XC(size) );
@@ -991,21 +1131,34 @@ while (0);
         else
         {
             /* ----------------------------------------------------------
-                 Non-fileContainsPolarisationData images can be read in 
-                 pixel-wise fashion like any sane format.
+                 Non-fileContainsPolarisationData images have a fixed
+                 scanline size, so each scanline is fetched and decoded
+                 as a single block.
             -------------------------------------------------------aw- */
 
+            unsigned long  floatsPerPixel = channels + 1;
+            unsigned long  floatsPerScanline =
+                XC(image->size) * floatsPerPixel;
+
+            arfartraw_decode_floats(
+                [ self _readDataBytes: floatsPerScanline * 4 ],
+                floatBuffer,
+                floatsPerScanline
+                );
+
             for ( long x = 0; x < XC(image->size); x++ )
             {
-                [self _readPixelToBufferAt
-                   :   bufferS0
-                   :   x
-                   ];
+                float  * pixel = floatBuffer + x * floatsPerPixel;
 
-                [ self _readDoubleToBufferAt
-                   :   bufferA
-                   :   x
-                   ];
+                for ( int c = 0; c < channels; c++ )
+                    [ self _assignDToBuffer
+                        :   pixel[c]
+                        :   bufferS0
+                        :   x
+                        :   c
+                        ];
+
+                bufferA[x] = pixel[channels];
             }
         }
 
@@ -1133,7 +1286,19 @@ while (0);
                 0.0
                 );
 
-    charBuffer = ALLOC_ARRAY(unsigned char, channels * 4);
+    floatBuffer = ALLOC_ARRAY( float, channels );
+
+    //   Worst case size of an encoded scanline: all pixels polarised, plus
+    //   the flag bytes.
+
+    if ( LIGHT_SUBSYSTEM_IS_IN_POLARISATION_MODE )
+        [ self _ensureStripBufferSize
+            :   ( XC(size) / 8 + 1 ) + XC(size) * ( 4 * channels + 1 ) * 4
+            ];
+    else
+        [ self _ensureStripBufferSize
+            :   XC(size) * ( channels + 1 ) * 4
+            ];
 
     if ( LIGHT_SUBSYSTEM_IS_IN_POLARISATION_MODE )
     {
@@ -1343,7 +1508,7 @@ while (0);
                     if ( i < 7 ) flagByte = flagByte << 1;
                 }
 
-                [ file write: & flagByte : 1 : 1 ];
+                [ self _writeByte: flagByte ];
 
                 /* ----------------------------------------------------------
                     Part 2 - the individual stokes vectors are written to
@@ -1396,10 +1561,10 @@ while (0);
             to CIE XYZ before writing.
         ---------------------------------------------------------------aw- */
 
+        ArSpectrum  * spc = spc_alloc( art_gv );
+
         for ( long x = 0; x < XC(image->size); x++ )
         {
-            ArSpectrum  * spc = spc_alloc( art_gv );
-
             if (   art_foundation_isr(art_gv) == ardt_xyz
                 || art_foundation_isr(art_gv) == ardt_xyz_polarisable
                )
@@ -1441,23 +1606,27 @@ while (0);
                 :   spc
                 ];
 
-            spc_free(
-                art_gv,
-                spc
-                );
-
             [ self _writeDouble
                :   & ARLIGHTALPHA_ALPHA( *scanline[x] )
                ];
         }
+
+        spc_free(
+            art_gv,
+            spc
+            );
         }
+
+        [ self _writeStripBuffer ];
     }
 }
 
 - (void) dealloc
 {
     if (scanline) FREE_ARRAY(scanline);
-    if (charBuffer) FREE_ARRAY(charBuffer);
+    if (stripBuffer) FREE_ARRAY(stripBuffer);
+    if (floatBuffer) FREE_ARRAY(floatBuffer);
+    if (mappedFile) munmap( mappedFile, mappedFileSize );
 
     [ super dealloc ];
 }
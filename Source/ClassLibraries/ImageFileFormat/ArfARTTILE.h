@@ -0,0 +1,95 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+#include "ART_Foundation.h"
+
+ART_MODULE_INTERFACE(ArfARTTILE)
+
+    /* ------------------------------------------------------------------
+        For a detailed description of this file format see the
+        comments in the accompanying implementation file (.m)!
+    ---------------------------------------------------------------aw- */
+
+#import "ArfRAWRasterImage.h"
+
+#define ARFARTTILE_VERSION       1.0
+#define ARFARTTILE_EXTENSION     "arttile"
+
+#define ARFARTTILE_TILE_SIZE     64
+
+    /* ------------------------------------------------------------------
+
+        Version history
+        ---------------
+
+        1.0    first release: ARTRAW 2.5 header, compressed tiles plus
+               tile index
+
+    ---------------------------------------------------------------aw- */
+
+@interface ArfARTTILE
+           : ArfRAWRasterImage
+           < ArpRandomAccessImageFile >
+{
+    IVec2D               imageSize;
+    IVec2D               tileSize;
+    long                 tilesX;
+    long                 tilesY;
+    int                  channels;
+    int                  floatsPerPixel;
+    ArReferenceFrame     referenceFrame;
+    BOOL                 openForWriting;
+
+    //   File offset of the most recent record of each tile, 0 if there
+    //   is none (yet).
+
+    unsigned long      * tileOffset;
+    unsigned long        numberOfTilesPresent;
+    unsigned long        dataOffset;
+
+    //   Reading: the tiles of one tile row are decoded on demand and
+    //   kept until a different tile row is requested.
+
+    float              * tileRowCache;
+    BOOL               * tileRowCacheValid;
+    long                 cachedTileRow;
+
+    //   Writing: tiles that have only been partially covered so far.
+
+    float             ** stagingTile;
+    unsigned char     ** stagingMask;
+    long               * stagingCount;
+
+    unsigned char      * shuffleBuffer;
+    unsigned char      * codecBuffer;
+    unsigned long        codecBufferSize;
+    ArLightAlpha      ** scanline;
+    ArSpectrum         * spectrum[4];
+}
+
+@end
+
+// ===========================================================================
@@ -0,0 +1,1533 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+    /* -----------------------------------------------------------------------
+
+        Definition of the ART tiled image format
+        ========================================
+
+        ARTTILE is the compressed, random access counterpart of ARTRAW. It
+        stores the same pixel information - spectral or CIE XYZ values,
+        optional polarisation information, and an alpha channel - but
+        splits the image into square tiles that are compressed
+        individually, and keeps an index of where each tile lives in the
+        file. Any region of an image can therefore be read by decoding just
+        the tiles it overlaps, and tiles can be written in any order, as
+        soon as their pixels are known.
+
+        Layout of an ARTTILE file
+        -------------------------
+
+        <identification string> <line break>
+        <ARTRAW 2.5 style header lines>
+        <tile size> <line break>
+        <data section marker>
+        <tile records>
+        <tile index>
+        <eof>
+
+        1. Identification string and header
+
+        The string "ART TILE image format x.x", followed by the same human
+        readable header lines an ARTRAW 2.5 file contains (creation info,
+        image size, DPI, optional white point, image type, sample bounds),
+        plus a line "Tile size: <tx> x <ty>". The header ends with the line
+        "Compressed tiles follow:" and a single "X" character.
+
+        2. Tile records
+
+        Each record is a 20 byte header - the characters "TILE", followed
+        by the tile column, tile row, encoding and payload size as 32 bit
+        integers - and the payload. All binary integers and floats in an
+        ARTTILE file are stored least significant byte first.
+
+        Tiles at the right and bottom border of the image are cropped to
+        the image. The pixel data of a w x h tile is a set of planes of
+        w x h floats each, in this order: the n spectral channels (3 for
+        CIE XYZ images), for polarised images the n channels of each of
+        the three remaining Stokes vector components, the alpha channel,
+        and for polarised images a plane that is 1.0 for polarised pixels
+        and 0.0 for the others.
+
+        Before compression each float is predicted from its left
+        neighbour (or the one above it, for the first column), and the
+        integer difference of the two bit patterns is zigzag coded. The
+        bytes of the resulting values are split into four byte planes per
+        float plane, most significant byte first. For typical images the
+        upper byte planes consist mostly of zeroes, and constant planes
+        such as alpha or the Stokes components of unpolarised pixels
+        vanish almost completely.
+
+        Encoding 0 stores these byte planes verbatim, encoding 1 compresses
+        them with a simple run length code: a control byte c < 128 is
+        followed by c+1 literal bytes, a control byte c >= 128 by one byte
+        that is repeated c-125 times.
+
+        A tile may occur more than once in a file; the last record for a
+        tile supersedes all earlier ones.
+
+        3. Tile index
+
+        The characters "TIDX", the number of tiles as 32 bit integer, and
+        for each tile (in scanline order) the 64 bit file offset of its
+        record, 0 for tiles that were never written. The file ends with
+        the 64 bit offset of the index and the characters "TEND".
+
+        Files that lack a valid index - e.g. because the renderer that
+        writes them is still running - are read by scanning the tile
+        records in sequence; all tiles that have been completed so far can
+        be read that way.
+
+    ---------------------------------------------------------------aw- */
+
+#define ART_MODULE_NAME     ArfARTTILE
+
+#import "ArfARTTILE.h"
+#import "ApplicationSupport.h"
+
+ART_MODULE_INITIALISATION_FUNCTION
+(
+    [ ArfARTTILE registerWithFileProbe
+        :   art_gv
+        ];
+)
+
+ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
+
+
+#import "ArfRasterImageImplementationMacros.h"
+
+static const char * arfarttile_short_class_name = "ARTTILE";
+static const char * arfarttile_long_class_name = "ART Tiled Image File Format";
+static const char * arfarttile_extension[] = { ARFARTTILE_EXTENSION, 0 };
+
+#define ARFARTTILE_ENCODING_SHUFFLED        0
+#define ARFARTTILE_ENCODING_RUNLENGTH       1
+
+#define ARFARTTILE_RECORD_HEADER_SIZE       20
+
+static void arfarttile_put_u32(
+        unsigned char  * bytes,
+        uint32_t         value
+        )
+{
+    for ( int i = 0; i < 4; i++ )
+        bytes[i] = (unsigned char) ( value >> ( 8 * i ) );
+}
+
+static uint32_t arfarttile_get_u32(
+        const unsigned char  * bytes
+        )
+{
+    uint32_t  value = 0;
+
+    for ( int i = 0; i < 4; i++ )
+        value |= ( (uint32_t) bytes[i] ) << ( 8 * i );
+
+    return value;
+}
+
+static void arfarttile_put_u64(
+        unsigned char  * bytes,
+        uint64_t         value
+        )
+{
+    for ( int i = 0; i < 8; i++ )
+        bytes[i] = (unsigned char) ( value >> ( 8 * i ) );
+}
+
+static uint64_t arfarttile_get_u64(
+        const unsigned char  * bytes
+        )
+{
+    uint64_t  value = 0;
+
+    for ( int i = 0; i < 8; i++ )
+        value |= ( (uint64_t) bytes[i] ) << ( 8 * i );
+
+    return value;
+}
+
+/* ---------------------------------------------------------------------------
+
+    'arfarttile_shuffle' / 'arfarttile_unshuffle'
+
+    Prediction, zigzag coding and byte plane split for the float planes
+    of one tile, and the inverse operation (see the format description
+    above).
+
+------------------------------------------------------------------------aw- */
+
+static void arfarttile_shuffle(
+        const float          * values,
+              long             width,
+              long             height,
+              int              planes,
+              unsigned char  * shuffled
+        )
+{
+    long  n = width * height;
+
+    for ( int p = 0; p < planes; p++ )
+    {
+        const float          * plane = values + p * n;
+              unsigned char  * bytes = shuffled + p * n * 4;
+
+        for ( long i = 0; i < n; i++ )
+        {
+            uint32_t  value, prediction = 0, residual;
+
+            memcpy( & value, plane + i, 4 );
+
+            if ( i % width > 0 )
+                memcpy( & prediction, plane + i - 1, 4 );
+            else if ( i >= width )
+                memcpy( & prediction, plane + i - width, 4 );
+
+            residual = value - prediction;
+            residual = ( residual << 1 ) ^ (uint32_t) ( (int32_t) residual >> 31 );
+
+            bytes[         i ] = (unsigned char) ( residual >> 24 );
+            bytes[     n + i ] = (unsigned char) ( residual >> 16 );
+            bytes[ 2 * n + i ] = (unsigned char) ( residual >>  8 );
+            bytes[ 3 * n + i ] = (unsigned char)   residual;
+        }
+    }
+}
+
+static void arfarttile_unshuffle(
+        const unsigned char  * shuffled,
+              long             width,
+              long             height,
+              int              planes,
+              float          * values
+        )
+{
+    long  n = width * height;
+
+    for ( int p = 0; p < planes; p++ )
+    {
+              float          * plane = values + p * n;
+        const unsigned char  * bytes = shuffled + p * n * 4;
+
+        for ( long i = 0; i < n; i++ )
+        {
+            uint32_t  value, prediction = 0, residual;
+
+            residual =
+                  ( (uint32_t) bytes[         i ] << 24 )
+                | ( (uint32_t) bytes[     n + i ] << 16 )
+                | ( (uint32_t) bytes[ 2 * n + i ] <<  8 )
+                |   (uint32_t) bytes[ 3 * n + i ];
+
+            residual = ( residual >> 1 ) ^ ( 0U - ( residual & 1U ) );
+
+            if ( i % width > 0 )
+                memcpy( & prediction, plane + i - 1, 4 );
+            else if ( i >= width )
+                memcpy( & prediction, plane + i - width, 4 );
+
+            value = prediction + residual;
+
+            memcpy( plane + i, & value, 4 );
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------------
+
+    'arfarttile_runlength_encode' / 'arfarttile_runlength_decode'
+
+    The encoder needs an output buffer of n + n / 128 + 1 bytes in the
+    worst case. The decoder returns NO if the input does not decode to
+    exactly n bytes.
+
+------------------------------------------------------------------------aw- */
+
+static unsigned long arfarttile_runlength_encode(
+        const unsigned char  * input,
+              unsigned long    n,
+              unsigned char  * output
+        )
+{
+    unsigned long  i = 0, o = 0;
+
+    while ( i < n )
+    {
+        unsigned long  run = 1;
+
+        while ( i + run < n && run < 130 && input[ i + run ] == input[i] )
+            run++;
+
+        if ( run >= 3 )
+        {
+            output[ o++ ] = (unsigned char) ( 128 + run - 3 );
+            output[ o++ ] = input[i];
+            i += run;
+        }
+        else
+        {
+            unsigned long  start = i, length = 0;
+
+            while ( i < n && length < 128 )
+            {
+                if (   i + 2 < n
+                    && input[i] == input[ i + 1 ]
+                    && input[i] == input[ i + 2 ] )
+                    break;
+
+                i++;
+                length++;
+            }
+
+            output[ o++ ] = (unsigned char) ( length - 1 );
+            memcpy( output + o, input + start, length );
+            o += length;
+        }
+    }
+
+    return o;
+}
+
+static BOOL arfarttile_runlength_decode(
+        const unsigned char  * input,
+              unsigned long    inputSize,
+              unsigned char  * output,
+              unsigned long    n
+        )
+{
+    unsigned long  i = 0, o = 0;
+
+    while ( i < inputSize && o < n )
+    {
+        unsigned int  control = input[ i++ ];
+
+        if ( control >= 128 )
+        {
+            unsigned long  run = control - 125;
+
+            if ( i >= inputSize || o + run > n )
+                return NO;
+
+            memset( output + o, input[ i++ ], run );
+            o += run;
+        }
+        else
+        {
+            unsigned long  length = control + 1;
+
+            if ( i + length > inputSize || o + length > n )
+                return NO;
+
+            memcpy( output + o, input + i, length );
+            i += length;
+            o += length;
+        }
+    }
+
+    return ( o == n );
+}
+
+
+@implementation ArfARTTILE
+
+ARPFILE_DEFAULT_IMPLEMENTATION( ArfARTTILE, arfiletypecapabilites_read | arfiletypecapabilites_write )
+ARFRASTERIMAGE_DEFAULT_IMPLEMENTATION(LightAlpha,arttile)
+
+- (void) parseFileGetExternals
+        : (ArNode **) objectPtr
+        : (ArList *) externals
+{
+    (void) externals;
+    
+    *objectPtr =
+        [ ALLOC_INIT_OBJECT(ArnFileImage)
+            :   [ file name ]
+            ];
+}
+
+- (void) parseFile
+        : (ArNode **) objectPtr
+{
+    [ self parseFileGetExternals
+        :   objectPtr
+        :   0
+        ];
+}
+
+- (void) _tileExtent
+        : (long) tx
+        : (long) ty
+        : (long *) width
+        : (long *) height
+{
+    *width  = XC(imageSize) - tx * XC(tileSize);
+    *height = YC(imageSize) - ty * YC(tileSize);
+
+    if ( *width  > XC(tileSize) ) *width  = XC(tileSize);
+    if ( *height > YC(tileSize) ) *height = YC(tileSize);
+}
+
+- (unsigned long) _tileCapacity
+{
+    return XC(tileSize) * YC(tileSize) * floatsPerPixel;
+}
+
+/* ---------------------------------------------------------------------------
+
+    '_setupForImageSize'
+
+    Allocates everything that only depends on the image size and pixel
+    layout, which are known once the header has been read or written.
+
+------------------------------------------------------------------------aw- */
+
+- (void) _setupForImageSize
+        : (IVec2D) newImageSize
+{
+    imageSize = newImageSize;
+
+    if ( XC(tileSize) <= 0 || YC(tileSize) <= 0 )
+        tileSize = IVEC2D( ARFARTTILE_TILE_SIZE, ARFARTTILE_TILE_SIZE );
+
+    tilesX = ( XC(imageSize) + XC(tileSize) - 1 ) / XC(tileSize);
+    tilesY = ( YC(imageSize) + YC(tileSize) - 1 ) / YC(tileSize);
+
+    if ( fileContainsPolarisationData )
+        floatsPerPixel = 4 * channels + 2;
+    else
+        floatsPerPixel = channels + 1;
+
+    tileOffset = ALLOC_ARRAY_ZERO( unsigned long, tilesX * tilesY );
+    numberOfTilesPresent = 0;
+
+    unsigned long  rawTileBytes = [ self _tileCapacity ] * 4;
+
+    shuffleBuffer = ALLOC_ARRAY( unsigned char, rawTileBytes );
+    codecBufferSize = rawTileBytes + rawTileBytes / 128 + 1;
+    codecBuffer = ALLOC_ARRAY( unsigned char, codecBufferSize );
+
+    scanline = ALLOC_ARRAY( ArLightAlpha *, XC(imageSize) );
+
+    for ( long i = 0; i < XC(imageSize); i++ )
+        scanline[i] =
+            arlightalpha_d_alloc_init_unpolarised(
+                art_gv,
+                0.0
+                );
+
+    for ( int i = 0; i < 4; i++ )
+        spectrum[i] = spc_alloc( art_gv );
+
+    ARREFFRAME_RF_I( referenceFrame, 0 ) = VEC3D( 1.0, 0.0, 0.0 );
+    ARREFFRAME_RF_I( referenceFrame, 1 ) = VEC3D( 0.0, 1.0, 0.0 );
+}
+
+- (void) _freeBuffers
+{
+    if ( stagingTile )
+    {
+        for ( long i = 0; i < tilesX * tilesY; i++ )
+        {
+            if ( stagingTile[i] ) FREE_ARRAY( stagingTile[i] );
+            if ( stagingMask[i] ) FREE_ARRAY( stagingMask[i] );
+        }
+
+        FREE_ARRAY( stagingTile );
+        FREE_ARRAY( stagingMask );
+        FREE_ARRAY( stagingCount );
+    }
+
+    if ( scanline )
+    {
+        for ( long i = 0; i < XC(imageSize); i++ )
+            arlightalpha_free( art_gv, scanline[i] );
+
+        FREE_ARRAY( scanline );
+    }
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        if ( spectrum[i] ) spc_free( art_gv, spectrum[i] );
+        spectrum[i] = 0;
+    }
+
+    if ( tileOffset ) FREE_ARRAY( tileOffset );
+    if ( tileRowCache ) FREE_ARRAY( tileRowCache );
+    if ( tileRowCacheValid ) FREE_ARRAY( tileRowCacheValid );
+    if ( shuffleBuffer ) FREE_ARRAY( shuffleBuffer );
+    if ( codecBuffer ) FREE_ARRAY( codecBuffer );
+}
+
+/* ---------------------------------------------------------------------------
+
+    Conversion between ART light values and the float planes of a tile.
+    'values' points at the first plane entry of a pixel, and 'stride' is
+    the distance between the planes, i.e. the number of pixels in the tile.
+
+------------------------------------------------------------------------aw- */
+
+- (void) _spectrumToValues
+        : (ArSpectrum *) spc
+        : (float *) values
+        : (long) stride
+{
+    if (   art_foundation_isr(art_gv) == ardt_xyz
+        || art_foundation_isr(art_gv) == ardt_xyz_polarisable )
+    {
+        ArCIEXYZ  xyz;
+
+        spc_to_xyz(
+              art_gv,
+              spc,
+            & xyz
+            );
+
+        values[ 0 * stride ] = ARCIEXYZ_X(xyz);
+        values[ 1 * stride ] = ARCIEXYZ_Y(xyz);
+        values[ 2 * stride ] = ARCIEXYZ_Z(xyz);
+    }
+    else
+    {
+        for ( int c = 0; c < channels; c++ )
+            values[ c * stride ] = spc_si( art_gv, spc, c );
+    }
+}
+
+- (void) _valuesToSpectrum
+        : (const float *) values
+        : (long) stride
+        : (ArSpectrum *) spc
+{
+    switch ( channels )
+    {
+        case 3:
+        {
+            ArCIEXYZ  xyz =
+                ARCIEXYZ(
+                    values[ 0 * stride ],
+                    values[ 1 * stride ],
+                    values[ 2 * stride ] );
+
+            xyz_to_spc( art_gv, & xyz, spc );
+            break;
+        }
+        case 8:
+        {
+            ArSpectrum8  s;
+
+            for ( int c = 0; c < channels; c++ )
+                s8_set_sid( art_gv, & s, c, values[ c * stride ] );
+
+            s8_to_spc( art_gv, & s, spc );
+            break;
+        }
+        case 11:
+        {
+            ArSpectrum11  s;
+
+            for ( int c = 0; c < channels; c++ )
+                s11_set_sid( art_gv, & s, c, values[ c * stride ] );
+
+            s11_to_spc( art_gv, & s, spc );
+            break;
+        }
+        case 18:
+        {
+            ArSpectrum18  s;
+
+            for ( int c = 0; c < channels; c++ )
+                s18_set_sid( art_gv, & s, c, values[ c * stride ] );
+
+            s18_to_spc( art_gv, & s, spc );
+            break;
+        }
+        case 46:
+        {
+            ArSpectrum46  s;
+
+            for ( int c = 0; c < channels; c++ )
+                s46_set_sid( art_gv, & s, c, values[ c * stride ] );
+
+            s46_to_spc( art_gv, & s, spc );
+            break;
+        }
+    }
+}
+
+- (void) _lightAlphaToValues
+        : (ArLightAlpha *) lightAlpha
+        : (float *) values
+        : (long) stride
+{
+    long  alphaPlane = floatsPerPixel - ( fileContainsPolarisationData ? 2 : 1 );
+
+    if (   fileContainsPolarisationData
+        && arlightalpha_l_polarised( art_gv, lightAlpha ) )
+    {
+        ArStokesVector  * sv = arstokesvector_alloc( art_gv );
+
+        arlightalpha_l_to_sv(
+            art_gv,
+            lightAlpha,
+            sv
+            );
+
+        for ( int j = 0; j < 4; j++ )
+            [ self _spectrumToValues
+                :   ARSV_I( *sv, j )
+                :   values + j * channels * stride
+                :   stride
+                ];
+
+        arstokesvector_free( art_gv, sv );
+
+        values[ ( alphaPlane + 1 ) * stride ] = 1.0;
+    }
+    else
+    {
+        arlightalpha_to_spc(
+              art_gv,
+              lightAlpha,
+              spectrum[0]
+            );
+
+        [ self _spectrumToValues
+            :   spectrum[0]
+            :   values
+            :   stride
+            ];
+
+        if ( fileContainsPolarisationData )
+        {
+            for ( int c = channels; c < 4 * channels; c++ )
+                values[ c * stride ] = 0.0;
+
+            values[ ( alphaPlane + 1 ) * stride ] = 0.0;
+        }
+    }
+
+    values[ alphaPlane * stride ] = ARLIGHTALPHA_ALPHA( *lightAlpha );
+}
+
+- (void) _valuesToLightAlpha
+        : (const float *) values
+        : (long) stride
+        : (ArLightAlpha *) lightAlpha
+{
+    long  alphaPlane = floatsPerPixel - ( fileContainsPolarisationData ? 2 : 1 );
+
+    [ self _valuesToSpectrum
+        :   values
+        :   stride
+        :   spectrum[0]
+        ];
+
+    if (   LIGHT_SUBSYSTEM_IS_IN_POLARISATION_MODE
+        && fileContainsPolarisationData
+        && values[ ( alphaPlane + 1 ) * stride ] != 0.0 )
+    {
+        for ( int j = 1; j < 4; j++ )
+            [ self _valuesToSpectrum
+                :   values + j * channels * stride
+                :   stride
+                :   spectrum[j]
+                ];
+
+        ArStokesVector  sv =
+        {
+              {
+              spectrum[0],
+              spectrum[1],
+              spectrum[2],
+              spectrum[3]
+              }
+        };
+
+        arlight_s_rf_init_polarised_l(
+              art_gv,
+            & sv,
+            & referenceFrame,
+              ARLIGHTALPHA_LIGHT( *lightAlpha )
+            );
+    }
+    else
+        arlight_s_init_unpolarised_l(
+              art_gv,
+              spectrum[0],
+              ARLIGHTALPHA_LIGHT( *lightAlpha )
+            );
+
+    ARLIGHTALPHA_ALPHA( *lightAlpha ) = values[ alphaPlane * stride ];
+}
+
+/* ---------------------------------------------------------------------------
+
+    '_writeTile' / '_readTile'
+
+    Compress and append one tile record to the file, or locate, read and
+    decompress the most recent record of a tile. Tiles for which no
+    (valid) record exists read as zero.
+
+------------------------------------------------------------------------aw- */
+
+- (void) _writeTile
+        : (long) tx
+        : (long) ty
+        : (const float *) values
+{
+    long  width, height;
+
+    [ self _tileExtent: tx : ty : & width : & height ];
+
+    unsigned long  rawSize = width * height * floatsPerPixel * 4;
+
+    arfarttile_shuffle(
+        values,
+        width,
+        height,
+        floatsPerPixel,
+        shuffleBuffer
+        );
+
+    unsigned long  payloadSize =
+        arfarttile_runlength_encode(
+            shuffleBuffer,
+            rawSize,
+            codecBuffer
+            );
+
+    const unsigned char  * payload = codecBuffer;
+    unsigned int           encoding = ARFARTTILE_ENCODING_RUNLENGTH;
+
+    if ( payloadSize >= rawSize )
+    {
+        payload = shuffleBuffer;
+        payloadSize = rawSize;
+        encoding = ARFARTTILE_ENCODING_SHUFFLED;
+    }
+
+    unsigned char  record[ ARFARTTILE_RECORD_HEADER_SIZE ];
+
+    memcpy( record, "TILE", 4 );
+    arfarttile_put_u32( record +  4, (uint32_t) tx );
+    arfarttile_put_u32( record +  8, (uint32_t) ty );
+    arfarttile_put_u32( record + 12, encoding );
+    arfarttile_put_u32( record + 16, (uint32_t) payloadSize );
+
+    long  offset = ftell( [ file file ] );
+
+    [ file write: record : 1 : ARFARTTILE_RECORD_HEADER_SIZE ];
+    [ file write: payload : 1 : payloadSize ];
+
+    //   Files that are streamed out by the samplers can be read while they
+    //   are still being written, so each record goes out completely.
+
+    fflush( [ file file ] );
+
+    if ( ! tileOffset[ ty * tilesX + tx ] )
+        numberOfTilesPresent++;
+
+    tileOffset[ ty * tilesX + tx ] = offset;
+}
+
+- (void) _readTile
+        : (long) tx
+        : (long) ty
+        : (float *) values
+{
+    long  width, height;
+
+    [ self _tileExtent: tx : ty : & width : & height ];
+
+    unsigned long  rawSize = width * height * floatsPerPixel * 4;
+    unsigned long  offset = tileOffset[ ty * tilesX + tx ];
+
+    if ( ! offset )
+    {
+        memset( values, 0, rawSize );
+        return;
+    }
+
+    unsigned char  record[ ARFARTTILE_RECORD_HEADER_SIZE ];
+
+    BOOL  success =
+           fseek( [ file file ], offset, SEEK_SET ) == 0
+        && [ file read: record : 1 : ARFARTTILE_RECORD_HEADER_SIZE ]
+        && memcmp( record, "TILE", 4 ) == 0
+        && arfarttile_get_u32( record + 4 ) == (uint32_t) tx
+        && arfarttile_get_u32( record + 8 ) == (uint32_t) ty;
+
+    if ( success )
+    {
+        unsigned int   encoding    = arfarttile_get_u32( record + 12 );
+        unsigned long  payloadSize = arfarttile_get_u32( record + 16 );
+
+        success =
+               payloadSize <= codecBufferSize
+            && [ file read: codecBuffer : 1 : payloadSize ];
+
+        if ( success )
+        {
+            if ( encoding == ARFARTTILE_ENCODING_RUNLENGTH )
+                success =
+                    arfarttile_runlength_decode(
+                        codecBuffer,
+                        payloadSize,
+                        shuffleBuffer,
+                        rawSize
+                        );
+            else if (   encoding == ARFARTTILE_ENCODING_SHUFFLED
+                     && payloadSize == rawSize )
+                memcpy( shuffleBuffer, codecBuffer, rawSize );
+            else
+                success = NO;
+        }
+    }
+
+    if ( success )
+        arfarttile_unshuffle(
+            shuffleBuffer,
+            width,
+            height,
+            floatsPerPixel,
+            values
+            );
+    else
+    {
+        ART_ERRORHANDLING_WARNING(
+            "file %s: tile (%ld|%ld) is corrupted and read as zero"
+            ,   [ file name ]
+            ,   tx
+            ,   ty
+            );
+
+        memset( values, 0, rawSize );
+    }
+}
+
+/* ---------------------------------------------------------------------------
+
+    '_readTileIndex'
+
+    Fills 'tileOffset' from the index at the end of the file. If there is
+    no valid index, the tile records are scanned instead, and the ones
+    that are complete are used.
+
+------------------------------------------------------------------------aw- */
+
+- (void) _readTileIndex
+{
+    FILE           * fp = [ file file ];
+    unsigned long    numberOfTiles = tilesX * tilesY;
+    BOOL             haveIndex = NO;
+
+    fseek( fp, 0, SEEK_END );
+
+    long  fileSize = ftell( fp );
+
+    unsigned char  footer[12];
+
+    if (   fileSize >= (long) ( dataOffset + 12 )
+        && fseek( fp, fileSize - 12, SEEK_SET ) == 0
+        && [ file read: footer : 1 : 12 ]
+        && memcmp( footer + 8, "TEND", 4 ) == 0 )
+    {
+        unsigned long  indexOffset = arfarttile_get_u64( footer );
+        unsigned char  indexHeader[8];
+
+        if (   indexOffset >= dataOffset
+            && indexOffset + 8 + numberOfTiles * 8 + 12 == (unsigned long) fileSize
+            && fseek( fp, indexOffset, SEEK_SET ) == 0
+            && [ file read: indexHeader : 1 : 8 ]
+            && memcmp( indexHeader, "TIDX", 4 ) == 0
+            && arfarttile_get_u32( indexHeader + 4 ) == numberOfTiles )
+        {
+            unsigned char  * entries =
+                ALLOC_ARRAY( unsigned char, numberOfTiles * 8 );
+
+            if ( [ file read: entries : 1 : numberOfTiles * 8 ] )
+            {
+                for ( unsigned long i = 0; i < numberOfTiles; i++ )
+                    tileOffset[i] = arfarttile_get_u64( entries + i * 8 );
+
+                haveIndex = YES;
+            }
+
+            FREE_ARRAY( entries );
+        }
+    }
+
+    if ( ! haveIndex )
+    {
+        unsigned long  offset = dataOffset;
+        unsigned char  record[ ARFARTTILE_RECORD_HEADER_SIZE ];
+
+        memset( tileOffset, 0, numberOfTiles * sizeof(unsigned long) );
+
+        while (   offset + ARFARTTILE_RECORD_HEADER_SIZE <= (unsigned long) fileSize
+               && fseek( fp, offset, SEEK_SET ) == 0
+               && [ file read: record : 1 : ARFARTTILE_RECORD_HEADER_SIZE ]
+               && memcmp( record, "TILE", 4 ) == 0 )
+        {
+            unsigned long  tx = arfarttile_get_u32( record +  4 );
+            unsigned long  ty = arfarttile_get_u32( record +  8 );
+            unsigned long  recordSize =
+                ARFARTTILE_RECORD_HEADER_SIZE + arfarttile_get_u32( record + 16 );
+
+            if (   tx >= (unsigned long) tilesX
+                || ty >= (unsigned long) tilesY
+                || offset + recordSize > (unsigned long) fileSize )
+                break;
+
+            tileOffset[ ty * tilesX + tx ] = offset;
+            offset += recordSize;
+        }
+    }
+
+    numberOfTilesPresent = 0;
+
+    for ( unsigned long i = 0; i < numberOfTiles; i++ )
+        if ( tileOffset[i] )
+            numberOfTilesPresent++;
+}
+
+- (void) _writeTileIndex
+{
+    unsigned long  numberOfTiles = tilesX * tilesY;
+
+    //   Partially covered tiles are written as they are, so that none of
+    //   the pixels we were given get lost.
+
+    for ( unsigned long i = 0; i < numberOfTiles; i++ )
+    {
+        if ( stagingTile[i] )
+        {
+            [ self _writeTile
+                :   i % tilesX
+                :   i / tilesX
+                :   stagingTile[i]
+                ];
+
+            FREE_ARRAY( stagingTile[i] );
+            FREE_ARRAY( stagingMask[i] );
+        }
+    }
+
+    long  indexOffset = ftell( [ file file ] );
+
+    unsigned char  * index =
+        ALLOC_ARRAY( unsigned char, 8 + numberOfTiles * 8 + 12 );
+
+    memcpy( index, "TIDX", 4 );
+    arfarttile_put_u32( index + 4, (uint32_t) numberOfTiles );
+
+    for ( unsigned long i = 0; i < numberOfTiles; i++ )
+        arfarttile_put_u64( index + 8 + i * 8, tileOffset[i] );
+
+    arfarttile_put_u64( index + 8 + numberOfTiles * 8, indexOffset );
+    memcpy( index + 8 + numberOfTiles * 8 + 8, "TEND", 4 );
+
+    [ file write: index : 1 : 8 + numberOfTiles * 8 + 12 ];
+
+    FREE_ARRAY( index );
+}
+
+#define TERMINATE_IF_SCANF_UNSUCCESSFUL(__retval) \
+    if ( (__retval) == EOF ) \
+        ART_ERRORHANDLING_FATAL_ERROR( \
+            "file %s has corrupted or incomplete header information" \
+            ,   [ file name ] \
+            );
+
+#define READ_REMAINDER_OF_LINE(__file) \
+do \
+{ \
+    char  local_c; \
+\
+    do \
+    { \
+        int local_scanf_success = \
+            [ (__file) scanf \
+                :   "%c" \
+                , & local_c \
+                ]; \
+\
+        TERMINATE_IF_SCANF_UNSUCCESSFUL( local_scanf_success ); \
+    } \
+    while ( local_c != '\n' ); \
+} \
+while (0);
+
+#define READ_LINE_STARTING_WITH(__file,__line_header) \
+do \
+{ \
+        int local_scanf_success = \
+            [ (__file) scanf \
+                :   __line_header \
+                ]; \
+\
+        TERMINATE_IF_SCANF_UNSUCCESSFUL( local_scanf_success ); \
+\
+        READ_REMAINDER_OF_LINE(__file); \
+} \
+while (0);
+
+/* ----------------------------------------------------------------------
+
+    Opening an ARTTILE for *reading*
+    
+    This returns an ImageInfo for the new image
+
+---------------------------------------------------------------------- */
+
+- (ArnImageInfo *) open
+{
+    // ARTTILEs are always emissive images
+    _isEmissive = YES;
+
+    openForWriting = NO;
+
+    int  scanf_success = 0;
+
+    if ( [ file open: arfile_read ] & arstream_invalid )
+            ART_ERRORHANDLING_FATAL_ERROR(
+                "cannot open %s for reading"
+                ,   [ file name ]
+                );
+
+    float  artTileVersion = 0.0;
+
+    scanf_success =
+        [ file scanf
+            :   "ART TILE image format %f\n\n"
+            , & artTileVersion
+            ];
+    
+    TERMINATE_IF_SCANF_UNSUCCESSFUL( scanf_success );
+
+    if ( artTileVersion != (float) ARFARTTILE_VERSION )
+        ART_ERRORHANDLING_WARNING(
+            "file %s format version mismatch: %3.1f vs. %3.1f"
+            ,   [ file name ]
+            ,   artTileVersion
+            ,   ARFARTTILE_VERSION
+            );
+
+    READ_LINE_STARTING_WITH( file, "File created by:" );
+    READ_LINE_STARTING_WITH( file, "Platform:" );
+    READ_LINE_STARTING_WITH( file, "Command line:" );
+    READ_LINE_STARTING_WITH( file, "Creation date:" );
+    READ_LINE_STARTING_WITH( file, "Render time:" );
+    READ_LINE_STARTING_WITH( file, "Samples per pixel:" );
+
+    IVec2D  size;
+
+    scanf_success =
+        [ file scanf
+            :   "Image size:         %d x %d\n"
+            , & XC(size)
+            , & YC(size)
+            ];
+    
+    TERMINATE_IF_SCANF_UNSUCCESSFUL( scanf_success );
+
+    FVec2D  resolution = FVEC2D(72.0, 72.0);
+
+    scanf_success =
+        [ file scanf
+            :   "DPI:                %f x %f\n"
+            , & XC(resolution)
+            , & YC(resolution)
+            ];
+
+    TERMINATE_IF_SCANF_UNSUCCESSFUL( scanf_success );
+
+    if ( [ file peek ] == 'W' )
+    {
+        float  x, y;
+        
+        scanf_success =
+            [ file scanf
+                :   "White point (x|y):  ( %f | %f )\n"
+                , & x
+                , & y
+                ];
+        
+        TERMINATE_IF_SCANF_UNSUCCESSFUL( scanf_success );
+
+        char  wp_desc[256];
+
+        scanf_success =
+            [ file scanf
+                :   "White point desc:   %s\n"
+                , & wp_desc
+                ];
+        
+        TERMINATE_IF_SCANF_UNSUCCESSFUL( scanf_success );
+
+        if ( ! art_system_white_point_has_been_manually_set(art_gv) )
+        {
+            art_set_system_white_point(
+                  art_gv,
+                  wp_desc,
+                & ARCIExy( x, y )
+                );
+        }
+    }
+
+    char  polarisation[256], dataType[256];
+
+    scanf_success =
+        [ file scanf
+            :   "Image type:         %s %s with %d samples\n"
+            , & polarisation
+            , & dataType
+            , & channels
+            ];
+    
+    TERMINATE_IF_SCANF_UNSUCCESSFUL( scanf_success );
+
+    if ( strcmp( polarisation, "plain" ) == 0 )
+        fileContainsPolarisationData = NO;
+    else
+        if ( strcmp( polarisation, "polarised" ) == 0 )
+            fileContainsPolarisationData = YES;
+        else
+            ART_ERRORHANDLING_FATAL_ERROR(
+                "file %s lacks information about the polarisation state "
+                "of its contents"
+                ,   [ file name ]
+                );
+
+    scanf_success =
+        [ file scanf
+            :   "Tile size:          %d x %d\n"
+            , & XC(tileSize)
+            , & YC(tileSize)
+            ];
+
+    TERMINATE_IF_SCANF_UNSUCCESSFUL( scanf_success );
+
+    READ_LINE_STARTING_WITH( file, "Sample bounds in nanometers:" );
+
+    [ file scanf: "\nCompressed tiles follow:\nX" ];
+
+    fileDataType = ardt_unknown;
+
+    switch ( channels )
+    {
+        case 3:   fileDataType = ardt_xyz; break;
+        case 8:   fileDataType = ardt_spectrum8; break;
+        case 11:  fileDataType = ardt_spectrum11; break;
+        case 18:  fileDataType = ardt_spectrum18; break;
+        case 46:  fileDataType = ardt_spectrum46; break;
+        default:
+            ART_ERRORHANDLING_FATAL_ERROR(
+                "file %s has an unsupported number of channels (%d)"
+                ,   [ file name ]
+                ,   channels
+                );
+    }
+
+    if ( XC(tileSize) <= 0 || YC(tileSize) <= 0 )
+        ART_ERRORHANDLING_FATAL_ERROR(
+            "file %s has an invalid tile size"
+            ,   [ file name ]
+            );
+
+    if (    LIGHT_SUBSYSTEM_IS_IN_POLARISATION_MODE
+         && fileContainsPolarisationData )
+        fileDataType = fileDataType | ardt_polarisable;
+
+    dataOffset = ftell( [ file file ] );
+
+    [ self _freeBuffers ];
+    [ self _setupForImageSize: size ];
+
+    tileRowCache = ALLOC_ARRAY( float, tilesX * [ self _tileCapacity ] );
+    tileRowCacheValid = ALLOC_ARRAY_ZERO( BOOL, tilesX );
+    cachedTileRow = -1;
+
+    [ self _readTileIndex ];
+
+    unsigned int  imageDataType = fileDataType;
+
+    return
+        [ ALLOC_INIT_OBJECT(ArnImageInfo)
+            :   size
+            :   imageDataType
+            :   fileDataType
+            :   resolution
+            ];
+}
+
+#define SLINE ((void *)scanline)
+
+/* ---------------------------------------------------------------------------
+
+    'getPlainImage'
+
+    Reads the region of the file image that starts at 'start' and has the
+    size of 'image'. Only the tiles that overlap this region are decoded;
+    the most recently used tile row is cached, so that reading an image
+    scanline by scanline decodes each tile just once.
+
+------------------------------------------------------------------------aw- */
+
+- (void) getPlainImage
+        : (IPnt2D) start
+        : (ArnPlainImage *) image
+{
+    long  x0 = XC(start);
+    long  y0 = YC(start);
+    long  width  = M_MIN( XC(image->size), XC(imageSize) - x0 );
+    long  height = M_MIN( YC(image->size), YC(imageSize) - y0 );
+
+    if ( x0 < 0 || y0 < 0 || width <= 0 || height <= 0 )
+        return;
+
+    for ( long y = y0; y < y0 + height; y++ )
+    {
+        long  ty = y / YC(tileSize);
+
+        if ( ty != cachedTileRow )
+        {
+            for ( long tx = 0; tx < tilesX; tx++ )
+                tileRowCacheValid[tx] = NO;
+
+            cachedTileRow = ty;
+        }
+
+        for ( long x = x0; x < x0 + width; x++ )
+        {
+            long     tx = x / XC(tileSize);
+            float  * tile = tileRowCache + tx * [ self _tileCapacity ];
+
+            if ( ! tileRowCacheValid[tx] )
+            {
+                [ self _readTile: tx : ty : tile ];
+                tileRowCacheValid[tx] = YES;
+            }
+
+            long  tileWidth, tileHeight;
+
+            [ self _tileExtent: tx : ty : & tileWidth : & tileHeight ];
+
+            long  i =
+                  ( y - ty * YC(tileSize) ) * tileWidth
+                + ( x - tx * XC(tileSize) );
+
+            [ self _valuesToLightAlpha
+                :   tile + i
+                :   tileWidth * tileHeight
+                :   scanline[ x - x0 ]
+                ];
+        }
+
+        [ ((ArnLightAlphaImage*)image) setLightAlphaRegion
+            :   IPNT2D(0, y - y0)
+            :   IVEC2D(width, 1)
+            :   scanline
+            :   0
+            ];
+    }
+}
+
+/* ----------------------------------------------------------------------
+
+    Opening an ARTTILE for *writing*
+    
+    The provided ImageInfo is used to set the file specifics
+
+---------------------------------------------------------------------- */
+
+- (void) open
+        : (ArnImageInfo *) imageInfo
+{
+    // ARTTILEs are always emissive images
+    _isEmissive = YES;
+
+    IVec2D size = [ imageInfo size ];
+    time_t timer;
+    struct tm *tblock;
+
+    channels = ARDATATYPE_NUMCHANNELS([imageInfo fileDataType]);
+
+    if ([file open :arfile_write] & arstream_invalid)
+        ART_ERRORHANDLING_FATAL_ERROR(
+            "cannot open %s for writing"
+            ,   [ file name ]
+            );
+
+    fileContainsPolarisationData = LIGHT_SUBSYSTEM_IS_IN_POLARISATION_MODE;
+
+    //   A file image can be written to repeatedly (e.g. by the progressive
+    //   image updates of the samplers), so the buffers of the previous
+    //   round have to go.
+
+    [ self _freeBuffers ];
+
+    tileSize = IVEC2D( ARFARTTILE_TILE_SIZE, ARFARTTILE_TILE_SIZE );
+
+    [ self _setupForImageSize: size ];
+
+    stagingTile  = ALLOC_ARRAY_ZERO( float *, tilesX * tilesY );
+    stagingMask  = ALLOC_ARRAY_ZERO( unsigned char *, tilesX * tilesY );
+    stagingCount = ALLOC_ARRAY_ZERO( long, tilesX * tilesY );
+
+    openForWriting = YES;
+
+    [ file printf
+        :   "ART TILE image format %3.1f\n\n"
+        ,   ARFARTTILE_VERSION
+        ];
+
+    char  * createdByString = NULL;
+    
+    asprintf(
+        & createdByString,
+          "%s, ART %s",
+          ART_APPLICATION_NAME,
+          art_version_string
+        );
+
+    [ file printf
+        :   "File created by:    %s\n"
+        ,   createdByString
+        ];
+    
+    FREE( createdByString );
+
+    [ file printf
+        :   "Platform:           %s\n"
+        ,   ART_APPLICATION_PLATFORM_DESCRIPTION
+        ];
+
+    [ file printf
+        :   "Command line:       %s\n"
+        ,   ART_APPLICATION_ENTIRE_COMMANDLINE
+        ];
+
+    timer = time(NULL);
+    tblock = localtime(&timer);
+
+    [ file printf
+        :   "Creation date:      %.2d.%.2d.%d %.2d:%.2d\n"
+        ,   tblock->tm_mday
+        ,   tblock->tm_mon + 1
+        ,   tblock->tm_year + 1900
+        ,   tblock->tm_hour
+        ,   tblock->tm_min
+        ];
+
+    [ file printf
+        :   "Render time:        %s\n"
+        ,   [ imageInfo rendertimeString ]
+        ];
+
+    [ file printf
+        :   "Samples per pixel:  %s\n"
+        ,   [ imageInfo samplecountString ]
+        ];
+
+    [ file printf
+        :   "Image size:         %ld x %ld\n"
+        ,   XC(size)
+        ,   YC(size)
+        ];
+
+    [ file printf
+        :   "DPI:                %04.1f x %04.1f\n"
+        ,   XC([ imageInfo resolution ])
+        ,   YC([ imageInfo resolution ])
+        ];
+
+    if ( art_system_white_point_has_been_manually_set(art_gv) )
+    {
+        ArCIExyY  wp_xyy;
+        
+        xyz_to_xyy(
+              art_gv,
+              art_system_white_point_xyz(art_gv),
+            & wp_xyy
+            );
+        
+        [ file printf
+            :   "White point (x|y):  ( %f | %f )\n"
+            ,   ARCIExyY_x(wp_xyy)
+            ,   ARCIExyY_y(wp_xyy)
+            ];
+
+        [ file printf
+            :   "White point desc:   %s\n"
+            ,   art_system_white_point_symbol(art_gv)
+            ];
+    }
+
+    [ file printf
+        :   "Image type:         %s %s with %d samples\n"
+        ,   fileContainsPolarisationData ? "polarised" : "plain"
+        ,   channels == 3 ? "CIEXYZ" : "spectrum"
+        ,   channels
+        ];
+
+    [ file printf
+        :   "Tile size:          %ld x %ld\n"
+        ,   XC(tileSize)
+        ,   YC(tileSize)
+        ];
+
+    [ file printf: "Sample bounds in nanometers:" ];
+
+    for ( int c = 0; c <= channels && channels != 3; c++ )
+    {
+        double  bound = 0.0;
+
+        switch ( channels )
+        {
+            case 8:   bound = s8_channel_lower_bound( art_gv, c ); break;
+            case 11:  bound = s11_channel_lower_bound( art_gv, c ); break;
+            case 18:  bound = s18_channel_lower_bound( art_gv, c ); break;
+            case 46:  bound = s46_channel_lower_bound( art_gv, c ); break;
+        }
+
+        [ file printf: " %6.2f", NANO_FROM_UNIT(bound) ];
+    }
+
+    [ file printf: "\n\nCompressed tiles follow:\nX" ];
+
+    dataOffset = ftell( [ file file ] );
+}
+
+/* ---------------------------------------------------------------------------
+
+    'setPlainImage'
+
+    Writes 'image' to the region of the file image that starts at 'start'.
+    Tiles are compressed and appended to the file as soon as all of their
+    pixels have been set; tiles that are only partially covered are kept
+    in memory until the remaining pixels arrive, or the file is closed.
+
+------------------------------------------------------------------------aw- */
+
+- (void) setPlainImage
+        : (IPnt2D) start
+        : (ArnPlainImage *) image
+{
+    long  x0 = XC(start);
+    long  y0 = YC(start);
+    long  width  = M_MIN( XC(image->size), XC(imageSize) - x0 );
+    long  height = M_MIN( YC(image->size), YC(imageSize) - y0 );
+
+    if ( x0 < 0 || y0 < 0 || width <= 0 || height <= 0 )
+        return;
+
+    for ( long y = y0; y < y0 + height; y++ )
+    {
+        [ ((ArnLightAlphaImage *)image) getLightAlphaRegion
+            :   IPNT2D(0, y - y0)
+            :   IVEC2D(width, 1)
+            :   SLINE
+            :   0 ];
+
+        long  ty = y / YC(tileSize);
+
+        for ( long x = x0; x < x0 + width; x++ )
+        {
+            long  tx = x / XC(tileSize);
+            long  t  = ty * tilesX + tx;
+            long  tileWidth, tileHeight;
+
+            [ self _tileExtent: tx : ty : & tileWidth : & tileHeight ];
+
+            if ( ! stagingTile[t] )
+            {
+                stagingTile[t] =
+                    ALLOC_ARRAY_ZERO( float, [ self _tileCapacity ] );
+                stagingMask[t] =
+                    ALLOC_ARRAY_ZERO( unsigned char, tileWidth * tileHeight );
+                stagingCount[t] = 0;
+            }
+
+            long  i =
+                  ( y - ty * YC(tileSize) ) * tileWidth
+                + ( x - tx * XC(tileSize) );
+
+            [ self _lightAlphaToValues
+                :   scanline[ x - x0 ]
+                :   stagingTile[t] + i
+                :   tileWidth * tileHeight
+                ];
+
+            if ( ! stagingMask[t][i] )
+            {
+                stagingMask[t][i] = 1;
+                stagingCount[t]++;
+            }
+
+            if ( stagingCount[t] == tileWidth * tileHeight )
+            {
+                [ self _writeTile: tx : ty : stagingTile[t] ];
+
+                FREE_ARRAY( stagingTile[t] );
+                FREE_ARRAY( stagingMask[t] );
+            }
+        }
+    }
+}
+
+- (BOOL) allPixelsWritten
+{
+    return
+        (   openForWriting
+         && numberOfTilesPresent == (unsigned long) ( tilesX * tilesY ) );
+}
+
+- (void) close
+{
+    if ( openForWriting )
+    {
+        [ self _writeTileIndex ];
+        openForWriting = NO;
+    }
+
+    [ super close ];
+}
+
+- (void) dealloc
+{
+    if ( openForWriting )
+        [ self close ];
+
+    [ self _freeBuffers ];
+
+    [ super dealloc ];
+}
+
+@end
+
+// ===========================================================================
@@ -246,6 +246,17 @@ ArPixelID;
     
     ArPixelID  px_id;
     
+    //   Generators that know about pixels and sample indices get those
+    //   directly. Each thread renders every pixel, so the i-th sample of
+    //   a thread becomes sample i * numberOfRenderThreads + THREAD_INDEX
+    //   of the pixel, which makes the indices of all threads together a
+    //   contiguous range.
+
+    BOOL  pixelSampleRandomGeneration =
+        [ THREAD_RANDOM_GENERATOR conformsToProtocol
+            :   @protocol(ArpPixelSampleRandomGenerator)
+            ];
+
     px_id.threadIndex = THREAD_INDEX;
     px_id.globalRandomSeed = arrandom_global_seed(art_gv);
     
@@ -288,9 +299,21 @@ ArPixelID;
 
                 for ( int w = 0; w < wavelengthSteps; w++ )
                 {
-                    [ THREAD_RANDOM_GENERATOR reInitializeWith
-                        :   crc32_of_data( & px_id, sizeof(ArPixelID) )
-                        ];
+                    if ( pixelSampleRandomGeneration )
+                    {
+                        [ (ArcRandomGenerator <ArpPixelSampleRandomGenerator> *)
+                            THREAD_RANDOM_GENERATOR reInitializeWithPixel
+                            :   XC(px_id.pixelCoord)
+                            :   YC(px_id.pixelCoord)
+                            :   i * numberOfRenderThreads + THREAD_INDEX
+                            ];
+                    }
+                    else
+                    {
+                        [ THREAD_RANDOM_GENERATOR reInitializeWith
+                            :   crc32_of_data( & px_id, sizeof(ArPixelID) )
+                            ];
+                    }
 
                     /* --------------------------------------------------------------
                         We double-check whether a given sample should be
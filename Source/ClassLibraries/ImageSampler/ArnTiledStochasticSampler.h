@@ -28,6 +28,10 @@ ART_MODULE_INTERFACE(ArnMySampler)
 typedef struct {
         ArnLightAlphaImage** image;
         double* samples;
+        //   Adaptive sampling only: sample count, sum and sum of squares
+        //   of the sample norms of the first result image, three doubles
+        //   per pixel, stored for the pixel each sample originates from
+        double* moments;
         IVec2D size;
 }tile_t;
 typedef struct image_window_t{
@@ -41,6 +45,8 @@ typedef enum {
         WRITE_TONEMAP,
         WRITE_EXIT,
         TEV_CONNECT,
+        TEV_REFRESH,
+        STREAM_WINDOW,
         POISON,
 }art_task_type_t;
 typedef struct {
@@ -69,6 +75,26 @@ typedef struct {
         pthread_cond_t cond_var;
 } merge_queue_t;
 
+//   Thread count from which on direct accumulation is used by default, and
+//   the schedule of samples per window for that mode: passes start with the
+//   initial number of samples, which then doubles with each pass until the
+//   maximum is reached.
+
+#define DIRECT_ACCUMULATION_THREAD_THRESHOLD        16
+#define DIRECT_ACCUMULATION_INITIAL_SAMPLES         16
+#define DIRECT_ACCUMULATION_MAX_SAMPLES            256
+
+//   Adaptive sampling: number of samples a pixel needs before its noise
+//   estimate is trusted enough to stop sampling it.
+
+#define ADAPTIVE_SAMPLING_MINIMUM_SAMPLES           64
+
+//   Archives only contain a noise threshold if adaptive sampling is on.
+//   This is flagged by a bit of the coded random value generation that
+//   no ArRandomValueGeneration uses, so older archives read unchanged.
+
+#define ADAPTIVE_SAMPLING_CODED_FLAG                0x40000000
+
 @interface ArnTiledStochasticSampler 
         : ArnBinary
         <ArpImageSampler, ArpImageSamplerMessenger, ArpAction,ArpConcreteClass, ArpCoding>
@@ -102,6 +128,13 @@ typedef struct {
         int             wavelengthSteps;
         char          * preSamplingMessage;
 
+        //   Set if the thread RNGs are ArcPhiloxRandomGenerators, which are
+        //   then keyed by pixel and sample index instead of a CRC32 of the
+        //   ArPixelID; this also makes the result independent of the
+        //   number of render threads.
+
+        BOOL            counterBasedRandomGeneration;
+
         IVec2D                                imageSize;
         IPnt2D                                imageOrigin;
         IVec2D                                tile_size;
@@ -154,6 +187,76 @@ typedef struct {
         ArnLightAlphaImage  *  out;
 
         ArcMessageQueue* messageQueue;
+
+        //   Direct accumulation mode: each render thread merges its own
+        //   tiles into merge_image, and obtains its next window from an
+        //   atomic ticket counter instead of going through the render and
+        //   merge queues. The merge thread is then only used for writing,
+        //   tev updates and the interactive controls.
+        //
+        //   No locks are needed for the merges: the windows are coloured
+        //   such that the padded tiles of windows with the same colour do
+        //   not overlap. Within a pass, the tickets are handed out one
+        //   colour after the other, and each such phase only gets merged
+        //   once all earlier phases are complete. 'windowOrder' lists the
+        //   windows sorted by colour, 'colourOfPosition' the colour at
+        //   each position in that order, and 'phaseSize' the number of
+        //   windows per colour.
+        //
+        //   writeImage and the tev refreshes pause the merges via
+        //   'accumulationPaused', and wait for 'mergesInFlight' to drop
+        //   to zero.
+
+        BOOL                directAccumulation;
+        BOOL                accumulationModeFixed;
+        unsigned long       nextRenderTicket;
+        unsigned long       numberOfRenderTickets;
+        unsigned int        numberOfWindowColours;
+        unsigned int      * windowOrder;
+        unsigned int      * colourOfPosition;
+        unsigned int      * phaseSize;
+        unsigned long       numberOfPhases;
+        unsigned int      * ticketsFinishedInPhase;
+        unsigned long       completedPhases;
+        int                 accumulationPaused;
+        unsigned int        mergesInFlight;
+        pthread_mutex_t     sampleCounterLock;
+
+        unsigned long     * samplesRenderedByThread;
+        char              * postSamplingMessage;
+
+        //   Adaptive sampling: pixels are taken out of 'unfinished' once
+        //   the relative standard error of their mean drops below the
+        //   noise threshold, and windows without unfinished pixels are no
+        //   longer rendered. Off if the threshold is zero.
+
+        double              noiseThreshold;
+        unsigned int      * activePixelsInWindow;
+        unsigned int        numberOfActiveWindows;
+
+        //   Result images in random access formats (see
+        //   ArpRandomAccessImageFile) are streamed: a window is written to
+        //   them as soon as it is final, i.e. once neither its own tile nor
+        //   that of any window within reach of the splatting kernel - up to
+        //   'streamReachX/Y' windows away - will be merged again. A window
+        //   is done once its last ticket is finished (direct mode), or once
+        //   its last task is merged (queue mode), and final once all of its
+        //   'neighbours' are done. Windows that never become final, e.g.
+        //   because the rendering was cut short, are written on exit.
+
+        BOOL              * streamOutput;
+        BOOL                streaming;
+        unsigned int        streamReachX;
+        unsigned int        streamReachY;
+        unsigned long       numberOfPasses;
+        unsigned int      * ticketsFinishedInWindow;
+        unsigned int      * tasksInFlight;
+        BOOL              * lastTaskIssued;
+        BOOL              * windowDone;
+        unsigned int      * doneNeighbours;
+        BOOL              * windowStreamed;
+        unsigned int        numberOfStreamedWindows;
+        ArnLightAlphaImage  * streamImage;
 }
 
 - (id) init
@@ -172,6 +275,29 @@ typedef struct {
 - (void) useDeterministicWavelengths
         ;
 
+/* ---------------------------------------------------------------------------
+    'useDirectAccumulation'
+        Switches direct accumulation mode on or off, regardless of the
+        number of render threads. Without this, it is used from
+        DIRECT_ACCUMULATION_THREAD_THRESHOLD threads on, and the queue
+        based mode below that.
+--------------------------------------------------------------------------- */
+
+- (void) useDirectAccumulation
+        : (BOOL) newDirectAccumulation
+        ;
+
+/* ---------------------------------------------------------------------------
+    'useAdaptiveSampling'
+        Stops sampling a pixel once the standard error of its mean is below
+        the given fraction of the mean, e.g. 0.01 for 1% noise. The number
+        of samples per pixel then only acts as an upper limit.
+--------------------------------------------------------------------------- */
+
+- (void) useAdaptiveSampling
+        : (double) newNoiseThreshold
+        ;
+
 @end
 
 
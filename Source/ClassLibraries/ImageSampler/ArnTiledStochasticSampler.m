@@ -21,6 +21,7 @@
 #include <unistd.h>
 #include <termios.h> 
 #include <stdlib.h>
+#include <sched.h>
 
 
 #define TILE_CONSTANT 3
@@ -277,6 +278,41 @@ void swap_merge_queue(merge_queue_t* q){
     pthread_mutex_unlock(SYNC_LOCK_PTR);
 }
 
+//   Direct accumulation mode: samples per window, and index of the first
+//   sample, for a given pass. A pass with zero samples lies beyond the
+//   overall number of samples per pixel.
+
+void direct_pass_samples(
+        unsigned long    pass,
+        unsigned int     overallSamples,
+        unsigned int   * samples,
+        unsigned int   * sampleStart
+        )
+{
+    unsigned long  start = 0;
+    unsigned long  size  = DIRECT_ACCUMULATION_INITIAL_SAMPLES;
+
+    while ( pass > 0 && size < DIRECT_ACCUMULATION_MAX_SAMPLES )
+    {
+        start += size;
+        size  *= 2;
+        pass--;
+    }
+
+    start += pass * size;
+
+    if ( start >= overallSamples )
+    {
+        *samples     = 0;
+        *sampleStart = overallSamples;
+    }
+    else
+    {
+        *samples     = MIN( size, overallSamples - start );
+        *sampleStart = start;
+    }
+}
+
 
 
 
@@ -307,25 +343,40 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
             double,
             numberOfImagesToWrite*XC(tile->size) * YC(tile->size)
             );
+    tile->moments=NULL;
+    if ( noiseThreshold > 0.0 )
+        tile->moments=ALLOC_ARRAY(
+                double,
+                3 * XC(tile->size) * YC(tile->size)
+                );
 }
 
 - (void) clean_tile
     :(tile_t*) tile
 {
+    unsigned long  numberOfPixels = XC(tile->size) * YC(tile->size);
+
     for ( unsigned int i=0 ; i <numberOfImagesToWrite; i++) {
-        for ( int y = 0; y < YC(tile->size); y++ )
-        {
-            for ( int x = 0; x < XC(tile->size); x++ )
-            {
-                arlightalpha_l_init_l(
-                        art_gv,
-                        ARLIGHTALPHA_NONE_A0,
-                        tile->image[i]->data[x + y*XC(tile->size)]
-                    );
-                tile->samples[i*XC(tile->size)*YC(tile->size)+x +y*XC(tile->size)]=0.0;
-            }
-        }
+        arlightalphaframebuffer_clear(
+                art_gv,
+              & tile->image[i]->framebuffer,
+                0,
+                numberOfPixels
+            );
     }
+
+    memset(
+        tile->samples,
+        0,
+        numberOfImagesToWrite * numberOfPixels * sizeof(double)
+        );
+
+    if ( tile->moments )
+        memset(
+            tile->moments,
+            0,
+            3 * numberOfPixels * sizeof(double)
+            );
 }
 - (void) free_tile
     :(tile_t*) tile
@@ -335,12 +386,27 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
     }
     FREE_ARRAY(tile->image);
     FREE_ARRAY(tile->samples);
+    if ( tile->moments )
+        FREE_ARRAY(tile->moments);
 }
 
 
 - (BOOL) make_task
     :(art_task_t*) t
 {
+    //   Adaptive sampling: windows in which all pixels have converged are
+    //   passed over, so new render tasks only go to the noisy ones.
+
+    if ( noiseThreshold > 0.0 && ! finishedGeneratingRenderTasks )
+    {
+        if ( numberOfActiveWindows == 0 )
+            finishedGeneratingRenderTasks = true;
+
+        while (   ! finishedGeneratingRenderTasks
+               && activePixelsInWindow[window_iterator] == 0 )
+            [self task_next_iteration];
+    }
+
     if (finishedGeneratingRenderTasks){
         if (poisoned_render) {
             return false;
@@ -354,6 +420,15 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
     t->window=&render_windows[window_iterator];
     t->sample_start=samples_issued;
     t->type=RENDER;
+
+    if ( streaming )
+    {
+        tasksInFlight[window_iterator]++;
+
+        if ( samples_issued + samples_per_window >= overallNumberOfSamplesPerPixel )
+            lastTaskIssued[window_iterator] = YES;
+    }
+
     [self task_next_iteration];
     return true;
 }
@@ -390,6 +465,11 @@ ARPACTION_DEFAULT_IMPLEMENTATION(ArnTiledStochasticSampler)
     samples_issued=0;
     samples_per_window= MIN(overallNumberOfSamplesPerPixel-samples_issued,samples_per_window);
     numberOfRenderThreads = art_maximum_number_of_working_threads(art_gv);
+    if ( ! accumulationModeFixed )
+    {
+        directAccumulation =
+            ( numberOfRenderThreads >= DIRECT_ACCUMULATION_THREAD_THRESHOLD );
+    }
     if ( deterministicWavelengths )
     {
         [ self useDeterministicWavelengths ];
@@ -421,6 +501,9 @@ ARPACTION_DEFAULT_IMPLEMENTATION(ArnTiledStochasticSampler)
         overallNumberOfSamplesPerPixel = newNumberOfSamples;
         randomValueGeneration = newRandomValueGeneration;
         deterministicWavelengths = NO;       
+        directAccumulation = NO;
+        accumulationModeFixed = NO;
+        noiseThreshold = 0.0;
         [self setupInternalVariables];
     }
     return self;
@@ -524,6 +607,9 @@ ARPACTION_DEFAULT_IMPLEMENTATION(ArnTiledStochasticSampler)
             );
     }
 
+    counterBasedRandomGeneration =
+        [ randomGenerator[0] isKindOfClass: [ ArcPhiloxRandomGenerator class ] ];
+
     outputImage =
         ALLOC_ARRAY(ArNode <ArpImageWriter> *, numberOfResultImages);
     for ( int i = 0; i < numberOfResultImages; i++ )
@@ -665,6 +751,26 @@ ARPACTION_DEFAULT_IMPLEMENTATION(ArnTiledStochasticSampler)
         }
         y_start=MIN(y_start+YC(tile_size), YC(imageSize));
     }  
+
+    if ( noiseThreshold > 0.0 )
+    {
+        activePixelsInWindow =
+            ALLOC_ARRAY_ZERO( unsigned int, tiles_X * tiles_Y );
+        numberOfActiveWindows = 0;
+
+        for ( unsigned int i = 0; i < tiles_X * tiles_Y; i++ )
+        {
+            image_window_t  * window = & render_windows[i];
+
+            for ( int y = YC(window->start); y < YC(window->end); y++ )
+                for ( int x = XC(window->start); x < XC(window->end); x++ )
+                    if ( unfinished[x + y*XC(imageSize)] )
+                        activePixelsInWindow[i]++;
+
+            if ( activePixelsInWindow[i] > 0 )
+                numberOfActiveWindows++;
+        }
+    }
   
     splattingKernelWidth  = [ RECONSTRUCTION_KERNEL supportSize ];
     splattingKernelArea   = M_SQR( splattingKernelWidth );
@@ -684,12 +790,127 @@ ARPACTION_DEFAULT_IMPLEMENTATION(ArnTiledStochasticSampler)
     init_render_queue(&render_queue, buffer_size);
     init_merge_queue(&merge_queue, buffer_size);
     
-    for (size_t i =0; i< buffer_size; i++) {
-        art_task_t task;
-        task.work_tile=&tiles[i];
+    samplesRenderedByThread =
+        ALLOC_ARRAY_ZERO( unsigned long, numberOfRenderThreads );
+
+    streamOutput = ALLOC_ARRAY( BOOL, numberOfResultImages );
+    streaming    = NO;
+
+    for ( int i = 0; i < numberOfResultImages; i++ )
+    {
+        streamOutput[i] =
+               [ outputImage[i] isKindOfClass: [ ArnFileImage class ] ]
+            && [ (ArnFileImage *) outputImage[i] imageFileIsRandomAccess ];
+
+        if ( streamOutput[i] )
+            streaming = YES;
+    }
+
+    if ( streaming )
+    {
+        unsigned int  numberOfWindows = tiles_X * tiles_Y;
+
+        streamReachX = div_roundup( splattingKernelOffset, XC(tile_size) );
+        streamReachY = div_roundup( splattingKernelOffset, YC(tile_size) );
 
-        if([self make_task: &task]){
-            push_render_queue(&render_queue, task);
+        ticketsFinishedInWindow =
+            ALLOC_ARRAY_ZERO( unsigned int, numberOfWindows );
+        tasksInFlight  = ALLOC_ARRAY_ZERO( unsigned int, numberOfWindows );
+        lastTaskIssued = ALLOC_ARRAY_ZERO( BOOL, numberOfWindows );
+        windowDone     = ALLOC_ARRAY_ZERO( BOOL, numberOfWindows );
+        doneNeighbours = ALLOC_ARRAY_ZERO( unsigned int, numberOfWindows );
+        windowStreamed = ALLOC_ARRAY_ZERO( BOOL, numberOfWindows );
+
+        numberOfStreamedWindows = 0;
+
+        streamImage =
+            [ ALLOC_OBJECT(ArnLightAlphaImage)
+                initWithSize
+                :   tile_size
+                ];
+    }
+
+    if ( directAccumulation )
+    {
+        //   Each render thread only ever works on its own tile, so no
+        //   render tasks are queued up front. All passes are laid out
+        //   as one sequence of tickets, window index running fastest.
+
+        unsigned int  numberOfWindows = tiles_X * tiles_Y;
+        unsigned int  samples, sampleStart;
+
+        numberOfPasses = 0;
+
+        do
+        {
+            direct_pass_samples(
+                  numberOfPasses,
+                  overallNumberOfSamplesPerPixel,
+                & samples,
+                & sampleStart
+                );
+
+            if ( samples > 0 )
+                numberOfPasses++;
+        }
+        while ( samples > 0 );
+
+        nextRenderTicket = 0;
+        numberOfRenderTickets = numberOfPasses * numberOfWindows;
+
+        //   Window colouring: a padded tile reaches 'r' windows beyond its
+        //   own in each direction, so two windows at least 2r+1 windows
+        //   apart never touch the same pixels of merge_image.
+
+        unsigned int  strideX =
+            MIN( 2 * div_roundup( splattingKernelOffset, XC(tile_size) ) + 1,
+                 (int) tiles_X );
+        unsigned int  strideY =
+            MIN( 2 * div_roundup( splattingKernelOffset, YC(tile_size) ) + 1,
+                 (int) tiles_Y );
+
+        numberOfWindowColours = strideX * strideY;
+
+        windowOrder      = ALLOC_ARRAY( unsigned int, numberOfWindows );
+        colourOfPosition = ALLOC_ARRAY( unsigned int, numberOfWindows );
+        phaseSize        = ALLOC_ARRAY_ZERO( unsigned int, numberOfWindowColours );
+
+        unsigned int  position = 0;
+
+        for ( unsigned int c = 0; c < numberOfWindowColours; c++ )
+        {
+            for ( unsigned int y = c / strideX; y < tiles_Y; y += strideY )
+            {
+                for ( unsigned int x = c % strideX; x < tiles_X; x += strideX )
+                {
+                    windowOrder[position]      = y * tiles_X + x;
+                    colourOfPosition[position] = c;
+                    position++;
+                    phaseSize[c]++;
+                }
+            }
+        }
+
+        numberOfPhases = numberOfPasses * numberOfWindowColours;
+
+        ticketsFinishedInPhase =
+            ALLOC_ARRAY_ZERO( unsigned int, numberOfPhases );
+
+        completedPhases    = 0;
+        accumulationPaused = 0;
+        mergesInFlight     = 0;
+
+        pthread_mutex_init( & sampleCounterLock, NULL );
+    }
+    else
+    {
+        for (size_t i =0; i< buffer_size; i++) {
+            art_task_t task;
+            task.work_tile=&tiles[i];
+
+            if([self make_task: &task]){
+                push_render_queue(&render_queue, task);
+            }
         }
     }
     tev = [ ALLOC_INIT_OBJECT(ArcTevIntegration)];
@@ -883,9 +1104,26 @@ ARPACTION_DEFAULT_IMPLEMENTATION(ArnTiledStochasticSampler)
 
     artime_now( & endTime );
 
+    double  renderSeconds =
+        artime_seconds( & endTime )- artime_seconds( & beginTime);
+
     [ sampleCounter stop
-        :artime_seconds( & endTime )- artime_seconds( & beginTime)
+        :renderSeconds
         ];
+
+    unsigned long  renderedSamples = 0;
+
+    for ( unsigned int t = 0; t < numberOfRenderThreads; t++ )
+        renderedSamples += samplesRenderedByThread[t];
+
+    asprintf(
+        & postSamplingMessage,
+          "---   interactive mode off   ---\n"
+          "---   %.0f samples/s, %d render threads, %s accumulation   ---\n",
+          renderSeconds > 0.0 ? renderedSamples / renderSeconds : 0.0,
+          numberOfRenderThreads,
+          directAccumulation ? "direct" : "queued"
+        );
 }
 
 - (void)MessageQueueThread
@@ -934,18 +1172,258 @@ ARPACTION_DEFAULT_IMPLEMENTATION(ArnTiledStochasticSampler)
     (void) threadPool;
     (void) threadIndex;
     
-    while(!renderThreadsShouldTerminate){
-        art_task_t curr_task= pop_render_queue(&render_queue);
-        if(curr_task.type==POISON)
-            break;
-        [self render_task : &curr_task: threadIndex];
-        curr_task.type=MERGE;
-        push_merge_queue(&merge_queue, curr_task);
+    if ( directAccumulation )
+    {
+        [ self directRenderLoop : threadIndex ];
+    }
+    else
+    {
+        while(!renderThreadsShouldTerminate){
+            art_task_t curr_task= pop_render_queue(&render_queue);
+            if(curr_task.type==POISON)
+                break;
+            [self render_task : &curr_task: threadIndex];
+            curr_task.type=MERGE;
+            push_merge_queue(&merge_queue, curr_task);
+        }
     }
     
     pthread_barrier_wait(&renderingDone);
 }
 
+//   Direct accumulation mode: window, and merge phase, of a ticket.
+
+- (void) directTicket
+        : (unsigned long) ticket
+        : (unsigned int *) window
+        : (unsigned long *) phase
+{
+    unsigned int   numberOfWindows = tiles_X * tiles_Y;
+    unsigned long  pass            = ticket / numberOfWindows;
+    unsigned int   position        = ticket % numberOfWindows;
+
+    *window = windowOrder[position];
+    *phase  = pass * numberOfWindowColours + colourOfPosition[position];
+}
+
+//   Marks a ticket as done - merged, or dropped - and moves the phase
+//   frontier forward as far as the finished tickets allow. Whoever
+//   finishes the last ticket of a phase, or of one of its predecessors,
+//   gets to move the frontier past it.
+
+- (void) finishDirectTicket
+        : (unsigned int) window
+        : (unsigned long) phase
+{
+    if (   streaming
+        &&    __atomic_add_fetch(
+                  & ticketsFinishedInWindow[window], 1, __ATOMIC_ACQ_REL )
+           == numberOfPasses )
+        [ self _windowIsDone : window ];
+
+    __atomic_add_fetch(
+        & ticketsFinishedInPhase[phase], 1, __ATOMIC_SEQ_CST );
+
+    unsigned long  frontier =
+        __atomic_load_n( & completedPhases, __ATOMIC_SEQ_CST );
+
+    while (    frontier < numberOfPhases
+            &&    __atomic_load_n(
+                      & ticketsFinishedInPhase[frontier], __ATOMIC_SEQ_CST )
+               == phaseSize[ frontier % numberOfWindowColours ] )
+    {
+        //   On failure, 'frontier' is reloaded, and we carry on from
+        //   wherever the other thread got to. Sequential consistency is
+        //   needed here, as the thread finishing the last ticket of a
+        //   phase and the one moving the frontier up to that phase must
+        //   not both miss each other's update.
+
+        if ( __atomic_compare_exchange_n(
+                & completedPhases, & frontier, frontier + 1,
+                NO, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ) )
+            frontier++;
+    }
+}
+
+//   Merges a tile in direct accumulation mode, if its phase is open and
+//   the merges are not paused. Returns NO if the tile has to wait.
+
+- (BOOL) tryDirectMerge
+        : (art_task_t *) task
+        : (unsigned long) phase
+{
+    if ( __atomic_load_n( & completedPhases, __ATOMIC_ACQUIRE ) < phase )
+        return NO;
+
+    if ( __atomic_load_n( & accumulationPaused, __ATOMIC_SEQ_CST ) )
+        return NO;
+
+    __atomic_add_fetch( & mergesInFlight, 1, __ATOMIC_SEQ_CST );
+
+    //   Re-check, in case a pause was requested right after the first
+    //   check: the pausing thread waits for 'mergesInFlight' to drop to
+    //   zero after setting the flag, so one of us is bound to see the
+    //   other.
+
+    if ( __atomic_load_n( & accumulationPaused, __ATOMIC_SEQ_CST ) )
+    {
+        __atomic_sub_fetch( & mergesInFlight, 1, __ATOMIC_SEQ_CST );
+        return NO;
+    }
+
+    [ self merge_task : task ];
+
+    __atomic_sub_fetch( & mergesInFlight, 1, __ATOMIC_RELEASE );
+
+    return YES;
+}
+
+//   Used by the merge thread to get exclusive access to merge_image in
+//   direct accumulation mode: no new merges are started until the
+//   accumulation is resumed, and those in progress are waited for.
+
+- (void) pauseAccumulation
+{
+    __atomic_store_n( & accumulationPaused, 1, __ATOMIC_SEQ_CST );
+
+    while ( __atomic_load_n( & mergesInFlight, __ATOMIC_SEQ_CST ) > 0 )
+        sched_yield();
+}
+
+- (void) resumeAccumulation
+{
+    __atomic_store_n( & accumulationPaused, 0, __ATOMIC_RELEASE );
+}
+
+//   Each thread owns TILE_CONSTANT tiles. A rendered tile whose phase is
+//   not yet open is kept back, and the thread renders its next ticket into
+//   another of its tiles in the meantime; it only has to wait once all of
+//   its tiles are taken. The oldest pending tile always gets merged first,
+//   and tickets are handed out in phase order, so the oldest pending tile
+//   of all threads is always mergeable, and the phases cannot get stuck.
+
+- (void) directRenderLoop
+    : (ArcUnsignedInteger *) threadIndex
+{
+    unsigned int   numberOfWindows = tiles_X * tiles_Y;
+    art_task_t     pending[TILE_CONSTANT];
+    unsigned long  pendingPhase[TILE_CONSTANT];
+    unsigned int   firstPending    = 0;
+    unsigned int   numberOfPending = 0;
+    BOOL           moreTickets     = YES;
+
+    while ( ! renderThreadsShouldTerminate )
+    {
+        //   Merge whatever can be merged, oldest first.
+
+        while ( numberOfPending > 0 )
+        {
+            art_task_t     * task  = & pending[firstPending];
+            unsigned long    phase = pendingPhase[firstPending];
+
+            if ( ! [ self tryDirectMerge : task : phase ] )
+                break;
+
+            [ self finishDirectTicket
+                :   (unsigned int) ( task->window - render_windows )
+                :   phase
+                ];
+
+            if ( tev->connected )
+            {
+                art_task_t  refresh;
+
+                refresh.type   = TEV_REFRESH;
+                refresh.window = task->window;
+
+                push_merge_queue( & merge_queue, refresh );
+            }
+
+            firstPending = ( firstPending + 1 ) % TILE_CONSTANT;
+            numberOfPending--;
+        }
+
+        if ( ! moreTickets || numberOfPending == TILE_CONSTANT )
+        {
+            if ( numberOfPending == 0 )
+                break;
+
+            sched_yield();
+            continue;
+        }
+
+        unsigned long  ticket =
+            __atomic_fetch_add( & nextRenderTicket, 1, __ATOMIC_RELAXED );
+
+        if ( ticket >= numberOfRenderTickets )
+        {
+            moreTickets = NO;
+            continue;
+        }
+
+        unsigned int   window;
+        unsigned long  phase;
+
+        [ self directTicket : ticket : & window : & phase ];
+
+        unsigned int  samples, sampleStart;
+
+        direct_pass_samples(
+              ticket / numberOfWindows,
+              overallNumberOfSamplesPerPixel,
+            & samples,
+            & sampleStart
+            );
+
+        //   Whoever draws the last ticket of a pass reports it, which is
+        //   what the queue mode does when it issues the last window.
+
+        if ( ticket % numberOfWindows == numberOfWindows - 1 )
+        {
+            pthread_mutex_lock( & sampleCounterLock );
+            [ sampleCounter step
+                :   samples
+                ];
+            pthread_mutex_unlock( & sampleCounterLock );
+        }
+
+        //   Adaptive sampling: the tickets of converged windows are
+        //   dropped, and once all windows have converged, no further
+        //   tickets are drawn.
+
+        if ( noiseThreshold > 0.0 )
+        {
+            if ( __atomic_load_n( & numberOfActiveWindows, __ATOMIC_RELAXED ) == 0 )
+                moreTickets = NO;
+
+            if (   ! moreTickets
+                || __atomic_load_n(
+                       & activePixelsInWindow[window], __ATOMIC_RELAXED ) == 0 )
+            {
+                [ self finishDirectTicket : window : phase ];
+                continue;
+            }
+        }
+
+        unsigned int   slot = ( firstPending + numberOfPending ) % TILE_CONSTANT;
+        art_task_t   * task = & pending[slot];
+
+        task->type         = RENDER;
+        task->work_tile    = & tiles[ THREAD_INDEX * TILE_CONSTANT + slot ];
+        task->window       = & render_windows[window];
+        task->samples      = samples;
+        task->sample_start = sampleStart;
+
+        [ self render_task : task : threadIndex ];
+
+        pendingPhase[slot] = phase;
+        numberOfPending++;
+    }
+
+    //   Partially rendered tiles, and tiles that are still pending when
+    //   the rendering is cut short, are dropped, as in the queue mode.
+}
+
 typedef struct ArPixelID
 {
     long   globalRandomSeed;
@@ -963,6 +1441,21 @@ ArPixelID;
         ALLOC_ARRAY( ArPathspaceResult *, numberOfImagesToWrite );
     
     ArPixelID  px_id;
+    unsigned long  renderedSamples = 0;
+
+    //   Counter-based generators are keyed by pixel and sample index
+    //   directly, and are queried without message dispatch.
+
+    ArRandomPhilox  * philox = NULL;
+
+    if ( counterBasedRandomGeneration )
+        philox =
+            [ (ArcPhiloxRandomGenerator *) THREAD_RANDOM_GENERATOR philoxState ];
+
+    BOOL  pixelSampleRandomGeneration =
+        [ THREAD_RANDOM_GENERATOR conformsToProtocol
+            :   @protocol(ArpPixelSampleRandomGenerator)
+            ];
 
     px_id.threadIndex = THREAD_INDEX;
     px_id.globalRandomSeed = arrandom_global_seed(art_gv);
@@ -970,19 +1463,48 @@ ArPixelID;
         YC(px_id.pixelCoord) = y ;    
         for (int x=XC(t->window->start); x<XC(t->window->end); x++) {
             XC(px_id.pixelCoord) = x;
-            if(!unfinished[x + y*XC(imageSize)])
+            if ( ! __atomic_load_n(
+                       & unfinished[x + y*XC(imageSize)], __ATOMIC_RELAXED ) )
                 continue;
             for(int sample=0;sample<t->samples;sample++){
                 px_id.sampleIndex = t->sample_start  +sample;
                 int  subpixelIdx = (px_id.sampleIndex) % numberOfSubpixelSamples;
                 if ( renderThreadsShouldTerminate )
                     goto FREE_SAMPLE_VALUE;
+                renderedSamples++;
+
+                //   Adaptive sampling: norm of the sample, summed over all
+                //   wavelength steps
+
+                double        sampleNorm = 0.0;
+                unsigned int  validSteps = 0;
                 
                 for ( int w = 0; w < wavelengthSteps; w++ )
                 {
-                    [ THREAD_RANDOM_GENERATOR reInitializeWith
-                        :   crc32_of_data( & px_id, sizeof(ArPixelID) )
-                        ];
+                    if ( philox )
+                    {
+                        arrandom_philox_set_pixel_sample(
+                            philox,
+                            x,
+                            y,
+                            px_id.sampleIndex
+                            );
+                    }
+                    else if ( pixelSampleRandomGeneration )
+                    {
+                        [ (ArcRandomGenerator <ArpPixelSampleRandomGenerator> *)
+                            THREAD_RANDOM_GENERATOR reInitializeWithPixel
+                            :   x
+                            :   y
+                            :   px_id.sampleIndex
+                            ];
+                    }
+                    else
+                    {
+                        [ THREAD_RANDOM_GENERATOR reInitializeWith
+                            :   crc32_of_data( & px_id, sizeof(ArPixelID) )
+                            ];
+                    }
 
                     /* --------------------------------------------------------------
                         We double-check whether a given sample should be
@@ -999,9 +1521,16 @@ ArPixelID;
 
                     BOOL  validSample = FALSE;
 
-                    [ THREAD_RANDOM_GENERATOR setCurrentSequenceID
-                        :  startingSequenceID
-                        ];
+                    if ( philox )
+                    {
+                        ARRANDOM_PHILOX_DIMENSION( philox ) = startingSequenceID;
+                    }
+                    else
+                    {
+                        [ THREAD_RANDOM_GENERATOR setCurrentSequenceID
+                            :  startingSequenceID
+                            ];
+                    }
 
                     Ray3D              ray;
                     ArReferenceFrame   referenceFrame;
@@ -1020,7 +1549,9 @@ ArPixelID;
                         arwavelength_sd_init_w(
                               art_gv,
                             & spectralSamplingData,
-                              [ THREAD_RANDOM_GENERATOR valueFromNewSequence ],
+                              philox
+                            ? arrandom_philox_double( philox )
+                            : [ THREAD_RANDOM_GENERATOR valueFromNewSequence ],
                             & wavelength
                             );
                     }
@@ -1085,6 +1616,17 @@ ArPixelID;
                         int xc=x-XC(t->window->start);
                         int yc=y-YC(t->window->start);
                         IVec2D size=t->work_tile->size;
+
+                        if ( t->work_tile->moments )
+                        {
+                            sampleNorm +=
+                                arlightalphasample_l_norm(
+                                    art_gv,
+                                    ARPATHSPACERESULT_LIGHTALPHASAMPLE(*sampleValue[0])
+                                    );
+                            validSteps++;
+                        }
+
                         if ( splattingKernelWidth == 1 )
                         {
                             for ( unsigned int im = 0; im < numberOfImagesToWrite; im++ )
@@ -1143,12 +1685,27 @@ ArPixelID;
                             );
                     }
                 }
+
+                if ( validSteps > 0 )
+                {
+                    int  mx = x - XC(t->window->start) + splattingKernelOffset;
+                    int  my = y - YC(t->window->start) + splattingKernelOffset;
+
+                    double  * moments =
+                        t->work_tile->moments
+                        + 3 * ( mx + my * XC(t->work_tile->size) );
+
+                    moments[0] += 1.0;
+                    moments[1] += sampleNorm;
+                    moments[2] += M_SQR( sampleNorm );
+                }
             }
         }
     }
     
 
     FREE_SAMPLE_VALUE:
+    samplesRenderedByThread[THREAD_INDEX] += renderedSamples;
     FREE_ARRAY(sampleValue);
 }
 
@@ -1174,6 +1731,10 @@ ArPixelID;
                 case MERGE:
                     [self merge_task : &curr_task];
                     [self tev_task : &curr_task];
+                    if ( streaming )
+                        [self _queueTaskMerged
+                            :   (unsigned int) ( curr_task.window - render_windows )
+                            ];
                     if([self make_task: &curr_task]){
                         push_render_queue(&render_queue, curr_task);
                     }
@@ -1198,6 +1759,16 @@ ArPixelID;
                     [self writeImage];
                 case POISON:
                     goto END;
+                case TEV_REFRESH:
+                    [self pauseAccumulation];
+                    [self tev_task : &curr_task];
+                    [self resumeAccumulation];
+                    break;
+                case STREAM_WINDOW:
+                    [self _streamFinalWindow
+                        :   (unsigned int) ( curr_task.window - render_windows )
+                        ];
+                    break;
                 case TEV_CONNECT:
                     if([tev tryConnection]){
                         for (size_t i =0; i<numberOfImagesToWrite; i++) {
@@ -1219,32 +1790,108 @@ ArPixelID;
 -(void) merge_task
     :(art_task_t*) t
 {
+    if ( t->work_tile->moments )
+        [self merge_moments : t];
+
     IVec2D size=t->work_tile->size;
+
+    //   Tile position in the image, and the part of each tile row that
+    //   actually lies within the image
+
+    int tX=XC(t->window->start)-splattingKernelOffset;
+    int tY=YC(t->window->start)-splattingKernelOffset;
+    int x0=MAX(0,-tX);
+    int x1=MIN(XC(size),XC(imageSize)-tX);
+
+    if ( x1 <= x0 )
+        return;
+
     for ( unsigned int im = 0; im < numberOfImagesToWrite; im++ ){
         for (int y=0; y<YC(size); y++) {
-            for (int x=0; x<XC(size); x++) {
-                int cX=XC(t->window->start)-splattingKernelOffset+x;
-                int cY=YC(t->window->start)-splattingKernelOffset+y;
-                if (   cX >= 0
-                    && cX < XC(imageSize)
-                    && cY >= 0
-                    && cY < YC(imageSize) )
-                {
-                    merge_image.samples[
-                        cX+cY*XC(imageSize)+im*XC(imageSize)*YC(imageSize)
-                        ]+=
-                        t->work_tile->samples[im*XC(size)*YC(size)+x+y*XC(size)];
-                    
-                    
-                    arlightalpha_l_add_l(
-                        art_gv, 
-                        t->work_tile->image[im]->data[x+y*XC(size)], 
-                        merge_image.image[im]->data[cX+cY*XC(imageSize)]);
-                }
+            int cY=tY+y;
+            if ( cY < 0 || cY >= YC(imageSize) )
+                continue;
+
+            unsigned long src=x0+y*XC(size);
+            unsigned long dst=tX+x0+cY*XC(imageSize);
+
+            double * srcSamples=
+                t->work_tile->samples+im*XC(size)*YC(size)+src;
+            double * dstSamples=
+                merge_image.samples+im*XC(imageSize)*YC(imageSize)+dst;
+
+            for (int x=0; x<x1-x0; x++)
+                dstSamples[x]+=srcSamples[x];
+
+            arlightalphaframebuffer_add(
+                    art_gv,
+                  & t->work_tile->image[im]->framebuffer,
+                    src,
+                  & merge_image.image[im]->framebuffer,
+                    dst,
+                    x1-x0
+                );
+        }
+    }
+}
+//   Adaptive sampling: merges the noise estimates of the pixels of a
+//   window, and takes those pixels out of the rendering that have
+//   converged. Called under the same conditions as merge_task, so nobody
+//   else merges into the moments of this window in the meantime. Render
+//   threads with later tasks on the same window do read the 'unfinished'
+//   flags concurrently though, so these are accessed atomically; a
+//   render task that still sees a pixel as unfinished just spends a few
+//   more samples on it.
+
+-(void) merge_moments
+    :(art_task_t*) t
+{
+    IVec2D        size   = t->work_tile->size;
+    unsigned int  window = (unsigned int) ( t->window - render_windows );
+
+    for ( int y = YC(t->window->start); y < YC(t->window->end); y++ )
+    {
+        for ( int x = XC(t->window->start); x < XC(t->window->end); x++ )
+        {
+            size_t  idx = x + y*XC(imageSize);
+
+            if ( ! __atomic_load_n( & unfinished[idx], __ATOMIC_RELAXED ) )
+                continue;
+
+            int  mx = x - XC(t->window->start) + splattingKernelOffset;
+            int  my = y - YC(t->window->start) + splattingKernelOffset;
+
+            double  * src = t->work_tile->moments + 3 * ( mx + my*XC(size) );
+            double  * dst = merge_image.moments + 3 * idx;
+
+            dst[0] += src[0];
+            dst[1] += src[1];
+            dst[2] += src[2];
+
+            double  n = dst[0];
+
+            if ( n < ADAPTIVE_SAMPLING_MINIMUM_SAMPLES )
+                continue;
+
+            double  mean     = dst[1] / n;
+            double  variance = MAX( ( dst[2] - dst[1] * mean ) / ( n - 1.0 ), 0.0 );
+
+            //   Standard error of the pixel mean, relative to the mean;
+            //   written as a product so that black pixels converge, too.
+
+            if ( sqrt( variance / n ) <= noiseThreshold * mean )
+            {
+                __atomic_store_n( & unfinished[idx], NO, __ATOMIC_RELAXED );
+
+                if ( __atomic_sub_fetch(
+                        & activePixelsInWindow[window], 1, __ATOMIC_RELAXED ) == 0 )
+                    __atomic_sub_fetch(
+                        & numberOfActiveWindows, 1, __ATOMIC_RELAXED );
             }
         }
     }
 }
+
 -(void) tev_task
     :(art_task_t*) t
 {
@@ -1317,157 +1964,323 @@ ArPixelID;
     }
     
 }
-- (void)writeImage
+//   Streaming: a window is done once its own tile will not be merged again,
+//   and final once all windows within reach of the splatting kernel around
+//   it, itself included, are done. Called from the render threads in direct
+//   accumulation mode, hence the atomics; final windows are then handed to
+//   the merge thread, which does all the writing.
+
+- (void) _windowIsDone
+        : (unsigned int) window
 {
-   
-    unsigned int  overallNumberOfPixels = YC(imageSize) * XC(imageSize);
-    double writeThreadWallClockDuration;
-    
+    int  wx = window % tiles_X;
+    int  wy = window / tiles_X;
 
-    for ( unsigned int imgIdx = 0; imgIdx < numberOfImagesToWrite; imgIdx++ )
+    for ( int y = MAX( wy - (int) streamReachY, 0 );
+          y <= MIN( wy + (int) streamReachY, (int) tiles_Y - 1 );
+          y++ )
     {
-        //   first, we figure out the average number of samples per pixel
-        //   this goes into the image statistics that are saved
-        //   along with the command line
-        
-        unsigned int  maxSamples = 0;
-        unsigned int  minSamples = 0xffffffff;
-
-        unsigned long int  overallSampleCount = 0;
-        unsigned long int  nonzeroPixels = 0;
-        
-        for ( int y = 0; y < YC(imageSize); y++ )
+        for ( int x = MAX( wx - (int) streamReachX, 0 );
+              x <= MIN( wx + (int) streamReachX, (int) tiles_X - 1 );
+              x++ )
         {
-            for ( int x = 0; x < XC(imageSize); x++ )
+            unsigned int  neighbour = y * tiles_X + x;
+
+            //   The neighbourhood is symmetric, so the number of windows
+            //   within reach of 'neighbour' is also the number of windows
+            //   whose tiles reach it.
+
+            unsigned int  numberOfNeighbours =
+                  ( MIN( x + (int) streamReachX, (int) tiles_X - 1 )
+                  - MAX( x - (int) streamReachX, 0 ) + 1 )
+                * ( MIN( y + (int) streamReachY, (int) tiles_Y - 1 )
+                  - MAX( y - (int) streamReachY, 0 ) + 1 );
+
+            if (    __atomic_add_fetch(
+                        & doneNeighbours[neighbour], 1, __ATOMIC_ACQ_REL )
+                 != numberOfNeighbours )
+                continue;
+
+            if ( directAccumulation )
             {
-                unsigned int  pixelSampleCount = 0;
-                size_t idx=x +y*XC(imageSize);
-                //ASK: this is weird... why are we doing this with int and not doubles???
-                pixelSampleCount +=merge_image.samples[ 
-                    imgIdx*XC(imageSize) * YC(imageSize) + idx];
-                
-                if ( pixelSampleCount > 0 )
-                {
-                    nonzeroPixels++;
-                
-                    if ( pixelSampleCount < minSamples )
-                        minSamples = pixelSampleCount;
-                    
-                    overallSampleCount += pixelSampleCount;
-                }
-                
-                if ( pixelSampleCount > maxSamples )
-                    maxSamples = pixelSampleCount;
+                art_task_t  task;
+
+                task.type   = STREAM_WINDOW;
+                task.window = & render_windows[neighbour];
+
+                push_merge_queue( & merge_queue, task );
             }
+            else
+                [ self _streamFinalWindow : neighbour ];
         }
+    }
+}
 
-        unsigned int  avgSamples = 0;
-        
-        if ( nonzeroPixels > 0 )
+//   Streaming, queue mode: called by the merge thread for each merged
+//   task. A window is done once its last task has been issued and merged,
+//   or once all of its pixels have converged.
+
+- (void) _queueTaskMerged
+        : (unsigned int) window
+{
+    tasksInFlight[window]--;
+
+    if (   ! windowDone[window]
+        && tasksInFlight[window] == 0
+        && (   lastTaskIssued[window]
+            || ( noiseThreshold > 0.0 && activePixelsInWindow[window] == 0 ) ) )
+    {
+        windowDone[window] = YES;
+
+        [ self _windowIsDone : window ];
+    }
+}
+
+//   Writes the pixels of a window to all streamed result images.
+
+- (void) _streamWindow
+        : (unsigned int) windowIndex
+{
+    image_window_t  * window = & render_windows[windowIndex];
+    unsigned long     overallNumberOfPixels = XC(imageSize) * YC(imageSize);
+    int               width = XC(window->end) - XC(window->start);
+
+    for ( unsigned int imgIdx = 0; imgIdx < numberOfImagesToWrite; imgIdx++ )
+    {
+        if ( ! streamOutput[imgIdx] )
+            continue;
+
+        for ( int y = YC(window->start); y < YC(window->end); y++ )
         {
-            avgSamples = (unsigned int)
-                ( (double) overallSampleCount / (double) nonzeroPixels );
+            unsigned long  src = XC(window->start) + y * XC(imageSize);
+
+            arlightalphaframebuffer_div_samples(
+                    art_gv,
+                  & merge_image.image[imgIdx]->framebuffer,
+                    src,
+                    merge_image.samples + imgIdx*overallNumberOfPixels + src,
+                  & streamImage->framebuffer,
+                    ( y - YC(window->start) ) * XC(tile_size),
+                    width
+                );
         }
-        
-        char  * samplecountString = NULL;
-        
-        double  percentageOfZeroPixels =
-            ( 1.0 - ( 1.0 * nonzeroPixels / overallNumberOfPixels )) * 100.0;
 
-        if ( percentageOfZeroPixels > 1.0 )
+        //   Border windows are smaller than 'streamImage'; the parts of it
+        //   that lie outside the image are ignored.
+
+        [ outputImage[imgIdx] setPlainImage
+            :   window->start
+            :   streamImage
+            ];
+    }
+
+    windowStreamed[windowIndex] = YES;
+    numberOfStreamedWindows++;
+}
+
+//   The header of a streamed file is written along with its first window,
+//   and carries the image statistics of that moment.
+
+- (void) _streamFinalWindow
+        : (unsigned int) windowIndex
+{
+    if ( numberOfStreamedWindows == 0 )
+    {
+        if ( directAccumulation )
+            [ self pauseAccumulation ];
+
+        for ( unsigned int imgIdx = 0; imgIdx < numberOfImagesToWrite; imgIdx++ )
+            if ( streamOutput[imgIdx] )
+                [ self _setImageStatistics : imgIdx ];
+
+        if ( directAccumulation )
+            [ self resumeAccumulation ];
+    }
+
+    //   Nobody merges into a final window any more, so there is no need
+    //   to pause the direct accumulation while it is written.
+
+    [ self _streamWindow : windowIndex ];
+}
+
+- (void) _setImageStatistics
+        : (unsigned int) imgIdx
+{
+    unsigned int  overallNumberOfPixels = YC(imageSize) * XC(imageSize);
+    double writeThreadWallClockDuration;
+
+    //   first, we figure out the average number of samples per pixel
+    //   this goes into the image statistics that are saved
+    //   along with the command line
+    
+    unsigned int  maxSamples = 0;
+    unsigned int  minSamples = 0xffffffff;
+
+    unsigned long int  overallSampleCount = 0;
+    unsigned long int  nonzeroPixels = 0;
+
+    for ( int y = 0; y < YC(imageSize); y++ )
+    {
+        for ( int x = 0; x < XC(imageSize); x++ )
         {
-            if ( nonzeroPixels > 0 )
-            {
-                asprintf(
-                    & samplecountString,
-                        "%.0f%% pixels with zero samples,"
-                        " rest: %d/%d/%d min/avg/max spp",
-                        percentageOfZeroPixels,
-                        minSamples,
-                        avgSamples,
-                        maxSamples
-                    );
-            }
-            else
+            unsigned int  pixelSampleCount = 0;
+            size_t idx=x +y*XC(imageSize);
+            //ASK: this is weird... why are we doing this with int and not doubles???
+            pixelSampleCount +=merge_image.samples[ 
+                imgIdx*XC(imageSize) * YC(imageSize) + idx];
+            
+            if ( pixelSampleCount > 0 )
             {
-                asprintf(
-                    & samplecountString,
-                        "0 spp"
-                    );
+                nonzeroPixels++;
+            
+                if ( pixelSampleCount < minSamples )
+                    minSamples = pixelSampleCount;
+                
+                overallSampleCount += pixelSampleCount;
             }
+            
+            if ( pixelSampleCount > maxSamples )
+                maxSamples = pixelSampleCount;
         }
-        else
+    }
+
+    unsigned int  avgSamples = 0;
+    
+    if ( nonzeroPixels > 0 )
+    {
+        avgSamples = (unsigned int)
+            ( (double) overallSampleCount / (double) nonzeroPixels );
+    }
+    
+    char  * samplecountString = NULL;
+    
+    double  percentageOfZeroPixels =
+        ( 1.0 - ( 1.0 * nonzeroPixels / overallNumberOfPixels )) * 100.0;
+
+    if ( percentageOfZeroPixels > 1.0 )
+    {
+        if ( nonzeroPixels > 0 )
         {
             asprintf(
                 & samplecountString,
-                    "%d/%d/%d min/avg/max spp",
+                    "%.0f%% pixels with zero samples,"
+                    " rest: %d/%d/%d min/avg/max spp",
+                    percentageOfZeroPixels,
                     minSamples,
                     avgSamples,
                     maxSamples
                 );
         }
+        else
+        {
+            asprintf(
+                & samplecountString,
+                    "0 spp"
+                );
+        }
+    }
+    else
+    {
+        asprintf(
+            & samplecountString,
+                "%d/%d/%d min/avg/max spp",
+                minSamples,
+                avgSamples,
+                maxSamples
+            );
+    }
 
-        [ outputImage[imgIdx] setSamplecountString
-            :   samplecountString
-            ];
-        
-        FREE( samplecountString );
+    [ outputImage[imgIdx] setSamplecountString
+        :   samplecountString
+        ];
+    
+    FREE( samplecountString );
 
-        artime_now( & endTime );
+    artime_now( & endTime );
 
-        writeThreadWallClockDuration =
-                artime_seconds( & endTime )
-            - artime_seconds( & beginTime);
+    writeThreadWallClockDuration =
+            artime_seconds( & endTime )
+        - artime_seconds( & beginTime);
 
-        char  * rendertimeString = NULL;
-        
-        asprintf(
-            & rendertimeString,
-                "%.0f seconds",
-                writeThreadWallClockDuration
-            );
+    char  * rendertimeString = NULL;
+    
+    asprintf(
+        & rendertimeString,
+            "%.0f seconds",
+            writeThreadWallClockDuration
+        );
 
-        [ outputImage[imgIdx] setRendertimeString
-            :   rendertimeString
-            ];
-        
-        FREE( rendertimeString );
-        
-        for ( int y = 0; y < YC(imageSize); y++ )
-        {
-            for ( int x = 0; x < XC(imageSize); x++ )
-            {
-                size_t idx=XC(imageSize)*y+x;
-                arlightalpha_l_init_l(
-                        art_gv,
-                        ARLIGHTALPHA_NONE_A0,
-                        out->data[idx]
-                    );
-                arlightalpha_l_add_l(
-                        art_gv,
-                        merge_image.image[imgIdx]->data[idx],
-                        out->data[idx]
-                    );
-                double  pixelSampleCount = merge_image.samples[ imgIdx*overallNumberOfPixels + idx];
+    [ outputImage[imgIdx] setRendertimeString
+        :   rendertimeString
+        ];
+    
+    FREE( rendertimeString );
+}
 
+- (void)writeImage
+{
+   
+    unsigned int  overallNumberOfPixels = YC(imageSize) * XC(imageSize);
 
-                if ( pixelSampleCount > 0.0 )
-                {
-                    arlightalpha_d_mul_l(
-                            art_gv,
-                            1.0 / pixelSampleCount,
-                            out->data[idx]
-                        );
-                }
-            }
+    for ( unsigned int imgIdx = 0; imgIdx < numberOfImagesToWrite; imgIdx++ )
+    {
+        //   Streamed images only get written window by window: writing all
+        //   of them in between would finalise the file. Their finished
+        //   windows are in the file already, which can be read as it is.
+
+        if ( streamOutput[imgIdx] && ! renderThreadsShouldTerminate )
+            continue;
+
+        //   In direct accumulation mode the render threads keep merging
+        //   into merge_image while we read it.
+
+        if ( directAccumulation )
+            [ self pauseAccumulation ];
+
+        [ self _setImageStatistics : imgIdx ];
+
+        if ( ! streamOutput[imgIdx] )
+            arlightalphaframebuffer_div_samples(
+                    art_gv,
+                  & merge_image.image[imgIdx]->framebuffer,
+                    0,
+                    merge_image.samples + imgIdx*overallNumberOfPixels,
+                  & out->framebuffer,
+                    0,
+                    overallNumberOfPixels
+                );
 
-        }
-        [ outputImage[imgIdx] setPlainImage
-            :   IPNT2D(0,0)
-            :   out
-            ];
+        if ( directAccumulation )
+            [ self resumeAccumulation ];
+
+        if ( ! streamOutput[imgIdx] )
+            [ outputImage[imgIdx] setPlainImage
+                :   IPNT2D(0,0)
+                :   out
+                ];
+    }
+
+    //   On exit, the windows of the streamed images that did not become
+    //   final - because the rendering was cut short, or because all pixels
+    //   converged early - are written as they are, which completes the
+    //   files.
+
+    if (   streaming
+        && renderThreadsShouldTerminate
+        && numberOfStreamedWindows < tiles_X * tiles_Y )
+    {
+        if ( directAccumulation )
+            [ self pauseAccumulation ];
+
+        for ( unsigned int i = 0; i < tiles_X * tiles_Y; i++ )
+            if ( ! windowStreamed[i] )
+                [ self _streamWindow : i ];
+
+        if ( directAccumulation )
+            [ self resumeAccumulation ];
     }
 }
+
 - (void) terminalIOThread
     : (ArcUnsignedInteger *) threadIndex
 {
@@ -1649,6 +2462,39 @@ ArPixelID;
 
     RELEASE_OBJECT( sampleCounter );
     RELEASE_OBJECT(messageQueue);
+
+    //   The sample counter prints this when it is released, so it has to
+    //   stay around until now.
+
+    if ( postSamplingMessage )
+    {
+        FREE( postSamplingMessage );
+        postSamplingMessage = NULL;
+    }
+
+    if ( directAccumulation )
+    {
+        FREE_ARRAY( windowOrder );
+        FREE_ARRAY( colourOfPosition );
+        FREE_ARRAY( phaseSize );
+        FREE_ARRAY( ticketsFinishedInPhase );
+        pthread_mutex_destroy( & sampleCounterLock );
+    }
+
+    FREE_ARRAY( samplesRenderedByThread );
+
+    if ( streaming )
+    {
+        FREE_ARRAY( ticketsFinishedInWindow );
+        FREE_ARRAY( tasksInFlight );
+        FREE_ARRAY( lastTaskIssued );
+        FREE_ARRAY( windowDone );
+        FREE_ARRAY( doneNeighbours );
+        FREE_ARRAY( windowStreamed );
+        RELEASE_OBJECT( streamImage );
+    }
+
+    FREE_ARRAY( streamOutput );
     
     FREE_ARRAY(preSamplingMessage);
 
@@ -1686,6 +2532,9 @@ ArPixelID;
     FREE_ARRAY(unfinished);
     FREE_ARRAY(render_windows);
 
+    if ( noiseThreshold > 0.0 )
+        FREE_ARRAY(activePixelsInWindow);
+
     RELEASE_OBJECT(tev);
     FREE_ARRAY(tev_update_tile);
 
@@ -1831,7 +2680,10 @@ ArPixelID;
 
 - (const char *) postSamplingMessage
 {
-    return "---   interactive mode off   ---\n";
+    if ( postSamplingMessage )
+        return postSamplingMessage;
+    else
+        return "---   interactive mode off   ---\n";
 }
 
 - (void) code
@@ -1840,8 +2692,23 @@ ArPixelID;
     [ super code: coder ];
 
     [ coder codeUInt: & overallNumberOfSamplesPerPixel ];
-    [ coder codeInt:  & randomValueGeneration ];
+
+    int  codedRandomValueGeneration = randomValueGeneration;
+
+    if ( noiseThreshold > 0.0 )
+        codedRandomValueGeneration |= ADAPTIVE_SAMPLING_CODED_FLAG;
+
+    [ coder codeInt:  & codedRandomValueGeneration ];
+
+    randomValueGeneration =
+        codedRandomValueGeneration & ~ADAPTIVE_SAMPLING_CODED_FLAG;
+
     [ coder codeBOOL: & deterministicWavelengths ];
+
+    if ( codedRandomValueGeneration & ADAPTIVE_SAMPLING_CODED_FLAG )
+        [ coder codeDouble: & noiseThreshold ];
+    else
+        noiseThreshold = 0.0;
     
     if ( [ coder isReading ] )
     {
@@ -1858,4 +2725,17 @@ ArPixelID;
     art_set_hero_samples_to_splat( art_gv, 1 );
 }
 
+- (void) useDirectAccumulation
+        : (BOOL) newDirectAccumulation
+{
+    directAccumulation    = newDirectAccumulation;
+    accumulationModeFixed = YES;
+}
+
+- (void) useAdaptiveSampling
+        : (double) newNoiseThreshold
+{
+    noiseThreshold = newNoiseThreshold;
+}
+
 @end
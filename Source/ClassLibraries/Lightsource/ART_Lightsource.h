@@ -34,6 +34,7 @@ ART_LIBRARY_INTERFACE(ART_Lightsource)
 #import "ArcPointLightsource.h"
 #import "ArcSkydomeLightsource.h"
 #import "ArcComplexSkydomeLightsource.h"
+#import "ArSkydomeDistribution.h"
 
 #import "ArnLightsourceCollection.h"
 #import "ArnLightsourceCollector.h"
@@ -36,6 +36,7 @@ ART_LIBRARY_INITIALISATION_FUNCTION
     ART_PERFORM_MODULE_INITIALISATION( ArcPointLightsource )
     ART_PERFORM_MODULE_INITIALISATION( ArcSkydomeLightsource )
     ART_PERFORM_MODULE_INITIALISATION( ArcComplexSkydomeLightsource )
+    ART_PERFORM_MODULE_INITIALISATION( ArSkydomeDistribution )
     ART_PERFORM_MODULE_INITIALISATION( ArnLightsourceCollection )
     ART_PERFORM_MODULE_INITIALISATION( ArnLightsourceCollector )
 )
@@ -0,0 +1,127 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+#include "ART_Foundation.h"
+
+ART_MODULE_INTERFACE(ArSkydomeDistribution)
+
+#import "ART_Scenegraph.h"
+
+@class ArcPointContext;
+
+/* ---------------------------------------------------------------------------
+    'ArSkydomeDistribution'
+        Tabulated directional distribution of the radiance of a sky dome
+        (excluding the solar disc), used to importance sample the sky
+        instead of picking directions uniformly on the hemisphere. At low
+        solar elevations, nearly all of the sky radiance comes from the
+        circumsolar region and the horizon near the sun; uniform samples
+        mostly end up in the dark parts of the sky.
+
+        The upper hemisphere of the skydome coordinate system is mapped
+        to the unit square via (azimuth / 2 pi, cos zenith angle). This
+        mapping preserves area, so all cells of the table cover the same
+        solid angle, and the density with respect to solid angle is just
+        that on the unit square divided by 2 pi.
+
+        The sky is not the same colour everywhere, so there is one table
+        per wavelength band. Directions for a wavelength sample are drawn
+        from the table of its hero wavelength. To keep the estimator
+        unbiased in regions the tables do not capture (e.g. at altitudes
+        other than the one they were built for), each cell gets a fixed
+        share of the average radiance of the sky added to its weight.
+
+        'skyFraction' is the probability that a direction drawn from the
+        table of a band does not lie on the solar disc - samples which
+        land on the sun are rejected by the sampling code, so the density
+        of the accepted ones is higher by this factor.
+--------------------------------------------------------------------------- */
+
+typedef struct ArSkydomeDistribution
+{
+    unsigned int        numberOfBands;
+    double              bandRangeStart;
+    double              bandWidth;
+    ArDistribution2D  * band;
+    double            * skyFraction;
+}
+ArSkydomeDistribution;
+
+void arskydomedistribution_init(
+        const ART_GV                           * art_gv,
+              ArSkydomeDistribution            * distribution,
+              ArNode <ArpEnvironmentMaterial>  * skyEmitter,
+              ArcPointContext                  * queryLocation,
+        const HTrafo3D                         * skydome2world,
+        const Vec3D                            * sunDirection,
+        const double                             areaOfSolarCap
+        );
+
+ArSkydomeDistribution arskydomedistribution_copy(
+        const ArSkydomeDistribution  * distribution
+        );
+
+void arskydomedistribution_free_contents(
+        ArSkydomeDistribution  * distribution
+        );
+
+//   Index of the table that is used for the given wavelength sample
+
+unsigned int arskydomedistribution_band(
+        const ArSkydomeDistribution  * distribution,
+        const ArWavelength           * wavelength
+        );
+
+/* ---------------------------------------------------------------------------
+    'arskydomedistribution_sample'
+        Maps two uniform random numbers to a direction on the upper
+        hemisphere (in skydome coordinates), and returns its density
+        with respect to solid angle - already divided by the sky fraction
+        of the band, i.e. valid for samples that are not on the sun.
+--------------------------------------------------------------------------- */
+
+double arskydomedistribution_sample(
+        const ArSkydomeDistribution  * distribution,
+        const unsigned int             band,
+        const double                   u0,
+        const double                   u1,
+              Vec3D                  * localDirection
+        );
+
+/* ---------------------------------------------------------------------------
+    'arskydomedistribution_pdf'
+        Density with respect to solid angle for the given (normalised)
+        direction in skydome coordinates, as it would be returned by
+        'arskydomedistribution_sample'. Zero below the horizon.
+--------------------------------------------------------------------------- */
+
+double arskydomedistribution_pdf(
+        const ArSkydomeDistribution  * distribution,
+        const unsigned int             band,
+        const Vec3D                  * localDirection
+        );
+
+// ===========================================================================
@@ -0,0 +1,299 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+#define ART_MODULE_NAME     ArSkydomeDistribution
+
+#import "ArSkydomeDistribution.h"
+#import "ArcSkydomeLightsource.h"
+
+ART_NO_MODULE_INITIALISATION_FUNCTION_NECESSARY
+
+ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
+
+//   Table resolution: azimuth cells are about 5.6 degrees wide, zenith
+//   cells get narrower towards the horizon, where the sky changes fastest
+//   at low solar elevations.
+
+#define SKYDOME_DISTRIBUTION_AZIMUTH_CELLS      64
+#define SKYDOME_DISTRIBUTION_ZENITH_CELLS       32
+#define SKYDOME_DISTRIBUTION_BANDS              8
+
+//   Fraction of the average sky radiance that is added to each cell
+
+#define SKYDOME_DISTRIBUTION_UNIFORM_FRACTION   0.1
+
+//   Lower limit for the sky fraction, just in case the sun falls into a
+//   very bright cell of a tiny table
+
+#define SKYDOME_DISTRIBUTION_MIN_SKY_FRACTION   0.01
+
+void arskydomedistribution_init(
+        const ART_GV                           * art_gv,
+              ArSkydomeDistribution            * distribution,
+              ArNode <ArpEnvironmentMaterial>  * skyEmitter,
+              ArcPointContext                  * queryLocation,
+        const HTrafo3D                         * skydome2world,
+        const Vec3D                            * sunDirection,
+        const double                             areaOfSolarCap
+        )
+{
+    const unsigned int  width  = SKYDOME_DISTRIBUTION_AZIMUTH_CELLS;
+    const unsigned int  height = SKYDOME_DISTRIBUTION_ZENITH_CELLS;
+    const unsigned int  bands  = SKYDOME_DISTRIBUTION_BANDS;
+
+    //   The bands evenly split the range of the spectra the sky emitter
+    //   returns, and each of its channels is added to the band its centre
+    //   lies in.
+
+    unsigned int  channels    = s500_channels( art_gv );
+    unsigned int  lastChannel = channels - 1;
+
+    distribution->numberOfBands  = bands;
+    distribution->bandRangeStart = s500_channel_lower_bound( art_gv, 0 );
+    distribution->bandWidth      =
+        (   s500_channel_lower_bound( art_gv, lastChannel )
+          + s500_channel_width( art_gv, lastChannel )
+          - distribution->bandRangeStart ) / bands;
+
+    unsigned int  * bandOfChannel = ALLOC_ARRAY( unsigned int, channels );
+
+    for ( unsigned int c = 0; c < channels; c++ )
+    {
+        int  b =
+            (int)
+            (   ( s500_channel_center( art_gv, c ) - distribution->bandRangeStart )
+              / distribution->bandWidth );
+
+        bandOfChannel[c] = (unsigned int) M_CLAMP( b, 0, (int) bands - 1 );
+    }
+
+    double  * weight = ALLOC_ARRAY( double, bands * width * height );
+
+    for ( unsigned int i = 0; i < bands * width * height; i++ )
+        weight[i] = 0.0;
+
+    ArSpectralIntensity  * radiance = arspectralintensity_alloc( art_gv );
+
+    for ( unsigned int y = 0; y < height; y++ )
+    {
+        double  z = ( y + 0.5 ) / height;
+        double  r = sqrt( 1.0 - M_SQR(z) );
+
+        for ( unsigned int x = 0; x < width; x++ )
+        {
+            double  phi = ( x + 0.5 ) / width * MATH_2_MUL_PI;
+
+            Vec3D  localDirection = VEC3D( r * cos( phi ), r * sin( phi ), z );
+            Vec3D  queryDirection;
+
+            vec3d_v_htrafo3d_v(
+                & localDirection,
+                  skydome2world,
+                & queryDirection
+                );
+
+            ArSamplingRegion  region;
+
+            [ skyEmitter spectralIntensityEmittedTowardsPointFromDirection
+                :   queryLocation
+                : & queryDirection
+                : & region
+                :   radiance
+                ];
+
+            //   Cells whose centre lies on the solar disc only get the
+            //   uniform share; the sun itself is sampled separately.
+
+            if ( region != ARNSKYLIGHT_SAMPLINGREGION_SKYDOME )
+                continue;
+
+            for ( unsigned int c = 0; c < channels; c++ )
+                weight[ ( bandOfChannel[c] * height + y ) * width + x ] +=
+                    s500_si( art_gv, radiance, c );
+        }
+    }
+
+    arspectralintensity_free( art_gv, radiance );
+
+    distribution->band        = ALLOC_ARRAY( ArDistribution2D, bands );
+    distribution->skyFraction = ALLOC_ARRAY( double, bands );
+
+    for ( unsigned int b = 0; b < bands; b++ )
+    {
+        double  * bandWeight = weight + b * width * height;
+        double    average    = 0.0;
+
+        for ( unsigned int i = 0; i < width * height; i++ )
+            average += bandWeight[i];
+
+        average /= width * height;
+
+        for ( unsigned int i = 0; i < width * height; i++ )
+            bandWeight[i] += SKYDOME_DISTRIBUTION_UNIFORM_FRACTION * average;
+
+        ardistribution2d_init(
+            & distribution->band[b],
+              bandWeight,
+              width,
+              height
+            );
+
+        distribution->skyFraction[b] = 1.0;
+
+        double  sunDensity =
+            arskydomedistribution_pdf(
+                  distribution,
+                  b,
+                  sunDirection
+                );
+
+        distribution->skyFraction[b] =
+            M_MAX(
+                1.0 - sunDensity * areaOfSolarCap,
+                SKYDOME_DISTRIBUTION_MIN_SKY_FRACTION
+                );
+    }
+
+    FREE_ARRAY( weight );
+    FREE_ARRAY( bandOfChannel );
+}
+
+ArSkydomeDistribution arskydomedistribution_copy(
+        const ArSkydomeDistribution  * distribution
+        )
+{
+    ArSkydomeDistribution  copy = *distribution;
+
+    if ( distribution->numberOfBands > 0 )
+    {
+        copy.band =
+            ALLOC_ARRAY( ArDistribution2D, distribution->numberOfBands );
+        copy.skyFraction =
+            ALLOC_ARRAY( double, distribution->numberOfBands );
+
+        for ( unsigned int b = 0; b < distribution->numberOfBands; b++ )
+        {
+            copy.band[b] =
+                ardistribution2d_copy( & distribution->band[b] );
+            copy.skyFraction[b] =
+                distribution->skyFraction[b];
+        }
+    }
+
+    return copy;
+}
+
+void arskydomedistribution_free_contents(
+        ArSkydomeDistribution  * distribution
+        )
+{
+    for ( unsigned int b = 0; b < distribution->numberOfBands; b++ )
+        ardistribution2d_free_contents( & distribution->band[b] );
+
+    if ( distribution->band )
+        FREE_ARRAY( distribution->band );
+    if ( distribution->skyFraction )
+        FREE_ARRAY( distribution->skyFraction );
+
+    distribution->numberOfBands = 0;
+    distribution->band          = 0;
+    distribution->skyFraction   = 0;
+}
+
+unsigned int arskydomedistribution_band(
+        const ArSkydomeDistribution  * distribution,
+        const ArWavelength           * wavelength
+        )
+{
+    int  b =
+        (int)
+        (   ( ARWL_WI(*wavelength,0) - distribution->bandRangeStart )
+          / distribution->bandWidth );
+
+    return
+        (unsigned int) M_CLAMP( b, 0, (int) distribution->numberOfBands - 1 );
+}
+
+double arskydomedistribution_sample(
+        const ArSkydomeDistribution  * distribution,
+        const unsigned int             band,
+        const double                   u0,
+        const double                   u1,
+              Vec3D                  * localDirection
+        )
+{
+    double  x, y;
+
+    double  density =
+        ardistribution2d_sample(
+            & distribution->band[band],
+              u0,
+              u1,
+            & x,
+            & y
+            );
+
+    double  phi = x * MATH_2_MUL_PI;
+    double  z   = y;
+    double  r   = sqrt( 1.0 - M_SQR(z) );
+
+    *localDirection = VEC3D( r * cos( phi ), r * sin( phi ), z );
+
+    return density / ( MATH_2_MUL_PI * distribution->skyFraction[band] );
+}
+
+double arskydomedistribution_pdf(
+        const ArSkydomeDistribution  * distribution,
+        const unsigned int             band,
+        const Vec3D                  * localDirection
+        )
+{
+    double  z = ZC(*localDirection);
+
+    if ( z <= 0.0 )
+        return 0.0;
+
+    double  x = atan2( YC(*localDirection), XC(*localDirection) ) / MATH_2_MUL_PI;
+
+    if ( x < 0.0 )
+        x += 1.0;
+
+    //   atan2 can return exactly pi, and z can exceed one by rounding
+
+    x = M_MIN( x, 1.0 - MATH_TINY_DOUBLE );
+    z = M_MIN( z, 1.0 - MATH_TINY_DOUBLE );
+
+    double  density =
+        ardistribution2d_pdf(
+            & distribution->band[band],
+              x,
+              z
+            );
+
+    return density / ( MATH_2_MUL_PI * distribution->skyFraction[band] );
+}
+
+// ===========================================================================
@@ -47,6 +47,13 @@ ART_MODULE_INTERFACE(ArcAreaLightsource)
     'lightsourceRadiantPowerPercentile' of the previous one, plus its own
     'percentOfLightsourceRadiantPower'. And so on. The last patch has to have
     a value of 1.0 in this field.
+
+    'patchSelection' (in ArcAreaLightsource)
+
+    Alias table over 'percentOfLightsourceRadiantPower' of all patches,
+    which is what is actually used to pick a patch in constant time during
+    rendering. Selects patches with the same probabilities as a search
+    through the percentiles would.
 */
 
 typedef struct ArAreaLightsourcePatch
@@ -73,6 +80,7 @@ ArAreaLightsourcePatch;
         : ArcLightsource
 {
     ArAreaLightsourcePatch  * patch;
+    ArAliasTable              patchSelection;
     ArTraversalState          traversalState;
     ArSpectralIntensity     * emission;
     ArLightIntensity        * intensityAtPoint;
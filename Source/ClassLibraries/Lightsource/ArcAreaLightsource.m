@@ -94,6 +94,8 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
         area = 0.0;
         patch = ALLOC_ARRAY( ArAreaLightsourcePatch, numberOfPatches );
 
+        araliastable_init( & patchSelection, 0, 0 );
+
         for ( unsigned int i = 0; i < numberOfPatches; i++ )
         {
             ArSamplingContext2D  samplingContext;
@@ -202,6 +204,19 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
                       patch[i-1].lightsourceRadiantPowerPercentile
                     + patch[i].percentOfLightsourceRadiantPower;
             }
+
+            double  * patchWeight = ALLOC_ARRAY( double, numberOfPatches );
+
+            for ( unsigned int i = 0; i < numberOfPatches; i++ )
+                patchWeight[i] = patch[i].percentOfLightsourceRadiantPower;
+
+            araliastable_init(
+                & patchSelection,
+                  patchWeight,
+                  numberOfPatches
+                );
+
+            FREE_ARRAY( patchWeight );
         }
 
         [ REPORTER endAction ];
@@ -223,6 +238,8 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
         for ( unsigned int i = 0; i < numberOfPatches; i++ )
             clone->patch[i] = patch[i];
 
+        clone->patchSelection = araliastable_copy( & patchSelection );
+
         clone->area       = area;
         clone->traversalState  = artraversalstate_copy(&traversalState);
         clone->emission = arspectralintensity_alloc(art_gv);
@@ -257,6 +274,8 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
 
     FREE_ARRAY(patch);
 
+    araliastable_free_contents( & patchSelection );
+
     artraversalstate_free_contents( & traversalState );
 
     [ super dealloc ];
@@ -29,6 +29,7 @@
 ART_MODULE_INTERFACE(ArcComplexSkydomeLightsource)
 
 #import "ArcLightsource.h"
+#import "ArSkydomeDistribution.h"
 
 @class ArnLightsourceCollector;
 
@@ -75,6 +76,10 @@ ArComplexSkydomeLightsourcePatch;
     double                              altitude[PSM_ARRAYSIZE];
     ArSpectralIntensity              ** spectralPowerAlt;               //  W * m^-1
     double                              radiantPowerAlt[PSM_ARRAYSIZE]; //  W
+
+    //   Directional distribution used for sampling the sky patch
+
+    ArSkydomeDistribution               skyDistribution;
 }
 
 - (id) init
@@ -299,6 +299,11 @@ int altitudeOfPoint(
         else
             patch[SKY_INDEX].probability = 0.0;
 
+        //   The uniform skydome probability is only a fallback for callers
+        //   that do not know the direction of a sample: sky directions are
+        //   actually drawn from a table of the sky radiance, which is built
+        //   once the sky power is known (see below).
+
         /* ----------------------------------------------------------------------
              Next we figure out the power of the skylight. For this we need
              radiance samples from both areas.
@@ -549,6 +554,31 @@ int altitudeOfPoint(
 
         radiantPower /= (double) PSM_ARRAYSIZE;
 
+        //   The sampling table is only built for the lowest altitude, as
+        //   that is where nearly all scenes are. At other altitudes, the
+        //   uniform share in each cell keeps the estimates unbiased.
+
+        Vec3D  sunDirection =
+            VEC3D(
+                cos( solarAzimuth ) * cos( solarElevation ),
+                sin( solarAzimuth ) * cos( solarElevation ),
+                sin( solarElevation )
+                );
+
+        XC(ARCSURFACEPOINT_WORLDSPACE_POINT(sp)) = 0.0;
+        YC(ARCSURFACEPOINT_WORLDSPACE_POINT(sp)) = 0.0;
+        ZC(ARCSURFACEPOINT_WORLDSPACE_POINT(sp)) = altitude[0];
+
+        arskydomedistribution_init(
+              art_gv,
+            & skyDistribution,
+              SKYDOME_ENVIRONMENT_MATERIAL,
+              sp,
+            & skydome2world,
+            & sunDirection,
+              areaOfSolarCap
+            );
+
         [ REPORTER printf
             :   "Overall                   : %12.6f [W]\n"
             ,   radiantPower
@@ -564,6 +594,8 @@ int altitudeOfPoint(
 
 - (void) dealloc
 {
+    arskydomedistribution_free_contents( & skyDistribution );
+
     [ super dealloc ];
 }
 
@@ -589,6 +621,8 @@ int altitudeOfPoint(
         clone->solarRadius      = solarRadius;
         clone->solarElevation   = solarElevation;
         clone->solarAzimuth     = solarAzimuth;
+        clone->skyDistribution  =
+            arskydomedistribution_copy( & skyDistribution );
         
         for ( int a = 0; a < PSM_ARRAYSIZE; a++ )
         {
@@ -29,6 +29,7 @@
 ART_MODULE_INTERFACE(ArcSkydomeLightsource)
 
 #import "ArcLightsource.h"
+#import "ArSkydomeDistribution.h"
 
 @class ArnLightsourceCollector;
 
@@ -72,6 +73,10 @@ ArSkydomeLightsourcePatch;
     double                       solarAzimuth;
     HTrafo3D                     skydome2world;
     HTrafo3D                     world2skydome;
+
+    //   Directional distribution used for sampling the sky patch
+
+    ArSkydomeDistribution        skyDistribution;
 }
 
 - (id) init
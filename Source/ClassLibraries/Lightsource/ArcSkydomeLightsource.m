@@ -175,6 +175,28 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
         else
             patch[SKY_INDEX].probability = 0.0;
 
+        //   The uniform skydome probability is only a fallback for callers
+        //   that do not know the direction of a sample: sky directions are
+        //   actually drawn from a table of the sky radiance, see
+        //   ArSkydomeDistribution.h.
+
+        Vec3D  sunDirection =
+            VEC3D(
+                cos( solarAzimuth ) * cos( solarElevation ),
+                sin( solarAzimuth ) * cos( solarElevation ),
+                sin( solarElevation )
+                );
+
+        arskydomedistribution_init(
+              art_gv,
+            & skyDistribution,
+              SKYDOME_ENVIRONMENT_MATERIAL,
+              0,
+            & skydome2world,
+            & sunDirection,
+              areaOfSolarCap
+            );
+
         /* ----------------------------------------------------------------------
              Next we figure out the power of the skylight. For this we need
              radiance samples from both areas.
@@ -417,6 +439,8 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
 
 - (void) dealloc
 {
+    arskydomedistribution_free_contents( & skyDistribution );
+
     [ super dealloc ];
 }
 
@@ -435,6 +459,8 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
         clone->solarRadius      = solarRadius;
         clone->solarElevation   = solarElevation;
         clone->solarAzimuth     = solarAzimuth;
+        clone->skyDistribution  =
+            arskydomedistribution_copy( & skyDistribution );
     }
 
     return clone;
@@ -66,6 +66,27 @@ ArLightsourceEntry;
     unsigned int           numberOfActualSlots;
     unsigned int           numberOfLights;
     ArLightsourceEntry  * light;
+
+    //   Constant time light selection, built by 'prepareForUse' for
+    //   altitude 0: one alias table per s500 channel, over the share each
+    //   light has of the overall spectral power in that channel, plus one
+    //   over the share of overall radiant power.
+
+    unsigned int           numberOfSelectionChannels;
+    double                 selectionRangeStart;
+    double                 selectionRangeEnd;
+    double                 selectionChannelWidth;
+    ArAliasTable         * spectralPowerSelection;
+    ArAliasTable           radiantPowerSelection;
+
+    //   Hash map from the shape of each light to its index, so that the
+    //   light for an emissive object that was hit can be found without
+    //   going through all of them. Open addressing with linear probing,
+    //   also built by 'prepareForUse'.
+
+    unsigned int           emitterLookupMask;
+    const void          ** emitterLookupShape;
+    unsigned int         * emitterLookupLight;
 }
 
 - (id) init
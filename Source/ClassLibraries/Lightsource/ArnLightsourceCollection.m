@@ -81,6 +81,23 @@ ART_MODULE_SHUTDOWN_FUNCTION
 #define UNLOCK_ADDITION_MUTEX    \
     pthread_mutex_unlock( & art_gv->arnlightsourcecollection_gv->mutex_1 )
 
+//   Internal interface, also used by the RaySampling category. No need to
+//   expose this to the outside world.
+
+@interface ArnLightsourceCollection ( internal )
+
+/* ---------------------------------------------------------------------------
+    '_lightIndexForEmissiveObject'
+        Index of the light whose shape is the given emissive object, or -1
+        if there is no such light. Only valid after 'prepareForUse'.
+--------------------------------------------------------------------------- */
+
+- (int) _lightIndexForEmissiveObject
+        : (const ArNode *) emissiveObject
+        ;
+
+@end
+
 @implementation ArnLightsourceCollection
 
 ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnLightsourceCollection)
@@ -124,6 +141,15 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnLightsourceCollection)
     }
 
     complexSkydomePresent  = NO;
+
+    numberOfSelectionChannels = 0;
+    spectralPowerSelection    = 0;
+
+    araliastable_init( & radiantPowerSelection, 0, 0 );
+
+    emitterLookupMask  = 0;
+    emitterLookupShape = 0;
+    emitterLookupLight = 0;
     }
 
     return self;
@@ -345,9 +371,156 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnLightsourceCollection)
     return overallNumberOfPatches;
 }
 
+- (void) _freeLightsourceSelection
+{
+    for ( unsigned int c = 0; c < numberOfSelectionChannels; c++ )
+        araliastable_free_contents( & spectralPowerSelection[c] );
+
+    if ( spectralPowerSelection )
+        FREE_ARRAY( spectralPowerSelection );
+
+    spectralPowerSelection    = 0;
+    numberOfSelectionChannels = 0;
+
+    araliastable_free_contents( & radiantPowerSelection );
+}
+
+- (void) _prepareLightsourceSelection
+{
+    [ self _freeLightsourceSelection ];
+
+    //   The channel layout has to match the one sps_s500w_init_s uses
+    //   when the selection probability of a light is looked up later.
+
+    numberOfSelectionChannels = s500_channels( art_gv );
+
+    unsigned int  lastChannel = numberOfSelectionChannels - 1;
+
+    selectionRangeStart   = s500_channel_lower_bound( art_gv, 0 );
+    selectionRangeEnd     =   s500_channel_lower_bound( art_gv, lastChannel )
+                            + s500_channel_width( art_gv, lastChannel );
+    selectionChannelWidth = s500_channel_width( art_gv, 0 );
+
+    spectralPowerSelection =
+        ALLOC_ARRAY( ArAliasTable, numberOfSelectionChannels );
+
+    double  * weight = ALLOC_ARRAY( double, M_MAX( numberOfLights, 1 ) );
+
+    for ( unsigned int c = 0; c < numberOfSelectionChannels; c++ )
+    {
+        for ( unsigned int i = 0; i < numberOfLights; i++ )
+            weight[i] =
+                s500_si(
+                    art_gv,
+                    LSC_LIGHT(0,i).percentOfOverallSpectralPower,
+                    c
+                    );
+
+        araliastable_init(
+            & spectralPowerSelection[c],
+              weight,
+              numberOfLights
+            );
+    }
+
+    for ( unsigned int i = 0; i < numberOfLights; i++ )
+        weight[i] = LSC_LIGHT(0,i).percentOfOverallRadiantPower;
+
+    araliastable_init(
+        & radiantPowerSelection,
+          weight,
+          numberOfLights
+        );
+
+    FREE_ARRAY( weight );
+}
+
+//   Fibonacci hashing of the shape address; the lowest bits of object
+//   pointers are always zero, so they are shifted out first.
+
+#define EMITTER_LOOKUP_HASH(__shape) \
+    ((unsigned int)((((unsigned long)(__shape)) >> 4) * 2654435761UL))
+
+- (void) _freeEmitterLookup
+{
+    if ( emitterLookupShape )
+        FREE_ARRAY( emitterLookupShape );
+    if ( emitterLookupLight )
+        FREE_ARRAY( emitterLookupLight );
+
+    emitterLookupMask  = 0;
+    emitterLookupShape = 0;
+    emitterLookupLight = 0;
+}
+
+- (void) _prepareEmitterLookup
+{
+    [ self _freeEmitterLookup ];
+
+    //   Table size: smallest power of two that keeps the load factor
+    //   at or below one half.
+
+    unsigned int  size = 2;
+
+    while ( size < 2 * numberOfLights )
+        size *= 2;
+
+    emitterLookupMask  = size - 1;
+    emitterLookupShape = ALLOC_ARRAY( const void *, size );
+    emitterLookupLight = ALLOC_ARRAY( unsigned int, size );
+
+    for ( unsigned int j = 0; j < size; j++ )
+        emitterLookupShape[j] = 0;
+
+    //   Lights are entered in order, and a shape that is already present
+    //   is not entered again - so just as with a linear search, the first
+    //   light with a given shape is the one that is found.
+
+    for ( unsigned int i = 0; i < numberOfLights; i++ )
+    {
+        const void  * shape = [ LSC_LIGHT(0,i).source shape ];
+
+        if ( ! shape )
+            continue;
+
+        unsigned int  j = EMITTER_LOOKUP_HASH(shape) & emitterLookupMask;
+
+        while ( emitterLookupShape[j] && emitterLookupShape[j] != shape )
+            j = ( j + 1 ) & emitterLookupMask;
+
+        if ( ! emitterLookupShape[j] )
+        {
+            emitterLookupShape[j] = shape;
+            emitterLookupLight[j] = i;
+        }
+    }
+}
+
+- (int) _lightIndexForEmissiveObject
+        : (const ArNode *) emissiveObject
+{
+    if ( ! emitterLookupShape || ! emissiveObject )
+        return -1;
+
+    unsigned int  j = EMITTER_LOOKUP_HASH(emissiveObject) & emitterLookupMask;
+
+    while ( emitterLookupShape[j] )
+    {
+        if ( emitterLookupShape[j] == (const void *) emissiveObject )
+            return (int) emitterLookupLight[j];
+
+        j = ( j + 1 ) & emitterLookupMask;
+    }
+
+    return -1;
+}
+
 - (void) prepareForUse
         : (ArcObject <ArpReporter> *) reporter
 {
+    [ self _prepareLightsourceSelection ];
+    [ self _prepareEmitterLookup ];
+
     [ reporter beginAction
         :   "Preparing lightsource collection for use"
         ];
@@ -373,16 +546,17 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnLightsourceCollection)
         : ( ArSamplingRegion *)     samplingRegionOnEmissiveObject
         : ( id <ArpLightsource> *)  lightsource
 {
-    unsigned int  i = 0;
+    int  i = [ self _lightIndexForEmissiveObject: emissiveObject ];
+
+    //   As before, the last light is used if none matches
 
-    while (   i < ( numberOfLights - 1 )
-           && (id)[ light[i].source shape ] != (id)emissiveObject )
-        i++;
+    if ( i < 0 )
+        i = numberOfLights - 1;
 
-    *lightsource = light[i].source;
+    *lightsource = LSC_LIGHT(0,i).source;
 
     return
-        [ light[i].source selectionProbabilityOfRegion
+        [ LSC_LIGHT(0,i).source selectionProbabilityOfRegion
             :   samplingRegionOnEmissiveObject
             ];
 }
@@ -393,16 +567,15 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnLightsourceCollection)
         : ( ArSamplingRegion *)     samplingRegionOnEmissiveObject
         : ( id <ArpLightsource> *)  lightsource
 {
-    unsigned int  i = 0;
+    int  i = [ self _lightIndexForEmissiveObject: emissiveObject ];
 
-    while (   i < ( numberOfLights - 1 )
-           && (id)[ light[i].source shape ] != (id)emissiveObject )
-        i++;
+    if ( i < 0 )
+        i = numberOfLights - 1;
 
-    *lightsource = light[i].source;
+    *lightsource = LSC_LIGHT(0,i).source;
 
     return
-        [ light[i].source selectionProbabilityOfRegion
+        [ LSC_LIGHT(0,i).source selectionProbabilityOfRegion
             :   samplingRegionOnEmissiveObject
             :   queryLocationWorldspace
             ];
@@ -419,6 +592,9 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnLightsourceCollection)
 
     FREE_ARRAY( light );
 
+    [ self _freeLightsourceSelection ];
+    [ self _freeEmitterLookup ];
+
     [ super dealloc ];
 }
 
@@ -433,6 +609,43 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnLightsourceCollection)
 
     for ( unsigned int i = 0; i < numberOfActualSlots; i++ )
         light[i] = otherLSC->light[i];
+
+    numberOfSelectionChannels = otherLSC->numberOfSelectionChannels;
+    selectionRangeStart       = otherLSC->selectionRangeStart;
+    selectionRangeEnd         = otherLSC->selectionRangeEnd;
+    selectionChannelWidth     = otherLSC->selectionChannelWidth;
+    spectralPowerSelection    = 0;
+
+    if ( numberOfSelectionChannels > 0 )
+    {
+        spectralPowerSelection =
+            ALLOC_ARRAY( ArAliasTable, numberOfSelectionChannels );
+
+        for ( unsigned int c = 0; c < numberOfSelectionChannels; c++ )
+            spectralPowerSelection[c] =
+                araliastable_copy( & otherLSC->spectralPowerSelection[c] );
+    }
+
+    radiantPowerSelection =
+        araliastable_copy( & otherLSC->radiantPowerSelection );
+
+    emitterLookupMask  = otherLSC->emitterLookupMask;
+    emitterLookupShape = 0;
+    emitterLookupLight = 0;
+
+    if ( otherLSC->emitterLookupShape )
+    {
+        unsigned int  size = emitterLookupMask + 1;
+
+        emitterLookupShape = ALLOC_ARRAY( const void *, size );
+        emitterLookupLight = ALLOC_ARRAY( unsigned int, size );
+
+        for ( unsigned int j = 0; j < size; j++ )
+        {
+            emitterLookupShape[j] = otherLSC->emitterLookupShape[j];
+            emitterLookupLight[j] = otherLSC->emitterLookupLight[j];
+        }
+    }
 }
 
 - (void) _copyLightsourcesOfOtherLSC
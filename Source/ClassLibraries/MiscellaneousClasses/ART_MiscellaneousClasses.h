@@ -33,6 +33,7 @@ ART_LIBRARY_INTERFACE(ART_MiscellaneousClasses)
 #import "ArcBBoxCache.h"
 #import "ArcOption.h"
 #import "ArcUnsignedInteger.h"
+#import "ArcWorkerPool.h"
 #import "ArcEvaluationEnvironment.h"
 #import "ArcParameterisation.h"
 #import "ArcParameterRange.h"
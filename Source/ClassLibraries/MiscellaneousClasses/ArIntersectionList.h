@@ -97,6 +97,21 @@ unsigned int arintersectionlist_is_nonempty(
 #define arintersectionlist_is_empty \
     ! arintersectionlist_is_nonempty
 
+/* ---------------------------------------------------------------------------
+
+    'arintersectionlist_has_intersection_within_range'
+
+    Returns true if at least one of the intersections in the list has a
+    t value in the one sided interval [range.min, range.max). Used by the
+    generic form of the 'anyIntersectionWithinRange' occlusion query.
+
+--------------------------------------------------------------------------- */
+
+unsigned int arintersectionlist_has_intersection_within_range(
+        const ArIntersectionList  * list,
+        const Range               * range_of_t
+        );
+
 /* ---------------------------------------------------------------------------
 
     'arintersectionlist_validate'
@@ -241,6 +256,38 @@ void arintersectionlist_sub(
         double                eps
         );
 
+/* ---------------------------------------------------------------------------
+    'arintersectionlist_or_has_intersection_within_range'
+    'arintersectionlist_and_has_intersection_within_range'
+    'arintersectionlist_sub_has_intersection_within_range'
+
+    Occlusion query counterparts of the three CSG combination functions
+    above. The two operand lists are walked in parallel, just as the
+    combination would do, but no combined list is built: the walk stops
+    as soon as the first boundary of the combined object within the one
+    sided interval [range.min, range.max) is found, or once the walk has
+    moved past range.max. The operand lists are left untouched, and
+    remain the property of the caller.
+--------------------------------------------------------------------------- */
+
+unsigned int arintersectionlist_or_has_intersection_within_range(
+        const ArIntersectionList  * left_list,
+        const ArIntersectionList  * right_list,
+        const Range               * range_of_t
+        );
+
+unsigned int arintersectionlist_and_has_intersection_within_range(
+        const ArIntersectionList  * left_list,
+        const ArIntersectionList  * right_list,
+        const Range               * range_of_t
+        );
+
+unsigned int arintersectionlist_sub_has_intersection_within_range(
+        const ArIntersectionList  * left_list,
+        const ArIntersectionList  * right_list,
+        const Range               * range_of_t
+        );
+
 /* ---------------------------------------------------------------------------
     'arintersectionlist_combine'
     Combine the supplied intersectionlists using the CSG combine operator.
@@ -145,6 +145,28 @@ unsigned int arintersectionlist_is_nonempty(
         || ARINTERSECTIONLIST_HEAD_VOLUME_MATERIAL(*list);
 }
 
+unsigned int arintersectionlist_has_intersection_within_range(
+        const ArIntersectionList  * list,
+        const Range               * range_of_t
+        )
+{
+    ArcIntersection  * intersection = ARINTERSECTIONLIST_HEAD(*list);
+
+    while ( intersection )
+    {
+        if (   ARCINTERSECTION_T(intersection) >= RANGE_MIN(*range_of_t)
+            && ARCINTERSECTION_T(intersection) <  RANGE_MAX(*range_of_t) )
+            return 1;
+
+        if ( intersection == ARINTERSECTIONLIST_TAIL(*list) )
+            break;
+
+        intersection = ARCINTERSECTION_NEXT(intersection);
+    }
+
+    return 0;
+}
+
 void arintersectionlist_check_connectivity(
         ArIntersectionList  * list
         )
@@ -960,6 +982,199 @@ void arintersectionlist_sub(
     ARINTERSECTIONLIST_VALIDATE(combined_list);
 }
 
+/* ---------------------------------------------------------------------------
+    Lazy CSG evaluation for occlusion queries
+
+    The decisions taken here are the same as in the three combination
+    functions above, including the special treatment of singular faces;
+    an intersection counts as a boundary of the combined object if the
+    combined material changes at it. The only difference is that hits
+    left over once one list is exhausted are judged by the same rules
+    as all others, which only matters for degenerate lists that contain
+    consecutive hits without a change of material.
+--------------------------------------------------------------------------- */
+
+typedef enum ArCSGOperation
+{
+    arcsgoperation_or,
+    arcsgoperation_and,
+    arcsgoperation_sub
+}
+ArCSGOperation;
+
+static ArNode * _csg_material(
+        const ArCSGOperation    operation,
+              ArNode          * left_material,
+              ArNode          * right_material
+        )
+{
+    switch ( operation )
+    {
+        case arcsgoperation_or:
+            return left_material ? left_material : right_material;
+
+        case arcsgoperation_and:
+            return right_material ? left_material : NULL;
+
+        default:
+            return right_material ? NULL : left_material;
+    }
+}
+
+static unsigned int _csg_left_singular_face_counts(
+        const ArCSGOperation    operation,
+              ArNode          * right_material,
+              ArNode          * old_right_material
+        )
+{
+    switch ( operation )
+    {
+        case arcsgoperation_or:
+            return 1;
+
+        case arcsgoperation_and:
+            return right_material || old_right_material;
+
+        default:
+            return ! right_material || ! old_right_material;
+    }
+}
+
+#define NEXT_INTERSECTION_IN_LIST(_intersection,_list) \
+    ( (_intersection) == ARINTERSECTIONLIST_TAIL(*(_list)) \
+      ? NULL \
+      : ARCINTERSECTION_NEXT(_intersection) )
+
+static unsigned int _arintersectionlist_csg_has_intersection_within_range(
+        const ArIntersectionList  * left_list,
+        const ArIntersectionList  * right_list,
+        const Range               * range_of_t,
+        const ArCSGOperation        operation
+        )
+{
+    ArNode  * left_mat  = ARINTERSECTIONLIST_HEAD_VOLUME_MATERIAL(*left_list);
+    ArNode  * right_mat = ARINTERSECTIONLIST_HEAD_VOLUME_MATERIAL(*right_list);
+    ArNode  * combined_mat = _csg_material( operation, left_mat, right_mat );
+
+    ArcIntersection  * left_hit  = ARINTERSECTIONLIST_HEAD(*left_list);
+    ArcIntersection  * right_hit = ARINTERSECTIONLIST_HEAD(*right_list);
+
+    while ( left_hit || right_hit )
+    {
+        ArNode        * old_mat       = combined_mat;
+        ArNode        * old_right_mat = right_mat;
+        unsigned int    singular      = 0;
+        double          t;
+
+        if (   ! right_hit
+            || (   left_hit
+                && ARCINTERSECTION_T(left_hit) < ARCINTERSECTION_T(right_hit) ) )
+        {
+            t = ARCINTERSECTION_T(left_hit);
+            left_mat = ARCINTERSECTION_VOLUME_MATERIAL_INTO(left_hit);
+
+            singular =
+                   ( ARCINTERSECTION_FACE_TYPE(left_hit)
+                     & arface_on_shape_is_singular )
+                && _csg_left_singular_face_counts(
+                       operation, right_mat, old_right_mat );
+
+            left_hit = NEXT_INTERSECTION_IN_LIST(left_hit, left_list);
+        }
+        else if (   ! left_hit
+                 ||   ARCINTERSECTION_T(right_hit)
+                    < ARCINTERSECTION_T(left_hit) )
+        {
+            t = ARCINTERSECTION_T(right_hit);
+            right_mat = ARCINTERSECTION_VOLUME_MATERIAL_INTO(right_hit);
+
+            singular =
+                   operation == arcsgoperation_or
+                && ( ARCINTERSECTION_FACE_TYPE(right_hit)
+                     & arface_on_shape_is_singular )
+                && ! left_mat;
+
+            right_hit = NEXT_INTERSECTION_IN_LIST(right_hit, right_list);
+        }
+        else // ARCINTERSECTION_T(left_hit) == ARCINTERSECTION_T(right_hit)
+        {
+            t = ARCINTERSECTION_T(left_hit);
+            left_mat  = ARCINTERSECTION_VOLUME_MATERIAL_INTO(left_hit);
+            right_mat = ARCINTERSECTION_VOLUME_MATERIAL_INTO(right_hit);
+
+            singular =
+                   ( ARCINTERSECTION_FACE_TYPE(left_hit)
+                     & arface_on_shape_is_singular )
+                && _csg_left_singular_face_counts(
+                       operation, right_mat, old_right_mat );
+
+            left_hit  = NEXT_INTERSECTION_IN_LIST(left_hit, left_list);
+            right_hit = NEXT_INTERSECTION_IN_LIST(right_hit, right_list);
+        }
+
+        //   Both lists are sorted, so nothing beyond this point can be
+        //   of interest any more.
+
+        if ( t >= RANGE_MAX(*range_of_t) )
+            return 0;
+
+        combined_mat = _csg_material( operation, left_mat, right_mat );
+
+        if (   t >= RANGE_MIN(*range_of_t)
+            && ( combined_mat != old_mat || singular ) )
+            return 1;
+    }
+
+    return 0;
+}
+
+#undef NEXT_INTERSECTION_IN_LIST
+
+unsigned int arintersectionlist_or_has_intersection_within_range(
+        const ArIntersectionList  * left_list,
+        const ArIntersectionList  * right_list,
+        const Range               * range_of_t
+        )
+{
+    return
+        _arintersectionlist_csg_has_intersection_within_range(
+            left_list,
+            right_list,
+            range_of_t,
+            arcsgoperation_or
+            );
+}
+
+unsigned int arintersectionlist_and_has_intersection_within_range(
+        const ArIntersectionList  * left_list,
+        const ArIntersectionList  * right_list,
+        const Range               * range_of_t
+        )
+{
+    return
+        _arintersectionlist_csg_has_intersection_within_range(
+            left_list,
+            right_list,
+            range_of_t,
+            arcsgoperation_and
+            );
+}
+
+unsigned int arintersectionlist_sub_has_intersection_within_range(
+        const ArIntersectionList  * left_list,
+        const ArIntersectionList  * right_list,
+        const Range               * range_of_t
+        )
+{
+    return
+        _arintersectionlist_csg_has_intersection_within_range(
+            left_list,
+            right_list,
+            range_of_t,
+            arcsgoperation_sub
+            );
+}
+
 #define COMBINE_MAT_REF(_left, _right) _left
 
 void arintersectionlist_combine(
@@ -136,6 +136,73 @@ ArcRandomGenerator <ArpRandomGenerator> * newARTRandomGenerator(
 
 @end
 
+/* ---------------------------------------------------------------------------
+
+    ArcPhiloxRandomGenerator class
+    ------------------------------
+
+    Counter-based generator, see the arrandom_philox_... functions in
+    ArRandom.h. reInitializeWith: maps the 32 bit value to a stream, as with
+    the other generators, but image samplers that know about this class can
+    instead key the generator directly by pixel and sample index, and draw
+    values via the inline C functions on the state returned by
+    'philoxState', without any message dispatch.
+
+    The key is derived from the global random seed only, so all instances
+    produce the same values for the same pixel, sample index and dimension.
+
+--------------------------------------------------------------------------- */
+
+@interface ArcPhiloxRandomGenerator
+        : ArcRandomGenerator
+        < ArpPixelSampleRandomGenerator >
+{
+    ArRandomPhilox  philoxState;
+}
+
+- (ArRandomPhilox *) philoxState
+        ;
+
+@end
+
+/* ---------------------------------------------------------------------------
+
+    ArcSobolRandomGenerator class
+    -----------------------------
+
+    Owen-scrambled, padded Sobol sampler, see the arrandom_sobol_owen_...
+    functions in ArRandom.h. Each sequence ID gets its own scrambling seed,
+    derived from the pixel, so every dimension of a path is a stratified
+    1D or 2D point set over the samples of that pixel, and decorrelated
+    from all other dimensions and pixels.
+
+    The sample index is either supplied via 'reInitializeWithPixel', or
+    advanced by 'resetSequenceIDs' (which is how the 2D subpixel sample
+    tables and the skydome sun samples are generated). A plain
+    'reInitializeWith' selects sample 0 of a stream keyed by the 32 bit
+    value, which still gives correct - if unstratified - values.
+
+    Sequence IDs that are requested again before the next reset (rejection
+    loops in the volume integrators do this) yield fresh, independent
+    values rather than repeating the previous one.
+
+--------------------------------------------------------------------------- */
+
+@interface ArcSobolRandomGenerator
+        : ArcRandomGenerator
+        < ArpPixelSampleRandomGenerator >
+{
+    UInt32  globalSeed;
+    UInt32  pixelSeed;
+    UInt32  sampleIndex;
+    UInt32  nextSampleIndex;
+    UInt32  dimension;
+    UInt32  dimensionLimit;
+    UInt32  draws;
+}
+
+@end
+
 /* ---------------------------------------------------------------------------
 
     ArcHaltonRandomGenerator class
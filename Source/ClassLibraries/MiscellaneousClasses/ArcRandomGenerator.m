@@ -88,6 +88,26 @@ ArcRandomGenerator <ArpRandomGenerator> * newARTRandomGenerator(
         return (ArcRandomGenerator <ArpRandomGenerator> *) new_generator;
     }
 
+    if ( type == arrandomvaluegeneration_philox )
+    {
+        new_generator =
+            [ ALLOC_OBJECT_AGV(new_art_gv,ArcPhiloxRandomGenerator) initWithReporter
+                :   newReporter
+                ];
+
+        return (ArcRandomGenerator <ArpRandomGenerator> *) new_generator;
+    }
+
+    if ( type == arrandomvaluegeneration_sobol )
+    {
+        new_generator =
+            [ ALLOC_OBJECT_AGV(new_art_gv,ArcSobolRandomGenerator) initWithReporter
+                :   newReporter
+                ];
+
+        return (ArcRandomGenerator <ArpRandomGenerator> *) new_generator;
+    }
+
     if ( type == arrandomvaluegeneration_halton )
     {
         new_generator =
@@ -449,6 +469,300 @@ ArcRandomGenerator <ArpRandomGenerator> * newARTRandomGenerator(
 
 @end
 
+@implementation ArcPhiloxRandomGenerator
+
+- (ArcObject <ArpReporter> *) reporter
+{
+    return
+        [ super reporter ];
+}
+
+- (void) setReporter
+        : (ArcObject <ArpReporter> *) newReporter
+{
+    [ super setReporter: newReporter ];
+}
+
+- (id) init
+{
+    return
+        [ self initWithReporter
+            :   NULL
+            ];
+}
+
+- (id) initWithReporter
+        : (ArcObject <ArpReporter> *) newReporter
+{
+    self = [ super init ];
+
+    if ( self )
+    {
+        reporter = newReporter;
+
+        [ reporter printf
+            :   "Using %s\n"
+            ,   [ self cStringClassName ]
+            ];
+
+        //   Unlike the NR generators, this one is not seeded from the
+        //   master RNG: all instances have to agree on the key, or the
+        //   result would depend on which thread rendered a pixel.
+
+        arrandom_philox_seed(
+            & philoxState,
+              arrandom_global_seed( art_gv )
+            );
+    }
+    
+    return self;
+}
+
+- (ArRandomPhilox *) philoxState
+{
+    return & philoxState;
+}
+
+- (void) getValuesFromNewSequences
+        : (double *) a
+        : (double *) b
+{
+    arrandom_philox_double_pair( & philoxState, a, b );
+}
+
+- (double) valueFromNewSequence
+{
+    return arrandom_philox_double( & philoxState );
+}
+
+- (double) valueFromNewSequence
+        : (ArSequenceID *) usedSequence
+{
+    *usedSequence = ARRANDOM_PHILOX_DIMENSION( & philoxState );
+
+    return arrandom_philox_double( & philoxState );
+}
+
+- (double) valueFromSequence
+        : (ArSequenceID) sequenceToUse
+{
+    UInt32  dimension = ARRANDOM_PHILOX_DIMENSION( & philoxState );
+
+    ARRANDOM_PHILOX_DIMENSION( & philoxState ) = (UInt32) sequenceToUse;
+
+    double  value = arrandom_philox_double( & philoxState );
+
+    ARRANDOM_PHILOX_DIMENSION( & philoxState ) = dimension;
+
+    return value;
+}
+
+- (void) reInitializeWith
+        : (UInt32) uInt32Value
+{
+    arrandom_philox_set_pixel_sample( & philoxState, uInt32Value, 0, 0 );
+}
+
+- (void) reInitializeWithPixel
+        : (UInt32) x
+        : (UInt32) y
+        : (UInt32) newSampleIndex
+{
+    arrandom_philox_set_pixel_sample( & philoxState, x, y, newSampleIndex );
+}
+
+- (void) resetSequenceIDs
+{
+    ARRANDOM_PHILOX_DIMENSION( & philoxState ) = 0;
+}
+
+- (ArSequenceID) currentSequenceID
+{
+    return ARRANDOM_PHILOX_DIMENSION( & philoxState );
+}
+
+- (void) setCurrentSequenceID
+        : (ArSequenceID) sequenceID
+{
+    ARRANDOM_PHILOX_DIMENSION( & philoxState ) = (UInt32) sequenceID;
+}
+
+@end
+
+@implementation ArcSobolRandomGenerator
+
+- (ArcObject <ArpReporter> *) reporter
+{
+    return
+        [ super reporter ];
+}
+
+- (void) setReporter
+        : (ArcObject <ArpReporter> *) newReporter
+{
+    [ super setReporter: newReporter ];
+}
+
+- (id) init
+{
+    return
+        [ self initWithReporter
+            :   NULL
+            ];
+}
+
+- (id) initWithReporter
+        : (ArcObject <ArpReporter> *) newReporter
+{
+    self = [ super init ];
+
+    if ( self )
+    {
+        reporter = newReporter;
+
+        [ reporter printf
+            :   "Using %s\n"
+            ,   [ self cStringClassName ]
+            ];
+
+        //   As with the Philox generator, all instances have to agree on
+        //   the scrambling, so only the global seed goes in here.
+
+        long  seed = arrandom_global_seed( art_gv );
+
+        globalSeed =
+            arrandom_hash_combine(
+                arrandom_hash( (UInt32) seed ),
+                (UInt32) ( (UInt64) seed >> 32 )
+                );
+
+        pixelSeed       = globalSeed;
+        sampleIndex     = 0;
+        nextSampleIndex = 0;
+        dimension       = 0;
+        dimensionLimit  = 0;
+        draws           = 0;
+    }
+    
+    return self;
+}
+
+//   Scrambling seed for a draw of 'count' consecutive dimensions, starting
+//   at 'firstDimension'. Dimensions below the high water mark have been
+//   handed out before, and get a seed that also depends on the number of
+//   draws so far.
+
+- (UInt32) _seedForDimensions
+        : (UInt32) firstDimension
+        : (UInt32) count
+{
+    UInt32  seed = arrandom_hash_combine( pixelSeed, firstDimension );
+
+    if ( firstDimension < dimensionLimit )
+        seed = arrandom_hash_combine( seed, 0x80000000U | draws );
+    else
+        dimensionLimit = firstDimension + count;
+
+    draws++;
+
+    return seed;
+}
+
+- (void) getValuesFromNewSequences
+        : (double *) a
+        : (double *) b
+{
+    arrandom_sobol_owen_2d(
+          sampleIndex,
+          [ self _seedForDimensions: dimension : 2 ],
+          a,
+          b
+        );
+
+    dimension += 2;
+}
+
+- (double) valueFromNewSequence
+{
+    double  value =
+        arrandom_sobol_owen_1d(
+            sampleIndex,
+            [ self _seedForDimensions: dimension : 1 ]
+            );
+
+    dimension++;
+
+    return value;
+}
+
+- (double) valueFromNewSequence
+        : (ArSequenceID *) usedSequence
+{
+    *usedSequence = dimension;
+
+    return [ self valueFromNewSequence ];
+}
+
+- (double) valueFromSequence
+        : (ArSequenceID) sequenceToUse
+{
+    return
+        arrandom_sobol_owen_1d(
+            sampleIndex,
+            [ self _seedForDimensions: (UInt32) sequenceToUse : 1 ]
+            );
+}
+
+- (void) reInitializeWith
+        : (UInt32) uInt32Value
+{
+    pixelSeed       = arrandom_hash_combine( globalSeed, uInt32Value );
+    sampleIndex     = 0;
+    nextSampleIndex = 1;
+    dimension       = 0;
+    dimensionLimit  = 0;
+    draws           = 0;
+}
+
+- (void) reInitializeWithPixel
+        : (UInt32) x
+        : (UInt32) y
+        : (UInt32) newSampleIndex
+{
+    pixelSeed =
+        arrandom_hash_combine(
+            arrandom_hash_combine( globalSeed, x ),
+            y
+            );
+
+    sampleIndex     = newSampleIndex;
+    nextSampleIndex = newSampleIndex + 1;
+    dimension       = 0;
+    dimensionLimit  = 0;
+    draws           = 0;
+}
+
+- (void) resetSequenceIDs
+{
+    sampleIndex     = nextSampleIndex++;
+    dimension       = 0;
+    dimensionLimit  = 0;
+    draws           = 0;
+}
+
+- (ArSequenceID) currentSequenceID
+{
+    return dimension;
+}
+
+- (void) setCurrentSequenceID
+        : (ArSequenceID) sequenceID
+{
+    dimension = (UInt32) sequenceID;
+}
+
+@end
+
 @implementation ArcHaltonRandomGenerator
 
 - (id) init
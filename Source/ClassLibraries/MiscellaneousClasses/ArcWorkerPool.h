@@ -0,0 +1,119 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+#include "ART_Foundation.h"
+
+ART_MODULE_INTERFACE(ArcWorkerPool)
+
+#include <pthread.h>
+
+#import "ArcUnsignedInteger.h"
+
+/* ===========================================================================
+    'ArcWorkerPool'
+     Runs a method of a target object on a number of worker threads that
+     are detached via art_thread_detach, and waits until all of them have
+     returned. There is one worker per work item, up to the maximum number
+     of working threads; with a single worker, the method is called on the
+     current thread.
+
+     The worker method has the signature of a thread method, and receives
+     the worker index as an ArcUnsignedInteger:
+
+         - (void) worker : (ArcUnsignedInteger *) threadIndex
+
+     Workers obtain the items they should process via 'nextWorkItem'. The
+     lock and condition of the pool are available to the workers for
+     anything else they have to synchronise, such as combining their
+     results, or writing them out in a particular order.
+=========================================================================== */
+
+@interface ArcWorkerPool
+        : ArcObject
+{
+    pthread_mutex_t   mutex;
+    pthread_cond_t    condition;
+    unsigned int      numberOfWorkItems;
+    unsigned int      nextItem;
+    unsigned int      numberOfWorkers;
+    unsigned int      numberOfActiveWorkers;
+    id                target;
+    SEL               workerSelector;
+}
+
+- (id) init
+        : (unsigned int) newNumberOfWorkItems
+        ;
+
+- (unsigned int) numberOfWorkers
+        ;
+
+/* ---------------------------------------------------------------------------
+    'run'
+        Starts the workers, and returns once all of them are done. Work
+        items are handed out from the first one again on each run.
+--------------------------------------------------------------------------- */
+
+- (void) run
+        : (SEL) newWorkerSelector
+        : (id) newTarget
+        ;
+
+/* ---------------------------------------------------------------------------
+    'nextWorkItem'
+        Hands out the work items in increasing order, each one exactly
+        once. Returns NO once all of them have been handed out.
+--------------------------------------------------------------------------- */
+
+- (BOOL) nextWorkItem
+        : (unsigned int *) item
+        ;
+
+//   Same as 'nextWorkItem', for workers that already hold the pool lock -
+//   e.g. because they have to do something in item order right after
+//   obtaining the item. The pool mutex is not recursive.
+
+- (BOOL) nextWorkItemWithLockHeld
+        : (unsigned int *) item
+        ;
+
+- (void) lock
+        ;
+
+- (void) unlock
+        ;
+
+//   Must be called with the pool locked, just like pthread_cond_wait.
+
+- (void) waitForSignal
+        ;
+
+- (void) signal
+        ;
+
+@end
+
+// ===========================================================================
@@ -0,0 +1,189 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+#define ART_MODULE_NAME     ArcWorkerPool
+
+#import "ArcWorkerPool.h"
+
+ART_NO_MODULE_INITIALISATION_FUNCTION_NECESSARY
+
+ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
+
+
+@implementation ArcWorkerPool
+
+- (id) init
+        : (unsigned int) newNumberOfWorkItems
+{
+    self = [ super init ];
+
+    if ( self )
+    {
+        numberOfWorkItems = newNumberOfWorkItems;
+
+        numberOfWorkers =
+            art_maximum_number_of_working_threads( art_gv );
+
+        numberOfWorkers = M_MIN( numberOfWorkers, numberOfWorkItems );
+
+        if ( numberOfWorkers < 1 )
+            numberOfWorkers = 1;
+
+        pthread_mutex_init( & mutex, NULL );
+        pthread_cond_init( & condition, NULL );
+    }
+    
+    return self;
+}
+
+- (void) dealloc
+{
+    pthread_cond_destroy( & condition );
+    pthread_mutex_destroy( & mutex );
+
+    [ super dealloc ];
+}
+
+- (unsigned int) numberOfWorkers
+{
+    return numberOfWorkers;
+}
+
+- (void) _workerThread
+        : (ArcUnsignedInteger *) threadIndex
+{
+    NSAutoreleasePool  * threadPool;
+    threadPool = [ [ NSAutoreleasePool alloc ] init ];
+
+    [ target performSelector
+        :   workerSelector
+        withObject
+        :   threadIndex
+        ];
+
+    pthread_mutex_lock( & mutex );
+    numberOfActiveWorkers--;
+    pthread_cond_broadcast( & condition );
+    pthread_mutex_unlock( & mutex );
+
+    [ threadPool release ];
+}
+
+- (void) run
+        : (SEL) newWorkerSelector
+        : (id) newTarget
+{
+    target                = newTarget;
+    workerSelector        = newWorkerSelector;
+    nextItem              = 0;
+    numberOfActiveWorkers = numberOfWorkers;
+
+    if ( numberOfWorkers == 1 )
+    {
+        //   No point in detaching a thread just to wait for it.
+
+        ArcUnsignedInteger  * index =
+            [ ALLOC_INIT_OBJECT(ArcUnsignedInteger) : 0 ];
+
+        [ self _workerThread
+            :   index
+            ];
+
+        RELEASE_OBJECT(index);
+    }
+    else
+    {
+        for ( unsigned int i = 0; i < numberOfWorkers; i++ )
+        {
+            ArcUnsignedInteger  * index =
+                [ ALLOC_INIT_OBJECT(ArcUnsignedInteger) : i ];
+
+            if ( ! art_thread_detach(@selector(_workerThread:), self, index) )
+                ART_ERRORHANDLING_FATAL_ERROR(
+                    "could not detach worker thread %d",
+                    i
+                    );
+
+            RELEASE_OBJECT(index);
+        }
+
+        pthread_mutex_lock( & mutex );
+
+        while ( numberOfActiveWorkers > 0 )
+            pthread_cond_wait( & condition, & mutex );
+
+        pthread_mutex_unlock( & mutex );
+    }
+
+    target = 0;
+}
+
+- (BOOL) nextWorkItem
+        : (unsigned int *) item
+{
+    pthread_mutex_lock( & mutex );
+
+    BOOL  result = [ self nextWorkItemWithLockHeld: item ];
+
+    pthread_mutex_unlock( & mutex );
+
+    return result;
+}
+
+- (BOOL) nextWorkItemWithLockHeld
+        : (unsigned int *) item
+{
+    *item = nextItem;
+
+    if ( nextItem < numberOfWorkItems )
+        nextItem++;
+
+    return ( *item < numberOfWorkItems );
+}
+
+- (void) lock
+{
+    pthread_mutex_lock( & mutex );
+}
+
+- (void) unlock
+{
+    pthread_mutex_unlock( & mutex );
+}
+
+- (void) waitForSignal
+{
+    pthread_cond_wait( & condition, & mutex );
+}
+
+- (void) signal
+{
+    pthread_cond_broadcast( & condition );
+}
+
+@end
+
+// ===========================================================================
@@ -39,5 +39,7 @@ ART_LIBRARY_INTERFACE(ART_MiscellaneousStructs)
 #import "ArSamplingRegion.h"
 #import "ArSurfaceType.h"
 #import "ArTreePath.h"
+#import "ArVoxelBrickGrid.h"
+#import "ArVolumeMajorantGrid.h"
 
 // ===========================================================================
@@ -39,6 +39,8 @@ ART_LIBRARY_INITIALISATION_FUNCTION
     ART_PERFORM_MODULE_INITIALISATION( ArPDFValue )
     ART_PERFORM_MODULE_INITIALISATION( ArRayTree )
     ART_PERFORM_MODULE_INITIALISATION( ArTreePath )
+    ART_PERFORM_MODULE_INITIALISATION( ArVoxelBrickGrid )
+    ART_PERFORM_MODULE_INITIALISATION( ArVolumeMajorantGrid )
 )
 
 ART_AUTOMATIC_LIBRARY_SHUTDOWN_FUNCTION
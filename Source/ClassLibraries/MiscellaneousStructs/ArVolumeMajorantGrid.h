@@ -0,0 +1,171 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+
+#include "ART_Foundation.h"
+
+ART_MODULE_INTERFACE(ArVolumeMajorantGrid)
+
+#import "ArVoxelBrickGrid.h"
+
+/* ---------------------------------------------------------------------------
+    'ArVolumeMajorantGrid'
+        Coarse grid of local maxima over a voxel volume. Each cell covers
+        a block of ARVOLUMEMAJORANTGRID_CELL_SIZE^3 voxels (plus one voxel
+        of padding on each side), and stores the largest value found in
+        any channel of those voxels.
+
+        Tracking integrators use these per-cell maxima instead of the
+        single global maximum of the volume, which drastically cuts down
+        on the number of null collisions in sparse media.
+--------------------------------------------------------------------------- */
+
+//   One cell per brick of the voxel grid
+
+#define ARVOLUMEMAJORANTGRID_CELL_SIZE      ARVOXELBRICKGRID_BRICK_SIZE
+
+typedef struct ArVolumeMajorantGrid
+{
+    int      xRes, yRes, zRes;
+    float  * majorant;
+}
+ArVolumeMajorantGrid;
+
+#define ARVOLUMEMAJORANTGRID_EMPTY \
+    ((ArVolumeMajorantGrid){ 0, 0, 0, NULL })
+
+void arvolumemajorantgrid_init(
+              ArVolumeMajorantGrid  * grid,
+        const ArVoxelBrickGrid      * voxels
+        );
+
+void arvolumemajorantgrid_copy(
+        const ArVolumeMajorantGrid  * grid,
+              ArVolumeMajorantGrid  * copiedGrid
+        );
+
+void arvolumemajorantgrid_free_contents(
+        ArVolumeMajorantGrid  * grid
+        );
+
+
+/* ---------------------------------------------------------------------------
+    'ArVolumeMajorantIterator'
+        Walks a ray through a majorant grid cell by cell (3D DDA), and
+        hands out the ray parameter interval of each cell, together with
+        the majorant valid in it. The majorant is multiplied by 'scale',
+        so callers can normalise it to whatever unit they need.
+
+        Volumes without a majorant grid use the constant variant, which
+        yields a single segment that spans the whole interval.
+
+        Typical use:
+
+            double  t0, t1, majorant;
+
+            while ( arvolumemajorantiterator_next( & it, & t0, & t1, & majorant ) )
+            {
+                ...
+            }
+--------------------------------------------------------------------------- */
+
+typedef struct ArVolumeMajorantIterator
+{
+    const ArVolumeMajorantGrid  * grid;
+    double                        scale;
+    double                        constantMajorant;
+
+    int                           cell[3];
+    int                           step[3];
+    double                        tNext[3];
+    double                        tDelta[3];
+
+    double                        t;
+    double                        tEnd;
+}
+ArVolumeMajorantIterator;
+
+void arvolumemajorantiterator_init_constant(
+              ArVolumeMajorantIterator  * iterator,
+        const double                      majorant,
+        const double                      tStart,
+        const double                      tEnd
+        );
+
+//   'gridPoint' and 'gridVector' describe the ray in the coordinates of
+//   the majorant grid: cell (i,j,k) covers [i,i+1) x [j,j+1) x [k,k+1).
+//   The ray parameter t has the same meaning as for the original ray.
+
+void arvolumemajorantiterator_init_grid(
+              ArVolumeMajorantIterator  * iterator,
+        const ArVolumeMajorantGrid      * grid,
+        const Pnt3D                     * gridPoint,
+        const Vec3D                     * gridVector,
+        const double                      tStart,
+        const double                      tEnd
+        );
+
+BOOL arvolumemajorantiterator_next(
+        ArVolumeMajorantIterator  * iterator,
+        double                    * segmentStart,
+        double                    * segmentEnd,
+        double                    * majorant
+        );
+
+
+/* ---------------------------------------------------------------------------
+    Tracking statistics
+        With ART_WITH_VOLUME_TRACKING_STATISTICS #defined, the tracking
+        integrators count the majorant segments they visit, and the real
+        and null collisions they sample. The totals are printed when the
+        module is shut down, which gives a quick way to compare majorant
+        quality (and time spent) between runs on the same scene.
+--------------------------------------------------------------------------- */
+
+#ifdef ART_WITH_VOLUME_TRACKING_STATISTICS
+
+typedef enum ArVolumeTrackingEvent
+{
+    arvolumetracking_segment        = 0,
+    arvolumetracking_real_collision = 1,
+    arvolumetracking_null_collision = 2
+}
+ArVolumeTrackingEvent;
+
+void arvolumetracking_count(
+        ArVolumeTrackingEvent  event
+        );
+
+#define ARVOLUMETRACKING_COUNT(__event) \
+    arvolumetracking_count( arvolumetracking_##__event )
+
+#else
+
+#define ARVOLUMETRACKING_COUNT(__event)
+
+#endif
+
+// ===========================================================================
@@ -0,0 +1,294 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+
+#define ART_MODULE_NAME     ArVolumeMajorantGrid
+
+#import "ArVolumeMajorantGrid.h"
+
+ART_NO_MODULE_INITIALISATION_FUNCTION_NECESSARY
+
+#ifdef ART_WITH_VOLUME_TRACKING_STATISTICS
+
+static unsigned long  arvolumetracking_counter[3];
+
+void arvolumetracking_count(
+        ArVolumeTrackingEvent  event
+        )
+{
+    __atomic_add_fetch( & arvolumetracking_counter[event], 1, __ATOMIC_RELAXED );
+}
+
+ART_MODULE_SHUTDOWN_FUNCTION
+(
+    (void) art_gv;
+
+    if ( arvolumetracking_counter[arvolumetracking_segment] > 0 )
+    {
+        printf(
+            "\nVolume tracking statistics: %lu majorant segments, "
+            "%lu real collisions, %lu null collisions\n"
+            ,   arvolumetracking_counter[arvolumetracking_segment]
+            ,   arvolumetracking_counter[arvolumetracking_real_collision]
+            ,   arvolumetracking_counter[arvolumetracking_null_collision]
+            );
+    }
+)
+
+#else
+
+ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
+
+#endif
+
+
+#define CELL_SIZE       ARVOLUMEMAJORANTGRID_CELL_SIZE
+
+void arvolumemajorantgrid_init(
+              ArVolumeMajorantGrid  * grid,
+        const ArVoxelBrickGrid      * voxels
+        )
+{
+    //   Lookups interpolate trilinearly between voxel centres, which sit
+    //   on integer voxel coordinates. Cell c of the majorant grid is
+    //   offset by half a voxel, and covers the voxel coordinates
+    //   [c*CELL_SIZE-0.5,(c+1)*CELL_SIZE-0.5). The trilinear footprint
+    //   of that range reaches from voxel c*CELL_SIZE-1 to voxel
+    //   (c+1)*CELL_SIZE, i.e. one voxel into each neighbouring brick.
+    //   One more cell is needed for the half voxel at the far end of
+    //   the volume.
+
+    grid->xRes = voxels->xRes / CELL_SIZE + 1;
+    grid->yRes = voxels->yRes / CELL_SIZE + 1;
+    grid->zRes = voxels->zRes / CELL_SIZE + 1;
+
+    grid->majorant = ALLOC_ARRAY( float, grid->xRes * grid->yRes * grid->zRes );
+
+    for ( int cz = 0; cz < grid->zRes; cz++ )
+    {
+        for ( int cy = 0; cy < grid->yRes; cy++ )
+        {
+            for ( int cx = 0; cx < grid->xRes; cx++ )
+            {
+                float  cellMax = 0.0;
+
+                //   Cell c lies on top of brick c, and only looks one
+                //   voxel beyond it. If that brick and its neighbours
+                //   are all empty, so is the cell.
+
+                BOOL  anyActive = NO;
+
+                for ( int bz = cz - 1; bz <= cz + 1 && ! anyActive; bz++ )
+                    for ( int by = cy - 1; by <= cy + 1 && ! anyActive; by++ )
+                        for ( int bx = cx - 1; bx <= cx + 1 && ! anyActive; bx++ )
+                        {
+                            if (   bx >= 0 && bx < voxels->xBricks
+                                && by >= 0 && by < voxels->yBricks
+                                && bz >= 0 && bz < voxels->zBricks
+                                && ARVOXELBRICKGRID_BRICK_INDEX(*voxels, bx, by, bz)
+                                   != ARVOXELBRICKGRID_EMPTY_BRICK )
+                                anyActive = YES;
+                        }
+
+                if ( anyActive )
+                {
+                    for ( int z = cz * CELL_SIZE - 1; z <= ( cz + 1 ) * CELL_SIZE; z++ )
+                        for ( int y = cy * CELL_SIZE - 1; y <= ( cy + 1 ) * CELL_SIZE; y++ )
+                            for ( int x = cx * CELL_SIZE - 1; x <= ( cx + 1 ) * CELL_SIZE; x++ )
+                                for ( int c = 0; c < voxels->nChannels; c++ )
+                                {
+                                    const float  v =
+                                        arvoxelbrickgrid_voxel( voxels, x, y, z, c );
+
+                                    if ( v > cellMax )
+                                        cellMax = v;
+                                }
+                }
+
+                grid->majorant[ ( cz * grid->yRes + cy ) * grid->xRes + cx ] =
+                    cellMax;
+            }
+        }
+    }
+}
+
+void arvolumemajorantgrid_copy(
+        const ArVolumeMajorantGrid  * grid,
+              ArVolumeMajorantGrid  * copiedGrid
+        )
+{
+    *copiedGrid = *grid;
+
+    if ( grid->majorant )
+    {
+        const int  n = grid->xRes * grid->yRes * grid->zRes;
+
+        copiedGrid->majorant = ALLOC_ARRAY( float, n );
+
+        memcpy( copiedGrid->majorant, grid->majorant, n * sizeof(float) );
+    }
+}
+
+void arvolumemajorantgrid_free_contents(
+        ArVolumeMajorantGrid  * grid
+        )
+{
+    if ( grid->majorant )
+        FREE_ARRAY( grid->majorant );
+
+    *grid = ARVOLUMEMAJORANTGRID_EMPTY;
+}
+
+void arvolumemajorantiterator_init_constant(
+              ArVolumeMajorantIterator  * iterator,
+        const double                      majorant,
+        const double                      tStart,
+        const double                      tEnd
+        )
+{
+    iterator->grid = NULL;
+    iterator->scale = 1.0;
+    iterator->constantMajorant = majorant;
+    iterator->t = tStart;
+    iterator->tEnd = tEnd;
+}
+
+void arvolumemajorantiterator_init_grid(
+              ArVolumeMajorantIterator  * iterator,
+        const ArVolumeMajorantGrid      * grid,
+        const Pnt3D                     * gridPoint,
+        const Vec3D                     * gridVector,
+        const double                      tStart,
+        const double                      tEnd
+        )
+{
+    iterator->grid = grid;
+    iterator->scale = 1.0;
+    iterator->constantMajorant = 0.0;
+    iterator->t = tStart;
+    iterator->tEnd = tEnd;
+
+    const int  res[3] = { grid->xRes, grid->yRes, grid->zRes };
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        const double  o = PNT3D_I( *gridPoint, i );
+        const double  d = VEC3D_I( *gridVector, i );
+        const double  p = o + tStart * d;
+
+        //   Points on the boundary of the volume may lie just outside
+        //   the grid; they are attributed to the outermost cells.
+
+        iterator->cell[i] = M_CLAMP( (int) floor( p ), 0, res[i] - 1 );
+
+        if ( d > 0.0 )
+        {
+            iterator->step[i]   = 1;
+            iterator->tNext[i]  = ( iterator->cell[i] + 1 - o ) / d;
+            iterator->tDelta[i] = 1.0 / d;
+        }
+        else if ( d < 0.0 )
+        {
+            iterator->step[i]   = -1;
+            iterator->tNext[i]  = ( iterator->cell[i] - o ) / d;
+            iterator->tDelta[i] = -1.0 / d;
+        }
+        else
+        {
+            iterator->step[i]   = 0;
+            iterator->tNext[i]  = MATH_HUGE_DOUBLE;
+            iterator->tDelta[i] = MATH_HUGE_DOUBLE;
+        }
+    }
+}
+
+BOOL arvolumemajorantiterator_next(
+        ArVolumeMajorantIterator  * iterator,
+        double                    * segmentStart,
+        double                    * segmentEnd,
+        double                    * majorant
+        )
+{
+    if ( iterator->t >= iterator->tEnd )
+        return NO;
+
+    *segmentStart = iterator->t;
+
+    if ( ! iterator->grid )
+    {
+        *segmentEnd = iterator->tEnd;
+        *majorant = iterator->constantMajorant * iterator->scale;
+
+        iterator->t = iterator->tEnd;
+
+        return YES;
+    }
+
+    const ArVolumeMajorantGrid  * grid = iterator->grid;
+
+    *majorant =
+          grid->majorant[
+              ( iterator->cell[2] * grid->yRes + iterator->cell[1] ) * grid->xRes
+            + iterator->cell[0]
+            ]
+        * iterator->scale;
+
+    //   Axis whose cell boundary is crossed next
+
+    int  axis = 0;
+
+    if ( iterator->tNext[1] < iterator->tNext[axis] ) axis = 1;
+    if ( iterator->tNext[2] < iterator->tNext[axis] ) axis = 2;
+
+    *segmentEnd = M_MIN( iterator->tNext[axis], iterator->tEnd );
+
+    //   Once the ray leaves the grid, the last cell is kept until the end
+    //   of the interval - everything beyond it is empty anyway.
+
+    const int  res[3] = { grid->xRes, grid->yRes, grid->zRes };
+    const int  nextCell = iterator->cell[axis] + iterator->step[axis];
+
+    if ( nextCell < 0 || nextCell >= res[axis] )
+    {
+        *segmentEnd = iterator->tEnd;
+    }
+    else
+    {
+        iterator->cell[axis] = nextCell;
+        iterator->tNext[axis] += iterator->tDelta[axis];
+    }
+
+    //   Cells which the ray only grazes can yield empty segments; these
+    //   are harmless, and just get skipped by the caller.
+
+    *segmentEnd = M_MAX( *segmentEnd, *segmentStart );
+
+    iterator->t = *segmentEnd;
+
+    return YES;
+}
+
+// ===========================================================================
@@ -0,0 +1,148 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+
+#include "ART_Foundation.h"
+
+ART_MODULE_INTERFACE(ArVoxelBrickGrid)
+
+/* ---------------------------------------------------------------------------
+    'ArVoxelBrickGrid'
+        Sparse storage for voxel volumes. The volume is split into bricks
+        of ARVOXELBRICKGRID_BRICK_SIZE^3 voxels, and only bricks that
+        contain at least one non-zero value are stored. A dense index
+        with one entry per brick position maps to the stored bricks, or
+        to ARVOXELBRICKGRID_EMPTY_BRICK. Everything in an empty brick
+        reads as zero.
+
+        Within a brick, voxels are laid out x fastest, then y, then z,
+        with 'nChannels' interleaved values per voxel - just like in a
+        dense volume.
+
+        Voxel coordinates are continuous, with voxel (i,j,k) centred on
+        the integer point (i,j,k). Lookups interpolate trilinearly
+        between the eight surrounding voxels.
+--------------------------------------------------------------------------- */
+
+#define ARVOXELBRICKGRID_BRICK_SIZE         8
+#define ARVOXELBRICKGRID_BRICK_VOXELS \
+    ( ARVOXELBRICKGRID_BRICK_SIZE * ARVOXELBRICKGRID_BRICK_SIZE * ARVOXELBRICKGRID_BRICK_SIZE )
+
+#define ARVOXELBRICKGRID_EMPTY_BRICK        -1
+
+typedef struct ArVoxelBrickGrid
+{
+    int       xRes, yRes, zRes;
+    int       nChannels;
+    int       xBricks, yBricks, zBricks;
+
+    int     * brickIndex;
+    int       numberOfBricks;
+    int       allocatedBricks;
+    float   * brickData;
+    float   * brickMax;
+}
+ArVoxelBrickGrid;
+
+#define ARVOXELBRICKGRID_BRICK_FLOATS(__g) \
+    ( ARVOXELBRICKGRID_BRICK_VOXELS * (__g).nChannels )
+
+#define ARVOXELBRICKGRID_BRICK_INDEX(__g,__bx,__by,__bz) \
+    ((__g).brickIndex[ ( (__bz) * (__g).yBricks + (__by) ) * (__g).xBricks + (__bx) ])
+
+//   Sets up an empty grid - all bricks are inactive.
+
+void arvoxelbrickgrid_init(
+        ArVoxelBrickGrid  * grid,
+        const int           xRes,
+        const int           yRes,
+        const int           zRes,
+        const int           nChannels
+        );
+
+void arvoxelbrickgrid_copy(
+        const ArVoxelBrickGrid  * grid,
+              ArVoxelBrickGrid  * copiedGrid
+        );
+
+void arvoxelbrickgrid_free_contents(
+        ArVoxelBrickGrid  * grid
+        );
+
+//   Converts one layer of bricks from dense data. 'slab' holds the
+//   ARVOXELBRICKGRID_BRICK_SIZE z slices starting at slice
+//   'brickLayer * ARVOXELBRICKGRID_BRICK_SIZE' (fewer for the last layer).
+//   This is what allows dense files to be streamed into a sparse grid
+//   without ever holding the entire dense volume in memory.
+
+void arvoxelbrickgrid_add_dense_layer(
+              ArVoxelBrickGrid  * grid,
+        const int                 brickLayer,
+        const float             * slab
+        );
+
+//   Largest value over all channels and bricks
+
+double arvoxelbrickgrid_max(
+        const ArVoxelBrickGrid  * grid
+        );
+
+//   Single voxel access, 0 outside the grid and in inactive bricks
+
+float arvoxelbrickgrid_voxel(
+        const ArVoxelBrickGrid  * grid,
+        const int                 x,
+        const int                 y,
+        const int                 z,
+        const int                 channel
+        );
+
+//   Trilinear lookup of all channels at a point in voxel coordinates;
+//   'values' has to have room for 'nChannels' doubles.
+
+void arvoxelbrickgrid_lookup(
+        const ArVoxelBrickGrid  * grid,
+        const Pnt3D             * voxelPoint,
+              double            * values
+        );
+
+//   Brick payload I/O: brick index, per-brick maxima and the active
+//   bricks, in this order. Only the active bricks are stored, and only
+//   they get read back. Reading expects a grid that was set up with
+//   arvoxelbrickgrid_init() for the resolution of the file. Both return
+//   NO on I/O errors or inconsistent data.
+
+BOOL arvoxelbrickgrid_write_bricks(
+        const ArVoxelBrickGrid  * grid,
+              FILE              * file
+        );
+
+BOOL arvoxelbrickgrid_read_bricks(
+        ArVoxelBrickGrid  * grid,
+        FILE              * file
+        );
+
+// ===========================================================================
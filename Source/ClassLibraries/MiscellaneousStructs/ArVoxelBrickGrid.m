@@ -0,0 +1,447 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+
+#define ART_MODULE_NAME     ArVoxelBrickGrid
+
+#import "ArVoxelBrickGrid.h"
+
+ART_NO_MODULE_INITIALISATION_FUNCTION_NECESSARY
+
+ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
+
+
+#define BRICK_SIZE      ARVOXELBRICKGRID_BRICK_SIZE
+#define BRICK_VOXELS    ARVOXELBRICKGRID_BRICK_VOXELS
+
+void arvoxelbrickgrid_init(
+        ArVoxelBrickGrid  * grid,
+        const int           xRes,
+        const int           yRes,
+        const int           zRes,
+        const int           nChannels
+        )
+{
+    grid->xRes = xRes;
+    grid->yRes = yRes;
+    grid->zRes = zRes;
+    grid->nChannels = nChannels;
+
+    grid->xBricks = ( xRes + BRICK_SIZE - 1 ) / BRICK_SIZE;
+    grid->yBricks = ( yRes + BRICK_SIZE - 1 ) / BRICK_SIZE;
+    grid->zBricks = ( zRes + BRICK_SIZE - 1 ) / BRICK_SIZE;
+
+    const int  indexSize = grid->xBricks * grid->yBricks * grid->zBricks;
+
+    grid->brickIndex = ALLOC_ARRAY( int, indexSize );
+
+    for ( int i = 0; i < indexSize; i++ )
+        grid->brickIndex[i] = ARVOXELBRICKGRID_EMPTY_BRICK;
+
+    grid->numberOfBricks = 0;
+    grid->allocatedBricks = 0;
+    grid->brickData = NULL;
+    grid->brickMax = NULL;
+}
+
+void arvoxelbrickgrid_copy(
+        const ArVoxelBrickGrid  * grid,
+              ArVoxelBrickGrid  * copiedGrid
+        )
+{
+    *copiedGrid = *grid;
+
+    const int  indexSize = grid->xBricks * grid->yBricks * grid->zBricks;
+    const int  brickFloats = ARVOXELBRICKGRID_BRICK_FLOATS(*grid);
+
+    copiedGrid->brickIndex = ALLOC_ARRAY( int, indexSize );
+    memcpy( copiedGrid->brickIndex, grid->brickIndex, indexSize * sizeof(int) );
+
+    copiedGrid->allocatedBricks = grid->numberOfBricks;
+    copiedGrid->brickData = NULL;
+    copiedGrid->brickMax = NULL;
+
+    if ( grid->numberOfBricks > 0 )
+    {
+        copiedGrid->brickData =
+            ALLOC_ARRAY( float, (size_t) grid->numberOfBricks * brickFloats );
+        copiedGrid->brickMax =
+            ALLOC_ARRAY( float, grid->numberOfBricks );
+
+        memcpy(
+            copiedGrid->brickData,
+            grid->brickData,
+            (size_t) grid->numberOfBricks * brickFloats * sizeof(float)
+            );
+        memcpy(
+            copiedGrid->brickMax,
+            grid->brickMax,
+            grid->numberOfBricks * sizeof(float)
+            );
+    }
+}
+
+void arvoxelbrickgrid_free_contents(
+        ArVoxelBrickGrid  * grid
+        )
+{
+    if ( grid->brickIndex )
+        FREE_ARRAY( grid->brickIndex );
+
+    if ( grid->brickData )
+        FREE_ARRAY( grid->brickData );
+
+    if ( grid->brickMax )
+        FREE_ARRAY( grid->brickMax );
+
+    grid->numberOfBricks = 0;
+    grid->allocatedBricks = 0;
+}
+
+static void arvoxelbrickgrid_reserve(
+        ArVoxelBrickGrid  * grid,
+        const int           numberOfBricks
+        )
+{
+    if ( numberOfBricks <= grid->allocatedBricks )
+        return;
+
+    int  newSize = M_MAX( grid->allocatedBricks * 2, 64 );
+
+    if ( newSize < numberOfBricks )
+        newSize = numberOfBricks;
+
+    grid->brickData =
+        REALLOC_ARRAY(
+            grid->brickData,
+            float,
+            (size_t) newSize * ARVOXELBRICKGRID_BRICK_FLOATS(*grid)
+            );
+    grid->brickMax =
+        REALLOC_ARRAY( grid->brickMax, float, newSize );
+
+    if ( ! grid->brickData || ! grid->brickMax )
+        ART_ERRORHANDLING_FATAL_ERROR(
+            "out of memory for %d volume bricks"
+            ,   newSize
+            );
+
+    grid->allocatedBricks = newSize;
+}
+
+void arvoxelbrickgrid_add_dense_layer(
+              ArVoxelBrickGrid  * grid,
+        const int                 brickLayer,
+        const float             * slab
+        )
+{
+    const int  nc = grid->nChannels;
+    const int  brickFloats = ARVOXELBRICKGRID_BRICK_FLOATS(*grid);
+    const int  z0 = brickLayer * BRICK_SIZE;
+    const int  zCount = M_MIN( BRICK_SIZE, grid->zRes - z0 );
+
+    float  * brick = ALLOC_ARRAY( float, brickFloats );
+
+    for ( int by = 0; by < grid->yBricks; by++ )
+    {
+        const int  y0 = by * BRICK_SIZE;
+        const int  yCount = M_MIN( BRICK_SIZE, grid->yRes - y0 );
+
+        for ( int bx = 0; bx < grid->xBricks; bx++ )
+        {
+            const int  x0 = bx * BRICK_SIZE;
+            const int  xCount = M_MIN( BRICK_SIZE, grid->xRes - x0 );
+
+            //   Bricks at the far faces of the volume are only partially
+            //   covered by voxels, the rest stays zero.
+
+            memset( brick, 0, brickFloats * sizeof(float) );
+
+            float  brickMax = 0.0;
+
+            for ( int z = 0; z < zCount; z++ )
+            {
+                for ( int y = 0; y < yCount; y++ )
+                {
+                    const float  * src =
+                          slab
+                        + ( ( (size_t) z * grid->yRes + y0 + y ) * grid->xRes + x0 ) * nc;
+
+                    float  * dst =
+                        brick + ( ( z * BRICK_SIZE + y ) * BRICK_SIZE ) * nc;
+
+                    for ( int i = 0; i < xCount * nc; i++ )
+                    {
+                        dst[i] = src[i];
+
+                        if ( src[i] > brickMax )
+                            brickMax = src[i];
+                    }
+                }
+            }
+
+            //   Negative values are never looked up as anything but zero,
+            //   so bricks without positive values need not be stored.
+
+            if ( brickMax <= 0.0 )
+                continue;
+
+            arvoxelbrickgrid_reserve( grid, grid->numberOfBricks + 1 );
+
+            memcpy(
+                grid->brickData + (size_t) grid->numberOfBricks * brickFloats,
+                brick,
+                brickFloats * sizeof(float)
+                );
+
+            grid->brickMax[grid->numberOfBricks] = brickMax;
+
+            ARVOXELBRICKGRID_BRICK_INDEX(*grid, bx, by, brickLayer) =
+                grid->numberOfBricks;
+
+            grid->numberOfBricks++;
+        }
+    }
+
+    FREE_ARRAY( brick );
+}
+
+double arvoxelbrickgrid_max(
+        const ArVoxelBrickGrid  * grid
+        )
+{
+    double  result = 0.0;
+
+    for ( int i = 0; i < grid->numberOfBricks; i++ )
+        result = M_MAX( result, grid->brickMax[i] );
+
+    return result;
+}
+
+float arvoxelbrickgrid_voxel(
+        const ArVoxelBrickGrid  * grid,
+        const int                 x,
+        const int                 y,
+        const int                 z,
+        const int                 channel
+        )
+{
+    if (   x < 0 || x >= grid->xRes
+        || y < 0 || y >= grid->yRes
+        || z < 0 || z >= grid->zRes )
+        return 0.0;
+
+    const int  brick =
+        ARVOXELBRICKGRID_BRICK_INDEX(
+            *grid,
+            x / BRICK_SIZE,
+            y / BRICK_SIZE,
+            z / BRICK_SIZE
+            );
+
+    if ( brick == ARVOXELBRICKGRID_EMPTY_BRICK )
+        return 0.0;
+
+    const int  voxel =
+          ( ( z % BRICK_SIZE ) * BRICK_SIZE + ( y % BRICK_SIZE ) ) * BRICK_SIZE
+        + ( x % BRICK_SIZE );
+
+    return
+        grid->brickData[
+              (size_t) brick * ARVOXELBRICKGRID_BRICK_FLOATS(*grid)
+            + voxel * grid->nChannels
+            + channel
+            ];
+}
+
+void arvoxelbrickgrid_lookup(
+        const ArVoxelBrickGrid  * grid,
+        const Pnt3D             * voxelPoint,
+              double            * values
+        )
+{
+    const int  nc = grid->nChannels;
+
+    for ( int c = 0; c < nc; c++ )
+        values[c] = 0.0;
+
+    const double  fx = floor( XC(*voxelPoint) );
+    const double  fy = floor( YC(*voxelPoint) );
+    const double  fz = floor( ZC(*voxelPoint) );
+
+    //   Entirely outside - this also keeps the int conversion below safe
+
+    if (   fx < -1.0 || fx >= grid->xRes
+        || fy < -1.0 || fy >= grid->yRes
+        || fz < -1.0 || fz >= grid->zRes )
+        return;
+
+    const int  x0 = (int) fx, y0 = (int) fy, z0 = (int) fz;
+
+    const double  wx = XC(*voxelPoint) - fx;
+    const double  wy = YC(*voxelPoint) - fy;
+    const double  wz = ZC(*voxelPoint) - fz;
+
+    //   Fast path: all eight voxels lie inside one active brick
+
+    if (   x0 >= 0 && y0 >= 0 && z0 >= 0
+        && x0 % BRICK_SIZE != BRICK_SIZE - 1
+        && y0 % BRICK_SIZE != BRICK_SIZE - 1
+        && z0 % BRICK_SIZE != BRICK_SIZE - 1 )
+    {
+        const int  brick =
+            ARVOXELBRICKGRID_BRICK_INDEX(
+                *grid,
+                x0 / BRICK_SIZE,
+                y0 / BRICK_SIZE,
+                z0 / BRICK_SIZE
+                );
+
+        if ( brick == ARVOXELBRICKGRID_EMPTY_BRICK )
+            return;
+
+        //   Voxels beyond the far faces of the volume are zero in the
+        //   brick as well, so no further range checks are needed.
+
+        const float  * base =
+              grid->brickData
+            + (size_t) brick * ARVOXELBRICKGRID_BRICK_FLOATS(*grid)
+            + ( ( ( z0 % BRICK_SIZE ) * BRICK_SIZE + ( y0 % BRICK_SIZE ) )
+                * BRICK_SIZE + ( x0 % BRICK_SIZE ) ) * nc;
+
+        const int  dx = nc;
+        const int  dy = BRICK_SIZE * nc;
+        const int  dz = BRICK_SIZE * BRICK_SIZE * nc;
+
+        for ( int c = 0; c < nc; c++ )
+        {
+            const float  * v = base + c;
+
+            const double  c00 = v[0]       + wx * ( v[dx]           - v[0] );
+            const double  c10 = v[dy]      + wx * ( v[dy + dx]      - v[dy] );
+            const double  c01 = v[dz]      + wx * ( v[dz + dx]      - v[dz] );
+            const double  c11 = v[dz + dy] + wx * ( v[dz + dy + dx] - v[dz + dy] );
+
+            const double  c0 = c00 + wy * ( c10 - c00 );
+            const double  c1 = c01 + wy * ( c11 - c01 );
+
+            values[c] = c0 + wz * ( c1 - c0 );
+        }
+
+        return;
+    }
+
+    //   General case, across brick boundaries and the faces of the volume
+
+    for ( int c = 0; c < nc; c++ )
+    {
+        double  result = 0.0;
+
+        for ( int k = 0; k < 8; k++ )
+        {
+            const int  ix = k & 1, iy = ( k >> 1 ) & 1, iz = k >> 2;
+
+            const double  weight =
+                  ( ix ? wx : 1.0 - wx )
+                * ( iy ? wy : 1.0 - wy )
+                * ( iz ? wz : 1.0 - wz );
+
+            result +=
+                  weight
+                * arvoxelbrickgrid_voxel( grid, x0 + ix, y0 + iy, z0 + iz, c );
+        }
+
+        values[c] = result;
+    }
+}
+
+BOOL arvoxelbrickgrid_write_bricks(
+        const ArVoxelBrickGrid  * grid,
+              FILE              * file
+        )
+{
+    const int32_t  header[2] = { BRICK_SIZE, grid->numberOfBricks };
+    const size_t   indexSize = (size_t) grid->xBricks * grid->yBricks * grid->zBricks;
+    const size_t   dataSize  = (size_t) grid->numberOfBricks * ARVOXELBRICKGRID_BRICK_FLOATS(*grid);
+
+    if ( fwrite( header, sizeof(int32_t), 2, file ) != 2 )
+        return NO;
+
+    if ( fwrite( grid->brickIndex, sizeof(int), indexSize, file ) != indexSize )
+        return NO;
+
+    if ( grid->numberOfBricks == 0 )
+        return YES;
+
+    if ( fwrite( grid->brickMax, sizeof(float), grid->numberOfBricks, file )
+         != (size_t) grid->numberOfBricks )
+        return NO;
+
+    return fwrite( grid->brickData, sizeof(float), dataSize, file ) == dataSize;
+}
+
+BOOL arvoxelbrickgrid_read_bricks(
+        ArVoxelBrickGrid  * grid,
+        FILE              * file
+        )
+{
+    int32_t  header[2];
+
+    if ( fread( header, sizeof(int32_t), 2, file ) != 2 )
+        return NO;
+
+    if ( header[0] != BRICK_SIZE || header[1] < 0 )
+        return NO;
+
+    const size_t  indexSize = (size_t) grid->xBricks * grid->yBricks * grid->zBricks;
+
+    if ( fread( grid->brickIndex, sizeof(int), indexSize, file ) != indexSize )
+        return NO;
+
+    for ( size_t i = 0; i < indexSize; i++ )
+    {
+        if (   grid->brickIndex[i] < ARVOXELBRICKGRID_EMPTY_BRICK
+            || grid->brickIndex[i] >= header[1] )
+            return NO;
+    }
+
+    arvoxelbrickgrid_reserve( grid, header[1] );
+
+    grid->numberOfBricks = header[1];
+
+    if ( grid->numberOfBricks == 0 )
+        return YES;
+
+    const size_t  dataSize = (size_t) grid->numberOfBricks * ARVOXELBRICKGRID_BRICK_FLOATS(*grid);
+
+    if ( fread( grid->brickMax, sizeof(float), grid->numberOfBricks, file )
+         != (size_t) grid->numberOfBricks )
+        return NO;
+
+    return fread( grid->brickData, sizeof(float), dataSize, file ) == dataSize;
+}
+
+// ===========================================================================
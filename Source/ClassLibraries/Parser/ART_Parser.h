@@ -33,6 +33,7 @@ ART_LIBRARY_INTERFACE(ART_Parser)
 #import "ArfMeasurementArchive.h"
 #import "ArfArm.h"
 #import "ArfNative.h"
+#import "ArPLYMesh.h"
 #import "ArfPLY.h"
 #import "ArfVol.h"
 #import "ArcBinaryCoder.h"
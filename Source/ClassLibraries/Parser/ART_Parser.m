@@ -35,6 +35,7 @@ ART_LIBRARY_INITIALISATION_FUNCTION
     ART_PERFORM_MODULE_INITIALISATION( ArfMeasurementArchive )
     ART_PERFORM_MODULE_INITIALISATION( ArfArm )
     ART_PERFORM_MODULE_INITIALISATION( ArfNative )
+    ART_PERFORM_MODULE_INITIALISATION( ArPLYMesh )
     ART_PERFORM_MODULE_INITIALISATION( ArfPLY )
     ART_PERFORM_MODULE_INITIALISATION( ArfVol )
     ART_PERFORM_MODULE_INITIALISATION( ArcBinaryCoder )
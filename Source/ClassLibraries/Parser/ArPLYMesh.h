@@ -0,0 +1,83 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+
+#include "ART_Foundation.h"
+
+ART_MODULE_INTERFACE(ArPLYMesh)
+
+/* ---------------------------------------------------------------------------
+    'ArPLYMesh'
+        The raw contents of a PLY triangle mesh, as needed for an
+        ArnTriangleMesh: vertex positions and optional normals (each with
+        one extra, huge terminator entry), three vertex indices per face,
+        and the extremal points of the vertices.
+
+        Binary little endian files are read straight from a memory
+        mapping, and ASCII files are split into chunks that are parsed in
+        parallel. Layouts these fast paths do not handle (other elements
+        with lists, non-triangular faces, big endian data, ...) are read
+        via rply.
+--------------------------------------------------------------------------- */
+
+typedef struct ArPLYMesh
+{
+    long          numberOfVertices;
+    long          numberOfFaces;
+    Pnt3D       * vertices;
+    FVec3D      * normals;
+    ArLongArray   faces;
+    Pnt3D         minPoint;
+    Pnt3D         maxPoint;
+}
+ArPLYMesh;
+
+//   Both return NO if the file could not be read; parsing uses up to
+//   art_maximum_number_of_working_threads worker threads.
+
+BOOL arplymesh_read(
+              ART_GV        * art_gv,
+              ArPLYMesh     * mesh,
+        const char          * pathToPlyFile
+        );
+
+//   Reads several independent PLY files at once, one file per worker.
+
+void arplymesh_read_files(
+              ART_GV        * art_gv,
+        const unsigned int    numberOfFiles,
+        const char         ** pathToPlyFile,
+              ArPLYMesh     * mesh,
+              BOOL          * success
+        );
+
+//   Only needed for meshes that are not handed over to an ArnTriangleMesh
+
+void arplymesh_free_contents(
+        ArPLYMesh  * mesh
+        );
+
+// ===========================================================================
@@ -0,0 +1,1409 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+
+#define ART_MODULE_NAME     ArPLYMesh
+
+#import "ArPLYMesh.h"
+
+#import "rply.h"
+#import "ArcWorkerPool.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+ART_NO_MODULE_INITIALISATION_FUNCTION_NECESSARY
+
+ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
+
+
+/* ---------------------------------------------------------------------------
+    Parallel loops
+        'work' is called once for each index in [0,n), by the workers of
+        an ArcWorkerPool. With 'numberOfThreads' of 1 or less - e.g. for
+        files that are already read in parallel with each other - the
+        loop just runs on the calling thread.
+--------------------------------------------------------------------------- */
+
+@interface ArcPLYJobs
+        : ArcObject
+{
+@public
+    void            (* work)( void *, unsigned int );
+    void             * data;
+    ArcWorkerPool    * pool;
+}
+
+- (void) _worker
+        : (ArcUnsignedInteger *) threadIndex
+        ;
+
+@end
+
+@implementation ArcPLYJobs
+
+- (void) _worker
+        : (ArcUnsignedInteger *) threadIndex
+{
+    (void) threadIndex;
+
+    unsigned int  i;
+
+    while ( [ pool nextWorkItem: & i ] )
+        work( data, i );
+}
+
+@end
+
+static void arplymesh_parallel(
+              ART_GV        * art_gv,
+        const unsigned int    n,
+        void               (* work)( void *, unsigned int ),
+        void                * data,
+        const unsigned int    numberOfThreads
+        )
+{
+    if ( numberOfThreads <= 1 || n <= 1 )
+    {
+        for ( unsigned int i = 0; i < n; i++ )
+            work( data, i );
+
+        return;
+    }
+
+    ArcWorkerPool  * pool =
+        [ ALLOC_INIT_OBJECT(ArcWorkerPool)
+            :   n
+            ];
+
+    ArcPLYJobs  * jobs = [ ALLOC_INIT_OBJECT(ArcPLYJobs) ];
+
+    jobs->work = work;
+    jobs->data = data;
+    jobs->pool = pool;
+
+    [ pool run
+        :   @selector(_worker:)
+        :   jobs
+        ];
+
+    RELEASE_OBJECT(jobs);
+    RELEASE_OBJECT(pool);
+}
+
+
+/* ---------------------------------------------------------------------------
+    Header
+--------------------------------------------------------------------------- */
+
+#define ARPLY_MAX_ELEMENTS      16
+#define ARPLY_MAX_PROPERTIES    32
+
+typedef enum ArPLYType
+{
+    arplytype_invalid,
+    arplytype_int8,
+    arplytype_uint8,
+    arplytype_int16,
+    arplytype_uint16,
+    arplytype_int32,
+    arplytype_uint32,
+    arplytype_float32,
+    arplytype_float64
+}
+ArPLYType;
+
+typedef enum ArPLYFormat
+{
+    arplyformat_ascii,
+    arplyformat_binary_le,
+    arplyformat_binary_be
+}
+ArPLYFormat;
+
+typedef struct ArPLYProperty
+{
+    char       name[32];
+    ArPLYType  type;
+    BOOL       isList;
+    ArPLYType  countType;
+}
+ArPLYProperty;
+
+typedef struct ArPLYElement
+{
+    char           name[32];
+    long           count;
+    int            numberOfProperties;
+    ArPLYProperty  property[ARPLY_MAX_PROPERTIES];
+}
+ArPLYElement;
+
+typedef struct ArPLYHeader
+{
+    ArPLYFormat    format;
+    int            numberOfElements;
+    ArPLYElement   element[ARPLY_MAX_ELEMENTS];
+    size_t         dataOffset;
+}
+ArPLYHeader;
+
+static const struct { const char * name; ArPLYType type; } arply_type_names[] =
+{
+    { "char", arplytype_int8 },       { "int8", arplytype_int8 },
+    { "uchar", arplytype_uint8 },     { "uint8", arplytype_uint8 },
+    { "short", arplytype_int16 },     { "int16", arplytype_int16 },
+    { "ushort", arplytype_uint16 },   { "uint16", arplytype_uint16 },
+    { "int", arplytype_int32 },       { "int32", arplytype_int32 },
+    { "uint", arplytype_uint32 },     { "uint32", arplytype_uint32 },
+    { "float", arplytype_float32 },   { "float32", arplytype_float32 },
+    { "double", arplytype_float64 },  { "float64", arplytype_float64 },
+    { NULL, arplytype_invalid }
+};
+
+static const size_t arply_type_size[] = { 0, 1, 1, 2, 2, 4, 4, 4, 8 };
+
+static ArPLYType arply_type(
+        const char  * name
+        )
+{
+    for ( int i = 0; arply_type_names[i].name; i++ )
+        if ( strcmp( name, arply_type_names[i].name ) == 0 )
+            return arply_type_names[i].type;
+
+    return arplytype_invalid;
+}
+
+static BOOL arply_parse_header(
+        const char   * data,
+        const size_t   size,
+        ArPLYHeader  * header
+        )
+{
+    memset( header, 0, sizeof(ArPLYHeader) );
+
+    if ( size < 4 || strncmp( data, "ply", 3 ) != 0 )
+        return NO;
+
+    BOOL    formatSeen = NO;
+    size_t  pos = 0;
+
+    while ( pos < size )
+    {
+        const char  * lineEnd = memchr( data + pos, '\n', size - pos );
+
+        if ( ! lineEnd )
+            return NO;
+
+        char    line[256];
+        size_t  length = lineEnd - ( data + pos );
+
+        if ( length >= sizeof(line) )
+        {
+            //   Only comments may be that long
+
+            if ( strncmp( data + pos, "comment", 7 ) != 0 )
+                return NO;
+
+            pos += length + 1;
+            continue;
+        }
+
+        memcpy( line, data + pos, length );
+        line[length] = 0;
+
+        if ( length > 0 && line[length - 1] == '\r' )
+            line[length - 1] = 0;
+
+        pos += length + 1;
+
+        char  word[4][32];
+
+        int  words =
+            sscanf( line, "%31s %31s %31s %31s", word[0], word[1], word[2], word[3] );
+
+        if ( words <= 0 )
+            continue;
+
+        if ( strcmp( word[0], "end_header" ) == 0 )
+        {
+            header->dataOffset = pos;
+            return formatSeen && header->numberOfElements > 0;
+        }
+        else if ( strcmp( word[0], "format" ) == 0 && words >= 2 )
+        {
+            if ( strcmp( word[1], "ascii" ) == 0 )
+                header->format = arplyformat_ascii;
+            else if ( strcmp( word[1], "binary_little_endian" ) == 0 )
+                header->format = arplyformat_binary_le;
+            else if ( strcmp( word[1], "binary_big_endian" ) == 0 )
+                header->format = arplyformat_binary_be;
+            else
+                return NO;
+
+            formatSeen = YES;
+        }
+        else if ( strcmp( word[0], "element" ) == 0 && words >= 3 )
+        {
+            if ( header->numberOfElements == ARPLY_MAX_ELEMENTS )
+                return NO;
+
+            ArPLYElement  * element =
+                & header->element[ header->numberOfElements++ ];
+
+            strcpy( element->name, word[1] );
+            element->count = atol( word[2] );
+
+            if ( element->count < 0 )
+                return NO;
+        }
+        else if ( strcmp( word[0], "property" ) == 0 && words >= 3 )
+        {
+            if ( header->numberOfElements == 0 )
+                return NO;
+
+            ArPLYElement  * element =
+                & header->element[ header->numberOfElements - 1 ];
+
+            if ( element->numberOfProperties == ARPLY_MAX_PROPERTIES )
+                return NO;
+
+            ArPLYProperty  * property =
+                & element->property[ element->numberOfProperties++ ];
+
+            if ( strcmp( word[1], "list" ) == 0 )
+            {
+                if ( words < 4 )
+                    return NO;
+
+                char  name[32];
+
+                if ( sscanf( line, "%*s %*s %*s %*s %31s", name ) != 1 )
+                    return NO;
+
+                property->isList    = YES;
+                property->countType = arply_type( word[2] );
+                property->type      = arply_type( word[3] );
+                strcpy( property->name, name );
+
+                if (   property->countType == arplytype_invalid
+                    || property->countType == arplytype_float32
+                    || property->countType == arplytype_float64 )
+                    return NO;
+            }
+            else
+            {
+                property->isList = NO;
+                property->type   = arply_type( word[1] );
+                strcpy( property->name, word[2] );
+            }
+
+            if ( property->type == arplytype_invalid )
+                return NO;
+        }
+    }
+
+    return NO;
+}
+
+static int arply_find_property(
+        const ArPLYElement  * element,
+        const char          * name
+        )
+{
+    for ( int i = 0; i < element->numberOfProperties; i++ )
+        if (   ! element->property[i].isList
+            && strcmp( element->property[i].name, name ) == 0 )
+            return i;
+
+    return -1;
+}
+
+static double arply_binary_value(
+        const unsigned char  * p,
+        const ArPLYType        type
+        )
+{
+    //   Little endian data on a little endian host only
+
+    switch ( type )
+    {
+        case arplytype_int8:    { int8_t   v; memcpy( & v, p, 1 ); return v; }
+        case arplytype_uint8:   { uint8_t  v; memcpy( & v, p, 1 ); return v; }
+        case arplytype_int16:   { int16_t  v; memcpy( & v, p, 2 ); return v; }
+        case arplytype_uint16:  { uint16_t v; memcpy( & v, p, 2 ); return v; }
+        case arplytype_int32:   { int32_t  v; memcpy( & v, p, 4 ); return v; }
+        case arplytype_uint32:  { uint32_t v; memcpy( & v, p, 4 ); return v; }
+        case arplytype_float32: { float    v; memcpy( & v, p, 4 ); return v; }
+        case arplytype_float64: { double   v; memcpy( & v, p, 8 ); return v; }
+        default:                return 0.0;
+    }
+}
+
+
+/* ---------------------------------------------------------------------------
+    Shared state of the fast paths
+--------------------------------------------------------------------------- */
+
+#define ARPLY_CHUNKS_PER_THREAD     4
+
+typedef struct ArPLYChunk
+{
+    const char  * begin;
+    const char  * end;
+    long          first;
+    long          count;
+    Pnt3D         minPoint;
+    Pnt3D         maxPoint;
+    BOOL          failed;
+}
+ArPLYChunk;
+
+typedef struct ArPLYReader
+{
+    ART_GV                * art_gv;
+    ArPLYMesh             * mesh;
+    const ArPLYElement    * vertexElement;
+    const ArPLYElement    * faceElement;
+
+    //   Property indices (ASCII) or byte offsets (binary) of the vertex
+    //   coordinates and normals, the latter -1 if not present
+
+    int                     coordinate[3];
+    int                     normal[3];
+    ArPLYType               coordinateType[3];
+    ArPLYType               normalType[3];
+
+    size_t                  vertexStride;
+    const unsigned char   * vertexData;
+    const unsigned char   * faceData;
+    ArPLYType               faceCountType;
+    ArPLYType               faceIndexType;
+
+    unsigned int            numberOfChunks;
+    ArPLYChunk            * chunk;
+}
+ArPLYReader;
+
+static void arply_chunk_reset_bounds(
+        ArPLYChunk  * chunk
+        )
+{
+    //   Same initial values as the original extremal point search
+
+    chunk->minPoint =
+        PNT3D( MATH_HUGE_DOUBLE, MATH_HUGE_DOUBLE, MATH_HUGE_DOUBLE );
+    chunk->maxPoint =
+        PNT3D( MATH_TINY_DOUBLE, MATH_TINY_DOUBLE, MATH_TINY_DOUBLE );
+    chunk->failed = NO;
+}
+
+static void arply_chunk_add_vertex(
+              ArPLYChunk  * chunk,
+        const Pnt3D       * vertex
+        )
+{
+    for ( int j = 0; j < 3; j++ )
+    {
+        PNT3D_I( chunk->minPoint, j ) =
+            MIN( PNT3D_I( *vertex, j ), PNT3D_I( chunk->minPoint, j ) );
+        PNT3D_I( chunk->maxPoint, j ) =
+            MAX( PNT3D_I( *vertex, j ), PNT3D_I( chunk->maxPoint, j ) );
+    }
+}
+
+static void arply_allocate_mesh(
+        ArPLYMesh  * mesh,
+        const long   numberOfVertices,
+        const long   numberOfFaces,
+        const BOOL   withNormals
+        )
+{
+    mesh->numberOfVertices = numberOfVertices;
+    mesh->numberOfFaces = numberOfFaces;
+
+    mesh->vertices = ALLOC_ARRAY( Pnt3D, numberOfVertices + 1 );
+    mesh->vertices[numberOfVertices] = PNT3D_HUGE;
+
+    mesh->normals = NULL;
+
+    if ( withNormals )
+    {
+        mesh->normals = ALLOC_ARRAY( FVec3D, numberOfVertices + 1 );
+        mesh->normals[numberOfVertices] =
+            FVEC3D( MATH_HUGE_FLOAT, MATH_HUGE_FLOAT, MATH_HUGE_FLOAT );
+    }
+
+    mesh->faces = arlongarray_init( numberOfFaces * 3 );
+}
+
+static BOOL arply_finish_chunks(
+        ArPLYReader  * reader
+        )
+{
+    ArPLYMesh   * mesh = reader->mesh;
+    ArPLYChunk    all;
+
+    arply_chunk_reset_bounds( & all );
+
+    for ( unsigned int i = 0; i < reader->numberOfChunks; i++ )
+    {
+        if ( reader->chunk[i].failed )
+            return NO;
+
+        //   Chunks without vertices still carry the initial values,
+        //   which are neutral in the respective MIN and MAX
+
+        for ( int j = 0; j < 3; j++ )
+        {
+            PNT3D_I( all.minPoint, j ) =
+                MIN( PNT3D_I( reader->chunk[i].minPoint, j ),
+                     PNT3D_I( all.minPoint, j ) );
+            PNT3D_I( all.maxPoint, j ) =
+                MAX( PNT3D_I( reader->chunk[i].maxPoint, j ),
+                     PNT3D_I( all.maxPoint, j ) );
+        }
+    }
+
+    mesh->minPoint = all.minPoint;
+    mesh->maxPoint = all.maxPoint;
+
+    return YES;
+}
+
+static BOOL arply_vertex_properties(
+        ArPLYReader  * reader,
+        const BOOL     byteOffsets
+        )
+{
+    const ArPLYElement  * element = reader->vertexElement;
+
+    static const char  * coordinateName[3] = { "x", "y", "z" };
+    static const char  * normalName[3] = { "nx", "ny", "nz" };
+
+    BOOL  withNormals = YES;
+
+    for ( int j = 0; j < 3; j++ )
+    {
+        reader->coordinate[j] = arply_find_property( element, coordinateName[j] );
+        reader->normal[j] = arply_find_property( element, normalName[j] );
+
+        if ( reader->coordinate[j] < 0 )
+            return NO;
+
+        if ( reader->normal[j] < 0 )
+            withNormals = NO;
+    }
+
+    for ( int i = 0; i < element->numberOfProperties; i++ )
+        if ( element->property[i].isList )
+            return NO;
+
+    for ( int j = 0; j < 3; j++ )
+    {
+        reader->coordinateType[j] =
+            element->property[ reader->coordinate[j] ].type;
+
+        if ( withNormals )
+            reader->normalType[j] =
+                element->property[ reader->normal[j] ].type;
+        else
+            reader->normal[j] = -1;
+    }
+
+    if ( byteOffsets )
+    {
+        size_t  offset[ARPLY_MAX_PROPERTIES];
+
+        reader->vertexStride = 0;
+
+        for ( int i = 0; i < element->numberOfProperties; i++ )
+        {
+            offset[i] = reader->vertexStride;
+            reader->vertexStride += arply_type_size[ element->property[i].type ];
+        }
+
+        for ( int j = 0; j < 3; j++ )
+        {
+            reader->coordinate[j] = (int) offset[ reader->coordinate[j] ];
+
+            if ( withNormals )
+                reader->normal[j] = (int) offset[ reader->normal[j] ];
+        }
+    }
+
+    return YES;
+}
+
+
+/* ---------------------------------------------------------------------------
+    Binary little endian files
+--------------------------------------------------------------------------- */
+
+static void arply_binary_vertex_chunk(
+        void          * data,
+        unsigned int    index
+        )
+{
+    ArPLYReader  * reader = data;
+    ArPLYChunk   * chunk = & reader->chunk[index];
+    ArPLYMesh    * mesh = reader->mesh;
+
+    arply_chunk_reset_bounds( chunk );
+
+    const unsigned char  * record =
+        reader->vertexData + chunk->first * reader->vertexStride;
+
+    for ( long i = chunk->first; i < chunk->first + chunk->count; i++ )
+    {
+        for ( int j = 0; j < 3; j++ )
+            PNT3D_I( mesh->vertices[i], j ) =
+                arply_binary_value(
+                    record + reader->coordinate[j],
+                    reader->coordinateType[j]
+                    );
+
+        if ( mesh->normals )
+            for ( int j = 0; j < 3; j++ )
+                mesh->normals[i].c.x[j] =
+                    arply_binary_value(
+                        record + reader->normal[j],
+                        reader->normalType[j]
+                        );
+
+        arply_chunk_add_vertex( chunk, & mesh->vertices[i] );
+
+        record += reader->vertexStride;
+    }
+}
+
+static void arply_binary_face_chunk(
+        void          * data,
+        unsigned int    index
+        )
+{
+    ArPLYReader  * reader = data;
+    ArPLYChunk   * chunk = & reader->chunk[index];
+    long         * faces = arlongarray_array( & reader->mesh->faces );
+
+    const size_t  countSize = arply_type_size[ reader->faceCountType ];
+    const size_t  indexSize = arply_type_size[ reader->faceIndexType ];
+    const size_t  stride = countSize + 3 * indexSize;
+
+    const unsigned char  * record =
+        reader->faceData + chunk->first * stride;
+
+    chunk->failed = NO;
+
+    for ( long i = chunk->first; i < chunk->first + chunk->count; i++ )
+    {
+        //   Fixed size records rely on all faces being triangles
+
+        if ( arply_binary_value( record, reader->faceCountType ) != 3.0 )
+        {
+            chunk->failed = YES;
+            return;
+        }
+
+        for ( int j = 0; j < 3; j++ )
+            faces[ 3 * i + j ] = (long)
+                arply_binary_value(
+                    record + countSize + j * indexSize,
+                    reader->faceIndexType
+                    );
+
+        record += stride;
+    }
+}
+
+static void arply_split_records(
+        ArPLYReader  * reader,
+        const long     numberOfRecords
+        )
+{
+    const long  perChunk =
+        ( numberOfRecords + reader->numberOfChunks - 1 ) / reader->numberOfChunks;
+
+    for ( unsigned int i = 0; i < reader->numberOfChunks; i++ )
+    {
+        reader->chunk[i].first = M_MIN( i * perChunk, numberOfRecords );
+        reader->chunk[i].count =
+            M_MIN( perChunk, numberOfRecords - reader->chunk[i].first );
+    }
+}
+
+static BOOL arply_read_binary(
+              ArPLYReader     * reader,
+        const ArPLYHeader     * header,
+        const unsigned char   * data,
+        const size_t            size,
+        const unsigned int      numberOfThreads
+        )
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if ( header->format != arplyformat_binary_le )
+        return NO;
+#else
+    return NO;
+#endif
+
+    if ( ! arply_vertex_properties( reader, YES ) )
+        return NO;
+
+    //   Locate the vertex and face blocks. All other elements have to
+    //   consist of fixed size records, and the face element of a single
+    //   list of triangle indices.
+
+    size_t  offset = header->dataOffset;
+
+    for ( int e = 0; e < header->numberOfElements; e++ )
+    {
+        const ArPLYElement  * element = & header->element[e];
+
+        size_t  recordSize = 0;
+
+        if ( element == reader->faceElement )
+        {
+            if (   element->numberOfProperties != 1
+                || ! element->property[0].isList
+                || element->property[0].type == arplytype_float32
+                || element->property[0].type == arplytype_float64 )
+                return NO;
+
+            reader->faceCountType = element->property[0].countType;
+            reader->faceIndexType = element->property[0].type;
+            reader->faceData = data + offset;
+
+            recordSize =
+                  arply_type_size[ reader->faceCountType ]
+                + 3 * arply_type_size[ reader->faceIndexType ];
+        }
+        else
+        {
+            for ( int i = 0; i < element->numberOfProperties; i++ )
+            {
+                if ( element->property[i].isList )
+                    return NO;
+
+                recordSize += arply_type_size[ element->property[i].type ];
+            }
+
+            if ( element == reader->vertexElement )
+                reader->vertexData = data + offset;
+        }
+
+        if ( (size_t) element->count > ( size - offset ) / M_MAX( recordSize, 1 ) )
+            return NO;
+
+        offset += element->count * recordSize;
+    }
+
+    ArPLYMesh  * mesh = reader->mesh;
+
+    arply_allocate_mesh(
+        mesh,
+        reader->vertexElement->count,
+        reader->faceElement->count,
+        reader->normal[0] >= 0
+        );
+
+    arply_split_records( reader, mesh->numberOfVertices );
+
+    arplymesh_parallel(
+        reader->art_gv,
+        reader->numberOfChunks,
+        arply_binary_vertex_chunk,
+        reader,
+        numberOfThreads
+        );
+
+    if ( ! arply_finish_chunks( reader ) )
+        return NO;
+
+    Pnt3D  minPoint = mesh->minPoint;
+    Pnt3D  maxPoint = mesh->maxPoint;
+
+    arply_split_records( reader, mesh->numberOfFaces );
+
+    arplymesh_parallel(
+        reader->art_gv,
+        reader->numberOfChunks,
+        arply_binary_face_chunk,
+        reader,
+        numberOfThreads
+        );
+
+    for ( unsigned int i = 0; i < reader->numberOfChunks; i++ )
+        if ( reader->chunk[i].failed )
+            return NO;
+
+    mesh->minPoint = minPoint;
+    mesh->maxPoint = maxPoint;
+
+    return YES;
+}
+
+
+/* ---------------------------------------------------------------------------
+    ASCII files
+        The vertex and face blocks are cut into chunks at line boundaries.
+        A first parallel pass counts the records in each chunk, so that the
+        second one knows where to store them.
+--------------------------------------------------------------------------- */
+
+static BOOL arply_is_space(
+        const char  c
+        )
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static void arply_ascii_count_chunk(
+        void          * data,
+        unsigned int    index
+        )
+{
+    ArPLYReader  * reader = data;
+    ArPLYChunk   * chunk = & reader->chunk[index];
+
+    long  count = 0;
+    BOOL  inContent = NO;
+
+    for ( const char * p = chunk->begin; p < chunk->end; p++ )
+    {
+        if ( *p == '\n' )
+        {
+            if ( inContent )
+                count++;
+
+            inContent = NO;
+        }
+        else if ( ! arply_is_space( *p ) )
+            inContent = YES;
+    }
+
+    if ( inContent )
+        count++;
+
+    chunk->count = count;
+}
+
+static void arply_ascii_vertex_chunk(
+        void          * data,
+        unsigned int    index
+        )
+{
+    ArPLYReader  * reader = data;
+    ArPLYChunk   * chunk = & reader->chunk[index];
+    ArPLYMesh    * mesh = reader->mesh;
+
+    const int  numberOfProperties = reader->vertexElement->numberOfProperties;
+
+    arply_chunk_reset_bounds( chunk );
+
+    const char  * p = chunk->begin;
+
+    for ( long i = chunk->first; i < chunk->first + chunk->count; i++ )
+    {
+        double  value[ARPLY_MAX_PROPERTIES];
+
+        for ( int k = 0; k < numberOfProperties; k++ )
+        {
+            char  * next;
+
+            value[k] = strtod( p, & next );
+
+            if ( next == p || next > chunk->end )
+            {
+                chunk->failed = YES;
+                return;
+            }
+
+            p = next;
+        }
+
+        for ( int j = 0; j < 3; j++ )
+            PNT3D_I( mesh->vertices[i], j ) = value[ reader->coordinate[j] ];
+
+        if ( mesh->normals )
+            for ( int j = 0; j < 3; j++ )
+                mesh->normals[i].c.x[j] = value[ reader->normal[j] ];
+
+        arply_chunk_add_vertex( chunk, & mesh->vertices[i] );
+
+        //   On to the next line
+
+        while ( p < chunk->end && *p != '\n' )
+            p++;
+    }
+}
+
+static void arply_ascii_face_chunk(
+        void          * data,
+        unsigned int    index
+        )
+{
+    ArPLYReader  * reader = data;
+    ArPLYChunk   * chunk = & reader->chunk[index];
+    long         * faces = arlongarray_array( & reader->mesh->faces );
+
+    chunk->failed = NO;
+
+    const char  * p = chunk->begin;
+
+    for ( long i = chunk->first; i < chunk->first + chunk->count; i++ )
+    {
+        char  * next;
+
+        if ( strtol( p, & next, 10 ) != 3 || next == p )
+        {
+            chunk->failed = YES;
+            return;
+        }
+
+        p = next;
+
+        for ( int j = 0; j < 3; j++ )
+        {
+            faces[ 3 * i + j ] = strtol( p, & next, 10 );
+
+            if ( next == p || next > chunk->end )
+            {
+                chunk->failed = YES;
+                return;
+            }
+
+            p = next;
+        }
+
+        while ( p < chunk->end && *p != '\n' )
+            p++;
+    }
+}
+
+static BOOL arply_ascii_block(
+              ArPLYReader   * reader,
+        const char          * begin,
+        const char          * end,
+        const long            numberOfRecords,
+        void               (* parse)( void *, unsigned int ),
+        const unsigned int    numberOfThreads
+        )
+{
+    //   Chunk boundaries are moved to just after the next line break
+
+    const size_t  length = end - begin;
+
+    for ( unsigned int i = 0; i < reader->numberOfChunks; i++ )
+    {
+        const char  * chunkBegin =
+            i == 0 ? begin : reader->chunk[i - 1].end;
+
+        const char  * chunkEnd =
+            begin + length / reader->numberOfChunks * ( i + 1 );
+
+        if ( i == reader->numberOfChunks - 1 || chunkEnd < chunkBegin )
+            chunkEnd = i == reader->numberOfChunks - 1 ? end : chunkBegin;
+
+        while ( chunkEnd < end && chunkEnd > chunkBegin && chunkEnd[-1] != '\n' )
+            chunkEnd++;
+
+        reader->chunk[i].begin = chunkBegin;
+        reader->chunk[i].end = chunkEnd;
+        reader->chunk[i].failed = NO;
+    }
+
+    arplymesh_parallel(
+        reader->art_gv,
+        reader->numberOfChunks,
+        arply_ascii_count_chunk,
+        reader,
+        numberOfThreads
+        );
+
+    long  first = 0;
+
+    for ( unsigned int i = 0; i < reader->numberOfChunks; i++ )
+    {
+        reader->chunk[i].first = first;
+        first += reader->chunk[i].count;
+    }
+
+    if ( first != numberOfRecords )
+        return NO;
+
+    arplymesh_parallel(
+        reader->art_gv,
+        reader->numberOfChunks,
+        parse,
+        reader,
+        numberOfThreads
+        );
+
+    for ( unsigned int i = 0; i < reader->numberOfChunks; i++ )
+        if ( reader->chunk[i].failed )
+            return NO;
+
+    return YES;
+}
+
+static BOOL arply_read_ascii(
+              ArPLYReader     * reader,
+        const ArPLYHeader     * header,
+        const char            * data,
+        const size_t            size,
+        const unsigned int      numberOfThreads
+        )
+{
+    //   Only the plain 'vertex, then face' layout, and the data has to end
+    //   in whitespace, so that no number runs into the end of the mapping
+
+    if (   header->format != arplyformat_ascii
+        || header->numberOfElements != 2
+        || reader->vertexElement != & header->element[0]
+        || reader->faceElement != & header->element[1]
+        || reader->faceElement->numberOfProperties != 1
+        || ! reader->faceElement->property[0].isList
+        || size == header->dataOffset
+        || ! arply_is_space( data[size - 1] ) )
+        return NO;
+
+    if ( ! arply_vertex_properties( reader, NO ) )
+        return NO;
+
+    //   Find the end of the vertex block
+
+    const char  * vertexBegin = data + header->dataOffset;
+    const char  * end = data + size;
+    const char  * p = vertexBegin;
+
+    for ( long n = 0; n < reader->vertexElement->count; )
+    {
+        while ( p < end && arply_is_space( *p ) )
+            p++;
+
+        if ( p == end )
+            return NO;
+
+        p = memchr( p, '\n', end - p );
+
+        if ( ! p )
+            return NO;
+
+        p++;
+        n++;
+    }
+
+    const char  * faceBegin = p;
+
+    ArPLYMesh  * mesh = reader->mesh;
+
+    arply_allocate_mesh(
+        mesh,
+        reader->vertexElement->count,
+        reader->faceElement->count,
+        reader->normal[0] >= 0
+        );
+
+    if ( ! arply_ascii_block(
+               reader,
+               vertexBegin,
+               faceBegin,
+               mesh->numberOfVertices,
+               arply_ascii_vertex_chunk,
+               numberOfThreads ) )
+        return NO;
+
+    if ( ! arply_finish_chunks( reader ) )
+        return NO;
+
+    Pnt3D  minPoint = mesh->minPoint;
+    Pnt3D  maxPoint = mesh->maxPoint;
+
+    if ( ! arply_ascii_block(
+               reader,
+               faceBegin,
+               end,
+               mesh->numberOfFaces,
+               arply_ascii_face_chunk,
+               numberOfThreads ) )
+        return NO;
+
+    mesh->minPoint = minPoint;
+    mesh->maxPoint = maxPoint;
+
+    return YES;
+}
+
+
+/* ---------------------------------------------------------------------------
+    rply fallback
+        Everything the fast paths do not cover is read through the rply
+        per-value callbacks.
+--------------------------------------------------------------------------- */
+
+typedef struct ArVertexCbData
+{
+    Pnt3D   * vertices;
+    FVec3D  * normals;
+    long      indexIntoVertexArray;
+    BOOL      normalsPresent;
+}
+ArVertexCbData;
+
+typedef struct ArFaceCbData
+{
+    ArLongArray  * indices;
+    long           indexIntoIndecesArray;
+}
+ArFaceCbData;
+
+static int vertex_cb(
+        p_ply_argument  argument
+        )
+{
+    ArVertexCbData  * vertexCbData = 0;
+    long dim;
+
+    ply_get_argument_user_data(
+          argument,
+(void*) & vertexCbData,
+        & dim
+        );
+
+    vertexCbData->vertices[vertexCbData->indexIntoVertexArray].c.x[dim] =
+        ply_get_argument_value(argument);
+
+    //   We work under the assumption that the data for a single vertex is read
+    //   sequentially. Thus when, we have read the data for dimension Z (2), we
+    //   assume we are done with one vertex.
+
+    if ( dim == 2 && ! vertexCbData->normalsPresent )
+        ++(vertexCbData->indexIntoVertexArray);
+
+    return 1;
+}
+
+static int normal_cb(
+        p_ply_argument  argument
+        )
+{
+    ArVertexCbData  * vertexCbData = 0;
+    long dim;
+
+    ply_get_argument_user_data(
+          argument,
+(void*) & vertexCbData,
+        & dim
+        );
+
+    vertexCbData->normals[vertexCbData->indexIntoVertexArray].c.x[dim] =
+        ply_get_argument_value(argument);
+
+    if ( dim == 2 && vertexCbData->normalsPresent )
+        ++(vertexCbData->indexIntoVertexArray);
+
+    return 1;
+}
+
+static int face_cb(
+        p_ply_argument  argument
+        )
+{
+    // the first value for a face is just the length of the list, which we
+    // assume to be 3
+
+    long length, value_index;
+
+    ply_get_argument_property(argument, NULL, &length, &value_index);
+
+    if (value_index < 0) return 1;
+
+    ArFaceCbData* faceCbData = 0;
+
+    ply_get_argument_user_data(argument, (void*)&faceCbData, NULL);
+
+    ARARRAY_I(*faceCbData->indices, faceCbData->indexIntoIndecesArray) =
+    ply_get_argument_value(argument);
+
+    ++faceCbData->indexIntoIndecesArray;
+
+    return 1;
+}
+
+static BOOL arply_read_rply(
+              ArPLYMesh  * mesh,
+        const char       * pathToPlyFile
+        )
+{
+    ArVertexCbData vertexCbData;
+    ArFaceCbData faceCbData;
+
+    p_ply ply = ply_open(pathToPlyFile, NULL, 0, NULL);
+
+    if ( ! ply )
+        return NO;
+
+    if ( ! ply_read_header(ply) )
+    {
+        ply_close(ply);
+        return NO;
+    }
+
+    long numberOfVertices;
+
+    numberOfVertices = ply_set_read_cb(ply, "vertex", "x", vertex_cb, (void*)&vertexCbData, 0);
+    numberOfVertices = ply_set_read_cb(ply, "vertex", "y", vertex_cb, (void*)&vertexCbData, 1);
+    numberOfVertices = ply_set_read_cb(ply, "vertex", "z", vertex_cb, (void*)&vertexCbData, 2);
+
+    long numberOfNormals = 0;
+
+    numberOfNormals = ply_set_read_cb(ply, "vertex", "nx", normal_cb, (void*)&vertexCbData, 0);
+    numberOfNormals = ply_set_read_cb(ply, "vertex", "ny", normal_cb, (void*)&vertexCbData, 1);
+    numberOfNormals = ply_set_read_cb(ply, "vertex", "nz", normal_cb, (void*)&vertexCbData, 2);
+
+    long numberOfFaces =
+        ply_set_read_cb(ply, "face", "vertex_indices", face_cb, (void*)&faceCbData, 0);
+
+    arply_allocate_mesh(
+        mesh,
+        numberOfVertices,
+        numberOfFaces,
+        numberOfNormals > 0
+        );
+
+    vertexCbData.vertices = mesh->vertices;
+    vertexCbData.normals = mesh->normals;
+    vertexCbData.indexIntoVertexArray = 0;
+    vertexCbData.normalsPresent = ( numberOfNormals > 0 );
+
+    faceCbData.indices = & mesh->faces;
+    faceCbData.indexIntoIndecesArray = 0;
+
+    ply_read(ply);
+    ply_close(ply);
+
+    ArPLYChunk  bounds;
+
+    arply_chunk_reset_bounds( & bounds );
+
+    for ( long i = 0; i < numberOfVertices; i++ )
+        arply_chunk_add_vertex( & bounds, & mesh->vertices[i] );
+
+    mesh->minPoint = bounds.minPoint;
+    mesh->maxPoint = bounds.maxPoint;
+
+    return YES;
+}
+
+
+/* ---------------------------------------------------------------------------
+    Entry points
+--------------------------------------------------------------------------- */
+
+void arplymesh_free_contents(
+        ArPLYMesh  * mesh
+        )
+{
+    if ( mesh->vertices )
+        FREE_ARRAY( mesh->vertices );
+
+    if ( mesh->normals )
+        FREE_ARRAY( mesh->normals );
+
+    if ( arlongarray_array( & mesh->faces ) )
+        arlongarray_free_contents( & mesh->faces );
+
+    memset( mesh, 0, sizeof(ArPLYMesh) );
+}
+
+static BOOL arply_read_mapped(
+              ART_GV        * art_gv,
+              ArPLYMesh     * mesh,
+        const char          * pathToPlyFile,
+        const unsigned int    numberOfThreads
+        )
+{
+    int  fd = open( pathToPlyFile, O_RDONLY );
+
+    if ( fd < 0 )
+        return NO;
+
+    struct stat  fileStat;
+
+    if ( fstat( fd, & fileStat ) != 0 || fileStat.st_size == 0 )
+    {
+        close( fd );
+        return NO;
+    }
+
+    const size_t  size = fileStat.st_size;
+
+    void  * mapping = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+    close( fd );
+
+    if ( mapping == MAP_FAILED )
+        return NO;
+
+    madvise( mapping, size, MADV_SEQUENTIAL );
+
+    BOOL          success = NO;
+    ArPLYHeader * header = ALLOC( ArPLYHeader );
+
+    if ( arply_parse_header( mapping, size, header ) )
+    {
+        ArPLYReader  reader;
+
+        memset( & reader, 0, sizeof(ArPLYReader) );
+
+        reader.art_gv = art_gv;
+        reader.mesh = mesh;
+
+        for ( int e = 0; e < header->numberOfElements; e++ )
+        {
+            if ( strcmp( header->element[e].name, "vertex" ) == 0 )
+                reader.vertexElement = & header->element[e];
+            if ( strcmp( header->element[e].name, "face" ) == 0 )
+                reader.faceElement = & header->element[e];
+        }
+
+        if ( reader.vertexElement && reader.faceElement )
+        {
+            reader.numberOfChunks =
+                M_MAX( numberOfThreads, 1 ) * ARPLY_CHUNKS_PER_THREAD;
+            reader.chunk = ALLOC_ARRAY( ArPLYChunk, reader.numberOfChunks );
+
+            if ( header->format == arplyformat_ascii )
+                success =
+                    arply_read_ascii(
+                        & reader, header, mapping, size, numberOfThreads
+                        );
+            else
+                success =
+                    arply_read_binary(
+                        & reader, header, mapping, size, numberOfThreads
+                        );
+
+            FREE_ARRAY( reader.chunk );
+
+            if ( ! success )
+                arplymesh_free_contents( mesh );
+        }
+    }
+
+    FREE( header );
+
+    munmap( mapping, size );
+
+    return success;
+}
+
+static BOOL arply_read_file(
+              ART_GV        * art_gv,
+              ArPLYMesh     * mesh,
+        const char          * pathToPlyFile,
+        const unsigned int    numberOfThreads
+        )
+{
+    memset( mesh, 0, sizeof(ArPLYMesh) );
+
+    if ( arply_read_mapped( art_gv, mesh, pathToPlyFile, numberOfThreads ) )
+        return YES;
+
+    return arply_read_rply( mesh, pathToPlyFile );
+}
+
+BOOL arplymesh_read(
+              ART_GV        * art_gv,
+              ArPLYMesh     * mesh,
+        const char          * pathToPlyFile
+        )
+{
+    return
+        arply_read_file(
+            art_gv,
+            mesh,
+            pathToPlyFile,
+            art_maximum_number_of_working_threads( art_gv )
+            );
+}
+
+typedef struct ArPLYFiles
+{
+    ART_GV       * art_gv;
+    const char  ** pathToPlyFile;
+    ArPLYMesh    * mesh;
+    BOOL         * success;
+}
+ArPLYFiles;
+
+static void arply_read_one_file(
+        void          * data,
+        unsigned int    index
+        )
+{
+    ArPLYFiles  * files = data;
+
+    //   The files themselves are already spread over all threads
+
+    files->success[index] =
+        arply_read_file(
+              files->art_gv,
+            & files->mesh[index],
+              files->pathToPlyFile[index],
+              1
+            );
+}
+
+void arplymesh_read_files(
+              ART_GV        * art_gv,
+        const unsigned int    numberOfFiles,
+        const char         ** pathToPlyFile,
+              ArPLYMesh     * mesh,
+              BOOL          * success
+        )
+{
+    if ( numberOfFiles == 1 )
+    {
+        success[0] = arplymesh_read( art_gv, & mesh[0], pathToPlyFile[0] );
+        return;
+    }
+
+    ArPLYFiles  files = { art_gv, pathToPlyFile, mesh, success };
+
+    arplymesh_parallel(
+        art_gv,
+        numberOfFiles,
+        arply_read_one_file,
+        & files,
+        art_maximum_number_of_working_threads( art_gv )
+        );
+}
+
+// ===========================================================================
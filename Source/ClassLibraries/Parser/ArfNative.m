@@ -34,6 +34,7 @@
 #import "ArcBinaryCoder.h"
 #import "ArcObjCCoder.h"
 #import "ArnTriangleMesh.h"
+#import "ArPLYMesh.h"
 
 static const char * arfnativebinary_magic_string =      "ART binary";
 static const char * arfnativebinary_short_class_name =  "native ART binary";
@@ -80,6 +81,138 @@ ArNodeHashEntry;
 
 #define ARNHTE_NODE      ARNODEHASHTABLEENTRY_NODE
 
+/* ---------------------------------------------------------------------------
+    'ArfNativePLYPreload'
+        PLY meshes that are referenced as externals do not depend on each
+        other, so they are all read in parallel before the externals are
+        resolved one by one. Only plain references are considered: PLY
+        externals with an auxiliary node still go through the usual parser.
+--------------------------------------------------------------------------- */
+
+typedef struct ArfNativePLYPreload
+{
+    unsigned int    numberOfMeshes;
+    ArSymbol      * fileName;
+    ArPLYMesh     * mesh;
+    BOOL          * success;
+    BOOL          * used;
+}
+ArfNativePLYPreload;
+
+static BOOL arfnative_has_ply_extension(
+        const char  * fileName
+        )
+{
+    const char  * extension = strrchr( fileName, '.' );
+
+    return extension && strcasecmp( extension, ".ply" ) == 0;
+}
+
+static void arfnative_preload_ply_meshes(
+        ART_GV               * art_gv,
+        ArList               * externalList,
+        ArfNativePLYPreload  * preload
+        )
+{
+    const unsigned int  numberOfExternals = arlist_length( externalList );
+
+    preload->numberOfMeshes = 0;
+    preload->fileName = ALLOC_ARRAY( ArSymbol, M_MAX( numberOfExternals, 1 ) );
+
+    for ( ArListEntry * listEntry = ARLIST_HEAD(*externalList);
+          listEntry;
+          listEntry = ARLISTENTRY_NEXT(*listEntry) )
+    {
+        ArnExternal  * external = arlistentry_external( listEntry );
+
+        if (   [ external auxiliaryNode ]
+            || ! arfnative_has_ply_extension( [ external externalFileName ] ) )
+            continue;
+
+        ArString  complete_path_to_external;
+
+        full_path_for_filename(
+            & complete_path_to_external,
+              [ external externalFileName ],
+              ART_INCLUDE_PATHS
+            );
+
+        ArSymbol  externalFileName =
+            arsymbol( art_gv, complete_path_to_external );
+
+        BOOL  alreadyListed = NO;
+
+        for ( unsigned int i = 0; i < preload->numberOfMeshes; i++ )
+            if ( preload->fileName[i] == externalFileName )
+                alreadyListed = YES;
+
+        if ( ! alreadyListed )
+            preload->fileName[ preload->numberOfMeshes++ ] = externalFileName;
+    }
+
+    preload->mesh = NULL;
+    preload->success = NULL;
+    preload->used = NULL;
+
+    if ( preload->numberOfMeshes == 0 )
+        return;
+
+    preload->mesh = ALLOC_ARRAY( ArPLYMesh, preload->numberOfMeshes );
+    preload->success = ALLOC_ARRAY( BOOL, preload->numberOfMeshes );
+    preload->used = ALLOC_ARRAY( BOOL, preload->numberOfMeshes );
+
+    for ( unsigned int i = 0; i < preload->numberOfMeshes; i++ )
+        preload->used[i] = NO;
+
+    arplymesh_read_files(
+        art_gv,
+        preload->numberOfMeshes,
+        (const char **) preload->fileName,
+        preload->mesh,
+        preload->success
+        );
+}
+
+//   Returns NULL if the file was not preloaded, or could not be read; the
+//   normal parser then takes care of it (and of reporting any errors).
+
+static ArPLYMesh * arfnative_preloaded_ply_mesh(
+        ArfNativePLYPreload  * preload,
+        ArSymbol               fileName
+        )
+{
+    for ( unsigned int i = 0; i < preload->numberOfMeshes; i++ )
+    {
+        if (   preload->fileName[i] == fileName
+            && preload->success[i]
+            && ! preload->used[i] )
+        {
+            preload->used[i] = YES;
+            return & preload->mesh[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void arfnative_free_ply_preload(
+        ArfNativePLYPreload  * preload
+        )
+{
+    for ( unsigned int i = 0; i < preload->numberOfMeshes; i++ )
+        if ( preload->success[i] && ! preload->used[i] )
+            arplymesh_free_contents( & preload->mesh[i] );
+
+    FREE_ARRAY( preload->fileName );
+
+    if ( preload->numberOfMeshes > 0 )
+    {
+        FREE_ARRAY( preload->mesh );
+        FREE_ARRAY( preload->success );
+        FREE_ARRAY( preload->used );
+    }
+}
+
 @implementation ArfNative
 
 ARPFILE_DEFAULT_IMPLEMENTATION(
@@ -213,6 +346,14 @@ ARPPARSER_AUXLIARY_NODE_DEFAULT_IMPLEMENTATION
 
     arhashtable_init( & hashtableOfAlreadyLoadedExternals, 0 );
 
+    ArfNativePLYPreload  plyPreload;
+
+    arfnative_preload_ply_meshes(
+          art_gv,
+        & externalList,
+        & plyPreload
+        );
+
     //   We count the externals and then treat all of them in a loop
 
     const unsigned int  numberOfExternals = arlist_length( & externalList );
@@ -268,35 +409,53 @@ ARPPARSER_AUXLIARY_NODE_DEFAULT_IMPLEMENTATION
                   FIELD_POINTER( hashtableEntry, entry )
                 );
 
-            ArNode <ArpFiletype, ArpParser>  * nativeFile =
-                [ self _getFileNamed: externalFileName ];
+            ArPLYMesh  * plyMesh =
+                arfnative_preloaded_ply_mesh(
+                    & plyPreload,
+                      externalFileName
+                    );
 
-            if (   [ nativeFile conformsToProtocol: ARPROTOCOL(ArpImageFile) ]
-                && [ external conformsToArProtocol: ARPROTOCOL(ArpShape) ] )
+            if ( plyMesh )
             {
                 ARNHTE_NODE( *hashtableEntry ) =
-                    arntrianglemesh_heightfield_from_image(
+                    arntrianglemesh_from_plymesh(
                           art_gv,
                           arshape_solid,
-                          (ArNode <ArpImageFile> *) nativeFile
+                          plyMesh
                         );
             }
             else
             {
-                if ( auxiliaryNode )
-                    [ nativeFile parseFileGetExternalsWithAuxiliaryNode
-                        : & ARNHTE_NODE( *hashtableEntry )
-                        : & externalList
-                        :   auxiliaryNode
-                        ];
+                ArNode <ArpFiletype, ArpParser>  * nativeFile =
+                    [ self _getFileNamed: externalFileName ];
+
+                if (   [ nativeFile conformsToProtocol: ARPROTOCOL(ArpImageFile) ]
+                    && [ external conformsToArProtocol: ARPROTOCOL(ArpShape) ] )
+                {
+                    ARNHTE_NODE( *hashtableEntry ) =
+                        arntrianglemesh_heightfield_from_image(
+                              art_gv,
+                              arshape_solid,
+                              (ArNode <ArpImageFile> *) nativeFile
+                            );
+                }
                 else
-                    [ nativeFile parseFileGetExternals
-                        : & ARNHTE_NODE( *hashtableEntry )
-                        : & externalList
-                        ];
+                {
+                    if ( auxiliaryNode )
+                        [ nativeFile parseFileGetExternalsWithAuxiliaryNode
+                            : & ARNHTE_NODE( *hashtableEntry )
+                            : & externalList
+                            :   auxiliaryNode
+                            ];
+                    else
+                        [ nativeFile parseFileGetExternals
+                            : & ARNHTE_NODE( *hashtableEntry )
+                            : & externalList
+                            ];
+                }
+
+                RELEASE_OBJECT(nativeFile);
             }
-
-            RELEASE_OBJECT(nativeFile);
         }
 
         ArNode  * externalContentNode;
@@ -324,6 +483,8 @@ ARPPARSER_AUXLIARY_NODE_DEFAULT_IMPLEMENTATION
             ];
     }
 
+    arfnative_free_ply_preload( & plyPreload );
+
     //   HIER: hashtable versaften
 
             //FIXME!!!!!!!!!
@@ -30,6 +30,11 @@
 
 #import "ArnVolumeDataGrid.h"
 
+#include <unistd.h>
+#include <sys/stat.h>
+
+//   The magic string also matches the "SVOL" header of sparse volumes
+
 static const char * arfvol_magic_string =
     "VOL";
 static const char * arfvol_short_class_name =
@@ -37,7 +42,26 @@ static const char * arfvol_short_class_name =
 static const char * arfvol_long_class_name =
     "VOL volume data";
 const char * arfvol_exts[] =
-    { "vol", 0 };
+    { "vol", "svol", 0 };
+
+/* ---------------------------------------------------------------------------
+    Sparse volumes ('.svol')
+        Native format of ArnVolumeDataGrid, which only stores the bricks
+        that contain non-zero values:
+
+            "SVOL"                      4 chars
+            version                     int32, currently 1
+            xRes, yRes, zRes, channels  int32
+            bounding box min, max       3 + 3 floats
+            brick payload               see arvoxelbrickgrid_write_bricks()
+
+        When a dense Mitsuba style '.vol' file is loaded, a sparse copy
+        is written next to it as '<name>.svol' if the directory is
+        writable. Later runs load that copy instead, as long as it is not
+        older than the dense file.
+--------------------------------------------------------------------------- */
+
+#define ARFVOL_SPARSE_VERSION       1
 
 ART_MODULE_INITIALISATION_FUNCTION
 (
@@ -119,75 +143,283 @@ ARPPARSER_AUXLIARY_NODE_DEFAULT_IMPLEMENTATION
     return header[0] == 'V' && header[1] == 'O' && header[2] == 'L';
 }
 
-- (void) parseFileGetExternals
-        : (ArNode **) objectPtr
-        : (ArList *) externals
+- (void) _readBounds
+        : (ArnVolumeDataGrid *) volume
+        : (FILE *) pFile
 {
-    ArnVolumeDataGrid * newVolume = [ ALLOC_INIT_OBJECT(ArnVolumeDataGrid) ];
+    int32_t  resolution[4];
+    float    bounds[6];
 
-    FILE *pFile = fopen( [ file name ], "rb" );
-    
-    if (pFile != NULL) {
-        char header[3] = {0};
-        char version = 0;
-        int32_t encoding = 0;
-        
-        // Check the header
-        fread(header, 1, 3, pFile);
-        if (![ ArfVol isHeaderCorrect:header ]) {
-            ART_ERRORHANDLING_FATAL_ERROR(
-                "The VOL volume '%s' is not supported: Wrong header."
-                ,   [ file name ]
+    if (   fread( resolution, sizeof(int32_t), 4, pFile ) != 4
+        || fread( bounds, sizeof(float), 6, pFile ) != 6 )
+        ART_ERRORHANDLING_FATAL_ERROR(
+            "The VOL volume '%s' is truncated."
+            ,   [ file name ]
+            );
+
+    if (   resolution[0] <= 0 || resolution[1] <= 0
+        || resolution[2] <= 0 || resolution[3] <= 0 )
+        ART_ERRORHANDLING_FATAL_ERROR(
+            "The VOL volume '%s' has an invalid resolution."
+            ,   [ file name ]
+            );
+
+    volume->_xRes      = resolution[0];
+    volume->_yRes      = resolution[1];
+    volume->_zRes      = resolution[2];
+    volume->_nChannels = resolution[3];
+
+    volume->_xMin = bounds[0];
+    volume->_yMin = bounds[1];
+    volume->_zMin = bounds[2];
+    volume->_xMax = bounds[3];
+    volume->_yMax = bounds[4];
+    volume->_zMax = bounds[5];
+
+    arvoxelbrickgrid_init(
+        & volume->_data,
+          volume->_xRes,
+          volume->_yRes,
+          volume->_zRes,
+          volume->_nChannels
+        );
+}
+
+- (BOOL) _readSparse
+        : (ArnVolumeDataGrid *) volume
+        : (FILE *) pFile
+{
+    int32_t  version = 0;
+
+    if (   fread( & version, sizeof(int32_t), 1, pFile ) != 1
+        || version != ARFVOL_SPARSE_VERSION )
+        return NO;
+
+    [ self _readBounds
+        :   volume
+        :   pFile
+        ];
+
+    return arvoxelbrickgrid_read_bricks( & volume->_data, pFile );
+}
+
+- (void) _readDense
+        : (ArnVolumeDataGrid *) volume
+        : (FILE *) pFile
+{
+    char     version = 0;
+    int32_t  encoding = 0;
+
+    fread(&version, 1, 1, pFile);
+    if (version != 3) {
+        ART_ERRORHANDLING_FATAL_ERROR(
+            "The VOL volume '%s' is not supported: Not supporting this version."
+            ,   [ file name ]
+            );
+    }
+
+    fread(&encoding, sizeof(int32_t), 1, pFile);
+    if (encoding != 1) {
+        ART_ERRORHANDLING_FATAL_ERROR(
+            "The VOL volume '%s' is not supported: Not supporting this encoding format."
+            ,   [ file name ]
+            );
+    }
+
+    [ self _readBounds
+        :   volume
+        :   pFile
+        ];
+
+    //   The dense data is streamed in slabs of one brick layer, so that
+    //   only the active bricks, plus one slab, are ever held in memory.
+
+    const size_t  sliceFloats =
+        (size_t) volume->_xRes * volume->_yRes * volume->_nChannels;
+
+    float  * slab =
+        ALLOC_ARRAY( float, sliceFloats * ARVOXELBRICKGRID_BRICK_SIZE );
+
+    for ( int layer = 0; layer < volume->_data.zBricks; layer++ )
+    {
+        const int  slices =
+            M_MIN(
+                ARVOXELBRICKGRID_BRICK_SIZE,
+                volume->_zRes - layer * ARVOXELBRICKGRID_BRICK_SIZE
                 );
-        }
-        
-        fread(&version, 1, 1, pFile);
-        if (version != 3) {
+
+        if ( fread( slab, sizeof(float), slices * sliceFloats, pFile )
+             != slices * sliceFloats )
             ART_ERRORHANDLING_FATAL_ERROR(
-                "The VOL volume '%s' is not supported: Not supporting this version."
+                "The VOL volume '%s' is truncated."
                 ,   [ file name ]
                 );
+
+        arvoxelbrickgrid_add_dense_layer(
+            & volume->_data,
+              layer,
+              slab
+            );
+    }
+
+    FREE_ARRAY( slab );
+}
+
+- (void) _writeSparse
+        : (ArnVolumeDataGrid *) volume
+        : (const char *) sparseName
+{
+    //   Written under a temporary name first, so that concurrent runs
+    //   never see a partial file.
+
+    char  * tempName = ALLOC_ARRAY( char, strlen( sparseName ) + 32 );
+
+    sprintf( tempName, "%s.%d", sparseName, (int) getpid() );
+
+    FILE  * pFile = fopen( tempName, "wb" );
+
+    if ( ! pFile )
+    {
+        FREE_ARRAY( tempName );
+        return;
+    }
+
+    const int32_t  header[5] =
+        {
+            ARFVOL_SPARSE_VERSION,
+            volume->_xRes,
+            volume->_yRes,
+            volume->_zRes,
+            volume->_nChannels
+        };
+
+    const float  bounds[6] =
+        {
+            volume->_xMin, volume->_yMin, volume->_zMin,
+            volume->_xMax, volume->_yMax, volume->_zMax
+        };
+
+    BOOL  success =
+           fwrite( "SVOL", 1, 4, pFile ) == 4
+        && fwrite( header, sizeof(int32_t), 5, pFile ) == 5
+        && fwrite( bounds, sizeof(float), 6, pFile ) == 6
+        && arvoxelbrickgrid_write_bricks( & volume->_data, pFile );
+
+    success = ( fclose( pFile ) == 0 ) && success;
+
+    if ( ! success || rename( tempName, sparseName ) != 0 )
+        unlink( tempName );
+
+    FREE_ARRAY( tempName );
+}
+
+- (void) parseFileGetExternals
+        : (ArNode **) objectPtr
+        : (ArList *) externals
+{
+    ArnVolumeDataGrid * newVolume = [ ALLOC_INIT_OBJECT(ArnVolumeDataGrid) ];
+
+    const char  * fileName = [ file name ];
+
+    //   Dense volumes may have an up-to-date sparse copy next to them
+
+    char  * sparseName = ALLOC_ARRAY( char, strlen( fileName ) + 6 );
+
+    sprintf( sparseName, "%s.svol", fileName );
+
+    struct stat  denseStat, sparseStat;
+
+    const BOOL  sparseCopyUsable =
+           stat( fileName, & denseStat ) == 0
+        && stat( sparseName, & sparseStat ) == 0
+        && sparseStat.st_mtime >= denseStat.st_mtime;
+
+    BOOL  loaded = NO;
+
+    if ( sparseCopyUsable )
+    {
+        FILE  * pFile = fopen( sparseName, "rb" );
+
+        if ( pFile )
+        {
+            char  header[4] = {0};
+
+            loaded =
+                   fread( header, 1, 4, pFile ) == 4
+                && memcmp( header, "SVOL", 4 ) == 0
+                && [ self _readSparse
+                       :   newVolume
+                       :   pFile
+                       ];
+
+            fclose( pFile );
+
+            //   A broken copy is simply ignored, and overwritten below
+
+            if ( ! loaded )
+                arvoxelbrickgrid_free_contents( & newVolume->_data );
         }
-        
-        fread(&encoding, sizeof(int32_t), 1, pFile);
-        if (encoding != 1) {
+    }
+
+    if ( ! loaded )
+    {
+        FILE *pFile = fopen( fileName, "rb" );
+
+        if (pFile != NULL) {
+            char header[4] = {0};
+
+            // Check the header
+            fread(header, 1, 3, pFile);
+
+            if ( header[0] == 'S' && header[1] == 'V' && header[2] == 'O' ) {
+                if (   fread( & header[3], 1, 1, pFile ) != 1
+                    || header[3] != 'L'
+                    || ! [ self _readSparse
+                             :   newVolume
+                             :   pFile
+                             ] )
+                {
+                    ART_ERRORHANDLING_FATAL_ERROR(
+                        "The VOL volume '%s' is not supported: Invalid sparse volume."
+                        ,   fileName
+                        );
+                }
+            }
+            else {
+                if (![ ArfVol isHeaderCorrect:header ]) {
+                    ART_ERRORHANDLING_FATAL_ERROR(
+                        "The VOL volume '%s' is not supported: Wrong header."
+                        ,   fileName
+                        );
+                }
+
+                [ self _readDense
+                    :   newVolume
+                    :   pFile
+                    ];
+
+                [ self _writeSparse
+                    :   newVolume
+                    :   sparseName
+                    ];
+            }
+
+            fclose(pFile);
+        } else {
             ART_ERRORHANDLING_FATAL_ERROR(
-                "The VOL volume '%s' is not supported: Not supporting this encoding format."
-                ,   [ file name ]
-                );
-        }
-        
-        // Load volume size information
-        fread(&(newVolume->_xRes), sizeof(int32_t), 1, pFile);
-        fread(&(newVolume->_yRes), sizeof(int32_t), 1, pFile);
-        fread(&(newVolume->_zRes), sizeof(int32_t), 1, pFile);
-        fread(&(newVolume->_nChannels), sizeof(int32_t), 1, pFile);
-        fread(&(newVolume->_xMin), sizeof(float), 1, pFile);
-        fread(&(newVolume->_yMin), sizeof(float), 1, pFile);
-        fread(&(newVolume->_zMin), sizeof(float), 1, pFile);
-        fread(&(newVolume->_xMax), sizeof(float), 1, pFile);
-        fread(&(newVolume->_yMax), sizeof(float), 1, pFile);
-        fread(&(newVolume->_zMax), sizeof(float), 1, pFile);
-        
-        int n_data_el = newVolume->_xRes * newVolume->_yRes * newVolume->_zRes * newVolume->_nChannels;
-        
-        newVolume->_data = arfloatarray_init(n_data_el);
-        fread(arfloatarray_array(&newVolume->_data), sizeof(Float), n_data_el, pFile);
-        fclose(pFile);
-        
-        // find max
-        // TODO: What is a max? Works in 1D then...
-        newVolume->_max = 0;
-        for (int i = 0; i < n_data_el; i++) {
-            newVolume->_max = fmax(newVolume->_max, ARARRAY_I(newVolume->_data, i));
+                                          "cannot open VOL volume '%s'"
+                                          ,   fileName
+                                          );
         }
-    } else {
-        ART_ERRORHANDLING_FATAL_ERROR(
-                                      "cannot open VOL volume '%s'"
-                                      ,   [ file name ]
-                                      );
     }
-    
+
+    FREE_ARRAY( sparseName );
+
+    // TODO: What is a max? Works in 1D then...
+    newVolume->_max = arvoxelbrickgrid_max( & newVolume->_data );
+
+    [ newVolume prepareMajorantGrid ];
+
     *objectPtr = newVolume;
 }
 
@@ -57,9 +57,12 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
     --------------------------------------------------------------------aw- */
     
     double  powerThreshold = [ RANDOM_GENERATOR valueFromNewSequence ];
-    int     i = 0;
 
-    while( patch[i].lightsourceRadiantPowerPercentile < powerThreshold ) i++;
+    unsigned int  i =
+        araliastable_sample(
+            & patchSelection,
+              powerThreshold
+            );
     
     /* -----------------------------------------------------------------------
 
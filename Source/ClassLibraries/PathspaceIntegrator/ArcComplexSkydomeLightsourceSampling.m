@@ -79,37 +79,49 @@ int altitudeOfPoint(
     
     // inverse of sampledDirection is generated first, in both branches
     Vec3D queryDirection;
+
+    // density of the direction if it is a sky sample
+    double  skyDensity = 0.0;
     
     if ( i == 0 )   // create sample on the skydome excluding solar disc
     {
         // we use a local variable for sampling region, as the user may have not specified one
         ArSamplingRegion localSamplingRegion;
         
+        //   Directions are drawn from the tabulated sky radiance for the
+        //   band of the hero wavelength; samples that hit the solar disc
+        //   are rejected, which the table density already accounts for.
+
+        unsigned int  band =
+            arskydomedistribution_band(
+                & skyDistribution,
+                  wavelength
+                );
+
         ArSequenceID  sequenceIndex = [ RANDOM_GENERATOR currentSequenceID ];
         do
         {
-            double  z, t;
+            double  u0, u1;
 
             [ RANDOM_GENERATOR setCurrentSequenceID
                 :   sequenceIndex
                 ];
 
             [ RANDOM_GENERATOR getValuesFromNewSequences
-                : & z
-                : & t
+                : & u0
+                : & u1
                 ];
 
-            // sample hemisphere only
-            t *= MATH_2_MUL_PI;
+            Vec3D  localVector;
 
-            double r = sqrt ( 1 - M_SQR(z) );
-
-            Vec3D localVector =
-                VEC3D(
-                    r * cos( t ),
-                    r * sin( t ),
-                    z
-                  );
+            skyDensity =
+                arskydomedistribution_sample(
+                    & skyDistribution,
+                      band,
+                      u0,
+                      u1,
+                    & localVector
+                    );
             
             vec3d_v_htrafo3d_v(
                 & localVector,
@@ -217,7 +229,9 @@ int altitudeOfPoint(
     
     *sampledPoint = 0; // indicates that the point is on the infinite sphere
     
-    double pdf = patch[i].percentOfSkydomeRadiantPower[a] * patch[i].probability;
+    double pdf =
+          patch[i].percentOfSkydomeRadiantPower[a]
+        * ( i == 0 ? skyDensity : patch[i].probability );
     
     if(illuminationProbability)
     {
@@ -256,7 +270,39 @@ int altitudeOfPoint(
         patchIndex = 0;
     int  a = altitudeOfPoint(&ARCPOINTCONTEXT_WORLDSPACE_POINT(illuminatedPoint));
 
-    double pdf = patch[patchIndex].percentOfSkydomeRadiantPower[a] * patch[patchIndex].probability;
+    //   Sky samples: density of the table entry the direction falls in
+
+    double  directionDensity = patch[patchIndex].probability;
+
+    if ( patchIndex == 0 )
+    {
+        Vec3D  queryDirection, localDirection;
+
+        vec3d_v_negate_v(
+            & ARDIRECTIONCOSINE_VECTOR(*lightSampleDirection),
+            & queryDirection
+            );
+
+        vec3d_v_htrafo3d_v(
+            & queryDirection,
+            & world2skydome,
+            & localDirection
+            );
+
+        vec3d_norm_v( & localDirection );
+
+        directionDensity =
+            arskydomedistribution_pdf(
+                & skyDistribution,
+                  arskydomedistribution_band( & skyDistribution, wavelength ),
+                & localDirection
+                );
+    }
+
+    double pdf =
+          patch[patchIndex].percentOfSkydomeRadiantPower[a]
+        * directionDensity;
+
     if(illuminationProbability)
     {
         arpdfvalue_dd_init_p(
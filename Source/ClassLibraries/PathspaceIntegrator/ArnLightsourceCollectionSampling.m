@@ -37,6 +37,16 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
 #define LIGHTSOURCE(__a,__i) \
     ((id <ArpLightsourceSampling>)LSC_LIGHT((__a),(__i)).source)
 
+//   Implemented in ArnLightsourceCollection.m
+
+@interface ArnLightsourceCollection ( internal )
+
+- (int) _lightIndexForEmissiveObject
+        : (const ArNode *) emissiveObject
+        ;
+
+@end
+
 @implementation ArnLightsourceCollection ( RaySampling )
 
 - (BOOL) sampleLightsource
@@ -62,27 +72,36 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
     }
     else
     {
-        ArSpectralSample percentile;
+        //   Decide based on the hero wavelength only: the light is drawn
+        //   from the alias table of the s500 channel it falls into, i.e.
+        //   with the same probability that sps_s500w_init_s later reads
+        //   from percentOfOverallSpectralPower for the pdf.
 
-        for (i = 0; i < numberOfLights; i++) {
-            // the same method as is used later in pdf multiplication
-            // (as spc_sd_value_at_wavelength behaves differently)
-            sps_s500w_init_s(
-                art_gv,
-                LSC_LIGHT(a,i).overallSpectralPowerPercentile,
-                wavelength,
-                & percentile
-                );
+        double  heroWavelength = ARWL_WI(*wavelength,0);
 
-            // decide based on the hero wavelength only
-            if (SPS_CI(percentile, 0) >= percentileThreshold) {
-                break;
-            }
+        if (   numberOfSelectionChannels == 0
+            || heroWavelength < selectionRangeStart
+            || heroWavelength > selectionRangeEnd )
+        {
+            return NO;
         }
 
-        if (i == numberOfLights) {
+        unsigned int  channel =
+            (unsigned int)
+            ( ( heroWavelength - selectionRangeStart ) / selectionChannelWidth );
+
+        if ( channel >= numberOfSelectionChannels )
+            channel = numberOfSelectionChannels - 1;
+
+        if ( ARALIASTABLE_IS_EMPTY( spectralPowerSelection[channel] ) )
+        {
             return NO;
         }
+
+        i = araliastable_sample(
+              & spectralPowerSelection[channel],
+                percentileThreshold
+              );
     }
         
     BOOL result =
@@ -138,14 +157,10 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
         : (      ArPDFValue *)                   illuminationProbability /* optional */
         : (      ArPDFValue *)                   emissionProbability /* optional */
 {
-    unsigned int  i = 0;
+    int  i = [ self _lightIndexForEmissiveObject: emissiveObject ];
     int  a = 0;
 
-    while ( i < numberOfLights
-           && (id)[ LSC_LIGHT(a,i).source shape ] != (id)emissiveObject )
-        i++;
-
-    if(i >= numberOfLights)
+    if ( i < 0 )
         return NO;
 
     [ LIGHTSOURCE(a,i) sampleProbability
@@ -192,11 +207,16 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
         : (      ArLightsourceSamplingContext *) samplingContext
         : (      ArPDFValue *)                   selectionProbability
 {
+    ASSERT_POSITIVE_INTEGER(numberOfLights);
+
     double  powerThreshold = [ RANDOM_GENERATOR valueFromNewSequence ];
-    int  i = 0;
     int  a = 0;
-    while( LSC_LIGHT(a,i).overallRadiantPowerPercentile < powerThreshold )
-        i++;
+
+    unsigned int  i =
+        araliastable_sample(
+            & radiantPowerSelection,
+              powerThreshold
+            );
 
     arpdfvalue_dd_init_p(
         LSC_LIGHT(a,i).percentOfOverallRadiantPower,
@@ -214,12 +234,14 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
 {
     ASSERT_POSITIVE_INTEGER(numberOfLights);
 
-    unsigned int  i = 0;
+    int  i = [ self _lightIndexForEmissiveObject: emissiveObject ];
     int  a = 0;
 
-    while ( ( i + 1 < numberOfLights )
-           && (id)[ LSC_LIGHT(a,i).source shape ] != (id)emissiveObject )
-        i++;
+    //   Same as the former linear search: if no light matches, the last
+    //   one is returned
+
+    if ( i < 0 )
+        i = numberOfLights - 1;
 
     if(selectionProbability)
         arpdfvalue_dd_init_p(
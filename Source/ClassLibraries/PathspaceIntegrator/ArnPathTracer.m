@@ -509,37 +509,22 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnPathTracer)
     else
         *distance_r = 1.0;
     
-    ArcIntersection  * occlusion =
-        [ RAYCASTER firstRayObjectIntersection
-             :   entireScene
-             :   pointFrom
-             : & shadowRay
-             :   terminationDistance
-             ];
-    
-    if( !occlusion )
-        return NO; // no intersection means no occlusion
-    
-    BOOL result;
-    if(pointTo)
-    {
-        // we do not necessarily need to hit pointTo, as it may be a virtual point
-        result = m_ddd_equal( terminationDistance, ARCINTERSECTION_T(occlusion), 0.000001 )
-            ? NO : YES;
-    }
-    else
-    {
-        // if there is no point, we expect to hit infinite sphere
-        result = [ ARCINTERSECTION_SHAPE(occlusion)
-              isMemberOfClass
-              :   [ ArnInfSphere class ] ] ? NO : YES;
-    }
-    
-    [ INTERSECTION_FREELIST releaseInstance
-         :   occlusion
-         ];
-    
-    return result;
+    //   Hits which are within a small relative distance of pointTo are
+    //   considered to be pointTo itself (which may also be a virtual
+    //   point), so the occlusion query range ends just short of it. If
+    //   there is no pointTo, only the infinite sphere is expected to be
+    //   hit: the query never reports it, since it lies at infinity.
+
+    if ( pointTo )
+        terminationDistance *= 1.0 - 0.000001;
+
+    return
+        [ RAYCASTER anyRayObjectIntersection
+            :   entireScene
+            :   pointFrom
+            : & shadowRay
+            :   terminationDistance
+            ];
 }
 
 // light sampling
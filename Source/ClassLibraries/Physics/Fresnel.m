@@ -72,27 +72,37 @@ void fresnel_reflectivity_dielectric(
         )
 {
     // TODO: extract ior and extinction as spectral sample directly
+    ArSpectralSample  n, k;
+
     for ( int i = 0; i < 4; i++ )
     {
-        double  n =
+        SPS_CI(n, i) =
             ARCPHASEINTERFACE_IOR_AT_WAVELENGTH(
                 *ARCINTERSECTION_PHASEINTERFACE(incomingDirectionAndLocation),
                 ARWL_WI(*wavelength,i)
                 );
 
-        double  attenuation_perpendicular, attenuation_parallel;
+        SPS_CI(k, i) = 0.000001;
+    }
 
-        fresnel_ddd_attenuation_dd(
-              INCOMING_COSINE_WORLDSPACE,
-              n,
-              0.000001,
-            & attenuation_perpendicular,
-            & attenuation_parallel
-            );
+    ArSpectralSample  attenuation_perpendicular, attenuation_parallel;
 
-        SPS_CI(*reflectivity_r, i) =
-            0.5 * attenuation_perpendicular + 0.5 * attenuation_parallel;
-    }
+    fresnel_dss_attenuation_ss(
+          INCOMING_COSINE_WORLDSPACE,
+        & n,
+        & k,
+        & attenuation_perpendicular,
+        & attenuation_parallel
+        );
+
+    sps_ss_add_s(
+          art_gv,
+        & attenuation_perpendicular,
+        & attenuation_parallel,
+          reflectivity_r
+        );
+
+    sps_d_mul_s( art_gv, 0.5, reflectivity_r );
 }
 
 void fresnel_reflectivity_conductor(
@@ -103,33 +113,41 @@ void fresnel_reflectivity_conductor(
         )
 {
     // TODO: extract ior and extinction as spectral sample directly
+    ArSpectralSample  n, k;
+
     for ( int i = 0; i < 4; i++ )
     {
-        double  n =
+        SPS_CI(n, i) =
             ARCPHASEINTERFACE_IOR_AT_WAVELENGTH(
                 *ARCINTERSECTION_PHASEINTERFACE(incomingDirectionAndLocation),
                 ARWL_WI(*wavelength, i)
                 );
 
-        double  k =
+        SPS_CI(k, i) =
             ARCPHASEINTERFACE_EXTINCTION_INTO_AT_WAVELENGTH(
                 *ARCINTERSECTION_PHASEINTERFACE(incomingDirectionAndLocation),
                 ARWL_WI(*wavelength, i)
                 );
+    }
 
-        double  attenuation_perpendicular, attenuation_parallel;
+    ArSpectralSample  attenuation_perpendicular, attenuation_parallel;
 
-        fresnel_ddd_attenuation_dd(
-              INCOMING_COSINE_WORLDSPACE,
-              n,
-              k,
-            & attenuation_perpendicular,
-            & attenuation_parallel
-            );
+    fresnel_dss_attenuation_ss(
+          INCOMING_COSINE_WORLDSPACE,
+        & n,
+        & k,
+        & attenuation_perpendicular,
+        & attenuation_parallel
+        );
 
-        SPS_CI(*reflectivity_r, i) =
-            0.5 * attenuation_perpendicular + 0.5 * attenuation_parallel;
-    }
+    sps_ss_add_s(
+          art_gv,
+        & attenuation_perpendicular,
+        & attenuation_parallel,
+          reflectivity_r
+        );
+
+    sps_d_mul_s( art_gv, 0.5, reflectivity_r );
 }
 
 // refracts the incoming direction based on the IOR at the hero wavelength at the location
@@ -150,31 +150,36 @@ void fresnel_plain_refractive_attenuation_sample(
     (void) pathDirection;
     (void) refractedDirection;
 
-    ArSpectralSample  attenuationSpectralSample;
-    
+    ArSpectralSample  n, attenuation_perpendicular, attenuation_parallel;
+
     for ( int i = 0; i < 4; i++ )
-    {
-        double  n =
+        SPS_CI(n,i) =
             ARCPHASEINTERFACE_IOR_AT_WAVELENGTH(
                 *ARCINTERSECTION_PHASEINTERFACE(incomingDirectionAndLocation),
                 ARWL_WI(*wavelength,i)
                 );
 
-        double  attenuation_perpendicular, attenuation_parallel;
+    fresnel_dss_attenuation_ss(
+          INCOMING_COSINE_WORLDSPACE,
+        & n,
+          SS_ZERO,
+        & attenuation_perpendicular,
+        & attenuation_parallel
+        );
 
-        fresnel_dd_attenuation_dd(
-              INCOMING_COSINE_WORLDSPACE,
-              n,
-            & attenuation_perpendicular,
-            & attenuation_parallel
-            );
+    //   0.5 * ( 1 - R_s ) + 0.5 * ( 1 - R_p ) = 1 - 0.5 * ( R_s + R_p )
 
-        attenuation_perpendicular =  1.0 - attenuation_perpendicular;
-        attenuation_parallel      =  1.0 - attenuation_parallel;
+    ArSpectralSample  attenuationSpectralSample;
 
-        SPS_CI(attenuationSpectralSample,i) =
-            0.5 * attenuation_perpendicular + 0.5 * attenuation_parallel;
-    }
+    sps_ss_add_s(
+          art_gv,
+        & attenuation_perpendicular,
+        & attenuation_parallel,
+        & attenuationSpectralSample
+        );
+
+    sps_d_mul_s( art_gv, -0.5, & attenuationSpectralSample );
+    sps_s_add_s( art_gv, SS_ONE, & attenuationSpectralSample );
     
     arattenuationsample_s_init_a(
           art_gv,
@@ -72,4 +72,22 @@ ART_MODULE_INTERFACE(ArpImageFile)
 
 @end
 
+/* ---------------------------------------------------------------------------
+    'ArpRandomAccessImageFile'
+        Image files that can be read and written region by region, in any
+        order. 'getPlainImage' and 'setPlainImage' accept arbitrary
+        sub-regions of the image for such files, and the file stays open
+        between calls: for reading until it is closed explicitly, and for
+        writing until every pixel of the image has been written at least
+        once.
+--------------------------------------------------------------------------- */
+
+@protocol ArpRandomAccessImageFile
+        < ArpImageFile >
+
+- (BOOL) allPixelsWritten
+        ;
+
+@end
+
 // ===========================================================================
@@ -32,6 +32,7 @@ ART_MODULE_INITIALISATION_FUNCTION
 (
     (void) art_gv;
     RUNTIME_REGISTER_PROTOCOL(ArpImageFile);
+    RUNTIME_REGISTER_PROTOCOL(ArpRandomAccessImageFile);
 )
 
 ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
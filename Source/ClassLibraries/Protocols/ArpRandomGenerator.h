@@ -83,9 +83,11 @@ typedef enum ArRandomValueGeneration
     arrandomvaluegeneration_nr1                  = 0x1001,
     arrandomvaluegeneration_nr2                  = 0x1002,
     arrandomvaluegeneration_gaussian             = 0x1004,
+    arrandomvaluegeneration_philox               = 0x1008,
 
     arrandomvaluegeneration_halton               = 0x2010,
     arrandomvaluegeneration_efficient            = 0x2102,
+    arrandomvaluegeneration_sobol                = 0x2020,
 
     arrandomvaluegeneration_plain_sampling       = 0x0000,
     arrandomvaluegeneration_stratified_sampling  = 0x0100,
@@ -273,6 +275,32 @@ typedef UInt64 ArSequenceID;
 
 @end
 
+
+/* ---------------------------------------------------------------------------
+
+    'ArpPixelSampleRandomGenerator' protocol
+
+    Generators that can make use of knowing which pixel, and which sample
+    within that pixel, they are generating values for. Image samplers that
+    find this protocol call 'reInitializeWithPixel' instead of
+    'reInitializeWith' with a CRC32 of the pixel ID.
+
+    For such generators, the values only depend on the pixel, the sample
+    index and the sequence IDs - so sample indices should be unique per
+    pixel, and should not depend on the thread that renders the sample.
+
+------------------------------------------------------------------------aw- */
+
+@protocol ArpPixelSampleRandomGenerator < ArpRandomGenerator >
+
+- (void) reInitializeWithPixel
+        : (UInt32) x
+        : (UInt32) y
+        : (UInt32) sampleIndex
+        ;
+
+@end
+
 #endif // _ARPRANDOMGENERATOR_H_
 
 // ===========================================================================
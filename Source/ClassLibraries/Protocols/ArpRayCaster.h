@@ -104,6 +104,27 @@ struct ArIntersectionList;
         : (const double) range_end_t
         ;
 
+/* ---------------------------------------------------------------------------
+
+    'anyRayObjectIntersection'
+
+    Occlusion query for shadow rays: determines whether there is any
+    intersection between the starting point and a user-specified end point
+    of the range (the end point itself is not included).
+
+    Same conventions as the four parameter version of
+    'firstRayObjectIntersection', but no ArcIntersection is returned, and
+    traversal of the geometry stops as soon as any hit has been found.
+
+--------------------------------------------------------------------------- */
+
+- (BOOL) anyRayObjectIntersection
+        : (ArNode <ArpRayCasting> *) geometryToIntersectRayWith
+        : (const ArcPointContext *) startingPoint_worldCoordinates
+        : (const Ray3D *) ray_worldCoordinates
+        : (const double) range_end_t
+        ;
+
 /* ---------------------------------------------------------------------------
 
     'getMaterial_at_WorldPnt3D'
@@ -75,6 +75,21 @@ struct ArIntersectionList;
         : (struct ArIntersectionList *) intersectionList
         ;
 
+/* ---------------------------------------------------------------------------
+    'anyIntersectionWithinRange'
+        Occlusion query: returns YES if there is at least one intersection
+        in the one sided interval [range.min, range.max), and NO otherwise.
+        Unlike 'getIntersectionList', no intersection list is handed back,
+        so implementations are free to stop at the first such hit they
+        encounter. A generic version that just evaluates the full list is
+        provided for all nodes by the ArNode ( AnyHitRayCasting ) category.
+--------------------------------------------------------------------------- */
+
+- (BOOL) anyIntersectionWithinRange
+        : (ArnRayCaster *) rayCaster
+        : (Range) range_of_t
+        ;
+
 @end
 
 @protocol ArpShapeRayCasting < ArpRayCasting >
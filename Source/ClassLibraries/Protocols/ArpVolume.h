@@ -32,6 +32,8 @@
 ART_MODULE_INTERFACE(ArpVolume)
 
 #import "ArNode.h"
+
+struct ArVolumeMajorantIterator;
     
 @protocol ArpVolume <ArpNode>
 
@@ -40,6 +42,19 @@ ART_MODULE_INTERFACE(ArpVolume)
         : (     double *) value
         ;
 
+/* ---------------------------------------------------------------------------
+    'lookupPoints'
+        Batched version of 'lookup': 'values' receives 'dimensions' values
+        per point, one point after the other. Saves the per-message
+        overhead when many points of the same volume are needed at once.
+--------------------------------------------------------------------------- */
+
+- (void) lookupPoints
+        : (unsigned int) numberOfPoints
+        : (const Pnt3D *) pointsWorldspace
+        : (      double *) values
+        ;
+
 - (void) max
         : (double *) value
         ;
@@ -57,6 +72,21 @@ ART_MODULE_INTERFACE(ArpVolume)
         : (double *) far
         ;
 
+/* ---------------------------------------------------------------------------
+    'majorantIterator'
+        Sets up an iterator over the segments of the ray between 'near'
+        and 'far', each with an upper bound of the volume values along
+        it. Volumes without finer information just yield one segment
+        with their overall maximum.
+--------------------------------------------------------------------------- */
+
+- (void) majorantIterator
+        : (const Ray3D *) rayWorldspace
+        : (double) near
+        : (double) far
+        : (struct ArVolumeMajorantIterator *) iterator
+        ;
+
 @end
 
 #endif // _ARPVOLUME_H_
@@ -291,6 +291,35 @@ ART_MODULE_INTERFACE(ArpVolumeMaterial)
 @end
 
 
+/* ---------------------------------------------------------------------------
+    
+    'ArpVolumeMaterialMajorants'
+ 
+    Optional protocol for heterogeneous volume materials that can provide
+    majorants which are tighter than the single one per ray returned by
+    'maxCrossSectionForRay' and 'maxScatteringCoefficientForRay'.
+ 
+    The iterator splits the ray interval [near,far] into segments, and
+    for each of them yields a factor in [0,1] that the two per-ray
+    maxima can be multiplied with to obtain a valid majorant for that
+    segment. Tracking integrators restart the free flight sampling at
+    each segment boundary with the local majorant, which avoids most
+    of the null collisions in sparse media.
+ 
+--------------------------------------------------------------------------- */
+
+@protocol ArpVolumeMaterialMajorants
+
+- (void) majorantIteratorForRay
+        : (const Ray3D                     *) rayWorldspace
+        : (      double                     ) near
+        : (      double                     ) far
+        : (      ArVolumeMajorantIterator  *) iterator
+        ;
+
+@end
+
+
 /* ---------------------------------------------------------------------------
     
     Default implementation macros. Note that each volume material will only
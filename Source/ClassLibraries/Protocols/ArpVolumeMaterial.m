@@ -32,6 +32,7 @@ ART_MODULE_INITIALISATION_FUNCTION
 (
     (void) art_gv;
     RUNTIME_REGISTER_PROTOCOL(ArpVolumeMaterial);
+    RUNTIME_REGISTER_PROTOCOL(ArpVolumeMaterialMajorants);
 )
 
 ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
@@ -218,6 +218,41 @@ ARPRAYCASTING_DEFAULT_IMPLEMENTATION(AraWorld)
         );
 }
 
+- (BOOL) anyIntersectionWithinRange
+        : (ArnRayCaster *) rayCaster
+        : (Range) range_of_t
+{
+    //   Same traversal state setup as for 'getIntersectionList'; the
+    //   post-processing of the volume materials along the list is not
+    //   needed for a simple occlusion query.
+
+    CREATE_WEAK_OBJECT_REF(
+        DEFAULT_VOLUME_MATERIAL,
+        ARNRAYCASTER_VOLUME_MATERIAL_REF(rayCaster)
+        );
+
+    CREATE_WEAK_OBJECT_REF(
+        DEFAULT_SURFACE_MATERIAL,
+        ARNRAYCASTER_SURFACE_MATERIAL_REF(rayCaster)
+        );
+
+    ARNRAYCASTER_TRAFO_REF(rayCaster) = ARNODEREF_NONE;
+    ARNRAYCASTER_WORLD(rayCaster) = self;
+
+    BOOL  result =
+        [ SUBNODE anyIntersectionWithinRange
+            :   rayCaster
+            :   range_of_t
+            ];
+
+    ARNRAYCASTER_VOLUME_MATERIAL_REF(rayCaster) = ARNODEREF_NONE;
+    ARNRAYCASTER_SURFACE_MATERIAL_REF(rayCaster)  = ARNODEREF_NONE;
+    ARNRAYCASTER_TRAFO_REF(rayCaster)    = ARNODEREF_NONE;
+    ARNRAYCASTER_WORLD(rayCaster)        = NULL;
+
+    return result;
+}
+
 @end
 
 // ===========================================================================
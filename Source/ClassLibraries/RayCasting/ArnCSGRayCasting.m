@@ -255,6 +255,81 @@ ARPRAYCASTING_DEFAULT_IMPLEMENTATION(ArnCSGand)
 #endif
 }
 
+/* ---------------------------------------------------------------------------
+    'anyIntersectionWithinRange'
+        The right operand is only evaluated within the span of the left
+        one, and not at all if the left list is empty. The operand lists
+        are then walked lazily, without building the combined list.
+--------------------------------------------------------------------------- */
+
+- (BOOL) anyIntersectionWithinRange
+        : (ArnRayCaster *) rayCaster
+        : (Range) range_of_t
+{
+#ifdef ART_WITH_INTERSECTION_STATISTICS
+    arnraycaster_count_test(rayCaster, ArnCSGand);
+#endif
+
+    ArIntersectionList  leftIntersectionList = ARINTERSECTIONLIST_EMPTY;
+
+    [ rayCaster pushDecision: DECISION_LEFT ];
+
+    [ LEFT_SUBNODE getIntersectionList
+        :   rayCaster
+        :   range_of_t
+        : & leftIntersectionList
+        ];
+
+    [ rayCaster popDecision ];
+
+    if ( arintersectionlist_is_empty( & leftIntersectionList ) )
+        return NO;
+
+    Range  rightRange_of_t = range_of_t;
+
+    if ( ! INTERSECTIONLIST_HEAD_MATERIAL(leftIntersectionList) )
+        rightRange_of_t.min = INTERSECTIONLIST_HEAD_T(leftIntersectionList);
+
+    if ( ! INTERSECTIONLIST_TAIL_MATERIAL(leftIntersectionList) )
+        rightRange_of_t.max = INTERSECTIONLIST_TAIL_T(leftIntersectionList);
+
+    ArIntersectionList  rightIntersectionList = ARINTERSECTIONLIST_EMPTY;
+
+    [ rayCaster pushDecision: DECISION_RIGHT ];
+
+    [ RIGHT_SUBNODE getIntersectionList
+        :   rayCaster
+        :   rightRange_of_t
+        : & rightIntersectionList
+        ];
+
+    [ rayCaster popDecision ];
+
+    BOOL  result =
+        arintersectionlist_and_has_intersection_within_range(
+            & leftIntersectionList,
+            & rightIntersectionList,
+            & range_of_t
+            );
+
+    arintersectionlist_free_contents(
+        & leftIntersectionList,
+          ARNRAYCASTER_INTERSECTION_FREELIST(rayCaster)
+        );
+
+    arintersectionlist_free_contents(
+        & rightIntersectionList,
+          ARNRAYCASTER_INTERSECTION_FREELIST(rayCaster)
+        );
+
+#ifdef ART_WITH_INTERSECTION_STATISTICS
+    if ( result )
+        arnraycaster_count_intersection(rayCaster, ArnCSGand);
+#endif
+
+    return result;
+}
+
 @end
 
 @implementation ArnCSGor ( RayCasting )
@@ -483,6 +558,111 @@ ARPRAYCASTING_DEFAULT_IMPLEMENTATION(ArnCSGor)
 #endif
 }
 
+/* ---------------------------------------------------------------------------
+    'anyIntersectionWithinRange'
+        If the ray stays inside the left operand over the whole range, the
+        combined object has no boundary there, and the right operand is
+        not evaluated at all. Otherwise, it is only evaluated where the
+        left one does not override it, and the operand lists are walked
+        lazily, without building the combined list.
+--------------------------------------------------------------------------- */
+
+- (BOOL) anyIntersectionWithinRange
+        : (ArnRayCaster *) rayCaster
+        : (Range) range_of_t
+{
+#ifdef ART_WITH_INTERSECTION_STATISTICS
+    arnraycaster_count_test(rayCaster, ArnCSGor);
+#endif
+
+    ArIntersectionList  leftIntersectionList = ARINTERSECTIONLIST_EMPTY;
+
+    [ rayCaster pushDecision: DECISION_LEFT ];
+
+    [ LEFT_SUBNODE getIntersectionList
+        :   rayCaster
+        :   range_of_t
+        : & leftIntersectionList
+        ];
+
+    [ rayCaster popDecision ];
+
+    Range  rightRange_of_t = range_of_t;
+
+    if ( INTERSECTIONLIST_HEAD_MATERIAL(leftIntersectionList) )
+    {
+        if ( ! INTERSECTIONLIST_HEAD(leftIntersectionList) )  // no hit, just material
+        {
+            arintersectionlist_free_contents(
+                & leftIntersectionList,
+                  ARNRAYCASTER_INTERSECTION_FREELIST(rayCaster)
+                );
+
+            return NO;
+        }
+
+        rightRange_of_t.min =
+              INTERSECTIONLIST_HEAD_T(leftIntersectionList)
+            - ARNRAYCASTER_EPSILON(rayCaster);
+    }
+
+    if ( INTERSECTIONLIST_TAIL_MATERIAL(leftIntersectionList) ) // this also implies a tail
+        rightRange_of_t.max =
+              INTERSECTIONLIST_TAIL_T(leftIntersectionList)
+            + ARNRAYCASTER_EPSILON(rayCaster);
+
+    ArIntersectionList  rightIntersectionList = ARINTERSECTIONLIST_EMPTY;
+
+    [ rayCaster pushDecision: DECISION_RIGHT ];
+
+    [ RIGHT_SUBNODE getIntersectionList
+        :   rayCaster
+        :   rightRange_of_t
+        : & rightIntersectionList
+        ];
+
+    [ rayCaster popDecision ];
+
+    BOOL  result;
+
+    if ( arintersectionlist_is_empty( & rightIntersectionList ) )
+        result =
+            arintersectionlist_has_intersection_within_range(
+                & leftIntersectionList,
+                & range_of_t
+                );
+    else if ( arintersectionlist_is_empty( & leftIntersectionList ) )
+        result =
+            arintersectionlist_has_intersection_within_range(
+                & rightIntersectionList,
+                & range_of_t
+                );
+    else
+        result =
+            arintersectionlist_or_has_intersection_within_range(
+                & leftIntersectionList,
+                & rightIntersectionList,
+                & range_of_t
+                );
+
+    arintersectionlist_free_contents(
+        & leftIntersectionList,
+          ARNRAYCASTER_INTERSECTION_FREELIST(rayCaster)
+        );
+
+    arintersectionlist_free_contents(
+        & rightIntersectionList,
+          ARNRAYCASTER_INTERSECTION_FREELIST(rayCaster)
+        );
+
+#ifdef ART_WITH_INTERSECTION_STATISTICS
+    if ( result )
+        arnraycaster_count_intersection(rayCaster, ArnCSGor);
+#endif
+
+    return result;
+}
+
 @end
 
 @implementation ArnCSGcombine ( RayCasting )
@@ -851,6 +1031,8 @@ ARPRAYCASTING_DEFAULT_IMPLEMENTATION(ArnCSGsub)
         INTERSECTION_TEST_DEBUG_OUTPUT_RESULT_LIST_WITH_COMMENT(
             "(right list empty, left list taken)"
             );
+
+        return;
     }
 
     arintersectionlist_sub(
@@ -867,6 +1049,105 @@ ARPRAYCASTING_DEFAULT_IMPLEMENTATION(ArnCSGsub)
 #endif
 }
 
+/* ---------------------------------------------------------------------------
+    'anyIntersectionWithinRange'
+        Same pruning of the right operand as in 'getIntersectionList'; the
+        operand lists are then walked lazily, without building the
+        combined list.
+--------------------------------------------------------------------------- */
+
+- (BOOL) anyIntersectionWithinRange
+        : (ArnRayCaster *) rayCaster
+        : (Range) range_of_t
+{
+    ArIntersectionList  leftIntersectionList  = ARINTERSECTIONLIST_EMPTY;
+    ArIntersectionList  rightIntersectionList = ARINTERSECTIONLIST_EMPTY;
+    ArUnionOptions      unionOptionStore;
+
+#ifdef ART_WITH_INTERSECTION_STATISTICS
+    arnraycaster_count_test(rayCaster, ArnCSGsub);
+#endif
+
+    [ rayCaster pushUnionOptions
+        :   arunion_set
+        : & unionOptionStore
+        ];
+
+    [ rayCaster pushDecision: DECISION_LEFT ];
+
+    [ LEFT_SUBNODE getIntersectionList
+        :   rayCaster
+        :   range_of_t
+        : & leftIntersectionList
+        ];
+
+    [ rayCaster popDecision ];
+
+    if ( arintersectionlist_is_empty( & leftIntersectionList ) )
+    {
+        [ rayCaster popUnionOptions: unionOptionStore ];
+
+        return NO;
+    }
+
+    Range  rightRange_of_t = range_of_t;
+
+    if ( ! INTERSECTIONLIST_HEAD_MATERIAL(leftIntersectionList) )
+        rightRange_of_t.min = INTERSECTIONLIST_HEAD_T(leftIntersectionList);
+
+    if ( ! INTERSECTIONLIST_TAIL_MATERIAL(leftIntersectionList) )
+        rightRange_of_t.max = INTERSECTIONLIST_TAIL_T(leftIntersectionList);
+
+    [ rayCaster invertSpace ];
+
+    [ rayCaster pushDecision: DECISION_RIGHT ];
+
+    [ RIGHT_SUBNODE getIntersectionList
+        :   rayCaster
+        :   rightRange_of_t
+        : & rightIntersectionList
+        ];
+
+    [ rayCaster popDecision ];
+
+    [ rayCaster invertSpace ];
+
+    [ rayCaster popUnionOptions: unionOptionStore ];
+
+    BOOL  result;
+
+    if ( arintersectionlist_is_empty( & rightIntersectionList ) )
+        result =
+            arintersectionlist_has_intersection_within_range(
+                & leftIntersectionList,
+                & range_of_t
+                );
+    else
+        result =
+            arintersectionlist_sub_has_intersection_within_range(
+                & leftIntersectionList,
+                & rightIntersectionList,
+                & range_of_t
+                );
+
+    arintersectionlist_free_contents(
+        & leftIntersectionList,
+          ARNRAYCASTER_INTERSECTION_FREELIST(rayCaster)
+        );
+
+    arintersectionlist_free_contents(
+        & rightIntersectionList,
+          ARNRAYCASTER_INTERSECTION_FREELIST(rayCaster)
+        );
+
+#ifdef ART_WITH_INTERSECTION_STATISTICS
+    if ( result )
+        arnraycaster_count_intersection(rayCaster, ArnCSGsub);
+#endif
+
+    return result;
+}
+
 @end
 
 // ===========================================================================
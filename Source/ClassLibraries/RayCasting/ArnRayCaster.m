@@ -457,6 +457,40 @@ THIS ONLY HAS TO BE RE-ACTIVATED IF AND WHEN THE REFERENCE CACHE IS ADDED BACK
     return intersection;
 }
 
+- (BOOL) anyRayObjectIntersection
+        : (ArNode <ArpRayCasting> *) geometryToIntersectRayWith
+        : (const ArcPointContext *) startingPoint_worldCoordinates
+        : (const Ray3D *) ray_worldCoordinates
+        : (const double) range_end_t
+{
+    rayID++;
+
+    intersection_test_world_ray3d = *ray_worldCoordinates;
+
+    ray3de_init(
+        & intersection_test_world_ray3d,
+        & intersection_test_ray3de
+        );
+
+    intersection_test_origin = startingPoint_worldCoordinates;
+
+    //   Same policy as in 'firstRayObjectIntersection': close hits are
+    //   only ignored if we actually start at a surface point.
+
+    double  range_start_t = 0.0;
+
+    if ( [ startingPoint_worldCoordinates isMemberOfClass
+          :   [ ArcSurfacePoint class ]
+          ] )
+        range_start_t = hitEps;
+
+    return
+        [ geometryToIntersectRayWith anyIntersectionWithinRange
+            :   self
+            :   RANGE( range_start_t, range_end_t )
+            ];
+}
+
 - (void) prepareForRayCasting
         : (ArNode <ArpWorld> *) geometryToRayCast
         : (const Pnt3D *) eyePoint_worldCoordinates
@@ -156,6 +156,23 @@ ARPRAYCASTING_DEFAULT_IMPLEMENTATION(ArnTriangleMesh)
     *intersectionList = resultingList;
 }
 
+- (BOOL) anyIntersectionWithinRange
+        : (ArnRayCaster *) rayCaster
+        : (Range) range_of_t
+{
+    //   Any hit on any of the triangles is an occluder, regardless of
+    //   whether the mesh is solid or singular - so the pairing of entry
+    //   and exit hits done above is not needed here, and the internal
+    //   tree can stop at the first triangle it hits.
+
+    return
+        [ (ArNode <ArpRayCasting> *) internalMeshTree
+            anyIntersectionWithinRange
+            :   rayCaster
+            :   range_of_t
+            ];
+}
+
 @end
 
 // ===========================================================================
@@ -174,10 +174,51 @@ ARPRAYCASTING_SINGULAR_SHAPE_IMPLEMENTATION
 - (void) calculateLocalNormalForIntersection
         : (ArcIntersection *) intersection
 {
-    vec3d_fv_to_v(
-        & triangleData->normal,
-        & OBJECTSPACE_NORMAL(intersection)
-        );
+    //   Intersections created by the packed triangle kernel of the mesh
+    //   BSP only carry barycentric coordinates, so the interpolated vertex
+    //   normal is computed here, once the intersection is actually used.
+
+    if (   vertexNormals
+        && ARCINTERSECTION_TEXTURE_COORDS_ARE_VALID(intersection) )
+    {
+        double  w = YC(TEXTURE_COORDS(intersection));
+        double  v = XC(TEXTURE_COORDS(intersection));
+        double  u = 1. - w - v;
+
+        Vec3D  uv, vv, wv;
+
+        vec3d_fv_to_v(
+            & vertexNormals[ ARARRAY_I( indexTable, 0 ) ],
+            & uv
+            );
+
+        vec3d_fv_to_v(
+            & vertexNormals[ ARARRAY_I( indexTable, 1 ) ],
+            & vv
+            );
+
+        vec3d_fv_to_v(
+            & vertexNormals[ ARARRAY_I( indexTable, 2 ) ],
+            & wv
+            );
+
+        vec3d_dv_mul_dv_mul_dv_mul_add3_v(
+              u,
+            & uv,
+              v,
+            & vv,
+              w,
+            & wv,
+            & OBJECTSPACE_NORMAL(intersection)
+            );
+    }
+    else
+    {
+        vec3d_fv_to_v(
+            & triangleData->normal,
+            & OBJECTSPACE_NORMAL(intersection)
+            );
+    }
 
     FLAG_OBJECTSPACE_NORMAL_AS_VALID(intersection);
 }
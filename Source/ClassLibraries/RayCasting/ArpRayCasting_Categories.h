@@ -58,6 +58,28 @@ ART_MODULE_INTERFACE(ArpRayCasting_Categories)
 
 //#define ART_WITH_RAYCASTING_DEBUG_OUTPUT
 
+/* ---------------------------------------------------------------------------
+
+    ArNode ( AnyHitRayCasting )
+
+    Generic implementation of the 'anyIntersectionWithinRange' occlusion
+    query: the full intersection list is computed, checked for a hit inside
+    the range, and returned to the freelist. Nodes which can do better -
+    i.e. stop traversing at the first hit - override this.
+
+------------------------------------------------------------------------aw- */
+
+@interface ArNode ( AnyHitRayCasting )
+
+- (BOOL) anyIntersectionWithinRange
+        : (ArnRayCaster *) rayCaster
+        : (Range) range_of_t
+        ;
+
+@end
+
+ART_MODULE_INTERFACE(ArNodeAnyHitRayCasting)
+
 @interface AraBBox                  ( RayCasting ) < ArpRayCasting > @end
 @interface AraVolumeMaterial              ( RayCasting ) < ArpRayCasting > @end
 @interface AraRules                 ( RayCasting ) < ArpRayCasting > @end
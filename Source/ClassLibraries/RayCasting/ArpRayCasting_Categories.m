@@ -31,6 +31,7 @@
 
 ART_MODULE_INITIALISATION_FUNCTION
 (
+    ART_PERFORM_MODULE_INIT_FROM_MODULE( ArNodeAnyHitRayCasting )
     ART_PERFORM_MODULE_INIT_FROM_MODULE( AraBBoxRayCasting )
     ART_PERFORM_MODULE_INIT_FROM_MODULE( AraCombinedReferenceRayCasting )
     ART_PERFORM_MODULE_INIT_FROM_MODULE( AraCombinedAttributesRayCasting )
@@ -91,6 +92,7 @@ ART_MODULE_SHUTDOWN_FUNCTION
     ART_PERFORM_MODULE_SHUTDOWN( AraCombinedAttributesRayCasting )
     ART_PERFORM_MODULE_SHUTDOWN( AraCombinedReferenceRayCasting )
     ART_PERFORM_MODULE_SHUTDOWN( AraBBoxRayCasting )
+    ART_PERFORM_MODULE_SHUTDOWN( ArNodeAnyHitRayCasting )
 )
 
 
@@ -30,6 +30,7 @@ ART_LIBRARY_INTERFACE(ART_RayCastingAcceleration)
 
 #import "ArSGL.h"
 
+#import "ArBSPTreeCache.h"
 #import "ArnBSPTree.h"
 #import "ArnLeafNodeBBoxCollection.h"
 #import "ArnOperationTree.h"
@@ -31,6 +31,7 @@
 ART_LIBRARY_INITIALISATION_FUNCTION
 (
     ART_PERFORM_MODULE_INITIALISATION( ArSGL )
+    ART_PERFORM_MODULE_INITIALISATION( ArBSPTreeCache )
     ART_PERFORM_MODULE_INITIALISATION( ArnBSPTree )
     ART_PERFORM_MODULE_INITIALISATION( ArnLeafNodeBBoxCollection )
     ART_PERFORM_MODULE_INITIALISATION( ArnOperationTree )
@@ -0,0 +1,114 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+
+#include "ART_Foundation.h"
+
+ART_MODULE_INTERFACE(ArBSPTreeCache)
+
+/* ---------------------------------------------------------------------------
+    'ArBSPTreeCache'
+        Persistent cache for the BSP trees built by ArnBSPTree, so that
+        repeated renderings of the same static geometry can skip the SAH
+        build. The cache is switched on by naming a cache file (typically
+        next to the scene file) with art_set_bsp_tree_cache_file().
+
+        Each cached tree is keyed by a hash of the bounding boxes of the
+        scenegraph leaves it was built for, in the order in which they were
+        collected: any change of the geometry results in a different key,
+        and the stale tree is no longer found. The leaves themselves are
+        not stored; leaf cells refer to them by their index in the master
+        leaf array of the tree.
+
+        The existing cache file is mapped read-only when it is named. A new
+        one, containing all trees that were used or built in this run, is
+        written by art_write_bsp_tree_cache() if any tree had to be built.
+        Stale trees are dropped in the process.
+--------------------------------------------------------------------------- */
+
+typedef struct ArBSPTreeCacheKey
+{
+    UInt64  hash[2];
+    Int32   numberOfLeaves;
+}
+ArBSPTreeCacheKey;
+
+void arbsptreecachekey_init(
+              ArBSPTreeCacheKey  * key,
+        const int                  numberOfLeaves
+        );
+
+void arbsptreecachekey_add(
+              ArBSPTreeCacheKey  * key,
+        const void               * data,
+        const size_t               size
+        );
+
+//   'leafArrayStart' has numberOfLeafArrays + 1 entries: leaf cell i
+//   contains the master leaves with the indices leafIndex[leafArrayStart[i]]
+//   to leafIndex[leafArrayStart[i+1] - 1].
+
+typedef struct ArBSPTreeCacheData
+{
+    Int32            numberOfNodes;
+    Int32            numberOfLeafArrays;
+    Int32            maximumNumberOfLeavesPerCell;
+    Int32            numberOfInnerCells;
+    const BSPNode  * node;
+    const Int32    * leafArrayStart;
+    const Int32    * leafIndex;
+}
+ArBSPTreeCacheData;
+
+void art_set_bsp_tree_cache_file(
+              ART_GV  * art_gv,
+        const char    * cacheFileName
+        );
+
+BOOL art_use_bsp_tree_cache(
+        const ART_GV  * art_gv
+        );
+
+//   The data returned by a successful look-up stays valid until the
+//   module is shut down.
+
+BOOL arbsptreecache_find(
+              ART_GV              * art_gv,
+        const ArBSPTreeCacheKey   * key,
+              ArBSPTreeCacheData  * data
+        );
+
+void arbsptreecache_add(
+              ART_GV              * art_gv,
+        const ArBSPTreeCacheKey   * key,
+        const ArBSPTreeCacheData  * data
+        );
+
+void art_write_bsp_tree_cache(
+        ART_GV  * art_gv
+        );
+
+// ===========================================================================
@@ -0,0 +1,596 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+
+#define ART_MODULE_NAME     ArBSPTreeCache
+
+#import "ArBSPTreeCache.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//   Bump the version whenever the BSP build, or anything it depends on,
+//   changes in a way that would give different trees for the same leaves.
+
+#define ARBSPTREECACHE_MAGIC        "ARTBSPC"
+#define ARBSPTREECACHE_VERSION      1
+#define ARBSPTREECACHE_BYTE_ORDER   0x01020304
+
+typedef struct ArBSPTreeCacheFileHeader
+{
+    char    magic[8];
+    UInt32  version;
+    UInt32  byteOrder;
+    UInt32  sizeOfBSPNode;
+    UInt32  numberOfEntries;
+}
+ArBSPTreeCacheFileHeader;
+
+//   Each entry is this header, followed by the BSP nodes, the leaf array
+//   start indices and the leaf indices, padded to a multiple of 8 bytes.
+
+typedef struct ArBSPTreeCacheEntryHeader
+{
+    UInt64  hash[2];
+    Int32   numberOfLeaves;
+    Int32   numberOfNodes;
+    Int32   numberOfLeafArrays;
+    Int32   numberOfLeafIndices;
+    Int32   maximumNumberOfLeavesPerCell;
+    Int32   numberOfInnerCells;
+}
+ArBSPTreeCacheEntryHeader;
+
+typedef struct ArBSPTreeCacheEntry
+{
+    const ArBSPTreeCacheEntryHeader  * header;
+    size_t                             size;
+    BOOL                               owned;
+    BOOL                               used;
+}
+ArBSPTreeCacheEntry;
+
+typedef struct ArBSPTreeCache_GV
+{
+    char                 * fileName;
+    void                 * mapping;
+    size_t                 mappingSize;
+    int                    numberOfEntries;
+    int                    numberOfAllocatedEntries;
+    ArBSPTreeCacheEntry  * entry;
+    BOOL                   modified;
+    pthread_mutex_t        mutex;
+}
+ArBSPTreeCache_GV;
+
+#define ARBSPTREECACHE_GV           art_gv->arbsptreecache_gv
+#define ARBSPTREECACHE_GV_MUTEX     ARBSPTREECACHE_GV->mutex
+
+static void arbsptreecache_free_entries(
+        ART_GV  * art_gv
+        );
+
+ART_MODULE_INITIALISATION_FUNCTION
+(
+    ARBSPTREECACHE_GV = ALLOC(ArBSPTreeCache_GV);
+
+    ARBSPTREECACHE_GV->fileName = NULL;
+    ARBSPTREECACHE_GV->mapping = NULL;
+    ARBSPTREECACHE_GV->mappingSize = 0;
+    ARBSPTREECACHE_GV->numberOfEntries = 0;
+    ARBSPTREECACHE_GV->numberOfAllocatedEntries = 0;
+    ARBSPTREECACHE_GV->entry = NULL;
+    ARBSPTREECACHE_GV->modified = NO;
+
+    pthread_mutex_init( & ARBSPTREECACHE_GV_MUTEX, NULL );
+)
+
+ART_MODULE_SHUTDOWN_FUNCTION
+(
+    art_write_bsp_tree_cache( art_gv );
+
+    arbsptreecache_free_entries( art_gv );
+
+    pthread_mutex_destroy( & ARBSPTREECACHE_GV_MUTEX );
+
+    FREE( ARBSPTREECACHE_GV );
+)
+
+
+/* ---------------------------------------------------------------------------
+    Keys
+        Two independent 64 bit hashes (FNV-1a, and a multiplicative one
+        on 64 bit words), plus the number of leaves.
+--------------------------------------------------------------------------- */
+
+#define ARBSPTREECACHE_FNV_OFFSET   0xcbf29ce484222325ULL
+#define ARBSPTREECACHE_FNV_PRIME    0x100000001b3ULL
+
+void arbsptreecachekey_init(
+              ArBSPTreeCacheKey  * key,
+        const int                  numberOfLeaves
+        )
+{
+    key->hash[0] = ARBSPTREECACHE_FNV_OFFSET;
+    key->hash[1] = 0x9e3779b97f4a7c15ULL;
+    key->numberOfLeaves = numberOfLeaves;
+}
+
+void arbsptreecachekey_add(
+              ArBSPTreeCacheKey  * key,
+        const void               * data,
+        const size_t               size
+        )
+{
+    const unsigned char  * byte = data;
+
+    for ( size_t i = 0; i < size; i++ )
+    {
+        key->hash[0] ^= byte[i];
+        key->hash[0] *= ARBSPTREECACHE_FNV_PRIME;
+    }
+
+    for ( size_t i = 0; i < size; i += 8 )
+    {
+        UInt64  word = 0;
+
+        memcpy( & word, byte + i, M_MIN( size - i, 8 ) );
+
+        key->hash[1] ^= word;
+        key->hash[1] *= 0xff51afd7ed558ccdULL;
+        key->hash[1] ^= key->hash[1] >> 33;
+    }
+}
+
+
+/* ---------------------------------------------------------------------------
+    Entries
+--------------------------------------------------------------------------- */
+
+static size_t arbsptreecache_entry_size(
+        const ArBSPTreeCacheEntryHeader  * header
+        )
+{
+    size_t  size =
+          sizeof(ArBSPTreeCacheEntryHeader)
+        + (size_t) header->numberOfNodes * sizeof(BSPNode)
+        + (size_t) ( header->numberOfLeafArrays + 1 ) * sizeof(Int32)
+        + (size_t) header->numberOfLeafIndices * sizeof(Int32);
+
+    return ( size + 7 ) & ~ (size_t) 7;
+}
+
+static void arbsptreecache_entry_data(
+        const ArBSPTreeCacheEntryHeader  * header,
+              ArBSPTreeCacheData         * data
+        )
+{
+    const char  * payload = (const char *) ( header + 1 );
+
+    data->numberOfNodes = header->numberOfNodes;
+    data->numberOfLeafArrays = header->numberOfLeafArrays;
+    data->maximumNumberOfLeavesPerCell = header->maximumNumberOfLeavesPerCell;
+    data->numberOfInnerCells = header->numberOfInnerCells;
+
+    data->node = (const BSPNode *) payload;
+    payload += header->numberOfNodes * sizeof(BSPNode);
+
+    data->leafArrayStart = (const Int32 *) payload;
+    payload += ( header->numberOfLeafArrays + 1 ) * sizeof(Int32);
+
+    data->leafIndex = (const Int32 *) payload;
+}
+
+//   Cache files are not trusted: a damaged tree would otherwise send the
+//   ray caster off into random memory.
+
+static BOOL arbsptreecache_entry_is_consistent(
+        const ArBSPTreeCacheEntryHeader  * header
+        )
+{
+    ArBSPTreeCacheData  data;
+
+    arbsptreecache_entry_data( header, & data );
+
+    if ( data.leafArrayStart[0] != 0 )
+        return NO;
+
+    for ( int i = 0; i < data.numberOfLeafArrays; i++ )
+        if ( data.leafArrayStart[i + 1] < data.leafArrayStart[i] )
+            return NO;
+
+    if ( data.leafArrayStart[ data.numberOfLeafArrays ]
+         != header->numberOfLeafIndices )
+        return NO;
+
+    for ( int i = 0; i < header->numberOfLeafIndices; i++ )
+        if (   data.leafIndex[i] < 0
+            || data.leafIndex[i] >= header->numberOfLeaves )
+            return NO;
+
+    for ( int i = 0; i < data.numberOfNodes; i++ )
+    {
+        if ( BSP_NODE_IS_LEAF( data.node[i] ) )
+        {
+            if ( BSP_NODE_LEAF_INDEX( data.node[i] ) >= data.numberOfLeafArrays )
+                return NO;
+        }
+        else
+        {
+            long  child =
+                BSP_NODE_ARRAY_OFFSET( data.node[i] ) / sizeof(BSPNode);
+
+            if ( child <= i || child + 1 >= data.numberOfNodes )
+                return NO;
+        }
+    }
+
+    return YES;
+}
+
+static void arbsptreecache_append_entry(
+              ART_GV                     * art_gv,
+        const ArBSPTreeCacheEntryHeader  * header,
+        const size_t                       size,
+        const BOOL                         owned
+        )
+{
+    ArBSPTreeCache_GV  * gv = ARBSPTREECACHE_GV;
+
+    if ( gv->numberOfEntries == gv->numberOfAllocatedEntries )
+    {
+        gv->numberOfAllocatedEntries =
+            M_MAX( 2 * gv->numberOfAllocatedEntries, 16 );
+
+        gv->entry =
+            REALLOC_ARRAY(
+                gv->entry,
+                ArBSPTreeCacheEntry,
+                gv->numberOfAllocatedEntries
+                );
+    }
+
+    ArBSPTreeCacheEntry  * entry = & gv->entry[ gv->numberOfEntries++ ];
+
+    entry->header = header;
+    entry->size = size;
+    entry->owned = owned;
+    entry->used = owned;
+}
+
+static ArBSPTreeCacheEntry * arbsptreecache_entry_for_key(
+              ART_GV             * art_gv,
+        const ArBSPTreeCacheKey  * key
+        )
+{
+    ArBSPTreeCache_GV  * gv = ARBSPTREECACHE_GV;
+
+    for ( int i = 0; i < gv->numberOfEntries; i++ )
+    {
+        const ArBSPTreeCacheEntryHeader  * header = gv->entry[i].header;
+
+        if (   header->hash[0] == key->hash[0]
+            && header->hash[1] == key->hash[1]
+            && header->numberOfLeaves == key->numberOfLeaves )
+            return & gv->entry[i];
+    }
+
+    return NULL;
+}
+
+static void arbsptreecache_free_entries(
+        ART_GV  * art_gv
+        )
+{
+    ArBSPTreeCache_GV  * gv = ARBSPTREECACHE_GV;
+
+    for ( int i = 0; i < gv->numberOfEntries; i++ )
+        if ( gv->entry[i].owned )
+            FREE_ARRAY( gv->entry[i].header );
+
+    if ( gv->entry )
+        FREE_ARRAY( gv->entry );
+
+    if ( gv->mapping )
+        munmap( gv->mapping, gv->mappingSize );
+
+    if ( gv->fileName )
+        FREE_ARRAY( gv->fileName );
+
+    gv->entry = NULL;
+    gv->mapping = NULL;
+    gv->fileName = NULL;
+    gv->numberOfEntries = 0;
+    gv->numberOfAllocatedEntries = 0;
+    gv->modified = NO;
+}
+
+
+/* ---------------------------------------------------------------------------
+    Cache file
+--------------------------------------------------------------------------- */
+
+static void arbsptreecache_map_file(
+        ART_GV  * art_gv
+        )
+{
+    ArBSPTreeCache_GV  * gv = ARBSPTREECACHE_GV;
+
+    int  fd = open( gv->fileName, O_RDONLY );
+
+    if ( fd < 0 )
+        return;
+
+    struct stat  fileStat;
+
+    if (   fstat( fd, & fileStat ) != 0
+        || (size_t) fileStat.st_size < sizeof(ArBSPTreeCacheFileHeader) )
+    {
+        close( fd );
+        return;
+    }
+
+    const size_t  size = fileStat.st_size;
+
+    void  * mapping = mmap( NULL, size, PROT_READ, MAP_SHARED, fd, 0 );
+
+    close( fd );
+
+    if ( mapping == MAP_FAILED )
+        return;
+
+    const ArBSPTreeCacheFileHeader  * fileHeader = mapping;
+
+    if (   memcmp( fileHeader->magic, ARBSPTREECACHE_MAGIC, 8 ) != 0
+        || fileHeader->version != ARBSPTREECACHE_VERSION
+        || fileHeader->byteOrder != ARBSPTREECACHE_BYTE_ORDER
+        || fileHeader->sizeOfBSPNode != sizeof(BSPNode) )
+    {
+        munmap( mapping, size );
+        return;
+    }
+
+    gv->mapping = mapping;
+    gv->mappingSize = size;
+
+    //   Index the entries; a truncated or damaged tail is just ignored.
+
+    size_t  offset = sizeof(ArBSPTreeCacheFileHeader);
+
+    for ( UInt32 i = 0; i < fileHeader->numberOfEntries; i++ )
+    {
+        if ( size - offset < sizeof(ArBSPTreeCacheEntryHeader) )
+            break;
+
+        const ArBSPTreeCacheEntryHeader  * header =
+            (const ArBSPTreeCacheEntryHeader *) ( (char *) mapping + offset );
+
+        if (   header->numberOfLeaves < 0
+            || header->numberOfNodes < 1
+            || header->numberOfLeafArrays < 1
+            || header->numberOfLeafIndices < 0 )
+            break;
+
+        size_t  entrySize = arbsptreecache_entry_size( header );
+
+        if ( entrySize > size - offset )
+            break;
+
+        arbsptreecache_append_entry( art_gv, header, entrySize, NO );
+
+        offset += entrySize;
+    }
+}
+
+void art_set_bsp_tree_cache_file(
+              ART_GV  * art_gv,
+        const char    * cacheFileName
+        )
+{
+    pthread_mutex_lock( & ARBSPTREECACHE_GV_MUTEX );
+
+    arbsptreecache_free_entries( art_gv );
+
+    if ( cacheFileName )
+    {
+        ARBSPTREECACHE_GV->fileName =
+            ALLOC_ARRAY( char, strlen( cacheFileName ) + 1 );
+
+        strcpy( ARBSPTREECACHE_GV->fileName, cacheFileName );
+
+        arbsptreecache_map_file( art_gv );
+    }
+
+    pthread_mutex_unlock( & ARBSPTREECACHE_GV_MUTEX );
+}
+
+BOOL art_use_bsp_tree_cache(
+        const ART_GV  * art_gv
+        )
+{
+    return ARBSPTREECACHE_GV->fileName != NULL;
+}
+
+BOOL arbsptreecache_find(
+              ART_GV              * art_gv,
+        const ArBSPTreeCacheKey   * key,
+              ArBSPTreeCacheData  * data
+        )
+{
+    BOOL  found = NO;
+
+    pthread_mutex_lock( & ARBSPTREECACHE_GV_MUTEX );
+
+    ArBSPTreeCacheEntry  * entry = arbsptreecache_entry_for_key( art_gv, key );
+
+    if (   entry
+        && ( entry->used || arbsptreecache_entry_is_consistent( entry->header ) ) )
+    {
+        entry->used = YES;
+        arbsptreecache_entry_data( entry->header, data );
+        found = YES;
+    }
+
+    pthread_mutex_unlock( & ARBSPTREECACHE_GV_MUTEX );
+
+    return found;
+}
+
+void arbsptreecache_add(
+              ART_GV              * art_gv,
+        const ArBSPTreeCacheKey   * key,
+        const ArBSPTreeCacheData  * data
+        )
+{
+    ArBSPTreeCacheEntryHeader  header;
+
+    header.hash[0] = key->hash[0];
+    header.hash[1] = key->hash[1];
+    header.numberOfLeaves = key->numberOfLeaves;
+    header.numberOfNodes = data->numberOfNodes;
+    header.numberOfLeafArrays = data->numberOfLeafArrays;
+    header.numberOfLeafIndices = data->leafArrayStart[ data->numberOfLeafArrays ];
+    header.maximumNumberOfLeavesPerCell = data->maximumNumberOfLeavesPerCell;
+    header.numberOfInnerCells = data->numberOfInnerCells;
+
+    const size_t  size = arbsptreecache_entry_size( & header );
+
+    //   Allocated as UInt64 to get the alignment the payload needs
+
+    UInt64  * blob = ALLOC_ARRAY( UInt64, size / 8 );
+    char    * payload = (char *) blob;
+
+    memset( blob, 0, size );
+
+    memcpy( payload, & header, sizeof(header) );
+    payload += sizeof(header);
+
+    memcpy( payload, data->node, header.numberOfNodes * sizeof(BSPNode) );
+    payload += header.numberOfNodes * sizeof(BSPNode);
+
+    memcpy(
+        payload,
+        data->leafArrayStart,
+        ( header.numberOfLeafArrays + 1 ) * sizeof(Int32)
+        );
+    payload += ( header.numberOfLeafArrays + 1 ) * sizeof(Int32);
+
+    memcpy( payload, data->leafIndex, header.numberOfLeafIndices * sizeof(Int32) );
+
+    pthread_mutex_lock( & ARBSPTREECACHE_GV_MUTEX );
+
+    //   Identical geometry may have been built twice in parallel
+
+    if ( ! arbsptreecache_entry_for_key( art_gv, key ) )
+    {
+        arbsptreecache_append_entry(
+              art_gv,
+            (ArBSPTreeCacheEntryHeader *) blob,
+              size,
+              YES
+            );
+
+        ARBSPTREECACHE_GV->modified = YES;
+        blob = NULL;
+    }
+
+    pthread_mutex_unlock( & ARBSPTREECACHE_GV_MUTEX );
+
+    if ( blob )
+        FREE_ARRAY( blob );
+}
+
+void art_write_bsp_tree_cache(
+        ART_GV  * art_gv
+        )
+{
+    ArBSPTreeCache_GV  * gv = ARBSPTREECACHE_GV;
+
+    pthread_mutex_lock( & ARBSPTREECACHE_GV_MUTEX );
+
+    if ( ! gv->fileName || ! gv->modified )
+    {
+        pthread_mutex_unlock( & ARBSPTREECACHE_GV_MUTEX );
+        return;
+    }
+
+    //   Written under a temporary name and then renamed, so that other
+    //   processes never see a partial file, and so that our own mapping
+    //   of the old file stays intact.
+
+    char  * tempName = ALLOC_ARRAY( char, strlen( gv->fileName ) + 32 );
+
+    sprintf( tempName, "%s.%d", gv->fileName, (int) getpid() );
+
+    FILE  * file = fopen( tempName, "wb" );
+    BOOL    success = ( file != NULL );
+
+    if ( success )
+    {
+        ArBSPTreeCacheFileHeader  fileHeader;
+
+        memset( & fileHeader, 0, sizeof(fileHeader) );
+        memcpy( fileHeader.magic, ARBSPTREECACHE_MAGIC, 8 );
+
+        fileHeader.version = ARBSPTREECACHE_VERSION;
+        fileHeader.byteOrder = ARBSPTREECACHE_BYTE_ORDER;
+        fileHeader.sizeOfBSPNode = sizeof(BSPNode);
+        fileHeader.numberOfEntries = 0;
+
+        for ( int i = 0; i < gv->numberOfEntries; i++ )
+            if ( gv->entry[i].used )
+                fileHeader.numberOfEntries++;
+
+        success = fwrite( & fileHeader, sizeof(fileHeader), 1, file ) == 1;
+
+        for ( int i = 0; success && i < gv->numberOfEntries; i++ )
+            if ( gv->entry[i].used )
+                success =
+                    fwrite( gv->entry[i].header, gv->entry[i].size, 1, file ) == 1;
+
+        success = ( fclose( file ) == 0 ) && success;
+    }
+
+    if ( ! success || rename( tempName, gv->fileName ) != 0 )
+    {
+        unlink( tempName );
+
+        ART_ERRORHANDLING_WARNING(
+            "could not write BSP tree cache file '%s'"
+            ,   gv->fileName
+            );
+    }
+    else
+        gv->modified = NO;
+
+    FREE_ARRAY( tempName );
+
+    pthread_mutex_unlock( & ARBSPTREECACHE_GV_MUTEX );
+}
+
+// ===========================================================================
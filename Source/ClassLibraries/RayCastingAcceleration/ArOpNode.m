@@ -303,6 +303,26 @@ void intersect_leaf(
     ArOpNode* me = opNodeArray + myId;
     ArSGL* sglPtr = (ArSGL*)me->data;
 
+    if ( ARSGL_IS_INSTANCE(*sglPtr) )
+    {
+        //   Compiled instances restore the viewing ray themselves, so
+        //   it can be handed over unchanged.
+
+        Ray3D  viewingRay3D = RAYCASTER_VIEWING_RAY3D;
+
+        arsgl_instance_get_intersection_list(
+              sglPtr,
+              rayCaster,
+            & viewingRay3D,
+              RANGE(ARNRAYCASTER_EPSILON(rayCaster),MATH_HUGE_DOUBLE),
+              intersectionList
+            );
+
+        rayCaster->activeNodes[myId] = NO;
+
+        return;
+    }
+
     ray3d_r_htrafo3d_r(
         & RAYCASTER_VIEWING_RAY3D,
         & ARSGL_TRAFO(*sglPtr),
@@ -32,6 +32,36 @@ ART_MODULE_INTERFACE(ArSGL)
 #include "ArnOperationTree.h"
 //   ArSGL = ArScenegraphLeaf
 
+//   Instance bindings of a leaf. Nearly all leaves are AraCombinedAttributes
+//   nodes that carry the accumulated attributes of the scene graph above
+//   the actual shape. 'compileInstances' (see ArnLeafNodeBBoxCollection)
+//   looks through these nodes once, and stores their subnode, the
+//   attributes, and the method implementations of the subnode here. The
+//   trafo of the attribute node is folded into 'trafo_world2object' of the
+//   leaf, so that a ray only has to be transformed once per leaf.
+//
+//   'shape' is NULL for leaves that have not been compiled.
+
+typedef struct ArSGLInstance
+{
+    id        shape;
+    ArNode  * volumeMaterial;
+    ArNode  * surfaceMaterial;
+    ArNode  * environmentMaterial;
+    ArNode  * trafo;
+    ArNode  * vertices;
+
+    void  (*imp_getIntersectionList)
+          (id, SEL, ArnRayCaster *,Range,ArIntersectionList *);
+
+    BOOL  (*imp_anyIntersectionWithinRange)
+          (id, SEL, ArnRayCaster *,Range);
+}
+ArSGLInstance;
+
+#define ARSGLINSTANCE_NONE \
+((ArSGLInstance){NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL})
+
 typedef struct ArSGL
 {
     ArNodeRef         shapeRef;
@@ -48,7 +78,16 @@ typedef struct ArSGL
     void  (*imp_getIntersectionList)
           (id, SEL, ArnRayCaster *,Range,ArIntersectionList *);
 
+    //   Same for the any-hit occlusion query
+
+    SEL   sel_anyIntersectionWithinRange;
+
+    BOOL  (*imp_anyIntersectionWithinRange)
+          (id, SEL, ArnRayCaster *,Range);
+
     int leafInOperationTree;
+
+    ArSGLInstance  instance;
 }
 ArSGL;
 
@@ -58,6 +97,8 @@ ArSGL;
 #define ARSGL_TRAFO(__sgl)      (__sgl).trafo_world2object
 #define ARSGL_STATE(__sgl)      (__sgl).state_at_leaf
 #define ARSGL_OPERATION_LEAF(__sgl)      (__sgl).leafInOperationTree
+#define ARSGL_INSTANCE(__sgl)   (__sgl).instance
+#define ARSGL_IS_INSTANCE(__sgl)        ( (__sgl).instance.shape != NULL )
 
 #define  ARSGL_GET_INTERSECTION_LIST( \
     __sgl, \
@@ -73,8 +114,43 @@ ArSGL;
     __intersectionList \
     )
 
+#define  ARSGL_ANY_INTERSECTION_WITHIN_RANGE( \
+    __sgl, \
+    __rayCaster, \
+    __range_of_t \
+    ) \
+(__sgl).imp_anyIntersectionWithinRange( \
+    ARSGL_SHAPE(__sgl), \
+    (__sgl).sel_anyIntersectionWithinRange, \
+    __rayCaster, \
+    __range_of_t \
+    )
+
 #define ARSGL_EMPTY \
-((ArSGL){ARNODEREF_NONE,BOX3D_EMPTY,HTRAFO3D_UNIT,ARTS_EMPTY,NULL,NULL,0})
+((ArSGL){ARNODEREF_NONE,BOX3D_EMPTY,HTRAFO3D_UNIT,ARTS_EMPTY,NULL,NULL,NULL,NULL,0, \
+         ARSGLINSTANCE_NONE})
+
+//   Intersection tests for compiled leaves. 'ray3d' is the ray in the
+//   coordinate system the leaf trafo starts from (i.e. world space for the
+//   top level BSP tree). The attributes of the instance are bound in the
+//   traversal state of the ray caster for the duration of the test, and
+//   the object space ray of the ray caster is restored afterwards - just
+//   as the AraCombinedAttributes node would have done it.
+
+void arsgl_instance_get_intersection_list(
+        ArSGL               * sgl,
+        ArnRayCaster        * rayCaster,
+        const Ray3D         * ray3d,
+        Range                 range_of_t,
+        ArIntersectionList  * intersectionList
+        );
+
+BOOL arsgl_instance_any_intersection_within_range(
+        ArSGL               * sgl,
+        ArnRayCaster        * rayCaster,
+        const Ray3D         * ray3d,
+        Range                 range_of_t
+        );
 
 ARDYNARRAY_INTERFACE_FOR_ARTYPE(SGL,sgl,sgl);
 
@@ -87,16 +163,25 @@ ARDYNARRAY_INTERFACE_FOR_ARTYPE_PTR(SGL,sgl,sgl);
 //   Array for the BSP leaf nodes
 //   These arrays contain SceneGraphLeafPointers, hence the name
 
+//   Triangles that were packed for the flat intersection kernel are not
+//   part of 'array', but are instead referred to as a contiguous run of
+//   'numberOfPackets' Triangle3DPackets, starting at 'firstPacket' in the
+//   packet array of the BSP tree the leaf belongs to.
+
 typedef struct ArSGLPArray
 {
     int      numberOfLeaves;
     ArSGL ** array;
+    int      firstPacket;
+    int      numberOfPackets;
 }
 ArSGLPArray;
 
 #define SGLPARRAY(__a)           (__a).array
 #define SGLPARRAY_N(__a)         (__a).numberOfLeaves
 #define SGLPARRAY_I(__a,__i)     SGLPARRAY(__a)[(__i)]
+#define SGLPARRAY_FIRST_PACKET(__a)     (__a).firstPacket
+#define SGLPARRAY_PACKETS_N(__a)        (__a).numberOfPackets
 
 void arsglparray_free_contents(
         ArSGLPArray  * sglp
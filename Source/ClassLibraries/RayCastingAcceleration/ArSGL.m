@@ -27,6 +27,7 @@
 #define ART_MODULE_NAME     ArSGL
 
 #import "ArSGL.h"
+#import "ArnRayCaster.h"
 
 ART_NO_MODULE_INITIALISATION_FUNCTION_NECESSARY
 ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
@@ -56,4 +57,142 @@ ARDYNARRAY_IMPLEMENTATION_FOR_MANAGED_TYPE(
 
 ARDYNARRAY_IMPLEMENTATION_FOR_ARTYPE_PTR(SGL,sgl,sgl,0);
 
+#define RAYCASTER_STATE     ARNRAYCASTER_TRAVERSALSTATE(rayCaster)
+
+//   Everything the ray caster has to get back after the test of an
+//   instance: the object space ray, and the attribute references.
+
+typedef struct ArSGLInstanceStore
+{
+    Ray3DE     ray3de;
+    ArNodeRef  volumeMaterialRef;
+    ArNodeRef  surfaceMaterialRef;
+    ArNodeRef  environmentMaterialRef;
+    ArNodeRef  trafoRef;
+    ArNodeRef  verticesRef;
+}
+ArSGLInstanceStore;
+
+static void _arsgl_instance_enter(
+        ArSGL               * sgl,
+        ArnRayCaster        * rayCaster,
+        const Ray3D         * ray3d,
+        ArSGLInstanceStore  * store
+        )
+{
+    ArSGLInstance  * instance = & ARSGL_INSTANCE(*sgl);
+
+    store->ray3de = ARNRAYCASTER_OBJECTSPACE_RAY3DE(rayCaster);
+
+    ray3d_r_htrafo3d_r(
+          ray3d,
+        & ARSGL_TRAFO(*sgl),
+        & ARNRAYCASTER_OBJECTSPACE_RAY(rayCaster)
+        );
+
+    vec3d_vd_div_v(
+        & ARNRAYCASTER_OBJECTSPACE_RAY_VECTOR(rayCaster),
+          1.0,
+        & ARNRAYCASTER_OBJECTSPACE_RAY_INVVEC(rayCaster)
+        );
+
+    ARNRAYCASTER_OBJECTSPACE_RAYDIR(rayCaster) =
+        ray3ddir_init(
+            & ARNRAYCASTER_OBJECTSPACE_RAY(rayCaster)
+            );
+
+    //   The attribute references are all weak, so unlike the push/pop
+    //   methods of the ray caster, we can just swap them in and out.
+    //   Attributes the instance does not set are inherited, as usual.
+
+    store->volumeMaterialRef = ARTS_VOLUME_MATERIAL_REF(RAYCASTER_STATE);
+    store->surfaceMaterialRef = ARTS_SURFACE_MATERIAL_REF(RAYCASTER_STATE);
+    store->environmentMaterialRef =
+        ARTS_ENVIRONMENT_MATERIAL_REF(RAYCASTER_STATE);
+    store->trafoRef = ARTS_TRAFO_REF(RAYCASTER_STATE);
+    store->verticesRef = ARTS_VERTICES_REF(RAYCASTER_STATE);
+
+    if ( instance->volumeMaterial )
+        ARTS_VOLUME_MATERIAL_REF(RAYCASTER_STATE) =
+            WEAK_NODE_REFERENCE( instance->volumeMaterial );
+
+    if ( instance->surfaceMaterial )
+        ARTS_SURFACE_MATERIAL_REF(RAYCASTER_STATE) =
+            WEAK_NODE_REFERENCE( instance->surfaceMaterial );
+
+    if ( instance->environmentMaterial )
+        ARTS_ENVIRONMENT_MATERIAL_REF(RAYCASTER_STATE) =
+            WEAK_NODE_REFERENCE( instance->environmentMaterial );
+
+    if ( instance->trafo )
+        ARTS_TRAFO_REF(RAYCASTER_STATE) =
+            WEAK_NODE_REFERENCE( instance->trafo );
+
+    if ( instance->vertices )
+        ARTS_VERTICES_REF(RAYCASTER_STATE) =
+            WEAK_NODE_REFERENCE( instance->vertices );
+}
+
+static void _arsgl_instance_leave(
+        ArnRayCaster        * rayCaster,
+        ArSGLInstanceStore  * store
+        )
+{
+    ARTS_VOLUME_MATERIAL_REF(RAYCASTER_STATE) = store->volumeMaterialRef;
+    ARTS_SURFACE_MATERIAL_REF(RAYCASTER_STATE) = store->surfaceMaterialRef;
+    ARTS_ENVIRONMENT_MATERIAL_REF(RAYCASTER_STATE) =
+        store->environmentMaterialRef;
+    ARTS_TRAFO_REF(RAYCASTER_STATE) = store->trafoRef;
+    ARTS_VERTICES_REF(RAYCASTER_STATE) = store->verticesRef;
+
+    ARNRAYCASTER_OBJECTSPACE_RAY3DE(rayCaster) = store->ray3de;
+}
+
+void arsgl_instance_get_intersection_list(
+        ArSGL               * sgl,
+        ArnRayCaster        * rayCaster,
+        const Ray3D         * ray3d,
+        Range                 range_of_t,
+        ArIntersectionList  * intersectionList
+        )
+{
+    ArSGLInstanceStore  store;
+
+    _arsgl_instance_enter( sgl, rayCaster, ray3d, & store );
+
+    ARSGL_INSTANCE(*sgl).imp_getIntersectionList(
+        ARSGL_INSTANCE(*sgl).shape,
+        (*sgl).sel_getIntersectionList,
+        rayCaster,
+        range_of_t,
+        intersectionList
+        );
+
+    _arsgl_instance_leave( rayCaster, & store );
+}
+
+BOOL arsgl_instance_any_intersection_within_range(
+        ArSGL               * sgl,
+        ArnRayCaster        * rayCaster,
+        const Ray3D         * ray3d,
+        Range                 range_of_t
+        )
+{
+    ArSGLInstanceStore  store;
+
+    _arsgl_instance_enter( sgl, rayCaster, ray3d, & store );
+
+    BOOL  result =
+        ARSGL_INSTANCE(*sgl).imp_anyIntersectionWithinRange(
+            ARSGL_INSTANCE(*sgl).shape,
+            (*sgl).sel_anyIntersectionWithinRange,
+            rayCaster,
+            range_of_t
+            );
+
+    _arsgl_instance_leave( rayCaster, & store );
+
+    return result;
+}
+
 // ===========================================================================
@@ -66,6 +66,19 @@ ARDYNARRAY_INTERFACE_FOR_TYPE_PTR(plausibleSplit,plausibleSplit,plausibleSplit,p
 
     ArSGLptrDynArray  allLeaves;
     ArTraversalState  stateForVisShapes;
+
+    //   YES if the operation tree (if any) only contains union nodes; only
+    //   then is the first hit found in any leaf a valid occluder.
+
+    BOOL           operationTreeIsUnionOnly;
+
+    //   Flat copies of the triangles in the tree, see 'packTriangleLeaves'
+    //   below. For each packet lane, 'trianglePacketLeaves' holds the
+    //   scenegraph leaf the triangle came from, or NULL for unused lanes.
+
+    int                 numberOfTrianglePackets;
+    Triangle3DPacket  * trianglePackets;
+    ArSGL            ** trianglePacketLeaves;
 }
 
 - (id) init
@@ -74,6 +87,20 @@ ARDYNARRAY_INTERFACE_FOR_TYPE_PTR(plausibleSplit,plausibleSplit,plausibleSplit,p
         : (ArnOperationTree*) newOperationTree
         ;
 
+/* ---------------------------------------------------------------------------
+    'packTriangleLeaves'
+        Moves all ArnTriangle leaves out of the per-cell scenegraph leaf
+        arrays, and into Triangle3DPackets that are intersected directly,
+        without any message dispatch. The triangles have to be specified
+        via indices into the supplied point array, and must not be subject
+        to any transformation. Only possible for trees without operation
+        tree, i.e. the internal trees of triangle meshes.
+--------------------------------------------------------------------------- */
+
+- (void) packTriangleLeaves
+        : (const Pnt3D *) pointArray
+        ;
+
 @end
 
 // ===========================================================================
@@ -28,6 +28,7 @@
 
 #import "ArnBSPTree.h"
 #import "ArnRayCaster.h"
+#import "ArpRayCasting_Categories.h"
 
 #import "ART_Shape.h"
 #import "ART_SurfaceMaterial.h"
@@ -35,6 +36,7 @@
 
 #import "ArOrder.h"
 #import "ArnLeafNodeBBoxCollection.h"
+#import "ArBSPTreeCache.h"
 
 ART_MODULE_INITIALISATION_FUNCTION
 (
@@ -900,6 +902,8 @@ void bspTree_debugprintf(
 
         SGLPARRAY(*sglp) = ALLOC_ARRAY( ArSGL *, numberOfCurrentLeaves );
         SGLPARRAY_N(*sglp) = numberOfCurrentLeaves;
+        SGLPARRAY_FIRST_PACKET(*sglp) = 0;
+        SGLPARRAY_PACKETS_N(*sglp) = 0;
 
         if ( numberOfCurrentLeaves > maximumNumberOfLeavesPerCell )
             maximumNumberOfLeavesPerCell =
@@ -945,15 +949,6 @@ void bspTree_debugprintf(
     allLeaves =
         arsglptrdynarray_init( numberOfLeaves );
 
-    //  Need to create the array of plausible splits. At this point we know that
-    //  there will be exactly 6 plausible splits for every leaf node in the master
-    //  leaf array. These are the planes of the bouding box.
-
-    long numberOfSplits = 6 * numberOfLeaves;
-
-    plausibleSplit  * plausibleSplitArray =
-        ALLOC_ARRAY(plausibleSplit, numberOfSplits);
-
     //   We also need to know the AABB for all scene graph leaves; as usual
     //   in such cases, we start with an empty box, and grow it incrementally.
 
@@ -985,8 +980,42 @@ void bspTree_debugprintf(
             & MASTER_LEAF_I_BBOX(i),
             & aabbForAllLeaves
             );
+    }
 
-        //  ...fill 6 splits with their data.
+    //   If the same leaves have been seen before, the tree that was built
+    //   for them back then is re-used.
+
+    ArBSPTreeCacheKey  cacheKey;
+
+    if ( art_use_bsp_tree_cache( art_gv ) )
+    {
+        [ self _bspTreeCacheKey
+            : & cacheKey
+            ];
+
+        if ( [ self _readBSPTreeFromCache: & cacheKey ] )
+        {
+            arsglptrdynarray_free_contents( & allLeaves );
+
+            if ( outputBSPStatistics )
+                [ self _printBSPStatistics ];
+
+            return;
+        }
+    }
+
+    //  Need to create the array of plausible splits. At this point we know that
+    //  there will be exactly 6 plausible splits for every leaf node in the master
+    //  leaf array. These are the planes of the bouding box.
+
+    long numberOfSplits = 6 * numberOfLeaves;
+
+    plausibleSplit  * plausibleSplitArray =
+        ALLOC_ARRAY(plausibleSplit, numberOfSplits);
+
+    for ( long i = 0; i < numberOfLeaves; i++ )
+    {
+        //  Fill 6 splits with their data.
 
         for (long j = 0; j < 3; j++ )
         {
@@ -1108,30 +1137,153 @@ void bspTree_debugprintf(
         : & allSplits
         ];
 
+    if ( art_use_bsp_tree_cache( art_gv ) )
+        [ self _addBSPTreeToCache
+            : & cacheKey
+            ];
+
     if ( outputBSPStatistics )
-    {
-        //  The next line is really only for non-standard debugging
-        //  purposes, so it stays commented out in normal operation.
+        [ self _printBSPStatistics ];
+
+    FREE_ARRAY(plausibleSplitArray);
+}
 
-        //bspTree_debugprintf(bspTree);
+- (void) _printBSPStatistics
+{
+    //  The next line is really only for non-standard debugging
+    //  purposes, so it stays commented out in normal operation.
 
+    //bspTree_debugprintf(bspTree);
 
-        printf(
-            "\nNumber of leaf cells: %d\n"
-            ,   numberOfLeafCells
-            );
-        printf(
-            "Number of interior calls: %d\n"
-            ,   numberOfInnerCells
-            );
-        printf(
-            "Maximum number of shapes per leaf: %d\n\n"
-            ,   maximumNumberOfLeavesPerCell
+
+    printf(
+        "\nNumber of leaf cells: %d\n"
+        ,   numberOfLeafCells
+        );
+    printf(
+        "Number of interior calls: %d\n"
+        ,   numberOfInnerCells
+        );
+    printf(
+        "Maximum number of shapes per leaf: %d\n\n"
+        ,   maximumNumberOfLeavesPerCell
+        );
+}
+
+/* ---------------------------------------------------------------------------
+    BSP tree cache
+        The key covers the bounding boxes of all master leaves in order,
+        and the build parameters. Leaf cells are stored as indices into
+        the master leaf array, and the tree is stored before any triangles
+        are moved into packets by 'packTriangleLeaves'.
+--------------------------------------------------------------------------- */
+
+- (void) _bspTreeCacheKey
+        : (ArBSPTreeCacheKey *) cacheKey
+{
+    long  numberOfLeaves =
+        arsgldynarray_size( & MASTER_LEAF_ARRAY );
+
+    arbsptreecachekey_init( cacheKey, numberOfLeaves );
+
+    const int  buildParameters[3] =
+        { MAX_TREE_DEPTH, COST_TRAVERSAL, COST_INTERSECT };
+
+    arbsptreecachekey_add( cacheKey, buildParameters, sizeof(buildParameters) );
+
+    for ( long i = 0; i < numberOfLeaves; i++ )
+        arbsptreecachekey_add(
+            cacheKey,
+            & MASTER_LEAF_I_BBOX(i),
+            sizeof(Box3D)
             );
+}
+
+- (BOOL) _readBSPTreeFromCache
+        : (const ArBSPTreeCacheKey *) cacheKey
+{
+    ArBSPTreeCacheData  data;
+
+    if ( ! arbsptreecache_find( art_gv, cacheKey, & data ) )
+        return NO;
+
+    numberOfAllocatedBSPNodes = data.numberOfNodes;
+    indexOfNextFreeBSPNode = data.numberOfNodes;
+
+    bspTree = ALLOC_ARRAY( BSPNode, numberOfAllocatedBSPNodes );
+
+    memcpy( bspTree, data.node, data.numberOfNodes * sizeof(BSPNode) );
+
+    numberOfAllocatedLeafArrays = data.numberOfLeafArrays;
+    indexOfNextFreeLeafArray = data.numberOfLeafArrays;
+
+    scenegraphLeafArray =
+        ALLOC_ARRAY( ArSGLPArray, numberOfAllocatedLeafArrays );
 
+    for ( int i = 0; i < indexOfNextFreeLeafArray; i++ )
+    {
+        ArSGLPArray  * sglp = & scenegraphLeafArray[i];
+
+        const Int32  * leafIndex = data.leafIndex + data.leafArrayStart[i];
+
+        int  numberOfCellLeaves =
+            data.leafArrayStart[i + 1] - data.leafArrayStart[i];
+
+        SGLPARRAY(*sglp) = ALLOC_ARRAY( ArSGL *, numberOfCellLeaves );
+        SGLPARRAY_N(*sglp) = numberOfCellLeaves;
+        SGLPARRAY_FIRST_PACKET(*sglp) = 0;
+        SGLPARRAY_PACKETS_N(*sglp) = 0;
+
+        for ( int j = 0; j < numberOfCellLeaves; j++ )
+            SGLPARRAY_I( *sglp, j ) = PTR_TO_MASTER_LEAF_I( leafIndex[j] );
     }
 
-    FREE_ARRAY(plausibleSplitArray);
+    maximumNumberOfLeavesPerCell = data.maximumNumberOfLeavesPerCell;
+    numberOfLeafCells = data.numberOfLeafArrays;
+    numberOfInnerCells = data.numberOfInnerCells;
+
+    return YES;
+}
+
+- (void) _addBSPTreeToCache
+        : (const ArBSPTreeCacheKey *) cacheKey
+{
+    Int32  * leafArrayStart =
+        ALLOC_ARRAY( Int32, indexOfNextFreeLeafArray + 1 );
+
+    leafArrayStart[0] = 0;
+
+    for ( int i = 0; i < indexOfNextFreeLeafArray; i++ )
+        leafArrayStart[i + 1] =
+            leafArrayStart[i] + SGLPARRAY_N( scenegraphLeafArray[i] );
+
+    Int32  * leafIndex =
+        ALLOC_ARRAY( Int32, M_MAX( leafArrayStart[ indexOfNextFreeLeafArray ], 1 ) );
+
+    if ( arsgldynarray_size( & MASTER_LEAF_ARRAY ) > 0 )
+    {
+        ArSGL  * firstLeaf = PTR_TO_MASTER_LEAF_I(0);
+
+        for ( int i = 0; i < indexOfNextFreeLeafArray; i++ )
+            for ( int j = 0; j < SGLPARRAY_N( scenegraphLeafArray[i] ); j++ )
+                leafIndex[ leafArrayStart[i] + j ] =
+                    SGLPARRAY_I( scenegraphLeafArray[i], j ) - firstLeaf;
+    }
+
+    ArBSPTreeCacheData  data;
+
+    data.numberOfNodes = indexOfNextFreeBSPNode;
+    data.numberOfLeafArrays = indexOfNextFreeLeafArray;
+    data.maximumNumberOfLeavesPerCell = maximumNumberOfLeavesPerCell;
+    data.numberOfInnerCells = numberOfInnerCells;
+    data.node = bspTree;
+    data.leafArrayStart = leafArrayStart;
+    data.leafIndex = leafIndex;
+
+    arbsptreecache_add( art_gv, cacheKey, & data );
+
+    FREE_ARRAY( leafIndex );
+    FREE_ARRAY( leafArrayStart );
 }
 
 - (void) _freeBSPTree
@@ -1466,16 +1618,159 @@ void bspTree_debugprintf(
 
             [ self _createBSPTree ];
         }
+
+        //   Early termination of occlusion queries is only valid if no
+        //   CSG operation can remove hits that were found in a leaf.
+
+        operationTreeIsUnionOnly = YES;
+
+        if ( OPERATION_TREE )
+        {
+            long  numberOfOpNodes = [ OPERATION_TREE getOpNodeCount ];
+
+            for ( long i = 0; i < numberOfOpNodes; i++ )
+            {
+                if (   MASTER_OPERATION_ARRAY[i].intersectFunction
+                    == intersect_and
+                    || MASTER_OPERATION_ARRAY[i].intersectFunction
+                    == intersect_sub )
+                {
+                    operationTreeIsUnionOnly = NO;
+                    break;
+                }
+            }
+        }
     }
     
     return self;
 }
 
+- (BOOL) _canPackLeaf
+        : (ArSGL *) sgl
+{
+    HTrafo3D  unitTrafo = HTRAFO3D_UNIT;
+
+    return
+           [ ARSGL_SHAPE(*sgl) isMemberOfClass: [ ArnTriangle class ] ]
+        && memcmp( & ARSGL_TRAFO(*sgl), & unitTrafo, sizeof(HTrafo3D) ) == 0;
+}
+
+- (void) packTriangleLeaves
+        : (const Pnt3D *) pointArray
+{
+    //   Packed triangles have no slot in the operation tree, so this is
+    //   only possible for plain unions of shapes.
+
+    if ( OPERATION_TREE || trianglePackets )
+        return;
+
+    //   Pass 1 - count how many packets we need. Each cell gets its own,
+    //   possibly partially filled, run of packets. A triangle that
+    //   straddles a splitting plane is referenced by several cells, and
+    //   gets a lane in the packets of each of them.
+
+    int  numberOfPackets = 0;
+
+    for ( int i = 0; i < indexOfNextFreeLeafArray; i++ )
+    {
+        ArSGLPArray  * sglp = & scenegraphLeafArray[i];
+
+        int  numberOfTriangles = 0;
+
+        for ( int j = 0; j < SGLPARRAY_N(*sglp); j++ )
+            if ( [ self _canPackLeaf: SGLPARRAY_I(*sglp,j) ] )
+                numberOfTriangles++;
+
+        numberOfPackets +=
+              ( numberOfTriangles + TRIANGLE3D_PACKET_WIDTH - 1 )
+            / TRIANGLE3D_PACKET_WIDTH;
+    }
+
+    if ( numberOfPackets == 0 )
+        return;
+
+    trianglePackets =
+        ALLOC_ARRAY( Triangle3DPacket, numberOfPackets );
+
+    trianglePacketLeaves =
+        ALLOC_ARRAY_ZERO( ArSGL *, numberOfPackets * TRIANGLE3D_PACKET_WIDTH );
+
+    numberOfTrianglePackets = 0;
+
+    //   Pass 2 - fill the packets, and compact the remaining,
+    //   non-triangle leaves at the start of each cell leaf array.
+
+    for ( int i = 0; i < indexOfNextFreeLeafArray; i++ )
+    {
+        ArSGLPArray  * sglp = & scenegraphLeafArray[i];
+
+        int  numberOfRemainingLeaves = 0;
+        int  lane = TRIANGLE3D_PACKET_WIDTH;
+
+        SGLPARRAY_FIRST_PACKET(*sglp) = numberOfTrianglePackets;
+
+        for ( int j = 0; j < SGLPARRAY_N(*sglp); j++ )
+        {
+            ArSGL  * sgl = SGLPARRAY_I(*sglp,j);
+
+            if ( [ self _canPackLeaf: sgl ] )
+            {
+                if ( lane == TRIANGLE3D_PACKET_WIDTH )
+                {
+                    triangle3dpacket_init_empty(
+                        & trianglePackets[ numberOfTrianglePackets ]
+                        );
+
+                    numberOfTrianglePackets++;
+                    lane = 0;
+                }
+
+                ArnTriangle  * triangle = (ArnTriangle *) ARSGL_SHAPE(*sgl);
+
+                triangle3dpacket_set_lane(
+                    & trianglePackets[ numberOfTrianglePackets - 1 ],
+                      lane,
+                    & pointArray[ ARARRAY_I( triangle->indexTable, 0 ) ],
+                    & pointArray[ ARARRAY_I( triangle->indexTable, 1 ) ],
+                    & pointArray[ ARARRAY_I( triangle->indexTable, 2 ) ]
+                    );
+
+                trianglePacketLeaves[
+                      ( numberOfTrianglePackets - 1 ) * TRIANGLE3D_PACKET_WIDTH
+                    + lane
+                    ] = sgl;
+
+                lane++;
+            }
+            else
+            {
+                SGLPARRAY_I(*sglp,numberOfRemainingLeaves) = sgl;
+                numberOfRemainingLeaves++;
+            }
+        }
+
+        SGLPARRAY_N(*sglp) = numberOfRemainingLeaves;
+        SGLPARRAY_PACKETS_N(*sglp) =
+            numberOfTrianglePackets - SGLPARRAY_FIRST_PACKET(*sglp);
+    }
+
+    if ( outputBSPStatistics )
+    {
+        printf(
+            "Number of triangle packets: %d (%d lanes each)\n\n"
+            ,   numberOfTrianglePackets
+            ,   TRIANGLE3D_PACKET_WIDTH
+            );
+    }
+}
 
 - (void) dealloc
 {
     [ self _freeBSPTree ];
 
+    FREE_ARRAY( trianglePackets );
+    FREE_ARRAY( trianglePacketLeaves );
+
     [ super dealloc ];
 }
 
@@ -1549,34 +1844,50 @@ void getLeafShapeIntersectionList(
     {
         RAYCASTER_MARK_OBJ_AS_TESTED( sgl );
 #endif
-        ray3d_r_htrafo3d_r(
-              worldViewingRay3D,
-            & ARSGL_TRAFO(*sgl),
-            & RAYCASTER_VIEWING_RAY3D
-            );
-
-        vec3d_vd_div_v(
-            & RAYCASTER_VIEWING_VECTOR3D,
-              1.0,
-            & RAYCASTER_VIEWING_INVVEC3D
-            );
+        //   Compiled instances bypass their attribute node, and take
+        //   care of the ray transformation themselves.
 
-        RAYCASTER_VIEWING_RAYDIR =
-            ray3ddir_init(
+        if ( ARSGL_IS_INSTANCE(*sgl) )
+        {
+            arsgl_instance_get_intersection_list(
+                  sgl,
+                  rayCaster,
+                  worldViewingRay3D,
+                  RANGE(ARNRAYCASTER_EPSILON(rayCaster),MATH_HUGE_DOUBLE),
+                  intersectionList
+                );
+        }
+        else
+        {
+            ray3d_r_htrafo3d_r(
+                  worldViewingRay3D,
+                & ARSGL_TRAFO(*sgl),
                 & RAYCASTER_VIEWING_RAY3D
                 );
 
-        //   The actual intersection test; this uses a stored
-        //   function pointer, to avoid unnecessary polymorphism
-        //   resolution at this point. The original, non-function
-        //   pointer invocation is commented out below.
+            vec3d_vd_div_v(
+                & RAYCASTER_VIEWING_VECTOR3D,
+                  1.0,
+                & RAYCASTER_VIEWING_INVVEC3D
+                );
 
-        ARSGL_GET_INTERSECTION_LIST(
-            *sgl,
-            rayCaster,
-            RANGE(ARNRAYCASTER_EPSILON(rayCaster),MATH_HUGE_DOUBLE),
-            intersectionList
-            );
+            RAYCASTER_VIEWING_RAYDIR =
+                ray3ddir_init(
+                    & RAYCASTER_VIEWING_RAY3D
+                    );
+
+            //   The actual intersection test; this uses a stored
+            //   function pointer, to avoid unnecessary polymorphism
+            //   resolution at this point. The original, non-function
+            //   pointer invocation is commented out below.
+
+            ARSGL_GET_INTERSECTION_LIST(
+                *sgl,
+                rayCaster,
+                RANGE(ARNRAYCASTER_EPSILON(rayCaster),MATH_HUGE_DOUBLE),
+                intersectionList
+                );
+        }
 #ifdef WITH_MAILBOXING
     }
 #endif
@@ -1676,6 +1987,130 @@ void getLeafArrayIntersectionList(
     }
 }
 
+//   Counterpart of 'getLeafArrayIntersectionList' for the triangles that
+//   were moved into packets by 'packTriangleLeaves': all lanes of a packet
+//   are tested in one go, and no messages are sent for triangles that are
+//   not hit. For hits, only t, the face orientation and the barycentric
+//   coordinates are stored in the intersection; point and normal are
+//   left to 'prepareForUse', so they only get computed for the hit that
+//   is actually used for shading.
+
+void getLeafPacketIntersectionList(
+        ArSGLPArray         * leafArray,
+        Triangle3DPacket    * trianglePackets,
+        ArSGL              ** trianglePacketLeaves,
+        ArnRayCaster        * rayCaster,
+        Ray3D               * worldViewingRay3D,
+        ArIntersectionList  * intersectionList
+        )
+{
+    Range  range_of_t =
+        RANGE( ARNRAYCASTER_EPSILON(rayCaster), MATH_HUGE_DOUBLE );
+
+    BOOL  objectspaceRayIsSet = NO;
+
+    int  lastPacket =
+        SGLPARRAY_FIRST_PACKET(*leafArray) + SGLPARRAY_PACKETS_N(*leafArray);
+
+    for ( int p = SGLPARRAY_FIRST_PACKET(*leafArray); p < lastPacket; p++ )
+    {
+        Triangle3DPacketHits  hits;
+
+        unsigned int  hitMask =
+            triangle3dpacket_hit(
+                & trianglePackets[p],
+                  worldViewingRay3D,
+                & range_of_t,
+                & hits
+                );
+
+        ArSGL  ** laneLeaves =
+            & trianglePacketLeaves[ p * TRIANGLE3D_PACKET_WIDTH ];
+
+        for ( unsigned int lane = 0; lane < TRIANGLE3D_PACKET_WIDTH; lane++ )
+        {
+            ArSGL  * sgl = laneLeaves[lane];
+
+            //   Unused lanes only ever occur at the end of a packet.
+
+            if ( ! sgl )
+                break;
+
+#ifdef WITH_MAILBOXING
+            if ( RAYCASTER_OBJ_ALREADY_TESTED( sgl ) )
+                continue;
+
+            RAYCASTER_MARK_OBJ_AS_TESTED( sgl );
+#endif
+            if ( ! ( hitMask & ( 1U << lane ) ) )
+                continue;
+
+            //   The intersection takes its incoming ray from the raycaster;
+            //   packed triangles are not transformed, so this is just the
+            //   ray we were given (other leaves may have changed it).
+
+            if ( ! objectspaceRayIsSet )
+            {
+                RAYCASTER_VIEWING_RAY3D = *worldViewingRay3D;
+
+                vec3d_vd_div_v(
+                    & RAYCASTER_VIEWING_VECTOR3D,
+                      1.0,
+                    & RAYCASTER_VIEWING_INVVEC3D
+                    );
+
+                RAYCASTER_VIEWING_RAYDIR =
+                    ray3ddir_init(
+                        & RAYCASTER_VIEWING_RAY3D
+                        );
+
+                objectspaceRayIsSet = YES;
+            }
+
+            ArFaceOnShapeType  face_type =
+                ( hits.det[lane] > 0.0
+                  ?
+                  arface_on_shape_obverse | arface_on_shape_is_planar
+                  :
+                  arface_on_shape_reverse | arface_on_shape_is_planar
+                );
+
+            ArIntersectionList  laneIL = ARINTERSECTIONLIST_EMPTY;
+
+            arintersectionlist_init_1(
+                & laneIL,
+                  hits.t[lane],
+                  0,
+                  face_type,
+                  (ArNode <ArpShape> *) ARSGL_SHAPE(*sgl),
+                  rayCaster
+                );
+
+            ArcIntersection  * intersection = ARINTERSECTIONLIST_HEAD(laneIL);
+
+            ARCINTERSECTION_TEXTURE_COORDS(intersection) =
+                PNT2D( hits.u[lane], hits.v[lane] );
+
+            ARCINTERSECTION_FLAG_TEXTURE_COORDS_AS_VALID(intersection);
+
+            if ( ARINTERSECTIONLIST_HEAD( *intersectionList ) )
+            {
+                arintersectionlist_or(
+                      intersectionList,
+                    & laneIL,
+                      intersectionList,
+                      ARNRAYCASTER_INTERSECTION_FREELIST(rayCaster),
+                      ARNRAYCASTER_EPSILON(rayCaster)
+                    );
+            }
+            else
+            {
+                *intersectionList = laneIL;
+            }
+        }
+    }
+}
+
 //   Clips the range 'rr' of the parameter t for the ray 'r0'
 //   to the interval implied by the 3D box 'b0'. Obviously, the
 //   result can be anything between an empty range, and no
@@ -1760,6 +2195,8 @@ BSP_NODE_CHILD(*node,offsetForFarChild[BSP_NODE_SPLIT_AXIS(*node)])
 
 void intersectRayWithBSPTree(
         ArSGLPArray         * scenegraphLeafArray,
+        Triangle3DPacket    * trianglePackets,
+        ArSGL              ** trianglePacketLeaves,
         BSPNode             * bspTree,
         Box3D               * bspAABB,
         ArnRayCaster        * rayCaster,
@@ -1875,13 +2312,26 @@ void intersectRayWithBSPTree(
         ArSGLPArray* leafNodeShapeArray =
             & scenegraphLeafArray[ BSP_NODE_LEAF_INDEX(*node) ];
 
-        if ( SGLPARRAY_N(*leafNodeShapeArray) > 0 )
+        if (   SGLPARRAY_N(*leafNodeShapeArray) > 0
+            || SGLPARRAY_PACKETS_N(*leafNodeShapeArray) > 0 )
         {
             // the shape array is not empty so...
             // prepare an empty intersection list to be passed down to the shape intersection test
             
             ArIntersectionList  leafIL = ARINTERSECTIONLIST_EMPTY;
 
+            //    packed triangles first; the remaining shapes get merged
+            //    into the same list below.
+
+            getLeafPacketIntersectionList(
+                  leafNodeShapeArray,
+                  trianglePackets,
+                  trianglePacketLeaves,
+                  rayCaster,
+                & worldViewingRay3D,
+                & leafIL
+                );
+
             //    do the shape intersection test on the array referred from
             //    the bsp leaf node.
             
@@ -2104,6 +2554,195 @@ void intersectRayWithBSPTree_UseOpTree(
     }
 }
 
+//   Occlusion query version of 'intersectRayWithBSPTree': the leaves are
+//   tested one by one via their any-hit method, and traversal stops as soon
+//   as one of them reports a hit. No intersection lists are merged, and
+//   nothing is handed back to the caller except the yes/no answer.
+
+BOOL anyRayIntersectionWithBSPTree(
+        ArSGLPArray         * scenegraphLeafArray,
+        Triangle3DPacket    * trianglePackets,
+        BSPNode             * bspTree,
+        Box3D               * bspAABB,
+        ArnRayCaster        * rayCaster,
+        Range                 range_of_t
+        )
+{
+    Ray3D  VIEWING_RAY = RAYCASTER_VIEWING_RAY3D;
+
+    //   The leaves are tested against the entire original range; the
+    //   range_of_t variable itself is narrowed down during traversal.
+
+    Range  leafRange =
+        RANGE(
+            M_MAX( RANGE_MIN(range_of_t), ARNRAYCASTER_EPSILON(rayCaster) ),
+            RANGE_MAX(range_of_t)
+            );
+
+    box3d_br_clip_parameter_t_range(
+          bspAABB,
+        & VIEWING_RAY,
+        & range_of_t
+        );
+
+    if ( RANGE_MIN(range_of_t) > RANGE_MAX(range_of_t) )
+        return NO;
+
+    unsigned int  offsetForNearChild[3];
+    unsigned int  offsetForFarChild[3];
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        if ( VIEWING_RAY_VI( i ) >= 0.0 )
+        {
+            offsetForNearChild[i] = 0;
+            offsetForFarChild[i]  = sizeof(BSPNode);
+        }
+        else
+        {
+            offsetForNearChild[i] = sizeof(BSPNode);
+            offsetForFarChild[i]  = 0;
+        }
+    }
+
+    BSPStackElement  bspStack[ MAX_TREE_DEPTH ];
+    int              bspStackPtr = -1;
+
+    BSPNode  * node = bspTree;
+
+    while( 1 )
+    {
+        while( ! BSP_NODE_IS_LEAF(*node) )
+        {
+            double  d;
+
+            if ( VIEWING_RAY_VI( BSP_NODE_SPLIT_AXIS( *node ) ) != 0.0 )
+            {
+                d =
+                    (  BSP_NODE_SPLIT_COORDINATE( *node )
+                     - VIEWING_RAY_PI( BSP_NODE_SPLIT_AXIS( *node ) ) )
+                   / VIEWING_RAY_VI( BSP_NODE_SPLIT_AXIS( *node ))
+                ;
+            }
+            else
+            {
+                d = MATH_HUGE_DOUBLE;
+            }
+
+            if ( d <= RANGE_MIN(range_of_t)  )
+            {
+                node = VIEWDIR_DEPENDENT_FAR_CHILD;
+            }
+            else
+            {
+                if ( d >= RANGE_MAX(range_of_t) )
+                {
+                    node = VIEWDIR_DEPENDENT_NEAR_CHILD;
+                }
+                else
+                {
+                    bspStackPtr++;
+
+                    bspStack[ bspStackPtr ] =
+                        BSP_STACK_ELEMENT(
+                            VIEWDIR_DEPENDENT_FAR_CHILD,
+                            d,
+                            RANGE_MAX(range_of_t)
+                            );
+
+                    node = VIEWDIR_DEPENDENT_NEAR_CHILD;
+
+                    RANGE_MAX(range_of_t) = d;
+                }
+            }
+        }
+
+        ArSGLPArray  * leafNodeShapeArray =
+            & scenegraphLeafArray[ BSP_NODE_LEAF_INDEX(*node) ];
+
+        //   Packed triangles: any lane that reports a hit will do, so
+        //   neither mailboxing nor the per-lane results are of interest.
+
+        int  lastPacket =
+              SGLPARRAY_FIRST_PACKET(*leafNodeShapeArray)
+            + SGLPARRAY_PACKETS_N(*leafNodeShapeArray);
+
+        for ( int p = SGLPARRAY_FIRST_PACKET(*leafNodeShapeArray);
+              p < lastPacket;
+              p++ )
+        {
+            Triangle3DPacketHits  hits;
+
+            if ( triangle3dpacket_hit(
+                        & trianglePackets[p],
+                        & worldViewingRay3D,
+                        & leafRange,
+                        & hits
+                        ) )
+                return YES;
+        }
+
+        for ( int i = 0; i < SGLPARRAY_N(*leafNodeShapeArray); i++ )
+        {
+            ArSGL  * sgl = SGLPARRAY_I(*leafNodeShapeArray,i);
+
+            //   Unlike for the full intersection list, a hit can be used
+            //   straight away even if it lies outside the current cell, so
+            //   mailboxing is sufficient to avoid all duplicate tests.
+
+#ifdef WITH_MAILBOXING
+            if ( RAYCASTER_OBJ_ALREADY_TESTED( sgl ) )
+                continue;
+
+            RAYCASTER_MARK_OBJ_AS_TESTED( sgl );
+#endif
+            if ( ARSGL_IS_INSTANCE(*sgl) )
+            {
+                if ( arsgl_instance_any_intersection_within_range(
+                            sgl,
+                            rayCaster,
+                          & worldViewingRay3D,
+                            leafRange
+                            ) )
+                    return YES;
+
+                continue;
+            }
+
+            ray3d_r_htrafo3d_r(
+                & worldViewingRay3D,
+                & ARSGL_TRAFO(*sgl),
+                & RAYCASTER_VIEWING_RAY3D
+                );
+
+            vec3d_vd_div_v(
+                & RAYCASTER_VIEWING_VECTOR3D,
+                  1.0,
+                & RAYCASTER_VIEWING_INVVEC3D
+                );
+
+            RAYCASTER_VIEWING_RAYDIR =
+                ray3ddir_init(
+                    & RAYCASTER_VIEWING_RAY3D
+                    );
+
+            if ( ARSGL_ANY_INTERSECTION_WITHIN_RANGE(
+                        *sgl,
+                        rayCaster,
+                        leafRange
+                        ) )
+                return YES;
+        }
+
+        if ( bspStackPtr == -1 )
+            return NO;
+
+        node       = bspStack[bspStackPtr].node;
+        range_of_t = bspStack[bspStackPtr].range_of_t;
+        bspStackPtr--;
+    }
+}
+
 void opTreeDebugprintSimple(ArOpNode* tree, int size)
 {
     (void) tree;
@@ -2293,6 +2932,8 @@ void flagDebugPrint(ArnRayCaster* rayCaster, long size)
 #endif
         intersectRayWithBSPTree(
               scenegraphLeafArray,
+              trianglePackets,
+              trianglePacketLeaves,
               bspTree,
             & aabbForAllLeaves,
               rayCaster,
@@ -2336,6 +2977,38 @@ void flagDebugPrint(ArnRayCaster* rayCaster, long size)
 #endif // USE_ORIGINAL_SCENEGRAPH_FOR_RAYCASTING
 }
 
+- (BOOL) anyIntersectionWithinRange
+        : (ArnRayCaster *) rayCaster
+        : (Range) range_of_t
+{
+#ifndef USE_ORIGINAL_SCENEGRAPH_FOR_RAYCASTING
+
+    //   The infinite sphere is deliberately not considered here: it only
+    //   ever yields a hit at infinity, which is never inside the range.
+
+    if ( operationTreeIsUnionOnly )
+        return
+            anyRayIntersectionWithBSPTree(
+                  scenegraphLeafArray,
+                  trianglePackets,
+                  bspTree,
+                & aabbForAllLeaves,
+                  rayCaster,
+                  range_of_t
+                );
+
+#endif // USE_ORIGINAL_SCENEGRAPH_FOR_RAYCASTING
+
+    //   CSG operations present: a leaf hit might get cut away later, so
+    //   the full intersection list has to be evaluated.
+
+    return
+        [ super anyIntersectionWithinRange
+            :   rayCaster
+            :   range_of_t
+            ];
+}
+
 @end
 
 // ===========================================================================
@@ -60,6 +60,20 @@ ART_MODULE_INTERFACE(ArnLeafNodeBBoxCollection)
         : (int) operationTreeLeaf
         ;
 
+/* ---------------------------------------------------------------------------
+    'compileInstances'
+        Second stage of scene compilation for ray casting, after the leaves
+        have been collected: leaves that are AraCombinedAttributes nodes are
+        turned into instances of their subnode, with the attribute trafo
+        folded into the world to object trafo of the leaf (see ArSGL.h).
+        Only valid for the leaves of the top level acceleration structure,
+        since the instances do not concatenate their trafo with one that
+        might already be active in the ray caster.
+--------------------------------------------------------------------------- */
+
+- (void) compileInstances
+        ;
+
 @end
 
 #define ARLNBBC_INFSPHERE(__lnbbc)        (__lnbbc)->infSphere
@@ -115,6 +115,7 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnLeafNodeBBoxCollection)
     ARSGL_TRAFO(newLeafNode) = *trafo_world2object;
     ARSGL_STATE(newLeafNode) = artraversalstate_copy( state_at_leaf );
     ARSGL_OPERATION_LEAF(newLeafNode) = operationTreeLeaf;
+    ARSGL_INSTANCE(newLeafNode) = ARSGLINSTANCE_NONE;
 
     newLeafNode.sel_getIntersectionList =
         @selector(getIntersectionList:::);
@@ -125,12 +126,94 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnLeafNodeBBoxCollection)
             :   newLeafNode.sel_getIntersectionList
             ];
 
+    newLeafNode.sel_anyIntersectionWithinRange =
+        @selector(anyIntersectionWithinRange::);
+
+    newLeafNode.imp_anyIntersectionWithinRange = (BOOL(*)
+        (id, SEL, ArnRayCaster *,Range))
+        [ ARNODEREF_POINTER(object_to_raycast_ref) methodForSelector
+            :   newLeafNode.sel_anyIntersectionWithinRange
+            ];
+
     arsgldynarray_push(
         & sgl_dynarray,
           newLeafNode
         );
 }
 
+- (void) compileInstances
+{
+    int  numberOfLeaves = arsgldynarray_size( & sgl_dynarray );
+
+    for ( int i = 0; i < numberOfLeaves; i++ )
+    {
+        ArSGL  * sgl = arsgldynarray_ptr_to_i( & sgl_dynarray, i );
+
+        if ( ARSGL_IS_INSTANCE(*sgl) )
+            continue;
+
+        //   An exact class match on purpose: AraCombinedReference only
+        //   resolves its subnode during traversal.
+
+        if ( ! [ ARSGL_SHAPE(*sgl) isMemberOfClass
+                 :   [ AraCombinedAttributes class ]
+                 ] )
+            continue;
+
+        AraCombinedAttributes  * combinedAttributes =
+            (AraCombinedAttributes *) ARSGL_SHAPE(*sgl);
+
+        ArSGLInstance  instance;
+
+        [ combinedAttributes getAttributes
+            : & instance.volumeMaterial
+            : & instance.surfaceMaterial
+            : & instance.environmentMaterial
+            : & instance.trafo
+            : & instance.vertices
+            ];
+
+        instance.shape = [ combinedAttributes subnodeWithIndex: 0 ];
+
+        instance.imp_getIntersectionList = (void(*)
+            (id, SEL, ArnRayCaster *,Range,ArIntersectionList *))
+            [ instance.shape methodForSelector
+                :   sgl->sel_getIntersectionList
+                ];
+
+        instance.imp_anyIntersectionWithinRange = (BOOL(*)
+            (id, SEL, ArnRayCaster *,Range))
+            [ instance.shape methodForSelector
+                :   sgl->sel_anyIntersectionWithinRange
+                ];
+
+        if ( instance.trafo )
+        {
+            HTrafo3D  forward;
+            HTrafo3D  backward;
+            HTrafo3D  trafo_world2object;
+
+            [ (ArNode <ArpTrafo3D> *) instance.trafo getHTrafo3Ds
+                : & forward
+                : & backward
+                ];
+
+            //   The leaf trafo gets applied first, then the backward
+            //   trafo of the attribute node.
+
+            trafo3d_hh_mul_h(
+                & ARSGL_TRAFO(*sgl),
+                & backward,
+                & trafo_world2object
+                );
+
+            ARSGL_TRAFO(*sgl) = trafo_world2object;
+        }
+
+        ARSGL_INSTANCE(*sgl) = instance;
+    }
+}
+
 - (void) dealloc
 {
     int  numberOfLeaves = arsgldynarray_size( & sgl_dynarray );
@@ -68,6 +68,17 @@ ART_MODULE_INTERFACE(AraCombinedAttributes)
         : (ArNodeRef *) nodeRefStore
         ;
 
+//   Hands out the combined attributes without any traversal; attributes
+//   that are not set by this node are returned as NULL.
+
+- (void) getAttributes
+        : (ArNode **) volumeMaterial
+        : (ArNode **) surfaceMaterial
+        : (ArNode **) environmentMaterial
+        : (ArNode **) trafo
+        : (ArNode **) vertices
+        ;
+
 @end
 
 /* ===========================================================================
@@ -193,6 +193,20 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(AraCombinedAttributes)
             ];
 }
 
+- (void) getAttributes
+        : (ArNode **) volumeMaterial
+        : (ArNode **) surfaceMaterial
+        : (ArNode **) environmentMaterial
+        : (ArNode **) trafo
+        : (ArNode **) vertices
+{
+    *volumeMaterial      = VOLUME_MATERIAL;
+    *surfaceMaterial     = SURFACE_MATERIAL;
+    *environmentMaterial = ENVIRONMENT_MATERIAL;
+    *trafo               = TRAFO;
+    *vertices            = VERTICES;
+}
+
 - (ArNode <ArpTrafo3D> *) unambigousSubnodeTrafo
 {
     return TRAFO;
@@ -37,6 +37,12 @@ ART_MODULE_INTERFACE(ArnTriangle)
 {
     TriangleData  * triangleData;
     UInt8           dim;
+
+    //   Vertex normals of the vertex set the triangle was set up with, if
+    //   there are any. Used to fill in the normal of intersections that
+    //   were generated without it, i.e. by the flat mesh kernel.
+
+    const FVec3D  * vertexNormals;
 }
 
 - (id) init
@@ -60,6 +60,7 @@ ARPSHAPE_DEFAULT_IMPLEMENTATION(1,1,1)
 - (void) _setupTriangle
 {
     triangleData = 0;
+    vertexNormals = 0;
 }
 
 - (id) init
@@ -81,8 +82,9 @@ ARPSHAPE_DEFAULT_IMPLEMENTATION(1,1,1)
 {
     ArnTriangle  * copiedInstance = [ super copy ];
 
-    copiedInstance->triangleData = triangleData;
-    copiedInstance->dim          = dim;
+    copiedInstance->triangleData  = triangleData;
+    copiedInstance->dim           = dim;
+    copiedInstance->vertexNormals = vertexNormals;
 
     return copiedInstance;
 }
@@ -95,8 +97,9 @@ ARPSHAPE_DEFAULT_IMPLEMENTATION(1,1,1)
             :   traversal
             ];
 
-    copiedInstance->triangleData = triangleData;
-    copiedInstance->dim          = dim;
+    copiedInstance->triangleData  = triangleData;
+    copiedInstance->dim           = dim;
+    copiedInstance->vertexNormals = vertexNormals;
 
     return copiedInstance;
 }
@@ -123,6 +126,8 @@ ARPSHAPE_DEFAULT_IMPLEMENTATION(1,1,1)
                 & pointArray[ ARARRAY_I( indexTable, 1 ) ],
                 & pointArray[ ARARRAY_I( indexTable, 2 ) ]
                 );
+
+        vertexNormals = [ VERTICES normalArray ];
     }
 }
 
@@ -76,5 +76,16 @@ ArNode  * arntrianglemesh_from_ply(
         const char       * pathToPlyFile
         );
 
+//   Builds the mesh from a PLY file that has already been read, and takes
+//   over its arrays.
+
+struct ArPLYMesh;
+
+ArNode  * arntrianglemesh_from_plymesh(
+        ART_GV             * art_gv,
+        ArShapeGeometry      newGeometry,
+        struct ArPLYMesh   * plyMesh
+        );
+
 
 // ===========================================================================
@@ -45,281 +45,37 @@ ART_MODULE_INITIALISATION_FUNCTION
 
 ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
 
-#import "rply.h"
+#import "ArPLYMesh.h"
 
-/*
-    This is the callback structure for the vertices. The callback function
-    gets the pointer to the array of the verteces into wich the verteces need
-    to be saved. It also gets an index wich tells it where to write in the
-    vertex array.
-*/
-
-typedef struct ArVertexCbData
-{
-    Pnt3D   * vertices;
-    FVec3D  * normals;
-    long      indexIntoVertexArray;
-    BOOL      normalsPresent;
-}
-ArVertexCbData;
-
-
-/*
-    This is the callback structure for the indices. The callback function gets
-    the pointer to the array of the indeces into wich the indeces for faces
-    need to be saved. It also gets an index which tells it where to write in
-    the index array.
-*/
-
-typedef struct ArFaceCbData
-{
-    ArLongArray  * indices;
-    long           indexIntoIndecesArray;
-}
-ArFaceCbData;
-
-//   When the data for a vertex is read from the ply file this function
-//   gets called.
-
-static int vertex_cb(
-        p_ply_argument  argument
-        )
-{
-    ArVertexCbData  * vertexCbData = 0;
-    long dim;
-
-    //  Get the user data.
-
-    ply_get_argument_user_data(
-          argument,
-(void*) & vertexCbData,
-        & dim
-        );
-
-    //   Write the vertex data into the place defined by the user data.
-
-    vertexCbData->vertices[vertexCbData->indexIntoVertexArray].c.x[dim] =
-        ply_get_argument_value(argument);
-
-    //   We work under the assumption that the data for a single vertex is read
-    //   sequentially. Thus when, we have read the data for dimension Z (2), we
-    //   assume we are done with one vertex. This means wee can increase the
-    //   index pointing into the vertex array and begin work on the next vertex.
-
-    if ( dim == 2 && ! vertexCbData->normalsPresent )
-        ++(vertexCbData->indexIntoVertexArray);
-
-    return 1;
-}
-
-static int normal_cb(
-        p_ply_argument  argument
-        )
-{
-    ArVertexCbData  * vertexCbData = 0;
-    long dim;
-
-    //  Get the user data.
-
-    ply_get_argument_user_data(
-          argument,
-(void*) & vertexCbData,
-        & dim
-        );
-
-    //   Write the vertex data into the place defined by the user data.
-
-    vertexCbData->normals[vertexCbData->indexIntoVertexArray].c.x[dim] =
-        ply_get_argument_value(argument);
-
-    //   We work under the assumption that the data for a single vertex is read
-    //   sequentially. Thus when, we have read the data for dimension Z (2), we
-    //   assume we are done with one vertex. This means wee can increase the
-    //   index pointing into the vertex array and begin work on the next vertex.
-
-    if ( dim == 2 && vertexCbData->normalsPresent )
-        ++(vertexCbData->indexIntoVertexArray);
-
-    return 1;
-}
-
-//   When the data for a face is read from the ply file this function
-//   gets called.
-
-static int face_cb(
-        p_ply_argument  argument
-        )
-{
-    // for some reason need to filter out the first value for face becouse
-    // that is just the length of the list. This we assume to be 3.
-    
-    long length, value_index;
-
-    ply_get_argument_property(argument, NULL, &length, &value_index);
-
-    if (value_index < 0) return 1;
-
-    ArFaceCbData* faceCbData = 0; //This data given by user tells us where to save the index.
-
-    //get the user data.
-    ply_get_argument_user_data(argument, (void*)&faceCbData, NULL);
-
-    //write the index data into the array
-    ARARRAY_I(*faceCbData->indices, faceCbData->indexIntoIndecesArray) =
-    ply_get_argument_value(argument);
-
-    //since the storage for the indeces of faces is a simple long array we need to icrease
-    //the index into it every time we write into it.
-    ++faceCbData->indexIntoIndecesArray;
-
-    return 1;
-}
-
-
-//-------------------------------------------------------------------------------
-
-ArNode * arntrianglemesh_from_ply(
+ArNode * arntrianglemesh_from_plymesh(
         ART_GV           * art_gv,
         ArShapeGeometry    newGeometry,
-        const char       * pathToPlyFile
+        ArPLYMesh        * plyMesh
         )
 {
-    //To put the values into the right place we need this data structures
-    //to be passed to the callbacks.
-    ArVertexCbData vertexCbData;
-    ArFaceCbData faceCbData;
-
-    //Open the ply file.
-    p_ply ply = ply_open(pathToPlyFile, NULL, 0, NULL);
-    ply_read_header(ply);
-
-
-    //Set the callback functions. Also obtain the number of elements we will get.
-    long numberOfVertices;
-
-    numberOfVertices = ply_set_read_cb(ply, "vertex", "x", vertex_cb, (void*)&vertexCbData, 0);
-    numberOfVertices = ply_set_read_cb(ply, "vertex", "y", vertex_cb, (void*)&vertexCbData, 1);
-    numberOfVertices = ply_set_read_cb(ply, "vertex", "z", vertex_cb, (void*)&vertexCbData, 2);
-
-    //Declare the target data structures. Here we collect the data from the PLY file.
-
-    Pnt3D* vertices = ALLOC_ARRAY(Pnt3D, numberOfVertices + 1);
-
-    vertices[numberOfVertices] = PNT3D_HUGE;
-
-    long numberOfNormals = 0;
-
-    numberOfNormals =
-        ply_set_read_cb(
-              ply,
-              "vertex",
-              "nx",
-              normal_cb,
-    (void*) & vertexCbData,
-              0
-            );
+    //   The vertex set and the mesh take over the arrays of the PLY mesh
 
-    numberOfNormals =
-        ply_set_read_cb(
-              ply,
-              "vertex",
-              "ny",
-              normal_cb,
-    (void*) & vertexCbData,
-              1
-            );
-
-    numberOfNormals =
-        ply_set_read_cb(
-              ply,
-              "vertex",
-              "nz",
-              normal_cb,
-    (void*) & vertexCbData,
-              2
-            );
-
-    FVec3D* normals = NULL;
-
-    if ( numberOfNormals > 0 )
-    {
-        normals = ALLOC_ARRAY( FVec3D, numberOfNormals + 1 );
-        
-        normals[numberOfNormals] =
-            FVEC3D(MATH_HUGE_FLOAT,MATH_HUGE_FLOAT,MATH_HUGE_FLOAT);
-        
-        vertexCbData.normalsPresent = YES;
-    }
-    else
-        vertexCbData.normalsPresent = NO;
-
-    long numberOfFaces =
-        ply_set_read_cb(
-              ply,
-              "face",
-              "vertex_indices",
-              face_cb,
-    (void*) & faceCbData,
-              0
-            );
-
-    ArLongArray  faces = arlongarray_init( numberOfFaces * 3 );
-
-    //Initial setup of the calback data data.
-
-    vertexCbData.vertices = vertices;
-    vertexCbData.normals = normals;
-    vertexCbData.indexIntoVertexArray = 0;
-
-    faceCbData.indices = &faces;
-    faceCbData.indexIntoIndecesArray = 0;
-
-    //Read ply file. Here the callbacks will be executed somewhere.
-    ply_read(ply);
-
-    //Now we are done with ply file so close it.
-    ply_close(ply);
-
-    //Create the vertex set that will be assigned to the mesh.
-    id vertexSet = 0;
-
-    vertexSet =
+    id vertexSet =
         arnvertexset(
             art_gv,
-            vertices,
+            plyMesh->vertices,
             NULL,
             NULL,
             NULL,
-            normals
+            plyMesh->normals
             );
 
-    //  Find the Extremal points.
-
-    Pnt3D  minPoint =
-        PNT3D( MATH_HUGE_DOUBLE,MATH_HUGE_DOUBLE,MATH_HUGE_DOUBLE);
-
-    Pnt3D  maxPoint =
-        PNT3D( MATH_TINY_DOUBLE,MATH_TINY_DOUBLE,MATH_TINY_DOUBLE);
-
-    for( int i = 0; i < numberOfVertices; ++i )
-    {
-        for (int j = 0; j < 3; ++j)
-        {
-            PNT3D_I( minPoint, j ) = MIN(vertices[i].c.x[j], minPoint.c.x[j]);
-            PNT3D_I( maxPoint, j ) = MAX(vertices[i].c.x[j], maxPoint.c.x[j]);
-        }
-    }
-
-    //   Create the actual triangle mesh.
-
     ArnTriangleMesh* thisMesh =
         [ ALLOC_INIT_OBJECT(ArnTriangleMesh)
             :   newGeometry
-            :   faces
-            :   minPoint
-            :   maxPoint
+            :   plyMesh->faces
+            :   plyMesh->minPoint
+            :   plyMesh->maxPoint
             ];
 
+    plyMesh->vertices = NULL;
+    plyMesh->normals = NULL;
+
     //   Before we return the triangle mesh we need to apply the vertex set
     //   on it.
 
@@ -330,6 +86,28 @@ ArNode * arntrianglemesh_from_ply(
             ];
 }
 
+ArNode * arntrianglemesh_from_ply(
+        ART_GV           * art_gv,
+        ArShapeGeometry    newGeometry,
+        const char       * pathToPlyFile
+        )
+{
+    ArPLYMesh  plyMesh;
+
+    if ( ! arplymesh_read(
+                 art_gv,
+               & plyMesh,
+                 pathToPlyFile ) )
+        return NULL;
+
+    return
+        arntrianglemesh_from_plymesh(
+            art_gv,
+            newGeometry,
+            & plyMesh
+            );
+}
+
 
 #define GREY8_SOURCE_BUFFER(_x,_y,_s) \
     (((ArnGrey8Image*)sourceImageBuffer)->data[(_y)*XC(_s)+(_x)])
@@ -573,7 +351,11 @@ ARPSHAPE_DEFAULT_IMPLEMENTATION(
 {
     ArnTriangleMesh  * copiedInstance = [ super copy ];
 
-    copiedInstance->faces = arlongarray_copy(&faces);
+    //   The face table is never altered after creation, so all copies
+    //   of a mesh - e.g. the per-placement duplicates generated while
+    //   flattening the scene graph - share it, just like the BSP tree.
+
+    copiedInstance->faces = arlongarray_copy_by_reference(&faces);
     copiedInstance->minPoint = minPoint;
     copiedInstance->maxPoint = maxPoint;
 
@@ -592,7 +374,11 @@ ARPSHAPE_DEFAULT_IMPLEMENTATION(
             :   traversal
             ];
 
-    copiedInstance->faces = arlongarray_copy(&faces);
+    //   The face table is never altered after creation, so all copies
+    //   of a mesh - e.g. the per-placement duplicates generated while
+    //   flattening the scene graph - share it, just like the BSP tree.
+
+    copiedInstance->faces = arlongarray_copy_by_reference(&faces);
     copiedInstance->minPoint = minPoint;
     copiedInstance->maxPoint = maxPoint;
 
@@ -784,6 +570,16 @@ ARPSHAPE_DEFAULT_IMPLEMENTATION(
 
     RELEASE_OBJECT(leafBBoxes);
 
+    //   Replace the per-triangle leaves of the bsp tree with flat triangle
+    //   packets, so that ray casting does not have to dispatch a message
+    //   to each ArnTriangle it tests.
+
+    [ (ArnBSPTree *) internalMeshTree packTriangleLeaves
+        :   [ (ArNode <ArpVertices> *) ARTS_VERTICES(*traversalState)
+                pointArray
+                ]
+        ];
+
     return;
 }
 
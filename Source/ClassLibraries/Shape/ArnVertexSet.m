@@ -430,11 +430,35 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnVertexSet)
 {
     ArnVertexSet  * copiedInstance = [ super copy ];
 
-    copiedInstance->pointTable  = arpnt3darray_copy(&pointTable);
-    copiedInstance->pnt4DTable  = arpnt4darray_copy(&pnt4DTable);
-    copiedInstance->valueTable  = arfloatarray_copy(&valueTable);
-    copiedInstance->coordTable  = arfpnt2darray_copy(&coordTable);
-    copiedInstance->normalTable = arfvec3darray_copy(&normalTable);
+    //   The tables are only ever replaced, never written to in place,
+    //   so copies can safely share them. This keeps instanced meshes
+    //   from duplicating their vertex data for every placement.
+
+    copiedInstance->pointTable  = arpnt3darray_copy_by_reference(&pointTable);
+    copiedInstance->pnt4DTable  = arpnt4darray_copy_by_reference(&pnt4DTable);
+    copiedInstance->valueTable  = arfloatarray_copy_by_reference(&valueTable);
+    copiedInstance->coordTable  = arfpnt2darray_copy_by_reference(&coordTable);
+    copiedInstance->normalTable = arfvec3darray_copy_by_reference(&normalTable);
+
+    return copiedInstance;
+}
+
+- (id) deepSemanticCopy
+        : (ArnGraphTraversal *) traversal
+{
+    ArnVertexSet  * copiedInstance =
+        [ super deepSemanticCopy
+            :   traversal
+            ];
+
+    //   Shared for the same reason as in 'copy' - this is the path the
+    //   per-placement duplicates of scene graph flattening take.
+
+    copiedInstance->pointTable  = arpnt3darray_copy_by_reference(&pointTable);
+    copiedInstance->pnt4DTable  = arpnt4darray_copy_by_reference(&pnt4DTable);
+    copiedInstance->valueTable  = arfloatarray_copy_by_reference(&valueTable);
+    copiedInstance->coordTable  = arfpnt2darray_copy_by_reference(&coordTable);
+    copiedInstance->normalTable = arfvec3darray_copy_by_reference(&normalTable);
 
     return copiedInstance;
 }
@@ -31,5 +31,6 @@ ART_LIBRARY_INTERFACE(ART_SkyModel)
 #import "ArnPreethamSkyModel.h"
 #import "ArnHosekSkyModel.h"
 #import "ArnPragueSkyModel.h"
+#import "ArcSkyRadianceCache.h"
 
 // ===========================================================================
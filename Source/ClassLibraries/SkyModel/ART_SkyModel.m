@@ -30,6 +30,7 @@
 
 ART_LIBRARY_INITIALISATION_FUNCTION
 (
+    ART_PERFORM_MODULE_INITIALISATION( ArcSkyRadianceCache )
     ART_PERFORM_MODULE_INITIALISATION( ArnSkyModel )
     ART_PERFORM_MODULE_INITIALISATION( ArnPreethamSkyModel )
     ART_PERFORM_MODULE_INITIALISATION( ArnHosekSkyModel )
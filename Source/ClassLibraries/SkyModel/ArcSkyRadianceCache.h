@@ -0,0 +1,181 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+#include "ART_Foundation.h"
+
+ART_MODULE_INTERFACE(ArcSkyRadianceCache)
+
+#include <pthread.h>
+
+@class ArNode;
+@class ArcWorkerPool;
+
+/* ===========================================================================
+    'ArcSkyRadianceCache'
+
+    Tabulated sky radiance of a sky model with a fixed sun. For a given sun
+    position, the radiance of the sky only depends on the view direction
+    and the wavelength, so it can be evaluated once for a grid of these at
+    setup time, and interpolated afterwards.
+
+    Directions are parameterised by zenith angle and by the absolute
+    azimuth difference to the sun: all sky models in ART are symmetric
+    with respect to the vertical plane through the sun, so half the sphere
+    of azimuths is sufficient. The wavelength nodes cover the spectral
+    range of the current ISR. Lookups interpolate bilinearly in direction,
+    and linearly in wavelength.
+
+    Bounded error mode: if a maximum relative error is specified, the table
+    is checked against the exact model at the centre of each direction
+    cell, both at the wavelength nodes and halfway between them. Cells
+    where the interpolated value is off by more than the allowed error -
+    typically those around the sun, and along the horizon - are flagged,
+    and lookups in them fail, so that the caller falls back to evaluating
+    the model.
+
+    The table is filled in parallel, one row of zenith angles at a time,
+    by one worker thread per core.
+
+    The sun itself is not part of the table; callers have to handle
+    directions which hit the solar disc before asking the cache.
+=========================================================================== */
+
+@protocol ArpSkyRadianceCacheSource
+
+/* ---------------------------------------------------------------------------
+    'exactSkyRadiance'
+        Sky radiance (i.e. without the solar disc) for a world space
+        direction, at an arbitrary number of wavelengths. This is called
+        concurrently from several threads while the cache is being built.
+--------------------------------------------------------------------------- */
+
+- (void) exactSkyRadiance
+        : (const Vec3D *) direction_worldspace
+        : (unsigned int) numberOfWavelengths
+        : (const double *) wavelengths
+        : (double *) radiance
+        ;
+
+@end
+
+@interface ArcSkyRadianceCache
+        : ArcObject
+{
+    //   Only used while the cache is built, and not retained: the source
+    //   is usually the sky model that owns the cache.
+
+    ArNode <ArpSkyRadianceCacheSource>  * source;
+
+    //   Horizontal unit vector pointing towards the sun, and its normal
+
+    Vec3D            sunAzimuthDirection;
+    Vec3D            sunAzimuthNormal;
+
+    unsigned int     numberOfZenithNodes;
+    unsigned int     numberOfAzimuthNodes;
+    unsigned int     numberOfWavelengthNodes;
+
+    double           zenithStep;
+    double           azimuthStep;
+    double           wavelengthStart;
+    double           wavelengthStep;
+
+    double           maximumRelativeError;
+    double           maximumRadiance;
+
+    //   [zenith][azimuth][wavelength], and one flag per direction cell
+
+    float          * radiance;
+    unsigned char  * exactCell;
+    unsigned int     numberOfExactCells;
+
+    //   State of the parallel build
+
+    unsigned int     buildPhase;
+    ArcWorkerPool  * buildWorkers;
+}
+
+/* ---------------------------------------------------------------------------
+    'init'
+        Builds the table. A 'newMaximumRelativeError' of zero selects the
+        plain interpolation mode, in which every lookup succeeds.
+--------------------------------------------------------------------------- */
+
+- (id) init
+        : (ArNode <ArpSkyRadianceCacheSource> *) newSource
+        : (const Vec3D *) newSunDirection_worldspace
+        : (double) newMaximumRelativeError
+        ;
+
+/* ---------------------------------------------------------------------------
+    'skyRadiance'
+        Interpolated radiance for all four hero wavelengths. Returns NO if
+        the direction lies in a cell flagged in bounded error mode, or if
+        one of the wavelengths lies outside the table; the result is
+        undefined in that case.
+--------------------------------------------------------------------------- */
+
+- (BOOL) skyRadiance
+        : (const Vec3D *) direction_worldspace
+        : (const ArWavelength *) wavelength
+        : (ArSpectralSample *) result
+        ;
+
+@end
+
+/* ---------------------------------------------------------------------------
+    Global switches for the cache: whether sky models should use one at
+    all, and the error bound they pass on to it. These are set via the
+    '-sc' and '-sce' options of artist, and only affect caches that are
+    built afterwards.
+
+    The mutex guards the lazy creation of caches by the sky models, which
+    happens on the first lookup during rendering.
+--------------------------------------------------------------------------- */
+
+BOOL art_use_sky_radiance_cache(
+        const ART_GV  * art_gv
+        );
+
+void art_set_use_sky_radiance_cache(
+              ART_GV  * art_gv,
+        const BOOL      new_use_sky_radiance_cache
+        );
+
+double art_sky_radiance_cache_maximum_error(
+        const ART_GV  * art_gv
+        );
+
+void art_set_sky_radiance_cache_maximum_error(
+              ART_GV  * art_gv,
+        const double    new_maximum_error
+        );
+
+pthread_mutex_t * art_sky_radiance_cache_mutex(
+        const ART_GV  * art_gv
+        );
+
+// ===========================================================================
@@ -0,0 +1,536 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+#define ART_MODULE_NAME     ArcSkyRadianceCache
+
+#import "ArcSkyRadianceCache.h"
+#import "ART_Scenegraph.h"
+#import "ART_ColourAndSpectra.h"
+
+typedef struct ArcSkyRadianceCache_GV
+{
+    BOOL             useCache;
+    double           maximumError;
+    pthread_mutex_t  mutex;
+}
+ArcSkyRadianceCache_GV;
+
+#define ARCSKYRADIANCECACHE_GV              art_gv->arcskyradiancecache_gv
+#define ARCSKYRADIANCECACHE_GV_USE          ARCSKYRADIANCECACHE_GV->useCache
+#define ARCSKYRADIANCECACHE_GV_MAX_ERROR    ARCSKYRADIANCECACHE_GV->maximumError
+#define ARCSKYRADIANCECACHE_GV_MUTEX        ARCSKYRADIANCECACHE_GV->mutex
+
+ART_MODULE_INITIALISATION_FUNCTION
+(
+    ARCSKYRADIANCECACHE_GV = ALLOC(ArcSkyRadianceCache_GV);
+
+    ARCSKYRADIANCECACHE_GV_USE       = NO;
+    ARCSKYRADIANCECACHE_GV_MAX_ERROR = 0.0;
+
+    pthread_mutex_init( & ARCSKYRADIANCECACHE_GV_MUTEX, NULL );
+)
+
+ART_MODULE_SHUTDOWN_FUNCTION
+(
+    pthread_mutex_destroy( & ARCSKYRADIANCECACHE_GV_MUTEX );
+
+    FREE( ARCSKYRADIANCECACHE_GV );
+)
+
+BOOL art_use_sky_radiance_cache(
+        const ART_GV  * art_gv
+        )
+{
+    return ARCSKYRADIANCECACHE_GV_USE;
+}
+
+void art_set_use_sky_radiance_cache(
+              ART_GV  * art_gv,
+        const BOOL      new_use_sky_radiance_cache
+        )
+{
+    ARCSKYRADIANCECACHE_GV_USE = new_use_sky_radiance_cache;
+}
+
+double art_sky_radiance_cache_maximum_error(
+        const ART_GV  * art_gv
+        )
+{
+    return ARCSKYRADIANCECACHE_GV_MAX_ERROR;
+}
+
+void art_set_sky_radiance_cache_maximum_error(
+              ART_GV  * art_gv,
+        const double    new_maximum_error
+        )
+{
+    ARCSKYRADIANCECACHE_GV_MAX_ERROR = M_MAX( new_maximum_error, 0.0 );
+}
+
+pthread_mutex_t * art_sky_radiance_cache_mutex(
+        const ART_GV  * art_gv
+        )
+{
+    return & ARCSKYRADIANCECACHE_GV_MUTEX;
+}
+
+//   Table resolution: 1.4 degrees in both angles, and 5nm in wavelength.
+//   For the ISR range of 380-780nm, this amounts to about 5 MB.
+
+#define ARCSKYRADIANCECACHE_ZENITH_INTERVALS    128
+#define ARCSKYRADIANCECACHE_AZIMUTH_INTERVALS   128
+#define ARCSKYRADIANCECACHE_WAVELENGTH_STEP     5.0 NANOMETER
+
+//   In bounded error mode, the relative error of very dark cells (e.g.
+//   below the horizon) is measured against this fraction of the brightest
+//   table entry instead of against their own, vanishing radiance.
+
+#define ARCSKYRADIANCECACHE_ERROR_FLOOR         1.0E-3
+
+#define ARCSKYRADIANCECACHE_FILL_PHASE          0
+#define ARCSKYRADIANCECACHE_CHECK_PHASE         1
+
+//   Node index and fractional offset of a table coordinate that has
+//   already been clamped to [0, numberOfNodes - 1].
+
+static inline void arcskyradiancecache_node(
+        const double          coordinate,
+        const unsigned int    numberOfNodes,
+              unsigned int  * node,
+              double        * fraction
+        )
+{
+    unsigned int  n = (unsigned int) coordinate;
+
+    if ( n > numberOfNodes - 2 )
+        n = numberOfNodes - 2;
+
+    *node     = n;
+    *fraction = coordinate - n;
+}
+
+@implementation ArcSkyRadianceCache
+
+- (void) _direction
+        : (double) zenith
+        : (double) azimuth
+        : (Vec3D *) direction_worldspace
+{
+    const double  sinZenith = sin( zenith );
+
+    XC(*direction_worldspace) =
+          sinZenith * cos( azimuth ) * XC(sunAzimuthDirection)
+        + sinZenith * sin( azimuth ) * XC(sunAzimuthNormal);
+    YC(*direction_worldspace) =
+          sinZenith * cos( azimuth ) * YC(sunAzimuthDirection)
+        + sinZenith * sin( azimuth ) * YC(sunAzimuthNormal);
+    ZC(*direction_worldspace) = cos( zenith );
+}
+
+- (double) _fillRow
+        : (unsigned int) row
+        : (const double *) nodeWavelengths
+        : (double *) exactRadiance
+{
+    double  rowMaximum = 0.0;
+
+    for ( unsigned int j = 0; j < numberOfAzimuthNodes; j++ )
+    {
+        Vec3D  direction;
+
+        [ self _direction
+            :   row * zenithStep
+            :   j * azimuthStep
+            : & direction
+            ];
+
+        [ source exactSkyRadiance
+            : & direction
+            :   numberOfWavelengthNodes
+            :   nodeWavelengths
+            :   exactRadiance
+            ];
+
+        float  * node =
+            radiance
+            + ( row * numberOfAzimuthNodes + j ) * numberOfWavelengthNodes;
+
+        for ( unsigned int k = 0; k < numberOfWavelengthNodes; k++ )
+        {
+            const double  value = M_MAX( exactRadiance[k], 0.0 );
+
+            node[k] = (float) value;
+            rowMaximum = M_MAX( rowMaximum, value );
+        }
+    }
+
+    return rowMaximum;
+}
+
+//   Checks the cells between zenith nodes 'row' and 'row + 1' at twice
+//   the wavelength resolution of the table, and flags the ones that are
+//   not accurate enough.
+
+- (unsigned int) _checkRow
+        : (unsigned int) row
+        : (const double *) testWavelengths
+        : (double *) exactRadiance
+{
+    const unsigned int  nl = numberOfWavelengthNodes;
+    const unsigned int  numberOfTestWavelengths = 2 * nl - 1;
+    const double        errorFloor =
+        ARCSKYRADIANCECACHE_ERROR_FLOOR * maximumRadiance;
+
+    unsigned int  rowExactCells = 0;
+
+    for ( unsigned int j = 0; j + 1 < numberOfAzimuthNodes; j++ )
+    {
+        Vec3D  direction;
+
+        [ self _direction
+            :   ( row + 0.5 ) * zenithStep
+            :   ( j + 0.5 ) * azimuthStep
+            : & direction
+            ];
+
+        [ source exactSkyRadiance
+            : & direction
+            :   numberOfTestWavelengths
+            :   testWavelengths
+            :   exactRadiance
+            ];
+
+        const float  * c00 = radiance + ( row * numberOfAzimuthNodes + j ) * nl;
+        const float  * c01 = c00 + nl;
+        const float  * c10 = c00 + numberOfAzimuthNodes * nl;
+        const float  * c11 = c10 + nl;
+
+        BOOL  exceedsBound = NO;
+
+        for ( unsigned int k = 0; k < numberOfTestWavelengths; k++ )
+        {
+            const unsigned int  k0 = k / 2;
+            const unsigned int  k1 = ( k + 1 ) / 2;
+
+            const double  interpolated =
+                0.125 * (   c00[k0] + c01[k0] + c10[k0] + c11[k0]
+                          + c00[k1] + c01[k1] + c10[k1] + c11[k1] );
+
+            const double  exact = M_MAX( exactRadiance[k], 0.0 );
+
+            if (   fabs( interpolated - exact )
+                 > maximumRelativeError * M_MAX( exact, errorFloor ) )
+            {
+                exceedsBound = YES;
+                break;
+            }
+        }
+
+        if ( exceedsBound )
+        {
+            exactCell[ row * ( numberOfAzimuthNodes - 1 ) + j ] = 1;
+            rowExactCells++;
+        }
+    }
+
+    return rowExactCells;
+}
+
+- (void) _buildWorkerThread
+        : (ArcUnsignedInteger *) threadIndex
+{
+    (void) threadIndex;
+
+    const unsigned int  nl = numberOfWavelengthNodes;
+
+    double  * nodeWavelengths = ALLOC_ARRAY( double, nl );
+    double  * testWavelengths = ALLOC_ARRAY( double, 2 * nl - 1 );
+    double  * exactRadiance   = ALLOC_ARRAY( double, 2 * nl - 1 );
+
+    for ( unsigned int k = 0; k < nl; k++ )
+        nodeWavelengths[k] = wavelengthStart + k * wavelengthStep;
+
+    for ( unsigned int k = 0; k < 2 * nl - 1; k++ )
+        testWavelengths[k] = wavelengthStart + 0.5 * k * wavelengthStep;
+
+    double        workerMaximum = 0.0;
+    unsigned int  workerExactCells = 0;
+
+    unsigned int  row;
+
+    while ( [ buildWorkers nextWorkItem : & row ] )
+    {
+        if ( buildPhase == ARCSKYRADIANCECACHE_FILL_PHASE )
+        {
+            double  rowMaximum =
+                [ self _fillRow
+                    :   row
+                    :   nodeWavelengths
+                    :   exactRadiance
+                    ];
+
+            workerMaximum = M_MAX( workerMaximum, rowMaximum );
+        }
+        else
+        {
+            workerExactCells +=
+                [ self _checkRow
+                    :   row
+                    :   testWavelengths
+                    :   exactRadiance
+                    ];
+        }
+    }
+
+    FREE_ARRAY( nodeWavelengths );
+    FREE_ARRAY( testWavelengths );
+    FREE_ARRAY( exactRadiance );
+
+    [ buildWorkers lock ];
+    maximumRadiance = M_MAX( maximumRadiance, workerMaximum );
+    numberOfExactCells += workerExactCells;
+    [ buildWorkers unlock ];
+}
+
+//   The fill phase works on the rows of nodes, the check phase on the
+//   rows of cells in between them.
+
+- (void) _runBuildPhase
+        : (unsigned int) phase
+{
+    buildPhase = phase;
+
+    buildWorkers =
+        [ ALLOC_INIT_OBJECT(ArcWorkerPool)
+            :   phase == ARCSKYRADIANCECACHE_FILL_PHASE
+              ? numberOfZenithNodes
+              : numberOfZenithNodes - 1
+            ];
+
+    [ buildWorkers run
+        :   @selector(_buildWorkerThread:)
+        :   self
+        ];
+
+    RELEASE_OBJECT(buildWorkers);
+}
+
+- (id) init
+        : (ArNode <ArpSkyRadianceCacheSource> *) newSource
+        : (const Vec3D *) newSunDirection_worldspace
+        : (double) newMaximumRelativeError
+{
+    self = [ super init ];
+
+    if ( self )
+    {
+        source               = newSource;
+        maximumRelativeError = M_MAX( newMaximumRelativeError, 0.0 );
+
+        //   For a sun in the zenith, the sky is rotationally symmetric,
+        //   and any horizontal reference direction will do.
+
+        double  hx = XC(*newSunDirection_worldspace);
+        double  hy = YC(*newSunDirection_worldspace);
+        double  horizontalLength = sqrt( M_SQR(hx) + M_SQR(hy) );
+
+        if ( horizontalLength < 1.0E-9 )
+        {
+            hx = 1.0;
+            hy = 0.0;
+            horizontalLength = 1.0;
+        }
+
+        hx /= horizontalLength;
+        hy /= horizontalLength;
+
+        sunAzimuthDirection = VEC3D(  hx, hy, 0.0 );
+        sunAzimuthNormal    = VEC3D( -hy, hx, 0.0 );
+
+        numberOfZenithNodes  = ARCSKYRADIANCECACHE_ZENITH_INTERVALS + 1;
+        numberOfAzimuthNodes = ARCSKYRADIANCECACHE_AZIMUTH_INTERVALS + 1;
+
+        zenithStep  = MATH_PI / ARCSKYRADIANCECACHE_ZENITH_INTERVALS;
+        azimuthStep = MATH_PI / ARCSKYRADIANCECACHE_AZIMUTH_INTERVALS;
+
+        ArWavelengthSamplingData  samplingData;
+
+        arwavelength_sampling_data_from_current_ISR_s(
+              art_gv,
+            & samplingData
+            );
+
+        numberOfWavelengthNodes =
+            (unsigned int) ceil(   samplingData.spectralRange
+                                 / ( ARCSKYRADIANCECACHE_WAVELENGTH_STEP ) )
+            + 1;
+
+        if ( numberOfWavelengthNodes < 2 )
+            numberOfWavelengthNodes = 2;
+
+        wavelengthStart = samplingData.spectralRangeStart;
+        wavelengthStep  =
+            samplingData.spectralRange / ( numberOfWavelengthNodes - 1 );
+
+        radiance =
+            ALLOC_ARRAY(
+                float,
+                  numberOfZenithNodes
+                * numberOfAzimuthNodes
+                * numberOfWavelengthNodes
+                );
+
+        exactCell =
+            ALLOC_ARRAY(
+                unsigned char,
+                ( numberOfZenithNodes - 1 ) * ( numberOfAzimuthNodes - 1 )
+                );
+
+        memset(
+            exactCell,
+            0,
+            ( numberOfZenithNodes - 1 ) * ( numberOfAzimuthNodes - 1 )
+            );
+
+        maximumRadiance    = 0.0;
+        numberOfExactCells = 0;
+
+        [ self _runBuildPhase
+            :   ARCSKYRADIANCECACHE_FILL_PHASE
+            ];
+
+        if ( maximumRelativeError > 0.0 )
+            [ self _runBuildPhase
+                :   ARCSKYRADIANCECACHE_CHECK_PHASE
+                ];
+
+        source = 0;
+    }
+
+    return self;
+}
+
+- (void) dealloc
+{
+    FREE_ARRAY( radiance );
+    FREE_ARRAY( exactCell );
+
+    [ super dealloc ];
+}
+
+- (BOOL) skyRadiance
+        : (const Vec3D *) direction_worldspace
+        : (const ArWavelength *) wavelength
+        : (ArSpectralSample *) result
+{
+    const double  x = XC(*direction_worldspace);
+    const double  y = YC(*direction_worldspace);
+    const double  z = ZC(*direction_worldspace);
+
+    const double  horizontalLength = sqrt( M_SQR(x) + M_SQR(y) );
+    const double  length = sqrt( M_SQR(horizontalLength) + M_SQR(z) );
+
+    double  cosZenith = z / length;
+    double  cosAzimuth = 1.0;
+
+    if ( horizontalLength > 0.0 )
+        cosAzimuth =
+              (   x * XC(sunAzimuthDirection)
+                + y * YC(sunAzimuthDirection) )
+            / horizontalLength;
+
+    cosZenith  = M_CLAMP( cosZenith, -1.0, 1.0 );
+    cosAzimuth = M_CLAMP( cosAzimuth, -1.0, 1.0 );
+
+    const double  zenith  = acos( cosZenith ) / zenithStep;
+    const double  azimuth = acos( cosAzimuth ) / azimuthStep;
+
+    unsigned int  i, j;
+    double        fi, fj;
+
+    arcskyradiancecache_node(
+        M_MIN( zenith, numberOfZenithNodes - 1.0 ),
+        numberOfZenithNodes,
+      & i,
+      & fi
+        );
+
+    arcskyradiancecache_node(
+        M_MIN( azimuth, numberOfAzimuthNodes - 1.0 ),
+        numberOfAzimuthNodes,
+      & j,
+      & fj
+        );
+
+    if ( exactCell[ i * ( numberOfAzimuthNodes - 1 ) + j ] )
+        return NO;
+
+    const unsigned int  nl = numberOfWavelengthNodes;
+
+    const float  * c00 = radiance + ( i * numberOfAzimuthNodes + j ) * nl;
+    const float  * c01 = c00 + nl;
+    const float  * c10 = c00 + numberOfAzimuthNodes * nl;
+    const float  * c11 = c10 + nl;
+
+    const double  w00 = ( 1.0 - fi ) * ( 1.0 - fj );
+    const double  w01 = ( 1.0 - fi ) * fj;
+    const double  w10 = fi * ( 1.0 - fj );
+    const double  w11 = fi * fj;
+
+    for ( unsigned int l = 0; l < 4; l++ )
+    {
+        double  t = ( ARWL_WI(*wavelength,l) - wavelengthStart ) / wavelengthStep;
+
+        //   Wavelengths right at the end of the ISR range are fine, the
+        //   tolerance only absorbs the rounding error of the division.
+
+        if ( t < -1.0E-6 || t > nl - 1 + 1.0E-6 )
+            return NO;
+
+        unsigned int  k;
+        double        fk;
+
+        arcskyradiancecache_node(
+            M_CLAMP( t, 0.0, nl - 1.0 ),
+            nl,
+          & k,
+          & fk
+            );
+
+        const double  r0 =
+            w00 * c00[k] + w01 * c01[k] + w10 * c10[k] + w11 * c11[k];
+        const double  r1 =
+            w00 * c00[k+1] + w01 * c01[k+1] + w10 * c10[k+1] + w11 * c11[k+1];
+
+        SPS_CI( *result, l ) = r0 + fk * ( r1 - r0 );
+    }
+
+    return YES;
+}
+
+@end
+
+// ===========================================================================
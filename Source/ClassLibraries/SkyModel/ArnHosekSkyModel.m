@@ -40,6 +40,8 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnHosekSkyModel)
 
 - (void) _setup
 {
+    [ self _discardSkyRadianceCache ];
+
     XC(sunDirection) =   cos( solarAzimuth )
                        * cos( solarElevation );
     YC(sunDirection) =   sin( solarAzimuth )
@@ -136,6 +138,8 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnHosekSkyModel)
 
 - (void) prepareForISRChange
 {
+    [ self _discardSkyRadianceCache ];
+
     if ( skymodel_state )
     {
         const unsigned int  num_channels = spc_channels( art_gv );
@@ -100,6 +100,15 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnPragueSkyModel)
             resourcePaths[existingPathIndex]
             );
 
+    //   Only the coefficients for the turbidity of this sky will be used,
+    //   so these can already be paged in while the rest of the scene is
+    //   being set up.
+
+    arpragueskymodelstate_prefetch_turbidity(
+          skymodel_state,
+          atmosphericTurbidity
+        );
+
     solarRadius = PSM_SUN_RADIUS;
 }
 
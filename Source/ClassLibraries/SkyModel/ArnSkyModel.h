@@ -56,6 +56,7 @@ ART_MODULE_INTERFACE(ArnSkyModel)
 
 #define SKYMODEL_DEFAULT_SUN_RADIUS     0.251 DEGREES
 
+@class ArcSkyRadianceCache;
 
 @interface ArnSkyModel
         : ArnQuaternary
@@ -75,6 +76,9 @@ ART_MODULE_INTERFACE(ArnSkyModel)
 
     ArSpectrum  * groundAlbedo;
 
+    //   Tabulated sky radiance, only built on demand
+
+    ArcSkyRadianceCache  * skyRadianceCache;
 }
 
 - (id) init
@@ -89,6 +93,21 @@ ART_MODULE_INTERFACE(ArnSkyModel)
         : (ArNode <ArpTrafo3D> *) newTrafo
         ;
 
+/* ---------------------------------------------------------------------------
+    'skyRadianceCache'
+        Returns 0 unless sky radiance caching has been switched on via
+        art_set_use_sky_radiance_cache(). Otherwise, the cache is built on
+        the first call, which blocks all other callers until it is ready.
+        Only subclasses which implement ArpSkyRadianceCacheSource may use
+        this.
+--------------------------------------------------------------------------- */
+
+- (ArcSkyRadianceCache *) skyRadianceCache
+        ;
+
+- (void) _discardSkyRadianceCache
+        ;
+
 @end
 
 #endif // _ARNSKYDOME_H_
@@ -27,6 +27,7 @@
 #define ART_MODULE_NAME     ArnSkyModel
 
 #import "ArnSkyModel.h"
+#import "ArcSkyRadianceCache.h"
 
 #import "ARM_Shape.h"
 #import "ArNode_ARM_GenericAttributes.h"
@@ -44,8 +45,63 @@ ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
 
 ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnSkyModel)
 
+- (void) _discardSkyRadianceCache
+{
+    if ( skyRadianceCache )
+    {
+        RELEASE_OBJECT( skyRadianceCache );
+        skyRadianceCache = 0;
+    }
+}
+
+- (ArcSkyRadianceCache *) skyRadianceCache
+{
+    if ( ! art_use_sky_radiance_cache( art_gv ) )
+        return 0;
+
+    //   This is asked for every sky lookup by all rendering threads, so
+    //   the lock is only taken as long as there is no cache yet.
+
+    ArcSkyRadianceCache  * cache =
+        __atomic_load_n( & skyRadianceCache, __ATOMIC_ACQUIRE );
+
+    if ( ! cache )
+    {
+        pthread_mutex_t  * mutex = art_sky_radiance_cache_mutex( art_gv );
+
+        pthread_mutex_lock( mutex );
+
+        cache = skyRadianceCache;
+
+        if ( ! cache )
+        {
+            Vec3D  sunDirection =
+                VEC3D(
+                    cos( solarAzimuth ) * cos( solarElevation ),
+                    sin( solarAzimuth ) * cos( solarElevation ),
+                    sin( solarElevation )
+                    );
+
+            cache =
+                [ ALLOC_INIT_OBJECT(ArcSkyRadianceCache)
+                    :   (ArNode <ArpSkyRadianceCacheSource> *) self
+                    : & sunDirection
+                    :   art_sky_radiance_cache_maximum_error( art_gv )
+                    ];
+
+            __atomic_store_n( & skyRadianceCache, cache, __ATOMIC_RELEASE );
+        }
+
+        pthread_mutex_unlock( mutex );
+    }
+
+    return cache;
+}
+
 - (void) _setup
 {
+    [ self _discardSkyRadianceCache ];
+
     if ( SKYMODEL_GROUND_ALBEDO_SUBNODE )
     {
         if ( ! groundAlbedo )
@@ -122,8 +178,17 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnSkyModel)
     return self;
 }
 
+- (void) dealloc
+{
+    [ self _discardSkyRadianceCache ];
+
+    [ super dealloc ];
+}
+
 - (void) prepareForISRChange
 {
+    [ self _discardSkyRadianceCache ];
+
     if ( groundAlbedo )
     {
         spc_free( art_gv, groundAlbedo );
@@ -162,6 +227,10 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnSkyModel)
     
     copiedInstance->polarisedOutput = polarisedOutput;
 
+    //   The copy builds its own cache when it needs one
+
+    copiedInstance->skyRadianceCache = 0;
+
     [ copiedInstance _setup ];
 
     return copiedInstance;
@@ -27,6 +27,7 @@
 #define ART_MODULE_NAME ArnVolumeDataConst
 
 #import "ArnVolumeDataConst.h"
+#import "ArVolumeMajorantGrid.h"
 
 ART_MODULE_INITIALISATION_FUNCTION
 (
@@ -186,12 +187,40 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnVolumeDataConst)
     }
 }
 
+- (void) lookupPoints
+        : (unsigned int) numberOfPoints
+        : (const Pnt3D *) pointsWorldspace
+        : (      double *) values
+{
+    for ( unsigned int i = 0; i < numberOfPoints; i++ )
+        [ self lookup
+            : & pointsWorldspace[i]
+            : & values[i]
+            ];
+}
+
 - (int) dimensions
 {
     // TODO
     return 1;
 }
 
+- (void) majorantIterator
+        : (const Ray3D *) rayWorldspace
+        : (double) near
+        : (double) far
+        : (ArVolumeMajorantIterator *) iterator
+{
+    (void) rayWorldspace;
+
+    arvolumemajorantiterator_init_constant(
+          iterator,
+          _value,
+          near,
+          far
+        );
+}
+
 - (void) code
         : (ArcObject <ArpCoder> *) coder
 {
@@ -29,6 +29,8 @@
 ART_MODULE_INTERFACE(ArnVolumeDataGrid)
 
 #import "ART_Scenegraph.h"
+#import "ArVoxelBrickGrid.h"
+#import "ArVolumeMajorantGrid.h"
     
 @interface ArnVolumeDataGrid
     : ArnUnary < ArpConcreteClass, ArpCoding, ArpVolume>
@@ -39,13 +41,25 @@ ART_MODULE_INTERFACE(ArnVolumeDataGrid)
     float
         _xMin, _yMin, _zMin,
         _xMax, _yMax, _zMax;
-    ArFloatArray _data;
+    ArVoxelBrickGrid _data;
     float _max;
     
     HTrafo3D    world2local;
     HTrafo3D    local2world;
+
+    ArVolumeMajorantGrid  majorantGrid;
 }
 
+/* ---------------------------------------------------------------------------
+    'prepareMajorantGrid'
+        (Re)builds the coarse grid of local maxima that is used for the
+        majorant iterators of this volume. Has to be called once the voxel
+        data is in place.
+--------------------------------------------------------------------------- */
+
+- (void) prepareMajorantGrid
+        ;
+
 @end
 
     
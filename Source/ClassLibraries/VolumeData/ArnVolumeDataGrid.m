@@ -61,16 +61,16 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnVolumeDataGrid)
     
     copiedInstance->_max = _max;
     
-    int n_data_el = _xRes * _yRes * _zRes * _nChannels;
-    copiedInstance->_data = arfloatarray_init(n_data_el);
-    
-    memcpy(arfloatarray_array(&copiedInstance->_data),
-           arfloatarray_array(&_data),
-           n_data_el * sizeof(Float));
+    arvoxelbrickgrid_copy( & _data, & copiedInstance->_data );
     
     copiedInstance->world2local = world2local;
     copiedInstance->local2world = local2world;
 
+    arvolumemajorantgrid_copy(
+        & majorantGrid,
+        & copiedInstance->majorantGrid
+        );
+
     return copiedInstance;
 }
 
@@ -98,25 +98,36 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnVolumeDataGrid)
     
     copiedInstance->_max = _max;
     
-    int n_data_el = _xRes * _yRes * _zRes * _nChannels;
-    copiedInstance->_data = arfloatarray_init(n_data_el);
-
-    memcpy(arfloatarray_array(&copiedInstance->_data),
-           arfloatarray_array(&_data),
-           n_data_el * sizeof(Float));
+    arvoxelbrickgrid_copy( & _data, & copiedInstance->_data );
     
     copiedInstance->world2local = world2local;
     copiedInstance->local2world = local2world;
+
+    arvolumemajorantgrid_copy(
+        & majorantGrid,
+        & copiedInstance->majorantGrid
+        );
     
     return copiedInstance;
 }
 
 - (void) dealloc
 {
-    arfloatarray_free_contents(&_data);
+    arvoxelbrickgrid_free_contents(&_data);
+    arvolumemajorantgrid_free_contents(&majorantGrid);
     [super dealloc];
 }
 
+- (void) prepareMajorantGrid
+{
+    arvolumemajorantgrid_free_contents(&majorantGrid);
+
+    arvolumemajorantgrid_init(
+        & majorantGrid,
+        & _data
+        );
+}
+
 + (BOOL) isHeaderCorrect
         : (char*) header
 {
@@ -215,42 +226,69 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnVolumeDataGrid)
         z >= _xMin && z < _zMax;
 }
 
+- (void) _lookupLocal
+        : (const Pnt3D *) pointLocalSpace
+        : (     double *) value
+{
+    //   Voxel i is centred on the voxel coordinate i; the sparse grid
+    //   interpolates trilinearly between the voxel centres, and reads
+    //   as zero outside the volume.
+
+    const Pnt3D  voxelPoint =
+        PNT3D(
+            ( XC(*pointLocalSpace) - _xMin ) / ( _xMax - _xMin ) * (double)_xRes,
+            ( YC(*pointLocalSpace) - _yMin ) / ( _yMax - _yMin ) * (double)_yRes,
+            ( ZC(*pointLocalSpace) - _zMin ) / ( _zMax - _zMin ) * (double)_zRes
+            );
+
+    arvoxelbrickgrid_lookup(
+        & _data,
+        & voxelPoint,
+          value
+        );
+
+    for (int i = 0; i < _nChannels; i++) {
+        value[i] = MAX(0, value[i] - FLT_EPSILON);
+    }
+}
+
 - (void) lookup
         : (const Pnt3D *) point_wordspace
         : (     double *) value
 {
-    
     Pnt3D pointLocalSpace;
+
     pnt3d_p_htrafo3d_p(
           point_wordspace,
         & world2local,
         & pointLocalSpace
         );
-    
-    const double
-        x = XC(pointLocalSpace),
-        y = YC(pointLocalSpace),
-        z = ZC(pointLocalSpace);
 
-    const int
-        x_idx = round((x - _xMin) / (_xMax - _xMin) * (double)_xRes),
-        y_idx = round((y - _yMin) / (_yMax - _yMin) * (double)_yRes),
-        z_idx = round((z - _zMin) / (_zMax - _zMin) * (double)_zRes);
+    [ self _lookupLocal
+        : & pointLocalSpace
+        :   value
+        ];
+}
 
-    // Check if we're inside the volume
-    if (x_idx < 0 || x_idx >= _xRes ||
-        y_idx < 0 || y_idx >= _yRes ||
-        z_idx < 0 || z_idx >= _zRes){
+- (void) lookupPoints
+        : (unsigned int) numberOfPoints
+        : (const Pnt3D *) pointsWorldspace
+        : (      double *) values
+{
+    for ( unsigned int i = 0; i < numberOfPoints; i++ )
+    {
+        Pnt3D pointLocalSpace;
 
-        for (int i = 0; i < _nChannels; i++) {
-            value[i] = 0;
-        }
-    } else {
-        int offset = ((z_idx*_yRes + y_idx)*_xRes + x_idx)*_nChannels;
-        
-        for (int i = 0; i < _nChannels; i++) {
-            value[i] = MAX(0, (double)ARARRAY_I(_data, offset + i) - FLT_EPSILON);
-        }
+        pnt3d_p_htrafo3d_p(
+            & pointsWorldspace[i],
+            & world2local,
+            & pointLocalSpace
+            );
+
+        [ self _lookupLocal
+            : & pointLocalSpace
+            : & values[i * _nChannels]
+            ];
     }
 }
 
@@ -259,6 +297,72 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnVolumeDataGrid)
     return _nChannels;
 }
 
+- (void) majorantIterator
+        : (const Ray3D *) rayWorldspace
+        : (double) near
+        : (double) far
+        : (ArVolumeMajorantIterator *) iterator
+{
+    if ( ! majorantGrid.majorant )
+    {
+        arvolumemajorantiterator_init_constant(
+              iterator,
+              _max,
+              near,
+              far
+            );
+
+        return;
+    }
+
+    //   Same affine mapping as in 'lookup', followed by the half voxel
+    //   offset and the cell size of the majorant grid. Affine maps keep
+    //   the ray parameter intact, so no rescaling of t is needed.
+
+    Ray3D  localRay;
+
+    vec3d_v_htrafo3d_v(
+        & rayWorldspace->vector,
+        & world2local,
+        & RAY3D_VECTOR(localRay)
+        );
+
+    pnt3d_p_htrafo3d_p(
+        & rayWorldspace->point,
+        & world2local,
+        & RAY3D_POINT(localRay)
+        );
+
+    const double
+        xScale = _xRes / ( (double) _xMax - _xMin ) / ARVOLUMEMAJORANTGRID_CELL_SIZE,
+        yScale = _yRes / ( (double) _yMax - _yMin ) / ARVOLUMEMAJORANTGRID_CELL_SIZE,
+        zScale = _zRes / ( (double) _zMax - _zMin ) / ARVOLUMEMAJORANTGRID_CELL_SIZE,
+        offset = 0.5 / ARVOLUMEMAJORANTGRID_CELL_SIZE;
+
+    const Pnt3D  gridPoint =
+        PNT3D(
+            ( XC(localRay.point) - _xMin ) * xScale + offset,
+            ( YC(localRay.point) - _yMin ) * yScale + offset,
+            ( ZC(localRay.point) - _zMin ) * zScale + offset
+            );
+
+    const Vec3D  gridVector =
+        VEC3D(
+            XC(localRay.vector) * xScale,
+            YC(localRay.vector) * yScale,
+            ZC(localRay.vector) * zScale
+            );
+
+    arvolumemajorantiterator_init_grid(
+          iterator,
+        & majorantGrid,
+        & gridPoint,
+        & gridVector,
+          near,
+          far
+        );
+}
+
 /**
  * Checks if all the nodes are ArpTrafo3D
  * \param n number of nodes in attr array
@@ -655,12 +759,108 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnVolumeDataGrid)
     [ coder codeFloat: & _yMax ];
     [ coder codeFloat: & _zMax ];
     
-    arpcoder_arfloatarray(coder, &_data);
+    //   Only the active bricks are coded, along with the brick index
+    //   and the per-brick maxima.
+
+    if ( [ coder isReading ] )
+        arvoxelbrickgrid_init( & _data, _xRes, _yRes, _zRes, _nChannels );
+
+    //   Table sizes are overwritten with the archived ones when reading,
+    //   which have to match the grid they are read into.
+
+    const unsigned int  gridIndexSize =
+        _data.xBricks * _data.yBricks * _data.zBricks;
+
+    unsigned int  indexSize = gridIndexSize;
+
+    [ coder codeInt: & _data.numberOfBricks ];
+
+    if ( [ coder isReading ] && _data.numberOfBricks < 0 )
+        ART_ERRORHANDLING_FATAL_ERROR(
+            "invalid number of voxel bricks %d",
+            _data.numberOfBricks
+            );
+
+    if ( [ coder isReading ] && _data.numberOfBricks > 0 )
+    {
+        _data.allocatedBricks = _data.numberOfBricks;
+        _data.brickMax = ALLOC_ARRAY( float, _data.numberOfBricks );
+        _data.brickData =
+            ALLOC_ARRAY(
+                float,
+                (size_t) _data.numberOfBricks * ARVOXELBRICKGRID_BRICK_FLOATS(_data)
+                );
+    }
+
+    [ coder codeTableBegin: "brickindex" : & indexSize ];
+
+    if ( indexSize != gridIndexSize )
+        ART_ERRORHANDLING_FATAL_ERROR(
+            "voxel brick index has %u entries instead of %u",
+            indexSize,
+            gridIndexSize
+            );
+
+    for ( unsigned int i = 0; i < indexSize; i++ )
+    {
+        [ coder codeInt: & _data.brickIndex[i] ];
+
+        if (   [ coder isReading ]
+            && _data.brickIndex[i] != ARVOXELBRICKGRID_EMPTY_BRICK
+            && (   _data.brickIndex[i] < 0
+                || _data.brickIndex[i] >= _data.numberOfBricks ) )
+            ART_ERRORHANDLING_FATAL_ERROR(
+                "voxel brick index entry %d out of range",
+                _data.brickIndex[i]
+                );
+    }
+
+    [ coder codeTableEnd ];
+
+    const unsigned int  gridNumberOfBricks = _data.numberOfBricks;
+
+    unsigned int  numberOfBricks = gridNumberOfBricks;
+
+    [ coder codeTableBegin: "brickmax" : & numberOfBricks ];
+
+    if ( numberOfBricks != gridNumberOfBricks )
+        ART_ERRORHANDLING_FATAL_ERROR(
+            "voxel brick maxima table has %u entries instead of %u",
+            numberOfBricks,
+            gridNumberOfBricks
+            );
+
+    for ( int i = 0; i < _data.numberOfBricks; i++ )
+        [ coder codeFloat: & _data.brickMax[i] ];
+
+    [ coder codeTableEnd ];
+
+    const unsigned int  gridBrickFloats =
+        gridNumberOfBricks * ARVOXELBRICKGRID_BRICK_FLOATS(_data);
+
+    unsigned int  brickFloats = gridBrickFloats;
+
+    [ coder codeTableBegin: "brickdata" : & brickFloats ];
+
+    if ( brickFloats != gridBrickFloats )
+        ART_ERRORHANDLING_FATAL_ERROR(
+            "voxel brick data table has %u entries instead of %u",
+            brickFloats,
+            gridBrickFloats
+            );
+
+    for ( unsigned int i = 0; i < brickFloats; i++ )
+        [ coder codeFloat: & _data.brickData[i] ];
+
+    [ coder codeTableEnd ];
     
     [ coder codeFloat: & _max ];
     
     [ coder codeHTrafo3D: & world2local ];
     [ coder codeHTrafo3D: & local2world ];
+
+    if ( [ coder isReading ] )
+        [ self prepareMajorantGrid ];
 }
 
 @end
@@ -321,6 +321,30 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnMaxExponentialTrackingVolumeIntegrato
         );
 }
 
+- (void) _majorantIterator
+        : (      ArNode <ArpVolumeMaterial> *) volume
+        : (const Ray3D                      *) ray
+        : (      double                      ) mint
+        : (      double                      ) maxt
+        : (      ArVolumeMajorantIterator   *) majorants
+{
+    // Materials without local majorants get a single segment, for which
+    // the per-ray maximum is used as is.
+    if ( [ volume conformsToArProtocol: ARPROTOCOL(ArpVolumeMaterialMajorants) ] )
+    {
+        [ (ArNode <ArpVolumeMaterialMajorants> *) volume majorantIteratorForRay
+            :   ray
+            :   mint
+            :   maxt
+            :   majorants
+            ];
+    }
+    else
+    {
+        arvolumemajorantiterator_init_constant(majorants, 1.0, mint, maxt);
+    }
+}
+
 - (BOOL) _sampleDistanceTransmittanceHeterogeneous
         : (      ArNode <ArpVolumeMaterial>     *) volume
         : (const Ray3D                          *) ray
@@ -372,87 +396,134 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnMaxExponentialTrackingVolumeIntegrato
     mint = MAX(mint, 0);
     maxt = MIN(maxt, *distance);
     
-    double t = mint;
+    // The free flight distribution is memoryless, so sampling can be
+    // restarted at each boundary of the majorant segments, with the
+    // majorant of the next segment.
+    ArVolumeMajorantIterator majorants;
+    
+    [ self _majorantIterator
+        :   volume
+        :   ray
+        :   mint
+        :   maxt
+        : & majorants
+        ];
+    
+    double segmentStart, segmentEnd, majorantFactor;
+    BOOL done = NO;
     ArSequenceID  sequence_id = [ randomGenerator currentSequenceID ];
     
-    while ( mint < maxt )
+    while (   ! done
+           && arvolumemajorantiterator_next(
+                  & majorants,
+                  & segmentStart,
+                  & segmentEnd,
+                  & majorantFactor
+                  ) )
     {
-        // sample distance based on the hero wavelength
-        [ randomGenerator setCurrentSequenceID: sequence_id ];
-        const double rd = [ randomGenerator valueFromNewSequence ];
-        const double step = -log(1.0 - rd) / SPS_CI(inverseMeanFreePath, 0);
-        const double minStep = MIN(step, maxt - t);
-        
-        t += step;
+        // Empty segments are crossed without any collisions
+        if ( majorantFactor <= 0.0 || segmentEnd <= segmentStart ) continue;
         
-        ArSpectralSample stepTransmittance, stepProbability;
+        ARVOLUMETRACKING_COUNT(segment);
         
-        // stepTransmittance = exp(-step * mu_t_max)
-        sps_ds_mul_s(art_gv, minStep, &maxCrossSection, &stepTransmittance);
-        sps_negexp_s(art_gv, &stepTransmittance);
+        ArSpectralSample
+            localMaxCrossSection,
+            localInverseMeanFreePath,
+            localMinMeanFreePath;
         
-        // transmittanceSample *= stepTransmittance
-        sps_s_mul_s(art_gv, &stepTransmittance, transmittanceSample);
+        sps_ds_mul_s(art_gv, majorantFactor, &maxCrossSection, &localMaxCrossSection);
+        sps_ds_mul_s(art_gv, majorantFactor, &inverseMeanFreePath, &localInverseMeanFreePath);
+        sps_ds_mul_s(art_gv, 1.0 / majorantFactor, &minMeanFreePath, &localMinMeanFreePath);
         
-        // pdf *= exp(-step * mu_t_max)
-        sps_ds_mul_s(art_gv, minStep, &inverseMeanFreePath, &stepProbability);
-        sps_negexp_s(art_gv, &stepProbability);
-        sps_s_mul_s(art_gv, &stepProbability, &pdf);
+        double t = segmentStart;
         
-        if(t >= maxt) {
-            break;
-        } else {
-            // pdf *= inverseMeanFreePath
-            sps_s_mul_s(art_gv, &inverseMeanFreePath, &pdf);
+        while ( t < segmentEnd )
+        {
+            // sample distance based on the hero wavelength
+            [ randomGenerator setCurrentSequenceID: sequence_id ];
+            const double rd = [ randomGenerator valueFromNewSequence ];
+            const double step = -log(1.0 - rd) / SPS_CI(localInverseMeanFreePath, 0);
+            const double minStep = MIN(step, segmentEnd - t);
             
-            Pnt3D arrival;
-            pnt3d_dr_eval_p(t, ray, &arrival);
+            t += step;
             
-            ArSpectralSample
-                    arrivalCrossSection,
-                    arrivalMeanFreePath;
+            ArSpectralSample stepTransmittance, stepProbability;
             
-            [ self meanFreePath
-                :   volume
-                : & arrival
-                :   wavelength
-                :   pathDirection
-                : & arrivalCrossSection
-                : & arrivalMeanFreePath
-                ];
+            // stepTransmittance = exp(-step * mu_t_max)
+            sps_ds_mul_s(art_gv, minStep, &localMaxCrossSection, &stepTransmittance);
+            sps_negexp_s(art_gv, &stepTransmittance);
+            
+            // transmittanceSample *= stepTransmittance
+            sps_s_mul_s(art_gv, &stepTransmittance, transmittanceSample);
+            
+            // pdf *= exp(-step * mu_t_max)
+            sps_ds_mul_s(art_gv, minStep, &localInverseMeanFreePath, &stepProbability);
+            sps_negexp_s(art_gv, &stepProbability);
+            sps_s_mul_s(art_gv, &stepProbability, &pdf);
             
-            if ( allowTermination || distanceProbability )
-            {
-                [ randomGenerator setCurrentSequenceID: sequence_id ];
-                const double rejectionSample = [ randomGenerator valueFromNewSequence ];
+            if(t >= segmentEnd) {
+                break;
+            } else {
+                // pdf *= inverseMeanFreePath
+                sps_s_mul_s(art_gv, &localInverseMeanFreePath, &pdf);
+                
+                Pnt3D arrival;
+                pnt3d_dr_eval_p(t, ray, &arrival);
+                
+                ArSpectralSample
+                        arrivalCrossSection,
+                        arrivalMeanFreePath;
                 
-                ArSpectralSample ratio;
+                [ self meanFreePath
+                    :   volume
+                    : & arrival
+                    :   wavelength
+                    :   pathDirection
+                    : & arrivalCrossSection
+                    : & arrivalMeanFreePath
+                    ];
                 
-                sps_ss_div_s(
-                      art_gv,
-                    & arrivalMeanFreePath,
-                    & minMeanFreePath,
-                    & ratio
-                    );
-
-                if ( rejectionSample < SPS_CI(ratio, 0) )
+                if ( allowTermination || distanceProbability )
                 {
-                    *distance = t;
-                    arpdfvalue_s_mul_p(&ratio, distanceProbability);
-                    earlyEnd = YES;
-                    if (allowTermination) break;
+                    [ randomGenerator setCurrentSequenceID: sequence_id ];
+                    const double rejectionSample = [ randomGenerator valueFromNewSequence ];
+                    
+                    ArSpectralSample ratio;
+                    
+                    sps_ss_div_s(
+                          art_gv,
+                        & arrivalMeanFreePath,
+                        & localMinMeanFreePath,
+                        & ratio
+                        );
+
+                    if ( rejectionSample < SPS_CI(ratio, 0) )
+                    {
+                        ARVOLUMETRACKING_COUNT(real_collision);
+                        
+                        *distance = t;
+                        arpdfvalue_s_mul_p(&ratio, distanceProbability);
+                        earlyEnd = YES;
+                        if (allowTermination) { done = YES; break; }
+                    }
+                    else
+                    {
+                        ARVOLUMETRACKING_COUNT(null_collision);
+                        
+                        // *terminationProbability *= 1 - ratio
+                        sps_sd_sub_s(art_gv, &ratio, 1.0, & ratio);
+                        arpdfvalue_s_mul_p(&ratio, distanceProbability);
+                    }
                 }
                 else
                 {
-                    // *terminationProbability *= 1 - ratio
-                    sps_sd_sub_s(art_gv, &ratio, 1.0, & ratio);
-                    arpdfvalue_s_mul_p(&ratio, distanceProbability);
+                    ARVOLUMETRACKING_COUNT(null_collision);
                 }
+                
+                // transmittanceSample *= mu_t_max - mu_t;
+                sps_ss_sub_s(art_gv, &arrivalCrossSection, &localMaxCrossSection, &stepTransmittance);
+                sps_s_mul_s(art_gv, &stepTransmittance, transmittanceSample);
             }
-            
-            // transmittanceSample *= mu_t_max - mu_t;
-            sps_ss_sub_s(art_gv, &arrivalCrossSection, &maxCrossSection, &stepTransmittance);
-            sps_s_mul_s(art_gv, &stepTransmittance, transmittanceSample);
         }
     }
     
@@ -39,7 +39,7 @@ ART_MODULE_INTERFACE(ArnHeterogeneousVolumeMaterial)
 
 
 @interface ArnHeterogeneousVolumeMaterial
-        : ArnNoClosedFormVolumeMaterial
+        : ArnNoClosedFormVolumeMaterial < ArpVolumeMaterialMajorants >
 {
 @public
     double scale;
@@ -345,6 +345,34 @@ ARPCONCRETECLASS_DEFAULT_IMPLEMENTATION(ArnHeterogeneousVolumeMaterial)
             ];
 }
 
+- (void) majorantIteratorForRay
+        : (const Ray3D                     *) rayWorldspace
+        : (      double                     ) near
+        : (      double                     ) far
+        : (      ArVolumeMajorantIterator  *) iterator
+{
+    double maxDensity = 0;
+    [ DENSITY_VOLUMENODE max :&maxDensity ];
+    
+    if ( maxDensity <= 0.0 )
+    {
+        arvolumemajorantiterator_init_constant(iterator, 0.0, near, far);
+        return;
+    }
+    
+    [ DENSITY_VOLUMENODE majorantIterator
+        :   rayWorldspace
+        :   near
+        :   far
+        :   iterator
+        ];
+    
+    // Cross section and scattering coefficient are both linear in the
+    // density, so local density maxima relative to the global one scale
+    // the per-ray maxima directly.
+    iterator->scale = 1.0 / maxDensity;
+}
+
 - (BOOL) calculatePhaseFunctionSample
         : (      ArcRayEndpoint *)                incomingDirectionAndLocation
         : (      ArPathDirection)                 pathDirection
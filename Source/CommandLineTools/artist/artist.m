@@ -185,6 +185,28 @@ int artist(
             :   "only splat hero sample"
             ];
 
+    id skyCacheOpt =
+        [ FLAG_OPTION
+            :   "skyCache"
+            :   "sc"
+            :   "tabulate and interpolate sky model radiance"
+            ];
+
+    id skyCacheErrorOpt =
+        [ FLOAT_OPTION
+            :   "skyCacheError"
+            :   "sce"
+            :   "<rel. error>"
+            :   "sky cache, exact model where error is larger"
+            ];
+
+    id bspCacheOpt =
+        [ FLAG_OPTION
+            :   "bspCache"
+            :   "bc"
+            :   "keep BSP trees in a cache file next to the scene"
+            ];
+
     id cameraOpt =
         [ STRING_OPTION
             :   "camera"
@@ -244,6 +266,16 @@ int artist(
     if ( [ monoOpt hasBeenSpecified ] )
         art_set_hero_samples_to_splat( art_gv, 1 );
 
+    if (   [ skyCacheOpt hasBeenSpecified ]
+        || [ skyCacheErrorOpt hasBeenSpecified ] )
+        art_set_use_sky_radiance_cache( art_gv, YES );
+
+    if ( [ skyCacheErrorOpt hasBeenSpecified ] )
+        art_set_sky_radiance_cache_maximum_error(
+            art_gv,
+            [ skyCacheErrorOpt doubleValue ]
+            );
+
 // =============================   PHASE 4   =================================
 //
 //         Parsing the input files, and assembly of the scene graph.
@@ -255,6 +287,18 @@ int artist(
 
     const char  * mainInputFileName = argv[1];
 
+    if ( [ bspCacheOpt hasBeenSpecified ] )
+    {
+        char  * bspCacheFileName =
+            ALLOC_ARRAY( char, strlen( mainInputFileName ) + 10 );
+
+        sprintf( bspCacheFileName, "%s.bspcache", mainInputFileName );
+
+        art_set_bsp_tree_cache_file( art_gv, bspCacheFileName );
+
+        FREE_ARRAY( bspCacheFileName );
+    }
+
     //   Because the parsing processes may fork sub-processes that translate
     //   scene file components (e.g. ARM->ART), the normal ArcReporter action
     //   timing mechanisms that use elapsed user time for the calling process
@@ -856,11 +900,13 @@ int artist(
     else
     {
         // We need first to determine if a known extension is present
-        char * p_artraw = strstr(ART_APPLICATION_MAIN_FILENAME, ".artraw");
-        char * p_exr    = strstr(ART_APPLICATION_MAIN_FILENAME, ".exr");
+        char * p_artraw  = strstr(ART_APPLICATION_MAIN_FILENAME, ".artraw");
+        char * p_arttile = strstr(ART_APPLICATION_MAIN_FILENAME, ".arttile");
+        char * p_exr     = strstr(ART_APPLICATION_MAIN_FILENAME, ".exr");
         
-        if (   (p_artraw == NULL || strlen(p_artraw) != 7)
-            && (p_exr    == NULL || strlen(p_exr)    != 4))
+        if (   (p_artraw  == NULL || strlen(p_artraw)  != 7)
+            && (p_arttile == NULL || strlen(p_arttile) != 8)
+            && (p_exr     == NULL || strlen(p_exr)     != 4))
         {
             // We add artraw extension
             arstring_pe_copy_add_extension_p(
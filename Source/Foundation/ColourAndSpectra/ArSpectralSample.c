@@ -26,6 +26,11 @@
 
 #define ART_MODULE_NAME     ArSpectralSample
 
+//   This file provides the out-of-line definitions of the functions that
+//   ArSpectralSample.h otherwise redirects to the inline packet versions.
+
+#define ART_SPS_WITHOUT_PACKETS
+
 #include "ArSpectralSample.h"
 
 #include "SpectralDatatype_ImplementationMacros.h"
@@ -107,6 +107,155 @@ unsigned int arspectralsample_s_valid(
 #define sps_s_valid  arspectralsample_s_valid
 #define sps_c_valid  arspectralsample_s_valid
 
+/* ---------------------------------------------------------------------------
+    Hero sample packets
+
+        The four hero wavelengths of a spectral sample can be processed as
+        one 4-wide double vector (an 'ArSPSPacket'). With AVX enabled, each
+        packet operation is a single instruction, otherwise the compiler
+        emits two SSE2 instructions.
+
+        SPS_PACKET(s) accesses the Crd4 of a sample as such a packet. The
+        packet type only requires the alignment of a double, so
+        ArSpectralSample itself does not have to be aligned - it is
+        embedded in far too many malloc'd structs for that.
+
+        In builds without foundation assertions, the hot, lane-wise
+        arithmetic functions below are routed to static inline packet
+        versions. Function pointers and the out-of-line definitions in
+        ArSpectralSample.c are not affected by this, since only calls
+        of the form 'sps_xxx(...)' are redirected. #define
+        ART_SPS_WITHOUT_PACKETS to get the plain function calls back.
+--------------------------------------------------------------------------- */
+
+#if defined(__GNUC__) && ! defined(ART_SPS_WITHOUT_PACKETS)
+#define ART_SPS_WITH_PACKETS
+#endif
+
+#ifdef ART_SPS_WITH_PACKETS
+
+typedef double ArSPSPacket
+    __attribute__ ((
+        vector_size (4 * sizeof(double)),
+        aligned (sizeof(double)),
+        may_alias
+        ));
+
+#define SPS_PACKET(__sv)    (*(ArSPSPacket *) & SPS_C(__sv))
+
+static inline void sps_packet_sqrt_packet(
+        const ArSPSPacket  * p0,
+              ArSPSPacket  * pr
+        )
+{
+    for ( int i = 0; i < 4; i++ )
+        (*pr)[i] = sqrt( (*p0)[i] );
+}
+
+static inline void sps_packet_ds_mul_s(
+        const double              d0,
+        const ArSpectralSample  * s0,
+              ArSpectralSample  * sr
+        )
+{
+    SPS_PACKET(*sr) = d0 * SPS_PACKET(*s0);
+}
+
+static inline void sps_packet_d_mul_s(
+        const double              d0,
+              ArSpectralSample  * sr
+        )
+{
+    SPS_PACKET(*sr) *= d0;
+}
+
+static inline void sps_packet_s_mul_s(
+        const ArSpectralSample  * s0,
+              ArSpectralSample  * sr
+        )
+{
+    SPS_PACKET(*sr) *= SPS_PACKET(*s0);
+}
+
+static inline void sps_packet_ss_mul_s(
+        const ArSpectralSample  * s0,
+        const ArSpectralSample  * s1,
+              ArSpectralSample  * sr
+        )
+{
+    SPS_PACKET(*sr) = SPS_PACKET(*s0) * SPS_PACKET(*s1);
+}
+
+static inline void sps_packet_s_add_s(
+        const ArSpectralSample  * s0,
+              ArSpectralSample  * sr
+        )
+{
+    SPS_PACKET(*sr) += SPS_PACKET(*s0);
+}
+
+static inline void sps_packet_ss_add_s(
+        const ArSpectralSample  * s0,
+        const ArSpectralSample  * s1,
+              ArSpectralSample  * sr
+        )
+{
+    SPS_PACKET(*sr) = SPS_PACKET(*s0) + SPS_PACKET(*s1);
+}
+
+static inline void sps_packet_s_sub_s(
+        const ArSpectralSample  * s0,
+              ArSpectralSample  * sr
+        )
+{
+    SPS_PACKET(*sr) -= SPS_PACKET(*s0);
+}
+
+//   Note the operand order: sr = s1 - s0, as in c4_cc_sub_c
+
+static inline void sps_packet_ss_sub_s(
+        const ArSpectralSample  * s0,
+        const ArSpectralSample  * s1,
+              ArSpectralSample  * sr
+        )
+{
+    SPS_PACKET(*sr) = SPS_PACKET(*s1) - SPS_PACKET(*s0);
+}
+
+static inline void sps_packet_ds_mul_add_s(
+        const double              d0,
+        const ArSpectralSample  * s0,
+              ArSpectralSample  * sr
+        )
+{
+    SPS_PACKET(*sr) += d0 * SPS_PACKET(*s0);
+}
+
+#ifndef FOUNDATION_ASSERTIONS
+
+#define sps_ds_mul_s(__gv,__d0,__s0,__sr) \
+    ((void)(__gv), sps_packet_ds_mul_s((__d0),(__s0),(__sr)))
+#define sps_d_mul_s(__gv,__d0,__sr) \
+    ((void)(__gv), sps_packet_d_mul_s((__d0),(__sr)))
+#define sps_s_mul_s(__gv,__s0,__sr) \
+    ((void)(__gv), sps_packet_s_mul_s((__s0),(__sr)))
+#define sps_ss_mul_s(__gv,__s0,__s1,__sr) \
+    ((void)(__gv), sps_packet_ss_mul_s((__s0),(__s1),(__sr)))
+#define sps_s_add_s(__gv,__s0,__sr) \
+    ((void)(__gv), sps_packet_s_add_s((__s0),(__sr)))
+#define sps_ss_add_s(__gv,__s0,__s1,__sr) \
+    ((void)(__gv), sps_packet_ss_add_s((__s0),(__s1),(__sr)))
+#define sps_s_sub_s(__gv,__s0,__sr) \
+    ((void)(__gv), sps_packet_s_sub_s((__s0),(__sr)))
+#define sps_ss_sub_s(__gv,__s0,__s1,__sr) \
+    ((void)(__gv), sps_packet_ss_sub_s((__s0),(__s1),(__sr)))
+#define sps_ds_mul_add_s(__gv,__d0,__s0,__sr) \
+    ((void)(__gv), sps_packet_ds_mul_add_s((__d0),(__s0),(__sr)))
+
+#endif // ! FOUNDATION_ASSERTIONS
+
+#endif // ART_SPS_WITH_PACKETS
+
 //  The following data is needed during the generation of every HWSS spectral
 //  wavelength set. So it pays to have it around pre-computed in a single
 //  struct.
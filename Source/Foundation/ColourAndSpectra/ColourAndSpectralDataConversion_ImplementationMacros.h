@@ -276,13 +276,9 @@ void s##_n##_to_xyz( \
     CC_START_DEBUGPRINTF( s##_n##_to_xyz ) \
     CC_OPERAND_DEBUGPRINTF( s##_n, s_0 ) \
     const ArSpectrum##_n ** primary = s##_n##_ciexyz_primary(art_gv); \
-    ArSpectrum##_n  temp; \
-    s##_n##_ss_mul_s( art_gv,s_0, primary[0], & temp ); \
-    ARCIEXYZ_X(*xyz_r) = s##_n##_s_sum( art_gv, & temp ); \
-    s##_n##_ss_mul_s( art_gv,s_0, primary[1], & temp ); \
-    ARCIEXYZ_Y(*xyz_r) = s##_n##_s_sum( art_gv, & temp ); \
-    s##_n##_ss_mul_s( art_gv,s_0, primary[2], & temp ); \
-    ARCIEXYZ_Z(*xyz_r) = s##_n##_s_sum( art_gv, & temp ); \
+    ARCIEXYZ_X(*xyz_r) = c##_n##_cc_dot( & s_0->c, & primary[0]->c ); \
+    ARCIEXYZ_Y(*xyz_r) = c##_n##_cc_dot( & s_0->c, & primary[1]->c ); \
+    ARCIEXYZ_Z(*xyz_r) = c##_n##_cc_dot( & s_0->c, & primary[2]->c ); \
     CC_OPERAND_DEBUGPRINTF( xyz, xyz_r ) \
     CC_END_DEBUGPRINTF( s##_n##_to_xyz ) \
 }
@@ -807,6 +807,11 @@ double _typeShort##_##_vtype##_sum( \
     (void) art_gv; \
 \
     ASSERT_VALID_SPECTRUMTYPE( _typeShort, _Type,  c0, _vtype ) \
+\
+    /* Hero samples may use fewer channels than their Crd holds */ \
+\
+    if ( _ISR_CHANNELS == sizeof(_ISR_C(*c0)) / sizeof(_ISR_CI(*c0,0)) ) \
+        return _ctype##_c_sum( & _ISR_C(*c0) ); \
 \
     double  sum = 0.0; \
  \
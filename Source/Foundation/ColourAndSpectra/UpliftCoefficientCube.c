@@ -280,23 +280,22 @@ void ucc_alloc_and_read_from_file(
     fclose(inputFile);
 }
 
-void ucc_rgb_to_sps(
-              ART_GV            * art_gv,
-        const UCC               * ucc,
-        const ArRGB             * rgb,
-        const ArWavelength      * wl,
-              ArSpectralSample  * sps
+//   Finds the lattice cell that contains the given RGB value: the indices
+//   of its eight corners, and the position of the RGB value within the cell.
+
+static void _ucc_rgb_to_lattice_cell(
+        const UCC    * ucc,
+        const ArRGB  * rgb,
+              int    * ci,
+              Vec3D  * d
         )
 {
-//printf("RGB: %f %f %f \n", XC(*rgb)*255, YC(*rgb)*255, ZC(*rgb)*255);
     IPnt3D  bc;
     
     XC(bc) = M_MIN(UCC_F_TO_I( ucc, XC(*rgb) ), UCC_DIMENSION(ucc) - 2. );
     YC(bc) = M_MIN(UCC_F_TO_I( ucc, YC(*rgb) ), UCC_DIMENSION(ucc) - 2. );
     ZC(bc) = M_MIN(UCC_F_TO_I( ucc, ZC(*rgb) ), UCC_DIMENSION(ucc) - 2. );
 
-    int  ci[8];
-
     ci[0] = UCC_XYZ_TO_I( ucc, XC(bc)    , YC(bc)    , ZC(bc)     ); //000
     ci[1] = UCC_XYZ_TO_I( ucc, XC(bc)    , YC(bc)    , ZC(bc) + 1 ); //001
     ci[2] = UCC_XYZ_TO_I( ucc, XC(bc)    , YC(bc) + 1, ZC(bc)     ); //010
@@ -306,14 +305,68 @@ void ucc_rgb_to_sps(
     ci[6] = UCC_XYZ_TO_I( ucc, XC(bc) + 1, YC(bc) + 1, ZC(bc)     ); //110
     ci[7] = UCC_XYZ_TO_I( ucc, XC(bc) + 1, YC(bc) + 1, ZC(bc) + 1 ); //111
 
+    XC(*d) =   ( XC(*rgb) - XC( UCC_ENTRY_RGB( ucc, ci[0] ) ) )
+             * UCC_INV_LATTICE_SPACING(ucc);
+    YC(*d) =   ( YC(*rgb) - YC( UCC_ENTRY_RGB( ucc, ci[0] ) ) )
+             * UCC_INV_LATTICE_SPACING(ucc);
+    ZC(*d) =   ( ZC(*rgb) - ZC( UCC_ENTRY_RGB( ucc, ci[0] ) ) )
+             * UCC_INV_LATTICE_SPACING(ucc);
+}
+
+void ucc_rgb_to_coefficients(
+        const UCC    * ucc,
+        const ArRGB  * rgb,
+              FCrd3  * c
+        )
+{
+    int    ci[8];
+    Vec3D  d;
+
+    _ucc_rgb_to_lattice_cell( ucc, rgb, ci, & d );
+
+    Crd3  c00, c01, c10, c11;
+
+    c3_dcc_interpol_c( XC(d), & UCC_ENTRY_C(ucc, ci[0]), & UCC_ENTRY_C(ucc, ci[4]), & c00 );
+    c3_dcc_interpol_c( XC(d), & UCC_ENTRY_C(ucc, ci[1]), & UCC_ENTRY_C(ucc, ci[5]), & c01 );
+    c3_dcc_interpol_c( XC(d), & UCC_ENTRY_C(ucc, ci[2]), & UCC_ENTRY_C(ucc, ci[6]), & c10 );
+    c3_dcc_interpol_c( XC(d), & UCC_ENTRY_C(ucc, ci[3]), & UCC_ENTRY_C(ucc, ci[7]), & c11 );
+
+    Crd3  c0, c1, cr;
+
+    c3_dcc_interpol_c( YC(d), & c00, & c10, & c0 );
+    c3_dcc_interpol_c( YC(d), & c01, & c11, & c1 );
+
+    c3_dcc_interpol_c( ZC(d), & c0, & c1, & cr );
+
+    FC3_0(*c) = C3_0(cr);
+    FC3_1(*c) = C3_1(cr);
+    FC3_2(*c) = C3_2(cr);
+}
+
+void ucc_coefficients_to_sps(
+              ART_GV            * art_gv,
+        const FCrd3             * c,
+        const ArWavelength      * wl,
+              ArSpectralSample  * sps
+        )
+{
+    Crd3  cd = CRD3( FC3_0(*c), FC3_1(*c), FC3_2(*c) );
+
+    sps_sigmoid_sample( art_gv, wl, & cd, sps );
+}
+
+void ucc_rgb_to_sps(
+              ART_GV            * art_gv,
+        const UCC               * ucc,
+        const ArRGB             * rgb,
+        const ArWavelength      * wl,
+              ArSpectralSample  * sps
+        )
+{
+    int    ci[8];
     Vec3D  d;
 
-    XC(d) =   ( XC(*rgb) - XC( UCC_ENTRY_RGB( ucc, ci[0] ) ) )
-            * UCC_INV_LATTICE_SPACING(ucc);
-    YC(d) =   ( YC(*rgb) - YC( UCC_ENTRY_RGB( ucc, ci[0] ) ) )
-            * UCC_INV_LATTICE_SPACING(ucc);
-    ZC(d) =   ( ZC(*rgb) - ZC( UCC_ENTRY_RGB( ucc, ci[0] ) ) )
-            * UCC_INV_LATTICE_SPACING(ucc);
+    _ucc_rgb_to_lattice_cell( ucc, rgb, ci, & d );
 
     ArSpectralSample  sv[8];
     
@@ -73,6 +73,36 @@ void ucc_rgb_to_sps(
               ArSpectralSample  * sps
         );
 
+/*
+    For a given input RGB value, return the interpolated sigmoid
+    coefficients. Together with 'ucc_coefficients_to_sps', this lets
+    callers that look up the same RGB values over and over again - such as
+    image textures - do the uplift once, and only evaluate the sigmoid per
+    sample later on.
+
+    Note that this interpolates the coefficients, and not the resulting
+    sigmoid values as 'ucc_rgb_to_sps' does. Both agree exactly at the
+    lattice points; in between, the two differ slightly.
+*/
+
+void ucc_rgb_to_coefficients(
+        const UCC    * ucc,
+        const ArRGB  * rgb,
+              FCrd3  * c
+        );
+
+/*
+    Evaluates the sigmoid spectrum given by a set of coefficients at the
+    wavelengths of a hero sample.
+*/
+
+void ucc_coefficients_to_sps(
+              ART_GV            * art_gv,
+        const FCrd3             * c,
+        const ArWavelength      * wl,
+              ArSpectralSample  * sps
+        );
+
 /*
     Returns the system-wide default sRGB UCC. Do NOT call this in the inner
     loop of anything: instead, grab this pointer when you load a texture,
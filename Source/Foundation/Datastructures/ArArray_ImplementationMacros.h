@@ -254,6 +254,10 @@ Ar##_Type##Array ar##_type##array_copy_by_reference( \
     Ar##_Type##Array  clone; \
     \
     _ARARRAY_CONTENT(clone) = _ARARRAY_CONTENT(*original); \
+    \
+    if ( ! _ARARRAY_CONTENT(clone) ) \
+        return clone; \
+    \
     _ARARRAY_CONTENT_REFERENCES(clone)++;\
     if (    _ARARRAY_CONTENT_REFERENCES(clone) \
          != _ARARRAY_CONTENT_REFERENCES(*original) ) \
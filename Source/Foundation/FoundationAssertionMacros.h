@@ -29,6 +29,11 @@
 
 //#define WITH_RSA_STATISTICS
 
+//   Counts majorant segments and collisions of the volume tracking
+//   integrators; Gallery/Fluorescence/VolumeTracking.sh benchmarks them.
+
+//#define ART_WITH_VOLUME_TRACKING_STATISTICS
+
 /* ---------------------------------------------------------------------------
 
     Light and Attenuation assertion macros
@@ -71,6 +71,7 @@ ART_LIBRARY_INTERFACE(ART_Foundation_Geometry)
 
 #include "Triangle2D.h"
 #include "Triangle3D.h"
+#include "Triangle3DPacket.h"
 
 #include "Quadrangle3D.h"
 
@@ -0,0 +1,145 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+
+#include "Triangle3DPacket.h"
+
+void triangle3dpacket_init_empty(
+        Triangle3DPacket  * packet
+        )
+{
+    for ( unsigned int j = 0; j < 3; j++ )
+    {
+        for ( unsigned int i = 0; i < TRIANGLE3D_PACKET_WIDTH; i++ )
+        {
+            packet->p0[j][i] = 0.0;
+            packet->e1[j][i] = 0.0;
+            packet->e2[j][i] = 0.0;
+        }
+    }
+}
+
+void triangle3dpacket_set_lane(
+              Triangle3DPacket  * packet,
+        const unsigned int        lane,
+        const Pnt3D             * p0,
+        const Pnt3D             * p1,
+        const Pnt3D             * p2
+        )
+{
+    for ( unsigned int j = 0; j < 3; j++ )
+    {
+        packet->p0[j][lane] = PNT3D_I(*p0,j);
+        packet->e1[j][lane] = PNT3D_I(*p1,j) - PNT3D_I(*p0,j);
+        packet->e2[j][lane] = PNT3D_I(*p2,j) - PNT3D_I(*p0,j);
+    }
+}
+
+//   Moeller-Trumbore test, done for all lanes in lockstep. Degenerate
+//   triangles and rays that are parallel to a triangle yield det == 0,
+//   and the resulting infinities / NaNs are masked out by the final
+//   comparison, so no lane ever needs to leave the loop early.
+
+unsigned int triangle3dpacket_hit(
+        const Triangle3DPacket      * packet,
+        const Ray3D                 * in_ray,
+        const Range                 * in_range,
+              Triangle3DPacketHits  * out_hits
+        )
+{
+    const double  ox = RAY3D_PX(*in_ray);
+    const double  oy = RAY3D_PY(*in_ray);
+    const double  oz = RAY3D_PZ(*in_ray);
+
+    const double  dx = XC(RAY3D_V(*in_ray));
+    const double  dy = YC(RAY3D_V(*in_ray));
+    const double  dz = ZC(RAY3D_V(*in_ray));
+
+    const double  t_min = RANGE_MIN(*in_range);
+    const double  t_max = RANGE_MAX(*in_range);
+
+    int  hit[TRIANGLE3D_PACKET_WIDTH];
+
+    for ( unsigned int i = 0; i < TRIANGLE3D_PACKET_WIDTH; i++ )
+    {
+        const double  e1x = packet->e1[0][i];
+        const double  e1y = packet->e1[1][i];
+        const double  e1z = packet->e1[2][i];
+
+        const double  e2x = packet->e2[0][i];
+        const double  e2y = packet->e2[1][i];
+        const double  e2z = packet->e2[2][i];
+
+        //   p = d x e2
+
+        const double  px = dy * e2z - dz * e2y;
+        const double  py = dz * e2x - dx * e2z;
+        const double  pz = dx * e2y - dy * e2x;
+
+        //   det = e1 . p, which is - (d . (e1 x e2)); a negative
+        //   determinant therefore means that the ray hits the back side.
+
+        const double  det = e1x * px + e1y * py + e1z * pz;
+        const double  inv_det = 1.0 / det;
+
+        const double  sx = ox - packet->p0[0][i];
+        const double  sy = oy - packet->p0[1][i];
+        const double  sz = oz - packet->p0[2][i];
+
+        const double  u = ( sx * px + sy * py + sz * pz ) * inv_det;
+
+        //   q = s x e1
+
+        const double  qx = sy * e1z - sz * e1y;
+        const double  qy = sz * e1x - sx * e1z;
+        const double  qz = sx * e1y - sy * e1x;
+
+        const double  v = ( dx * qx + dy * qy + dz * qz ) * inv_det;
+        const double  t = ( e2x * qx + e2y * qy + e2z * qz ) * inv_det;
+
+        out_hits->t[i]   = t;
+        out_hits->u[i]   = u;
+        out_hits->v[i]   = v;
+        out_hits->det[i] = det;
+
+        hit[i] =
+              ( det != 0.0 )
+            & ( u >= 0.0 )
+            & ( v >= 0.0 )
+            & ( u + v <= 1.0 )
+            & ( t >= t_min )
+            & ( t < t_max );
+    }
+
+    unsigned int  mask = 0;
+
+    for ( unsigned int i = 0; i < TRIANGLE3D_PACKET_WIDTH; i++ )
+        mask |= ( (unsigned int) hit[i] ) << i;
+
+    return mask;
+}
+
+/* ======================================================================== */
@@ -0,0 +1,115 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+
+#ifndef _ART_FOUNDATION_GEOMETRY_TRIANGLE3DPACKET_H_
+#define _ART_FOUNDATION_GEOMETRY_TRIANGLE3DPACKET_H_
+
+#include "ART_Foundation_Math.h"
+
+#include "Ray3D.h"
+
+/* ===========================================================================
+    'Triangle3DPacket'
+        A fixed number of triangles, stored in structure-of-arrays form so
+        that one ray can be tested against all of them in a single pass.
+        Each triangle is held as its first vertex plus the two edge vectors
+        leading from there to the second and third vertex. Lanes that are
+        not in use contain a degenerate triangle, which is never hit.
+
+        The intersection loop deliberately contains no branches, so that
+        the compiler can vectorise it for whatever SIMD unit the target
+        has; widening the packet to 8 lanes only requires changing
+        TRIANGLE3D_PACKET_WIDTH.
+=========================================================================== */
+
+#define TRIANGLE3D_PACKET_WIDTH     4
+
+typedef struct Triangle3DPacket
+{
+    double  p0[3][TRIANGLE3D_PACKET_WIDTH];
+    double  e1[3][TRIANGLE3D_PACKET_WIDTH];
+    double  e2[3][TRIANGLE3D_PACKET_WIDTH];
+}
+Triangle3DPacket;
+
+/* ---------------------------------------------------------------------------
+    'Triangle3DPacketHits'
+        Per-lane results of a packet intersection. 'u' and 'v' are the
+        barycentric coordinates with respect to p1 and p2 (same convention
+        as 'out_crd' of 'triangledata_hit'), and 'det' is negative if the
+        ray hits the back side of the triangle.
+--------------------------------------------------------------------------- */
+
+typedef struct Triangle3DPacketHits
+{
+    double  t[TRIANGLE3D_PACKET_WIDTH];
+    double  u[TRIANGLE3D_PACKET_WIDTH];
+    double  v[TRIANGLE3D_PACKET_WIDTH];
+    double  det[TRIANGLE3D_PACKET_WIDTH];
+}
+Triangle3DPacketHits;
+
+/* ---------------------------------------------------------------------------
+    'triangle3dpacket_init_empty'
+        Fills all lanes of the packet with degenerate triangles.
+--------------------------------------------------------------------------- */
+
+void triangle3dpacket_init_empty(
+        Triangle3DPacket  * packet
+        );
+
+/* ---------------------------------------------------------------------------
+    'triangle3dpacket_set_lane'
+        Stores the triangle (p0,p1,p2) in the given lane of the packet.
+--------------------------------------------------------------------------- */
+
+void triangle3dpacket_set_lane(
+              Triangle3DPacket  * packet,
+        const unsigned int        lane,
+        const Pnt3D             * p0,
+        const Pnt3D             * p1,
+        const Pnt3D             * p2
+        );
+
+/* ---------------------------------------------------------------------------
+    'triangle3dpacket_hit'
+        Intersects the ray with all triangles in the packet, and returns a
+        bit mask that has bit i set if lane i is hit within the one sided
+        interval [in_range.min, in_range.max). The results for all lanes
+        are written to 'out_hits', but are only meaningful for lanes that
+        are flagged in the returned mask.
+--------------------------------------------------------------------------- */
+
+unsigned int triangle3dpacket_hit(
+        const Triangle3DPacket      * packet,
+        const Ray3D                 * in_ray,
+        const Range                 * in_range,
+              Triangle3DPacketHits  * out_hits
+        );
+
+#endif /* _ART_FOUNDATION_GEOMETRY_TRIANGLE3DPACKET_H_ */
+/* ======================================================================== */
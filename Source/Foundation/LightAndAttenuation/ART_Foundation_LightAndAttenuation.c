@@ -70,6 +70,7 @@ ART_LIBRARY_INITIALISATION_FUNCTION
  
     ART_PERFORM_MODULE_INITIALISATION( ArLightAlpha )
     ART_PERFORM_MODULE_INITIALISATION( ArLightAlphaSample )
+    ART_PERFORM_MODULE_INITIALISATION( ArLightAlphaFramebuffer )
  
     ART_PERFORM_MODULE_INITIALISATION( ArPlainDirectAttenuation )
     ART_PERFORM_MODULE_INITIALISATION( ArPlainDirectAttenuationSample )
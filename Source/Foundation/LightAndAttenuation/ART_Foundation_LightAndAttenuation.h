@@ -58,6 +58,7 @@ ART_LIBRARY_INTERFACE(ART_Foundation_LightAndAttenuation)
 
 #include "ArLightAlpha.h"
 #include "ArLightAlphaSample.h"
+#include "ArLightAlphaFramebuffer.h"
 
 #include "ArPlainDirectAttenuation.h"
 #include "ArPlainDirectAttenuationSample.h"
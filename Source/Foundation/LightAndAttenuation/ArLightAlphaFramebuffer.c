@@ -0,0 +1,250 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+
+#define ART_MODULE_NAME     ArLightAlphaFramebuffer
+
+#include "ArLightAlphaFramebuffer.h"
+
+#include "_ArLight_GV.h"
+#include "FoundationAssertionMacros.h"
+
+ART_NO_MODULE_INITIALISATION_FUNCTION_NECESSARY
+
+ART_NO_MODULE_SHUTDOWN_FUNCTION_NECESSARY
+
+
+void arlightalphaframebuffer_init(
+        const ART_GV                   * art_gv,
+              ArLightAlphaFramebuffer  * framebuffer,
+        const unsigned long              numberOfPixels
+        )
+{
+    *framebuffer = ARLIGHTALPHAFRAMEBUFFER_EMPTY;
+
+    framebuffer->numberOfPixels = numberOfPixels;
+
+    if ( numberOfPixels == 0 )
+        return;
+
+    framebuffer->pixel = ALLOC_ARRAY( ArLightAlpha *, numberOfPixels );
+    framebuffer->lightAlpha = ALLOC_ARRAY( ArLightAlpha, numberOfPixels );
+    framebuffer->light = ALLOC_ARRAY( ArLight, numberOfPixels );
+
+#ifndef FOUNDATION_ASSERTIONS
+    if ( ! LIGHT_SUBSYSTEM_IS_IN_POLARISATION_MODE )
+    {
+        //   Plain light is an ArSpectrum, and the ISR struct it points
+        //   to is nothing but a Crd of 'channels' doubles.
+
+        framebuffer->channels = spc_channels( art_gv );
+
+        framebuffer->spectrum = ALLOC_ARRAY( ArSpectrum, numberOfPixels );
+        framebuffer->values =
+            ALLOC_ARRAY( double, numberOfPixels * framebuffer->channels );
+
+        memset(
+            framebuffer->values,
+            0,
+            numberOfPixels * framebuffer->channels * sizeof(double)
+            );
+    }
+#endif
+
+    for ( unsigned long i = 0; i < numberOfPixels; i++ )
+    {
+        ArLightAlpha  * lightAlpha = & framebuffer->lightAlpha[i];
+
+        lightAlpha->light = & framebuffer->light[i];
+        lightAlpha->light->next = 0;
+        lightAlpha->alpha = 1.0;
+
+        if ( ARLIGHTALPHAFRAMEBUFFER_IS_CONTIGUOUS(*framebuffer) )
+        {
+            ArSpectrum  * spectrum = & framebuffer->spectrum[i];
+
+            spectrum->next = 0;
+            spectrum->value =
+                framebuffer->values + i * framebuffer->channels;
+
+            lightAlpha->light->value = spectrum;
+        }
+        else
+        {
+            lightAlpha->light->value =
+                art_gv->arlight_gv->_alf_d_alloc_init_unpolarised(
+                    art_gv,
+                    0.0
+                    );
+        }
+
+        framebuffer->pixel[i] = lightAlpha;
+    }
+}
+
+void arlightalphaframebuffer_free_contents(
+        const ART_GV                   * art_gv,
+              ArLightAlphaFramebuffer  * framebuffer
+        )
+{
+    if ( ! ARLIGHTALPHAFRAMEBUFFER_IS_CONTIGUOUS(*framebuffer) )
+    {
+        for ( unsigned long i = 0; i < framebuffer->numberOfPixels; i++ )
+            art_gv->arlight_gv->_alf_free(
+                art_gv,
+                framebuffer->light[i].value
+                );
+    }
+
+    if ( framebuffer->pixel )
+        FREE_ARRAY( framebuffer->pixel );
+    if ( framebuffer->lightAlpha )
+        FREE_ARRAY( framebuffer->lightAlpha );
+    if ( framebuffer->light )
+        FREE_ARRAY( framebuffer->light );
+    if ( framebuffer->spectrum )
+        FREE_ARRAY( framebuffer->spectrum );
+    if ( framebuffer->values )
+        FREE_ARRAY( framebuffer->values );
+
+    *framebuffer = ARLIGHTALPHAFRAMEBUFFER_EMPTY;
+}
+
+void arlightalphaframebuffer_clear(
+        const ART_GV                   * art_gv,
+              ArLightAlphaFramebuffer  * framebuffer,
+        const unsigned long              start,
+        const unsigned long              count
+        )
+{
+    if ( ARLIGHTALPHAFRAMEBUFFER_IS_CONTIGUOUS(*framebuffer) )
+    {
+        memset(
+            framebuffer->values + start * framebuffer->channels,
+            0,
+            count * framebuffer->channels * sizeof(double)
+            );
+
+        for ( unsigned long i = start; i < start + count; i++ )
+            framebuffer->lightAlpha[i].alpha = 0.0;
+    }
+    else
+    {
+        for ( unsigned long i = start; i < start + count; i++ )
+            arlightalpha_l_init_l(
+                art_gv,
+                ARLIGHTALPHA_NONE_A0,
+                framebuffer->pixel[i]
+                );
+    }
+}
+
+void arlightalphaframebuffer_add(
+        const ART_GV                   * art_gv,
+        const ArLightAlphaFramebuffer  * src,
+        const unsigned long              srcStart,
+              ArLightAlphaFramebuffer  * dst,
+        const unsigned long              dstStart,
+        const unsigned long              count
+        )
+{
+    if (   ARLIGHTALPHAFRAMEBUFFER_IS_CONTIGUOUS(*src)
+        && ARLIGHTALPHAFRAMEBUFFER_IS_CONTIGUOUS(*dst) )
+    {
+        const unsigned long  n = count * src->channels;
+
+        const double  * s = src->values + srcStart * src->channels;
+              double  * d = dst->values + dstStart * dst->channels;
+
+        for ( unsigned long i = 0; i < n; i++ )
+            d[i] += s[i];
+
+        for ( unsigned long i = 0; i < count; i++ )
+            dst->lightAlpha[dstStart + i].alpha +=
+                src->lightAlpha[srcStart + i].alpha;
+    }
+    else
+    {
+        for ( unsigned long i = 0; i < count; i++ )
+            arlightalpha_l_add_l(
+                art_gv,
+                src->pixel[srcStart + i],
+                dst->pixel[dstStart + i]
+                );
+    }
+}
+
+void arlightalphaframebuffer_div_samples(
+        const ART_GV                   * art_gv,
+        const ArLightAlphaFramebuffer  * src,
+        const unsigned long              srcStart,
+        const double                   * sampleCount,
+              ArLightAlphaFramebuffer  * dst,
+        const unsigned long              dstStart,
+        const unsigned long              count
+        )
+{
+    if (   ARLIGHTALPHAFRAMEBUFFER_IS_CONTIGUOUS(*src)
+        && ARLIGHTALPHAFRAMEBUFFER_IS_CONTIGUOUS(*dst) )
+    {
+        const unsigned int  channels = src->channels;
+
+        for ( unsigned long i = 0; i < count; i++ )
+        {
+            const double  factor =
+                sampleCount[i] > 0.0 ? 1.0 / sampleCount[i] : 1.0;
+
+            const double  * s = src->values + ( srcStart + i ) * channels;
+                  double  * d = dst->values + ( dstStart + i ) * channels;
+
+            for ( unsigned int c = 0; c < channels; c++ )
+                d[c] = factor * s[c];
+
+            dst->lightAlpha[dstStart + i].alpha =
+                factor * src->lightAlpha[srcStart + i].alpha;
+        }
+    }
+    else
+    {
+        for ( unsigned long i = 0; i < count; i++ )
+        {
+            arlightalpha_l_init_l(
+                art_gv,
+                src->pixel[srcStart + i],
+                dst->pixel[dstStart + i]
+                );
+
+            if ( sampleCount[i] > 0.0 )
+                arlightalpha_d_mul_l(
+                    art_gv,
+                    1.0 / sampleCount[i],
+                    dst->pixel[dstStart + i]
+                    );
+        }
+    }
+}
+
+// ===========================================================================
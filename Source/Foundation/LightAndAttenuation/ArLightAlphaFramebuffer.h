@@ -0,0 +1,128 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+
+#ifndef _ART_FOUNDATION_LIGHTANDATTENUATION_ARLIGHTALPHAFRAMEBUFFER_H_
+#define _ART_FOUNDATION_LIGHTANDATTENUATION_ARLIGHTALPHAFRAMEBUFFER_H_
+
+#include "ART_Foundation_System.h"
+
+ART_MODULE_INTERFACE(ArLightAlphaFramebuffer)
+
+#include "ArLightAlpha.h"
+
+/* ---------------------------------------------------------------------------
+
+    'ArLightAlphaFramebuffer' struct
+
+    Storage for a whole image (or tile) worth of ArLightAlpha values.
+
+    The 'pixel' table provides the usual one-ArLightAlpha-pointer-per-pixel
+    view, so all the existing arlightalpha_xxx() functions can be used on
+    individual pixels. Behind that view, the ArLightAlpha, ArLight and
+    ArSpectrum structs of all pixels live in one array each, instead of
+    being allocated one by one.
+
+    For plain (i.e. non-polarisable) light, the spectral values of all
+    pixels are also kept in one contiguous block, 'channels' doubles per
+    pixel. The bulk operations below then just stream through that block.
+    This is not possible for polarisable light (the Stokes vectors come
+    with reference frames), or for builds with foundation assertions (the
+    ISR structs carry extra assertion data). In these cases, 'channels' is
+    zero, the light values of the pixels are allocated individually, and
+    the bulk operations fall back to one arlightalpha_xxx() call per pixel.
+
+------------------------------------------------------------------------- */
+
+typedef struct ArLightAlphaFramebuffer
+{
+    unsigned long     numberOfPixels;
+    unsigned int      channels;
+
+    ArLightAlpha   ** pixel;
+
+    ArLightAlpha    * lightAlpha;
+    ArLight         * light;
+    ArSpectrum      * spectrum;
+    double          * values;
+}
+ArLightAlphaFramebuffer;
+
+#define ARLIGHTALPHAFRAMEBUFFER_EMPTY \
+    ((ArLightAlphaFramebuffer){ 0, 0, NULL, NULL, NULL, NULL, NULL })
+
+#define ARLIGHTALPHAFRAMEBUFFER_IS_CONTIGUOUS(__fb)    ((__fb).channels > 0)
+
+//   All pixels are set to unpolarised zero light with alpha 1, just as
+//   arlightalpha_d_alloc_init_unpolarised( art_gv, 0.0 ) would do.
+
+void arlightalphaframebuffer_init(
+        const ART_GV                   * art_gv,
+              ArLightAlphaFramebuffer  * framebuffer,
+        const unsigned long              numberOfPixels
+        );
+
+void arlightalphaframebuffer_free_contents(
+        const ART_GV                   * art_gv,
+              ArLightAlphaFramebuffer  * framebuffer
+        );
+
+//   Sets 'count' pixels from 'start' onwards to zero light with alpha 0,
+//   i.e. to ARLIGHTALPHA_NONE_A0.
+
+void arlightalphaframebuffer_clear(
+        const ART_GV                   * art_gv,
+              ArLightAlphaFramebuffer  * framebuffer,
+        const unsigned long              start,
+        const unsigned long              count
+        );
+
+//   dst[dstStart+i] += src[srcStart+i] for 'count' pixels, light and alpha
+
+void arlightalphaframebuffer_add(
+        const ART_GV                   * art_gv,
+        const ArLightAlphaFramebuffer  * src,
+        const unsigned long              srcStart,
+              ArLightAlphaFramebuffer  * dst,
+        const unsigned long              dstStart,
+        const unsigned long              count
+        );
+
+//   dst[dstStart+i] = src[srcStart+i] / sampleCount[i] for 'count' pixels.
+//   Pixels without samples are copied unchanged.
+
+void arlightalphaframebuffer_div_samples(
+        const ART_GV                   * art_gv,
+        const ArLightAlphaFramebuffer  * src,
+        const unsigned long              srcStart,
+        const double                   * sampleCount,
+              ArLightAlphaFramebuffer  * dst,
+        const unsigned long              dstStart,
+        const unsigned long              count
+        );
+
+#endif /* _ART_FOUNDATION_LIGHTANDATTENUATION_ARLIGHTALPHAFRAMEBUFFER_H_ */
+/* ======================================================================== */
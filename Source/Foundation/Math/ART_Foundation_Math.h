@@ -41,6 +41,8 @@ ART_LIBRARY_INTERFACE(ART_Foundation_Math)
 #include "Roots.h"
 #include "Units.h"
 
+#include "ArAliasTable.h"
+#include "ArDistribution2D.h"
 #include "ArFFT.h"
 #include "ArVector.h"
 
@@ -0,0 +1,185 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+#include <string.h>
+
+#include "ART_Foundation_System.h"
+#include "Constants.h"
+
+#include "ArAliasTable.h"
+
+//   Negative, NaN and infinite weights count as zero
+
+static double _araliastable_weight(
+        const double  w
+        )
+{
+    if ( w > 0.0 && isfinite( w ) )
+        return w;
+    else
+        return 0.0;
+}
+
+void araliastable_init(
+              ArAliasTable  * table,
+        const double        * weight,
+        const unsigned int    size
+        )
+{
+    table->size        = size;
+    table->totalWeight = 0.0;
+    table->probability = 0;
+    table->alias       = 0;
+
+    if ( size == 0 )
+        return;
+
+    table->probability = ALLOC_ARRAY( double, size );
+    table->alias       = ALLOC_ARRAY( unsigned int, size );
+
+    for ( unsigned int i = 0; i < size; i++ )
+        table->totalWeight += _araliastable_weight( weight[i] );
+
+    if ( table->totalWeight <= 0.0 )
+    {
+        for ( unsigned int i = 0; i < size; i++ )
+        {
+            table->probability[i] = 1.0;
+            table->alias[i]       = i;
+        }
+
+        return;
+    }
+
+    //   Vose's construction: 'probability' first holds the weights scaled
+    //   so that their average is 1. Entries below 1 ("small") are filled
+    //   up with the excess of entries above 1 ("large"). The worklist
+    //   holds the small entries from the front, the large ones from the
+    //   back.
+
+    unsigned int  * worklist = ALLOC_ARRAY( unsigned int, size );
+
+    unsigned int  numberOfSmall = 0;
+    unsigned int  firstLarge    = size;
+
+    double  scale = size / table->totalWeight;
+
+    for ( unsigned int i = 0; i < size; i++ )
+    {
+        table->probability[i] = _araliastable_weight( weight[i] ) * scale;
+        table->alias[i]       = i;
+
+        if ( table->probability[i] < 1.0 )
+            worklist[ numberOfSmall++ ] = i;
+        else
+            worklist[ --firstLarge ] = i;
+    }
+
+    while ( numberOfSmall > 0 && firstLarge < size )
+    {
+        unsigned int  small = worklist[ --numberOfSmall ];
+        unsigned int  large = worklist[ firstLarge++ ];
+
+        table->alias[small] = large;
+
+        table->probability[large] -= 1.0 - table->probability[small];
+
+        if ( table->probability[large] < 1.0 )
+            worklist[ numberOfSmall++ ] = large;
+        else
+            worklist[ --firstLarge ] = large;
+    }
+
+    //   Whatever is left over is 1 up to rounding errors.
+
+    while ( numberOfSmall > 0 )
+        table->probability[ worklist[ --numberOfSmall ] ] = 1.0;
+
+    while ( firstLarge < size )
+        table->probability[ worklist[ firstLarge++ ] ] = 1.0;
+
+    FREE_ARRAY( worklist );
+}
+
+ArAliasTable araliastable_copy(
+        const ArAliasTable  * table
+        )
+{
+    ArAliasTable  copy = *table;
+
+    if ( table->size > 0 )
+    {
+        copy.probability = ALLOC_ARRAY( double, table->size );
+        copy.alias       = ALLOC_ARRAY( unsigned int, table->size );
+
+        memcpy(
+            copy.probability,
+            table->probability,
+            table->size * sizeof(double)
+            );
+        memcpy(
+            copy.alias,
+            table->alias,
+            table->size * sizeof(unsigned int)
+            );
+    }
+
+    return copy;
+}
+
+void araliastable_free_contents(
+        ArAliasTable  * table
+        )
+{
+    if ( table->probability )
+        FREE_ARRAY( table->probability );
+    if ( table->alias )
+        FREE_ARRAY( table->alias );
+
+    table->probability = 0;
+    table->alias       = 0;
+    table->size        = 0;
+    table->totalWeight = 0.0;
+}
+
+unsigned int araliastable_sample(
+        const ArAliasTable  * table,
+        const double          u
+        )
+{
+    double        x = u * table->size;
+    unsigned int  i = (unsigned int) x;
+
+    if ( i >= table->size )
+        i = table->size - 1;
+
+    if ( x - i < table->probability[i] )
+        return i;
+    else
+        return table->alias[i];
+}
+
+/* ======================================================================== */
@@ -0,0 +1,88 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+#ifndef _ART_MATH_ALIASTABLE_H_
+#define _ART_MATH_ALIASTABLE_H_
+
+/* ---------------------------------------------------------------------------
+    'ArAliasTable'
+        Walker's alias method for drawing indices from a discrete
+        distribution in constant time. The table is built once from a set
+        of non-negative weights (Vose's O(n) construction). Afterwards,
+        drawing an index costs one array lookup and one comparison,
+        regardless of the number of entries, and only uses a single
+        uniform random number.
+
+        Weights which are negative or not finite are treated as zero. If
+        all weights are zero, 'totalWeight' is zero, and the table must
+        not be sampled - callers check for this case themselves, as they
+        usually want to report that nothing could be selected.
+
+        Tables are read-only after construction, so several threads can
+        sample from the same table concurrently.
+--------------------------------------------------------------------------- */
+
+typedef struct ArAliasTable
+{
+    unsigned int    size;
+    double          totalWeight;
+    double        * probability;
+    unsigned int  * alias;
+}
+ArAliasTable;
+
+#define ARALIASTABLE_SIZE(__t)          (__t).size
+#define ARALIASTABLE_TOTAL_WEIGHT(__t)  (__t).totalWeight
+#define ARALIASTABLE_IS_EMPTY(__t)      ( (__t).totalWeight <= 0.0 )
+
+void araliastable_init(
+              ArAliasTable  * table,
+        const double        * weight,
+        const unsigned int    size
+        );
+
+ArAliasTable araliastable_copy(
+        const ArAliasTable  * table
+        );
+
+void araliastable_free_contents(
+        ArAliasTable  * table
+        );
+
+/* ---------------------------------------------------------------------------
+    'araliastable_sample'
+        Returns the index selected by the uniform random number u, which
+        has to lie in [0,1). The probability of each index is its weight
+        divided by the total weight of the table.
+--------------------------------------------------------------------------- */
+
+unsigned int araliastable_sample(
+        const ArAliasTable  * table,
+        const double          u
+        );
+
+#endif /* _ART_MATH_ALIASTABLE_H_ */
+/* ======================================================================== */
@@ -0,0 +1,278 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+#include <string.h>
+
+#include "ART_Foundation_System.h"
+#include "Constants.h"
+#include "Functions.h"
+
+#include "ArDistribution2D.h"
+
+//   Negative, NaN and infinite weights count as zero
+
+static double _ardistribution2d_weight(
+        const double  w
+        )
+{
+    if ( w > 0.0 && isfinite( w ) )
+        return w;
+    else
+        return 0.0;
+}
+
+//   Fills 'cdf' (n + 1 entries) with the normalised running sum of the
+//   n weights, and returns their total. Rows without any weight get a
+//   uniform CDF, so that inversion is always well defined.
+
+static double _ardistribution2d_build_cdf(
+        const double        * weight,
+        const unsigned int    n,
+              double        * cdf
+        )
+{
+    cdf[0] = 0.0;
+
+    for ( unsigned int i = 0; i < n; i++ )
+        cdf[i+1] = cdf[i] + weight[i];
+
+    double  total = cdf[n];
+
+    if ( total > 0.0 )
+    {
+        for ( unsigned int i = 1; i < n; i++ )
+            cdf[i] /= total;
+    }
+    else
+    {
+        for ( unsigned int i = 1; i < n; i++ )
+            cdf[i] = i / (double) n;
+    }
+
+    cdf[n] = 1.0;
+
+    return total;
+}
+
+//   Inverts a CDF: returns the continuous position in [0,n) that u
+//   corresponds to, and the index of the cell it lies in.
+
+static double _ardistribution2d_invert_cdf(
+        const double        * cdf,
+        const unsigned int    n,
+        const double          u,
+              unsigned int  * index
+        )
+{
+    //   Largest i with cdf[i] <= u; cells with zero weight are never
+    //   returned, since for them cdf[i] == cdf[i+1].
+
+    unsigned int  lo = 0;
+    unsigned int  hi = n;
+
+    while ( hi - lo > 1 )
+    {
+        unsigned int  mid = ( lo + hi ) / 2;
+
+        if ( cdf[mid] <= u )
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    *index = lo;
+
+    double  width  = cdf[lo+1] - cdf[lo];
+    double  offset = 0.5;
+
+    if ( width > 0.0 )
+        offset = ( u - cdf[lo] ) / width;
+
+    return lo + M_CLAMP( offset, 0.0, 1.0 - MATH_TINY_DOUBLE );
+}
+
+void ardistribution2d_init(
+              ArDistribution2D  * distribution,
+        const double            * weight,
+        const unsigned int        width,
+        const unsigned int        height
+        )
+{
+    unsigned int  size = width * height;
+
+    distribution->width          = width;
+    distribution->height         = height;
+    distribution->totalWeight    = 0.0;
+    distribution->density        = 0;
+    distribution->marginalCDF    = 0;
+    distribution->conditionalCDF = 0;
+
+    if ( size == 0 )
+        return;
+
+    distribution->density        = ALLOC_ARRAY( double, size );
+    distribution->marginalCDF    = ALLOC_ARRAY( double, height + 1 );
+    distribution->conditionalCDF = ALLOC_ARRAY( double, height * ( width + 1 ) );
+
+    double  * rowWeight = ALLOC_ARRAY( double, height );
+
+    for ( unsigned int i = 0; i < size; i++ )
+        distribution->density[i] = _ardistribution2d_weight( weight[i] );
+
+    for ( unsigned int y = 0; y < height; y++ )
+        rowWeight[y] =
+            _ardistribution2d_build_cdf(
+                  distribution->density + y * width,
+                  width,
+                  distribution->conditionalCDF + y * ( width + 1 )
+                );
+
+    distribution->totalWeight =
+        _ardistribution2d_build_cdf(
+              rowWeight,
+              height,
+              distribution->marginalCDF
+            );
+
+    //   Density with respect to area on the unit square: the weight of
+    //   a cell relative to the average weight.
+
+    for ( unsigned int i = 0; i < size; i++ )
+    {
+        if ( distribution->totalWeight > 0.0 )
+            distribution->density[i] *= size / distribution->totalWeight;
+        else
+            distribution->density[i] = 1.0;
+    }
+
+    FREE_ARRAY( rowWeight );
+}
+
+ArDistribution2D ardistribution2d_copy(
+        const ArDistribution2D  * distribution
+        )
+{
+    ArDistribution2D  copy = *distribution;
+
+    unsigned int  width  = distribution->width;
+    unsigned int  height = distribution->height;
+
+    if ( width * height > 0 )
+    {
+        copy.density        = ALLOC_ARRAY( double, width * height );
+        copy.marginalCDF    = ALLOC_ARRAY( double, height + 1 );
+        copy.conditionalCDF = ALLOC_ARRAY( double, height * ( width + 1 ) );
+
+        memcpy(
+            copy.density,
+            distribution->density,
+            width * height * sizeof(double)
+            );
+        memcpy(
+            copy.marginalCDF,
+            distribution->marginalCDF,
+            ( height + 1 ) * sizeof(double)
+            );
+        memcpy(
+            copy.conditionalCDF,
+            distribution->conditionalCDF,
+            height * ( width + 1 ) * sizeof(double)
+            );
+    }
+
+    return copy;
+}
+
+void ardistribution2d_free_contents(
+        ArDistribution2D  * distribution
+        )
+{
+    if ( distribution->density )
+        FREE_ARRAY( distribution->density );
+    if ( distribution->marginalCDF )
+        FREE_ARRAY( distribution->marginalCDF );
+    if ( distribution->conditionalCDF )
+        FREE_ARRAY( distribution->conditionalCDF );
+
+    distribution->density        = 0;
+    distribution->marginalCDF    = 0;
+    distribution->conditionalCDF = 0;
+    distribution->width          = 0;
+    distribution->height         = 0;
+    distribution->totalWeight    = 0.0;
+}
+
+double ardistribution2d_sample(
+        const ArDistribution2D  * distribution,
+        const double              u0,
+        const double              u1,
+              double            * x,
+              double            * y
+        )
+{
+    unsigned int  width  = distribution->width;
+    unsigned int  height = distribution->height;
+
+    unsigned int  row, column;
+
+    *y =
+        _ardistribution2d_invert_cdf(
+              distribution->marginalCDF,
+              height,
+              u1,
+            & row
+            ) / height;
+
+    *x =
+        _ardistribution2d_invert_cdf(
+              distribution->conditionalCDF + row * ( width + 1 ),
+              width,
+              u0,
+            & column
+            ) / width;
+
+    return distribution->density[ row * width + column ];
+}
+
+double ardistribution2d_pdf(
+        const ArDistribution2D  * distribution,
+        const double              x,
+        const double              y
+        )
+{
+    unsigned int  width  = distribution->width;
+    unsigned int  height = distribution->height;
+
+    if ( x < 0.0 || x >= 1.0 || y < 0.0 || y >= 1.0 )
+        return 0.0;
+
+    unsigned int  column = M_MIN( (unsigned int) ( x * width ),  width - 1 );
+    unsigned int  row    = M_MIN( (unsigned int) ( y * height ), height - 1 );
+
+    return distribution->density[ row * width + column ];
+}
+
+/* ======================================================================== */
@@ -0,0 +1,107 @@
+/* ===========================================================================
+
+    Copyright (c) The ART Development Team
+    --------------------------------------
+
+    For a comprehensive list of the members of the development team, and a
+    description of their respective contributions, see the file
+    "ART_DeveloperList.txt" that is distributed with the libraries.
+
+    This file is part of the Advanced Rendering Toolkit (ART) libraries.
+
+    ART is free software: you can redistribute it and/or modify it under the
+    terms of the GNU General Public License as published by the Free Software
+    Foundation, either version 3 of the License, or (at your option) any
+    later version.
+
+    ART is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ART.  If not, see <http://www.gnu.org/licenses/>.
+
+=========================================================================== */
+
+#ifndef _ART_MATH_DISTRIBUTION2D_H_
+#define _ART_MATH_DISTRIBUTION2D_H_
+
+/* ---------------------------------------------------------------------------
+    'ArDistribution2D'
+        Piecewise constant probability density on the unit square, given
+        by a grid of 'width' x 'height' non-negative cell weights (stored
+        row by row). Samples are generated by inverting the marginal CDF
+        of the rows, and then the conditional CDF of the chosen row.
+        Unlike e.g. an alias table, this inversion is continuous and
+        monotonic in both random numbers, so stratification of the input
+        sample points carries over to the result.
+
+        Weights which are negative or not finite are treated as zero. If
+        all weights are zero, the distribution is uniform, and
+        ARDISTRIBUTION2D_IS_EMPTY is true.
+
+        Distributions are read-only after construction, so several
+        threads can sample from the same one concurrently.
+--------------------------------------------------------------------------- */
+
+typedef struct ArDistribution2D
+{
+    unsigned int    width;
+    unsigned int    height;
+    double          totalWeight;
+    double        * density;
+    double        * marginalCDF;
+    double        * conditionalCDF;
+}
+ArDistribution2D;
+
+#define ARDISTRIBUTION2D_WIDTH(__d)         (__d).width
+#define ARDISTRIBUTION2D_HEIGHT(__d)        (__d).height
+#define ARDISTRIBUTION2D_TOTAL_WEIGHT(__d)  (__d).totalWeight
+#define ARDISTRIBUTION2D_IS_EMPTY(__d)      ( (__d).totalWeight <= 0.0 )
+
+void ardistribution2d_init(
+              ArDistribution2D  * distribution,
+        const double            * weight,
+        const unsigned int        width,
+        const unsigned int        height
+        );
+
+ArDistribution2D ardistribution2d_copy(
+        const ArDistribution2D  * distribution
+        );
+
+void ardistribution2d_free_contents(
+        ArDistribution2D  * distribution
+        );
+
+/* ---------------------------------------------------------------------------
+    'ardistribution2d_sample'
+        Maps the uniform random numbers u0 and u1 from [0,1) to a point
+        (x,y) in the unit square, and returns the density at that point
+        (with respect to area on the unit square).
+--------------------------------------------------------------------------- */
+
+double ardistribution2d_sample(
+        const ArDistribution2D  * distribution,
+        const double              u0,
+        const double              u1,
+              double            * x,
+              double            * y
+        );
+
+/* ---------------------------------------------------------------------------
+    'ardistribution2d_pdf'
+        Density at the point (x,y) of the unit square, i.e. the value
+        'ardistribution2d_sample' returns when it generates this point.
+--------------------------------------------------------------------------- */
+
+double ardistribution2d_pdf(
+        const ArDistribution2D  * distribution,
+        const double              x,
+        const double              y
+        );
+
+#endif /* _ART_MATH_DISTRIBUTION2D_H_ */
+/* ======================================================================== */
@@ -26,6 +26,12 @@
 
 #include "C18.h"
 #include "Functions.h"
+
+//   The spectral vectors get runtime dispatched SIMD variants of their
+//   hot operations, see Cx_ImplementationMacros.h
+
+#define ART_Cx_WITH_SIMD_DISPATCH
+
 #include "Cx_ImplementationMacros.h"
 
 Cx_IMPLEMENTATION(18)
@@ -100,6 +100,11 @@ _ftype _f##c##_n##_cc_dot( \
         const _F##Crd##_n  * c1 \
         ); \
 \
+_ftype _f##c##_n##_c_sum( \
+        ART_Cx_CONTEXT_ARGUMENT \
+        const _F##Crd##_n  * c0 \
+        ); \
+\
 void _f##c##_n##_c_min_c( \
         ART_Cx_CONTEXT_ARGUMENT \
         const _F##Crd##_n  * c0, \
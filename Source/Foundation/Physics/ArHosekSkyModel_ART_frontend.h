@@ -49,6 +49,17 @@ void arhosekskymodel_solar_spc(
         ArSpectrum               * result
         );
 
+//   Sky radiance at a single wavelength, irrespective of how many
+//   hero samples are currently being splatted
+
+double  arhosekskymodel_mono_sample(
+              ART_GV                 * art_gv,
+              ArHosekSkyModelState  ** state,
+        const double                   theta,
+        const double                   gamma,
+        const double                   wavelength
+        );
+
 void  arhosekskymodel_sps(
               ART_GV                 * art_gv,
               ArHosekSkyModelState  ** state,
@@ -62,7 +62,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 //   Some macro definitions that occur elsewhere in ART, and that have to be
 //   replicated to make this a stand-alone module.
@@ -131,6 +137,33 @@ void printErrorAndExit(const char * message) {
 	exit(-1);
 }
 
+static void compute_radiance_layout(ArPragueSkyModelState * state)
+{
+	state->sun_offset = 0;
+	state->sun_stride = 2 * state->sun_nbreaks - 2 + 2 * state->zenith_nbreaks - 2;
+
+	state->zenith_offset = state->sun_offset + 2 * state->sun_nbreaks - 2;
+	state->zenith_stride = state->sun_stride;
+
+	state->emph_offset = state->sun_offset + state->tensor_components * state->sun_stride;
+
+	state->total_coefs_single_config = state->emph_offset + 2 * state->emph_nbreaks - 2; // this is for one specific configuration
+	state->total_configs = state->channels * state->elevations * state->altitudes * state->albedos * state->turbidities;
+	state->total_coefs_all_configs = state->total_coefs_single_config * state->total_configs;
+}
+
+static void compute_polarisation_layout(ArPragueSkyModelState * state)
+{
+	state->sun_offset_pol = 0;
+	state->sun_stride_pol = 2 * state->sun_nbreaks_pol - 2 + 2 * state->zenith_nbreaks_pol - 2;
+
+	state->zenith_offset_pol = state->sun_offset_pol + 2 * state->sun_nbreaks_pol - 2;
+	state->zenith_stride_pol = state->sun_stride_pol;
+
+	state->total_coefs_single_config_pol = state->sun_offset_pol + state->tensor_components_pol * state->sun_stride_pol; // this is for one specific configuration
+	state->total_coefs_all_configs_pol = state->total_coefs_single_config_pol * state->total_configs;
+}
+
 void read_radiance(ArPragueSkyModelState * state, FILE * handle)
 {
 	// Read metadata
@@ -211,17 +244,7 @@ void read_radiance(ArPragueSkyModelState * state, FILE * handle)
 
 	// Calculate offsets and strides
 
-	state->sun_offset = 0;
-	state->sun_stride = 2 * state->sun_nbreaks - 2 + 2 * state->zenith_nbreaks - 2;
-
-	state->zenith_offset = state->sun_offset + 2 * state->sun_nbreaks - 2;
-	state->zenith_stride = state->sun_stride;
-
-	state->emph_offset = state->sun_offset + state->tensor_components * state->sun_stride;
-
-	state->total_coefs_single_config = state->emph_offset + 2 * state->emph_nbreaks - 2; // this is for one specific configuration
-	state->total_configs = state->channels * state->elevations * state->altitudes * state->albedos * state->turbidities;
-	state->total_coefs_all_configs = state->total_coefs_single_config * state->total_configs;
+	compute_radiance_layout(state);
 
 	// Read data
 
@@ -363,14 +386,7 @@ void read_polarisation(ArPragueSkyModelState * state, FILE * handle)
 
 	// Calculate offsets and strides
 
-	state->sun_offset_pol = 0;
-	state->sun_stride_pol = 2 * state->sun_nbreaks_pol - 2 + 2 * state->zenith_nbreaks_pol - 2;
-
-	state->zenith_offset_pol = state->sun_offset_pol + 2 * state->sun_nbreaks_pol - 2;
-	state->zenith_stride_pol = state->sun_stride_pol;
-
-	state->total_coefs_single_config_pol = state->sun_offset_pol + state->tensor_components_pol * state->sun_stride_pol; // this is for one specific configuration
-	state->total_coefs_all_configs_pol = state->total_coefs_single_config_pol * state->total_configs;
+	compute_polarisation_layout(state);
 
 	// Read data
 
@@ -399,7 +415,310 @@ void read_polarisation(ArPragueSkyModelState * state, FILE * handle)
 	free(polarisation_temp);
 }
 
-#include "unistd.h"
+/* ----------------------------------------------------------------------------
+
+    Decoded copies of the dataset
+    -----------------------------
+
+    Decoding the half float coefficients of the dataset into piecewise
+    polynomial coefficients takes a while, and results in several hundred
+    MB of heap memory per process. So the decoded arrays are written to a
+    file, once, which subsequent runs just map into memory.
+
+    The mapping is shared, so concurrently running processes all use the
+    same physical pages. And it is only ever read on demand: a render that
+    uses one turbidity only pulls in the pages of the configurations that
+    are adjacent to it. Read-ahead of the OS is switched off for the same
+    reason, and arpragueskymodelstate_prefetch_turbidity() can be used to
+    fetch the slices that will be needed in advance.
+
+    The decoded file is placed next to the dataset, or into a per-user
+    file in $TMPDIR if the resource directory is read-only. Its header
+    records size and modification time of the dataset it was decoded
+    from, so stale copies are ignored (and replaced, if possible). Copies
+    that are writable by group or others, or that belong to anybody but
+    the current user or the owner of the dataset, are never mapped, so
+    that nobody else can plant coefficients in a shared $TMPDIR.
+
+---------------------------------------------------------------------------- */
+
+#define PSM_DECODED_MAGIC       "ARTPSMD1"
+#define PSM_DECODED_ALIGNMENT   4096
+#define PSM_DECODED_ARRAYS      15
+
+typedef struct ArPragueSkyModelDecodedHeader
+{
+	char     magic[8];
+	uint64_t source_size;
+	int64_t  source_mtime;
+	uint64_t file_size;
+
+	int32_t  turbidities;
+	int32_t  albedos;
+	int32_t  altitudes;
+	int32_t  elevations;
+	int32_t  channels;
+	int32_t  tensor_components;
+	int32_t  sun_nbreaks;
+	int32_t  zenith_nbreaks;
+	int32_t  emph_nbreaks;
+	int32_t  trans_n_a;
+	int32_t  trans_n_d;
+	int32_t  trans_turbidities;
+	int32_t  trans_altitudes;
+	int32_t  trans_rank;
+	int32_t  tensor_components_pol;
+	int32_t  sun_nbreaks_pol;
+	int32_t  zenith_nbreaks_pol;
+	int32_t  padding;
+
+	double   channel_start;
+	double   channel_width;
+
+	// Byte offsets of the arrays, in the order of decoded_arrays()
+
+	uint64_t offset[PSM_DECODED_ARRAYS];
+}
+ArPragueSkyModelDecodedHeader;
+
+typedef struct ArPragueSkyModelDecodedArray
+{
+	void  ** data;
+	size_t   element_size;
+	size_t   count;
+}
+ArPragueSkyModelDecodedArray;
+
+// All arrays of a state whose metadata is complete, with their sizes
+
+static void decoded_arrays(ArPragueSkyModelState * state, ArPragueSkyModelDecodedArray * arrays)
+{
+	const int pol = state->tensor_components_pol > 0;
+
+	arrays[ 0] = (ArPragueSkyModelDecodedArray){ (void **) & state->turbidity_vals,         sizeof(double), state->turbidities };
+	arrays[ 1] = (ArPragueSkyModelDecodedArray){ (void **) & state->albedo_vals,            sizeof(double), state->albedos };
+	arrays[ 2] = (ArPragueSkyModelDecodedArray){ (void **) & state->altitude_vals,          sizeof(double), state->altitudes };
+	arrays[ 3] = (ArPragueSkyModelDecodedArray){ (void **) & state->elevation_vals,         sizeof(double), state->elevations };
+	arrays[ 4] = (ArPragueSkyModelDecodedArray){ (void **) & state->sun_breaks,             sizeof(double), state->sun_nbreaks };
+	arrays[ 5] = (ArPragueSkyModelDecodedArray){ (void **) & state->zenith_breaks,          sizeof(double), state->zenith_nbreaks };
+	arrays[ 6] = (ArPragueSkyModelDecodedArray){ (void **) & state->emph_breaks,            sizeof(double), state->emph_nbreaks };
+	arrays[ 7] = (ArPragueSkyModelDecodedArray){ (void **) & state->radiance_dataset,       sizeof(double), (size_t) state->total_coefs_all_configs };
+	arrays[ 8] = (ArPragueSkyModelDecodedArray){ (void **) & state->transmission_altitudes, sizeof(float),  state->trans_altitudes };
+	arrays[ 9] = (ArPragueSkyModelDecodedArray){ (void **) & state->transmission_turbities, sizeof(float),  state->trans_turbidities };
+	arrays[10] = (ArPragueSkyModelDecodedArray){ (void **) & state->transmission_dataset_U, sizeof(float),  (size_t) state->trans_n_d * state->trans_n_a * state->trans_rank * state->trans_altitudes };
+	arrays[11] = (ArPragueSkyModelDecodedArray){ (void **) & state->transmission_dataset_V, sizeof(float),  (size_t) state->trans_turbidities * state->trans_rank * 11 * state->trans_altitudes };
+	arrays[12] = (ArPragueSkyModelDecodedArray){ (void **) & state->sun_breaks_pol,         sizeof(double), pol ? state->sun_nbreaks_pol : 0 };
+	arrays[13] = (ArPragueSkyModelDecodedArray){ (void **) & state->zenith_breaks_pol,      sizeof(double), pol ? state->zenith_nbreaks_pol : 0 };
+	arrays[14] = (ArPragueSkyModelDecodedArray){ (void **) & state->polarisation_dataset,   sizeof(double), pol ? (size_t) state->total_coefs_all_configs_pol : 0 };
+}
+
+static size_t decoded_align(const size_t offset)
+{
+	return (offset + PSM_DECODED_ALIGNMENT - 1) / PSM_DECODED_ALIGNMENT * PSM_DECODED_ALIGNMENT;
+}
+
+static int decoded_is_trusted(const struct stat * decoded_stat, const struct stat * source_stat)
+{
+	return
+		   S_ISREG(decoded_stat->st_mode)
+		&& (decoded_stat->st_mode & (S_IWGRP | S_IWOTH)) == 0
+		&& (decoded_stat->st_uid == getuid() || decoded_stat->st_uid == source_stat->st_uid);
+}
+
+static int map_decoded(ArPragueSkyModelState * state, const char * decoded_filename, const struct stat * source_stat)
+{
+	const int fd = open(decoded_filename, O_RDONLY);
+	if (fd < 0) return 0;
+
+	struct stat decoded_stat;
+	if (   fstat(fd, &decoded_stat) != 0
+		|| !decoded_is_trusted(&decoded_stat, source_stat)
+		|| decoded_stat.st_size < (off_t) sizeof(ArPragueSkyModelDecodedHeader))
+	{
+		close(fd);
+		return 0;
+	}
+
+	const size_t size = (size_t) decoded_stat.st_size;
+	void * mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (mapping == MAP_FAILED) return 0;
+
+	const ArPragueSkyModelDecodedHeader * header = mapping;
+
+	if (   memcmp(header->magic, PSM_DECODED_MAGIC, 8) != 0
+		|| header->source_size != (uint64_t) source_stat->st_size
+		|| header->source_mtime != (int64_t) source_stat->st_mtime
+		|| header->file_size != size)
+	{
+		munmap(mapping, size);
+		return 0;
+	}
+
+	state->turbidities           = header->turbidities;
+	state->albedos               = header->albedos;
+	state->altitudes             = header->altitudes;
+	state->elevations            = header->elevations;
+	state->channels              = header->channels;
+	state->channel_start         = header->channel_start;
+	state->channel_width         = header->channel_width;
+	state->tensor_components     = header->tensor_components;
+	state->sun_nbreaks           = header->sun_nbreaks;
+	state->zenith_nbreaks        = header->zenith_nbreaks;
+	state->emph_nbreaks          = header->emph_nbreaks;
+	state->trans_n_a             = header->trans_n_a;
+	state->trans_n_d             = header->trans_n_d;
+	state->trans_turbidities     = header->trans_turbidities;
+	state->trans_altitudes       = header->trans_altitudes;
+	state->trans_rank            = header->trans_rank;
+	state->tensor_components_pol = header->tensor_components_pol;
+	state->sun_nbreaks_pol       = header->sun_nbreaks_pol;
+	state->zenith_nbreaks_pol    = header->zenith_nbreaks_pol;
+
+	compute_radiance_layout(state);
+
+	if (state->tensor_components_pol > 0)
+		compute_polarisation_layout(state);
+
+	ArPragueSkyModelDecodedArray arrays[PSM_DECODED_ARRAYS];
+	decoded_arrays(state, arrays);
+
+	for (int i = 0; i < PSM_DECODED_ARRAYS; ++i)
+	{
+		if (arrays[i].count == 0)
+		{
+			*arrays[i].data = NULL;
+			continue;
+		}
+
+		if (header->offset[i] + arrays[i].count * arrays[i].element_size > size)
+		{
+			munmap(mapping, size);
+			return 0;
+		}
+
+		*arrays[i].data = (char *) mapping + header->offset[i];
+	}
+
+	madvise(mapping, size, MADV_RANDOM);
+
+	state->mapping = mapping;
+	state->mapping_size = size;
+
+	return 1;
+}
+
+// Written under a temporary name first, so that concurrently starting
+// processes never map a partially written file. The temporary file has to
+// be newly created by us, so that a link planted under its name is not
+// followed.
+
+static int write_decoded(ArPragueSkyModelState * state, const char * decoded_filename, const struct stat * source_stat)
+{
+	char temp_filename[1100];
+	if (snprintf(temp_filename, sizeof(temp_filename), "%s.%d", decoded_filename, (int) getpid()) >= (int) sizeof(temp_filename))
+		return 0;
+
+	const int fd = open(temp_filename, O_WRONLY | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+	if (fd < 0) return 0;
+
+	FILE * handle = fdopen(fd, "wb");
+	if (!handle)
+	{
+		close(fd);
+		unlink(temp_filename);
+		return 0;
+	}
+
+	ArPragueSkyModelDecodedHeader header;
+	memset(&header, 0, sizeof(header));
+
+	memcpy(header.magic, PSM_DECODED_MAGIC, 8);
+	header.source_size           = (uint64_t) source_stat->st_size;
+	header.source_mtime          = (int64_t) source_stat->st_mtime;
+	header.turbidities           = state->turbidities;
+	header.albedos               = state->albedos;
+	header.altitudes             = state->altitudes;
+	header.elevations            = state->elevations;
+	header.channels              = state->channels;
+	header.channel_start         = state->channel_start;
+	header.channel_width         = state->channel_width;
+	header.tensor_components     = state->tensor_components;
+	header.sun_nbreaks           = state->sun_nbreaks;
+	header.zenith_nbreaks        = state->zenith_nbreaks;
+	header.emph_nbreaks          = state->emph_nbreaks;
+	header.trans_n_a             = state->trans_n_a;
+	header.trans_n_d             = state->trans_n_d;
+	header.trans_turbidities     = state->trans_turbidities;
+	header.trans_altitudes       = state->trans_altitudes;
+	header.trans_rank            = state->trans_rank;
+	header.tensor_components_pol = state->tensor_components_pol;
+	header.sun_nbreaks_pol       = state->sun_nbreaks_pol;
+	header.zenith_nbreaks_pol    = state->zenith_nbreaks_pol;
+
+	ArPragueSkyModelDecodedArray arrays[PSM_DECODED_ARRAYS];
+	decoded_arrays(state, arrays);
+
+	size_t offset = decoded_align(sizeof(header));
+	size_t file_size = sizeof(header);
+
+	for (int i = 0; i < PSM_DECODED_ARRAYS; ++i)
+	{
+		if (arrays[i].count == 0) continue;
+
+		header.offset[i] = offset;
+		file_size = offset + arrays[i].count * arrays[i].element_size;
+		offset = decoded_align(file_size);
+	}
+
+	header.file_size = file_size;
+
+	int ok = fwrite(&header, sizeof(header), 1, handle) == 1;
+
+	for (int i = 0; ok && i < PSM_DECODED_ARRAYS; ++i)
+	{
+		if (arrays[i].count == 0) continue;
+
+		ok =    fseeko(handle, (off_t) header.offset[i], SEEK_SET) == 0
+			 && fwrite(*arrays[i].data, arrays[i].element_size, arrays[i].count, handle) == arrays[i].count;
+	}
+
+	ok = (fclose(handle) == 0) && ok;
+
+	if (!ok || rename(temp_filename, decoded_filename) != 0)
+	{
+		unlink(temp_filename);
+		return 0;
+	}
+
+	return 1;
+}
+
+static void free_arrays(ArPragueSkyModelState * state)
+{
+	free(state->turbidity_vals);
+	free(state->albedo_vals);
+	free(state->altitude_vals);
+	free(state->elevation_vals);
+
+	free(state->sun_breaks);
+	free(state->zenith_breaks);
+	free(state->emph_breaks);
+	free(state->radiance_dataset);
+
+	free(state->transmission_dataset_U);
+	free(state->transmission_dataset_V);
+	free(state->transmission_altitudes);
+	free(state->transmission_turbities);
+
+	if (state->tensor_components_pol > 0)
+	{
+		free(state->sun_breaks_pol);
+		free(state->zenith_breaks_pol);
+		free(state->polarisation_dataset);
+	}
+}
 
 ArPragueSkyModelState  * arpragueskymodelstate_alloc_init(
 	const char  * library_path
@@ -407,15 +726,45 @@ ArPragueSkyModelState  * arpragueskymodelstate_alloc_init(
 {
 	ArPragueSkyModelState * state = ALLOC(ArPragueSkyModelState);
 
+	state->mapping = NULL;
+	state->mapping_size = 0;
+
 	char filename[1024];
     
-	sprintf(filename, "%s/SkyModel/SkyModelDataset.dat", library_path);
+	if (snprintf(filename, sizeof(filename), "%s/SkyModel/SkyModelDataset.dat", library_path) >= (int) sizeof(filename))
+	{
+		ART_ERRORHANDLING_FATAL_ERROR("sky model dataset path too long, library path was %s",library_path);
+	}
     
     if ( access(filename, F_OK | R_OK) != 0 )
     {
         ART_ERRORHANDLING_FATAL_ERROR("sky model dataset not found, full path was %s",filename);
     }
-    
+
+	// Without size and modification time of the dataset, decoded copies
+	// cannot be validated, so the dataset is then just decoded in memory
+
+	struct stat source_stat;
+	const int use_decoded = stat(filename, &source_stat) == 0;
+
+	const char * temp_dir = getenv("TMPDIR");
+	if (!temp_dir || !*temp_dir) temp_dir = "/tmp";
+
+	char decoded_filename[2][1100];
+	int decoded_filename_ok[2];
+
+	decoded_filename_ok[0] =
+		   use_decoded
+		&& snprintf(decoded_filename[0], sizeof(decoded_filename[0]), "%s.decoded", filename) < (int) sizeof(decoded_filename[0]);
+	decoded_filename_ok[1] =
+		   use_decoded
+		&& snprintf(decoded_filename[1], sizeof(decoded_filename[1]), "%s/ART_SkyModelDataset.%d.decoded", temp_dir, (int) getuid()) < (int) sizeof(decoded_filename[1]);
+
+	for (int i = 0; i < 2; ++i)
+	{
+		if (decoded_filename_ok[i] && map_decoded(state, decoded_filename[i], &source_stat)) return state;
+	}
+
 	FILE * handle = fopen(filename, "rb");
 
 	// Read data
@@ -425,6 +774,25 @@ ArPragueSkyModelState  * arpragueskymodelstate_alloc_init(
 
 	fclose(handle);
 
+	// Leave a decoded copy for the next run, and switch over to it right
+	// away, so that this process shares its pages as well
+
+	for (int i = 0; i < 2; ++i)
+	{
+		if (decoded_filename_ok[i] && write_decoded(state, decoded_filename[i], &source_stat))
+		{
+			ArPragueSkyModelState mapped_state = *state;
+
+			if (map_decoded(&mapped_state, decoded_filename[i], &source_stat))
+			{
+				free_arrays(state);
+				*state = mapped_state;
+			}
+
+			break;
+		}
+	}
+
 	return state;
 }
 
@@ -432,29 +800,45 @@ void arpragueskymodelstate_free(
 	ArPragueSkyModelState  * state
 	)
 {
-	free(state->turbidity_vals);
-	free(state->albedo_vals);
-	free(state->altitude_vals);
-	free(state->elevation_vals);
+	if (state->mapping)
+		munmap(state->mapping, state->mapping_size);
+	else
+		free_arrays(state);
 
-	free(state->sun_breaks);
-	free(state->zenith_breaks);
-	free(state->emph_breaks);
-	free(state->radiance_dataset);
+	FREE(state);
+}
 
-	free(state->transmission_dataset_U);
-	free(state->transmission_dataset_V);
-	free(state->transmission_altitudes);
-	free(state->transmission_turbities);
+double map_parameter(const double param, const int value_count, const double * values);
 
-	if (state->tensor_components_pol > 0)
+void arpragueskymodelstate_prefetch_turbidity(
+	const ArPragueSkyModelState  * state,
+	const double                   turbidity
+	)
+{
+	if (!state->mapping) return;
+
+	const double turbidity_control = map_parameter(turbidity, state->turbidities, state->turbidity_vals);
+	const int turbidity_low = (int) turbidity_control;
+	const int turbidity_high = M_MIN(turbidity_low + 1, state->turbidities - 1);
+
+	const size_t page_size = (size_t) sysconf(_SC_PAGESIZE);
+
+	const size_t configs_per_turbidity = (size_t) state->total_configs / state->turbidities;
+
+	const double * datasets[2] = { state->radiance_dataset, state->polarisation_dataset };
+	const size_t coefs_per_config[2] = { (size_t) state->total_coefs_single_config, state->tensor_components_pol > 0 ? (size_t) state->total_coefs_single_config_pol : 0 };
+
+	for (int d = 0; d < 2; ++d)
 	{
-		free(state->sun_breaks_pol);
-		free(state->zenith_breaks_pol);
-		free(state->polarisation_dataset);
-	}
+		if (coefs_per_config[d] == 0) continue;
 
-	FREE(state);
+		const size_t slice = configs_per_turbidity * coefs_per_config[d];
+		const uintptr_t start = (uintptr_t) (datasets[d] + turbidity_low * slice);
+		const uintptr_t end = (uintptr_t) (datasets[d] + (turbidity_high + 1) * slice);
+		const uintptr_t page_start = start / page_size * page_size;
+
+		madvise((void *) page_start, end - page_start, MADV_WILLNEED);
+	}
 }
 
 void arpragueskymodel_compute_altitude_and_elevation(
@@ -156,6 +156,12 @@ typedef struct ArPragueSkyModelState
 	// Polarisation data
 
 	double * polarisation_dataset;
+
+	// Shared, read-only mapping of the decoded dataset, if one is in use.
+	// All arrays above point into it then, and are not freed individually.
+
+	void   * mapping;
+	size_t   mapping_size;
 }
 ArPragueSkyModelState;
 
@@ -167,6 +173,15 @@ void arpragueskymodelstate_free(
         ArPragueSkyModelState  * state
         );
 
+//   Asks the OS to page in the radiance and polarisation coefficients of
+//   the turbidities adjacent to the given one, ahead of rendering. Only
+//   does anything if the state uses a mapped decoded dataset.
+
+void arpragueskymodelstate_prefetch_turbidity(
+        const ArPragueSkyModelState  * state,
+        const double                   turbidity
+        );
+
 //   theta  - zenith angle
 //   gamma  - sun angle
 //   shadow - angle from the shadow point, which is further 90 degrees above the sun
@@ -124,6 +124,78 @@ void fresnel_ddd_attenuation_dd(
           sqrt(4*k_sqr*n_sqr + M_SQR(k_sqr - n_sqr + sin_phi_sqr)))*tan_phi + sin_phi_sqr*M_SQR(tan_phi)));
 }
 
+void fresnel_dss_attenuation_ss(
+        const double              cos_phi,
+        const ArSpectralSample  * n,
+        const ArSpectralSample  * k,
+              ArSpectralSample  * attenuation_senkrecht,
+              ArSpectralSample  * attenuation_parallel
+        )
+{
+#ifdef ART_SPS_WITH_PACKETS
+    double  cos_phi_sqr = M_SQR( cos_phi );
+    double  sin_phi_sqr =  1 - cos_phi_sqr ;
+    double  sin_phi = sqrt(sin_phi_sqr);
+
+    double  tan_phi;
+
+    if ( cos_phi > 0. )
+    {
+        tan_phi = sin_phi / cos_phi;
+    }
+    else
+    {
+        tan_phi = 0;
+    }
+
+    ArSPSPacket  n_sqr = SPS_PACKET(*n) * SPS_PACKET(*n);
+    ArSPSPacket  k_sqr = SPS_PACKET(*k) * SPS_PACKET(*k);
+
+    //   a = k^2 - n^2 + sin^2 phi
+    //   r = sqrt( 4 k^2 n^2 + a^2 )
+    //   b = sqrt( r - a )
+
+    ArSPSPacket  a = k_sqr - n_sqr + sin_phi_sqr;
+    ArSPSPacket  r, b;
+
+    r = 4 * k_sqr * n_sqr + a * a;
+    sps_packet_sqrt_packet( & r, & r );
+
+    b = r - a;
+    sps_packet_sqrt_packet( & b, & b );
+
+    ArSPSPacket  cos_term = ( MATH_SQRT_2 * cos_phi ) * b;
+    ArSPSPacket  tan_term = ( MATH_SQRT_2 * sin_phi * tan_phi ) * b;
+    double       tan_sqr_term = sin_phi_sqr * M_SQR( tan_phi );
+
+    ArSPSPacket  senkrecht_numerator   = cos_phi_sqr + r - cos_term;
+    ArSPSPacket  senkrecht_denominator = cos_phi_sqr + r + cos_term;
+
+    SPS_PACKET(*attenuation_senkrecht) =
+        senkrecht_numerator / senkrecht_denominator;
+
+    SPS_PACKET(*attenuation_parallel) =
+          ( senkrecht_numerator * ( r - tan_term + tan_sqr_term ) )
+        / ( senkrecht_denominator * ( r + tan_term + tan_sqr_term ) );
+#else
+    for ( int i = 0; i < 4; i++ )
+    {
+        double  senkrecht, parallel;
+
+        fresnel_ddd_attenuation_dd(
+              cos_phi,
+              SPS_CI( *n, i ),
+              SPS_CI( *k, i ),
+            & senkrecht,
+            & parallel
+            );
+
+        SPS_CI( *attenuation_senkrecht, i ) = senkrecht;
+        SPS_CI( *attenuation_parallel, i ) = parallel;
+    }
+#endif
+}
+
 #define REFRACTION_E                            hitInfo->refractionRef->colour_e
 
 void fresnel_plain_dd_attenuation_dd_birefringent(
@@ -29,6 +29,7 @@
 ART_MODULE_INTERFACE(FresnelTermsPlain)
 
 #include "ART_Foundation_Geometry.h"
+#include "ArSpectralSample.h"
 
 
 /* ---------------------------------------------------------------------------
@@ -83,4 +84,23 @@ void fresnel_ddd_attenuation_dd(
               double  * attenuation_parallel
         );
 
+/* ---------------------------------------------------------------------------
+    'fresnel_dss_attenuation_ss'
+
+    Same as 'fresnel_ddd_attenuation_dd', but for all four hero
+    wavelengths of a spectral sample at once: n and k are given per
+    hero wavelength, the angle of incidence is shared. The common
+    subexpressions are only evaluated once, and the arithmetic runs on
+    hero sample packets where those are available (see ArSpectralSample.h).
+    For dielectrics, pass a k of zero.
+--------------------------------------------------------------------------- */
+
+void fresnel_dss_attenuation_ss(
+        const double              cos_phi,
+        const ArSpectralSample  * n,
+        const ArSpectralSample  * k,
+              ArSpectralSample  * attenuation_senkrecht,
+              ArSpectralSample  * attenuation_parallel
+        );
+
 // ===========================================================================
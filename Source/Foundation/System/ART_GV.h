@@ -203,7 +203,7 @@ typedef struct ART_GV
     struct ART_DefaultEmissiveSurfaceMaterial_GV
            * art_defaultemissivesurfacematerial_gv;
 
-    //   60..66
+    //   60..68
     struct ART_DefaultEnvironmentMaterial_GV
            * art_defaultenvironmentmaterial_gv;
     struct ART_DefaultVolumeMaterial_GV
@@ -213,6 +213,8 @@ typedef struct ART_GV
     struct ARM_RayCasting_GV            * ar2m_raycasting_gv;
     struct ARM_ScenegraphActions_GV     * ar2m_scenegraphactions_gv;
     struct ApplicationSupport_GV        * application_support_gv;
+    struct ArcSkyRadianceCache_GV       * arcskyradiancecache_gv;
+    struct ArBSPTreeCache_GV            * arbsptreecache_gv;
 }
 ART_GV;
 
@@ -331,6 +331,153 @@ double arrandom_nr2_double(
 #undef IR2
 #undef NDIV
 
+void arrandom_philox_seed(
+        ArRandomPhilox  * state,
+        long              seed
+        )
+{
+    UInt64  s = (UInt64) seed;
+
+    state->key[0] = (UInt32) ( s ^ ( s >> 32 ) );
+    state->key[1] = 0;
+
+    state->counter[0] = 0;
+    state->counter[1] = 0;
+    state->counter[2] = 0;
+    state->counter[3] = 0;
+}
+
+void arrandom_philox_set_pixel_sample(
+        ArRandomPhilox  * state,
+        UInt32            x,
+        UInt32            y,
+        UInt32            sampleIndex
+        )
+{
+    state->key[1] = 0;
+
+    state->counter[0] = x;
+    state->counter[1] = y;
+    state->counter[2] = sampleIndex;
+    state->counter[3] = 0;
+}
+
+UInt32 arrandom_reverse_bits(
+        UInt32  x
+        )
+{
+    x = ( ( x & 0xaaaaaaaaU ) >>  1 ) | ( ( x & 0x55555555U ) <<  1 );
+    x = ( ( x & 0xccccccccU ) >>  2 ) | ( ( x & 0x33333333U ) <<  2 );
+    x = ( ( x & 0xf0f0f0f0U ) >>  4 ) | ( ( x & 0x0f0f0f0fU ) <<  4 );
+    x = ( ( x & 0xff00ff00U ) >>  8 ) | ( ( x & 0x00ff00ffU ) <<  8 );
+
+    return ( x >> 16 ) | ( x << 16 );
+}
+
+UInt32 arrandom_hash(
+        UInt32  x
+        )
+{
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+
+    return x;
+}
+
+UInt32 arrandom_hash_combine(
+        UInt32  seed,
+        UInt32  value
+        )
+{
+    return
+        seed ^ ( arrandom_hash( value ) + 0x9e3779b9U + ( seed << 6 ) + ( seed >> 2 ) );
+}
+
+//   Laine-Karras style permutation with the constants from Burley's paper;
+//   only ever affects bits above the one it is looking at, which is what
+//   makes it an Owen scramble once applied to the bit-reversed value.
+
+UInt32 arrandom_laine_karras_permutation(
+        UInt32  x,
+        UInt32  seed
+        )
+{
+    x ^= x * 0x3d20adeaU;
+    x += seed;
+    x *= ( seed >> 16 ) | 1;
+    x ^= x * 0x05526c56U;
+    x ^= x * 0x53a22864U;
+
+    return x;
+}
+
+UInt32 arrandom_nested_uniform_scramble(
+        UInt32  x,
+        UInt32  seed
+        )
+{
+    x = arrandom_reverse_bits( x );
+    x = arrandom_laine_karras_permutation( x, seed );
+
+    return arrandom_reverse_bits( x );
+}
+
+//   Second Sobol dimension; the first one is just the bit-reversed index.
+
+UInt32 arrandom_sobol_1(
+        UInt32  index
+        )
+{
+    UInt32  result    = 0;
+    UInt32  direction = 0x80000000U;
+
+    for ( ; index; index >>= 1, direction ^= direction >> 1 )
+        if ( index & 1 )
+            result ^= direction;
+
+    return result;
+}
+
+#define ARRANDOM_UINT32_TO_DOUBLE(__x)  ( (__x) * ( 1.0 / 4294967296.0 ) )
+
+double arrandom_sobol_owen_1d(
+        UInt32  index,
+        UInt32  seed
+        )
+{
+    index = arrandom_nested_uniform_scramble( index, seed );
+
+    UInt32  x = arrandom_reverse_bits( index );
+
+    x = arrandom_nested_uniform_scramble( x, arrandom_hash_combine( seed, 1 ) );
+
+    return ARRANDOM_UINT32_TO_DOUBLE( x );
+}
+
+void arrandom_sobol_owen_2d(
+        UInt32    index,
+        UInt32    seed,
+        double  * value_0,
+        double  * value_1
+        )
+{
+    index = arrandom_nested_uniform_scramble( index, seed );
+
+    UInt32  x = arrandom_reverse_bits( index );
+    UInt32  y = arrandom_sobol_1( index );
+
+    x = arrandom_nested_uniform_scramble( x, arrandom_hash_combine( seed, 1 ) );
+    y = arrandom_nested_uniform_scramble( y, arrandom_hash_combine( seed, 2 ) );
+
+    *value_0 = ARRANDOM_UINT32_TO_DOUBLE( x );
+    *value_1 = ARRANDOM_UINT32_TO_DOUBLE( y );
+}
+
+#undef ARRANDOM_UINT32_TO_DOUBLE
+
 /* ===========================================================================
    RI_vdC(), RI_S() and RI_LP() are from
    Kollig, Keller: Efficient Multidimensional Sampling. (Eurographics 2002)
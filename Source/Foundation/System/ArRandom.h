@@ -131,6 +131,168 @@ double arrandom_nr2_double(
         ArRandomNR2 * state
         );
 
+/* ---------------------------------------------------------------------------
+    'arrandom_philox_...'
+        Counter-based Philox-4x32-10 generator from Salmon et al., "Parallel
+        Random Numbers: As Easy as 1, 2, 3" (SC 2011). There is no state
+        that has to be stepped: each block of four 32 bit values is a pure
+        function of a 64 bit key and a 128 bit counter.
+
+        ART uses the counter for the pixel coordinates, the sample index
+        and the dimension (i.e. the sequence ID), and the key for the
+        global random seed and the number of values drawn since the last
+        reseeding. The latter makes repeated draws from the same dimension,
+        as done by rejection loops that rewind the sequence ID, yield
+        different values. A sample is hence fully determined by its pixel
+        and sample index, regardless of which thread computes it.
+
+        The per-value functions are static inline, so that image samplers
+        and integrators can use them without going through the
+        ArpRandomGenerator protocol.
+--------------------------------------------------------------------------- */
+
+typedef struct ArRandomPhilox
+{
+    UInt32  key[2];
+    UInt32  counter[4];
+}
+ArRandomPhilox;
+
+#define ARRANDOM_PHILOX_M0      0xD2511F53U
+#define ARRANDOM_PHILOX_M1      0xCD9E8D57U
+#define ARRANDOM_PHILOX_W0      0x9E3779B9U
+#define ARRANDOM_PHILOX_W1      0xBB67AE85U
+#define ARRANDOM_PHILOX_ROUNDS  10
+
+void arrandom_philox_seed(
+        ArRandomPhilox  * state,
+        long              seed
+        );
+
+void arrandom_philox_set_pixel_sample(
+        ArRandomPhilox  * state,
+        UInt32            x,
+        UInt32            y,
+        UInt32            sampleIndex
+        );
+
+static inline void arrandom_philox_block(
+        const UInt32  key[2],
+        const UInt32  counter[4],
+              UInt32  result[4]
+        )
+{
+    UInt32  k0 = key[0];
+    UInt32  k1 = key[1];
+    UInt32  c0 = counter[0];
+    UInt32  c1 = counter[1];
+    UInt32  c2 = counter[2];
+    UInt32  c3 = counter[3];
+
+    for ( int r = 0; r < ARRANDOM_PHILOX_ROUNDS; r++ )
+    {
+        UInt64  p0 = (UInt64) ARRANDOM_PHILOX_M0 * c0;
+        UInt64  p1 = (UInt64) ARRANDOM_PHILOX_M1 * c2;
+
+        c0 = (UInt32) ( p1 >> 32 ) ^ c1 ^ k0;
+        c1 = (UInt32) p1;
+        c2 = (UInt32) ( p0 >> 32 ) ^ c3 ^ k1;
+        c3 = (UInt32) p0;
+
+        k0 += ARRANDOM_PHILOX_W0;
+        k1 += ARRANDOM_PHILOX_W1;
+    }
+
+    result[0] = c0;
+    result[1] = c1;
+    result[2] = c2;
+    result[3] = c3;
+}
+
+//   53 bit double in [0,1) from two 32 bit values
+
+#define ARRANDOM_PHILOX_DOUBLE(__hi,__lo) \
+    ( ( ( (__hi) >> 5 ) * 67108864.0 + ( (__lo) >> 6 ) ) \
+      * ( 1.0 / 9007199254740992.0 ) )
+
+static inline double arrandom_philox_double(
+        ArRandomPhilox  * state
+        )
+{
+    UInt32  block[4];
+
+    arrandom_philox_block( state->key, state->counter, block );
+
+    state->counter[3]++;
+    state->key[1]++;
+
+    return ARRANDOM_PHILOX_DOUBLE( block[0], block[1] );
+}
+
+//   Both values come from the same block, but consume two dimensions, just
+//   as two separate calls would.
+
+static inline void arrandom_philox_double_pair(
+        ArRandomPhilox  * state,
+        double          * value_0,
+        double          * value_1
+        )
+{
+    UInt32  block[4];
+
+    arrandom_philox_block( state->key, state->counter, block );
+
+    state->counter[3] += 2;
+    state->key[1]++;
+
+    *value_0 = ARRANDOM_PHILOX_DOUBLE( block[0], block[1] );
+    *value_1 = ARRANDOM_PHILOX_DOUBLE( block[2], block[3] );
+}
+
+#define ARRANDOM_PHILOX_DIMENSION(__state)      ((__state)->counter[3])
+
+/* ---------------------------------------------------------------------------
+    'arrandom_sobol_owen_...'
+        Owen-scrambled Sobol points, using the hash-based nested uniform
+        scrambling from Burley, "Practical Hash-based Owen Scrambling"
+        (JCGT 2020). Only the first two Sobol dimensions are used; higher
+        dimensions are obtained by padding, i.e. by giving every 1D or 2D
+        draw its own seed, which scrambles both the sample index and the
+        resulting point. Consecutive indices 0..2^k-1 of a given seed
+        therefore form a stratified point set, while different seeds are
+        statistically independent.
+--------------------------------------------------------------------------- */
+
+UInt32 arrandom_reverse_bits(
+        UInt32  x
+        );
+
+UInt32 arrandom_hash(
+        UInt32  x
+        );
+
+UInt32 arrandom_hash_combine(
+        UInt32  seed,
+        UInt32  value
+        );
+
+UInt32 arrandom_nested_uniform_scramble(
+        UInt32  x,
+        UInt32  seed
+        );
+
+double arrandom_sobol_owen_1d(
+        UInt32  index,
+        UInt32  seed
+        );
+
+void arrandom_sobol_owen_2d(
+        UInt32    index,
+        UInt32    seed,
+        double  * value_0,
+        double  * value_1
+        );
+
 /* ---------------------------------------------------------------------------
 
     'arrandom_global_set_seed()'